@@ -225,10 +225,11 @@ int main( int argc, char * argv[] ) {
   }
 
   //============================================================================
-  // Create the output hdf5 file.  Do this after nuclide sort.
+  // Create the output hdf5 file.  Do this after nuclide sort.  The file is
+  // kept open and each time dump is flushed to it.
   //============================================================================
 
-  user::hdf5::create_output( 
+  user::hdf5::Hdf5OutputWriter output_writer(
     zone.getProperty<std::string>( S_OUTPUT_FILE ).c_str(),
     p_my_nucnet
   );
@@ -353,10 +354,7 @@ int main( int argc, char * argv[] ) {
        )
     )
     {
-      user::hdf5::append_zones(
-        zone.getProperty<std::string>( S_OUTPUT_FILE ).c_str(),
-        p_my_nucnet
-      );
+      output_writer.appendZones( p_my_nucnet );
       nnt::print_zone_abundances( zone );
     }
 
@@ -364,13 +362,13 @@ int main( int argc, char * argv[] ) {
   // Update timestep.
   //============================================================================
 
-    Libnucnet__Zone__updateTimeStep(
-      zone.getNucnetZone(),
-      &d_dt,
-      D_REG_T,
-      D_REG_Y,
-      D_Y_MIN_DT
-    );
+    d_dt =
+      user::get_zone_abundances( zone )->computeTimeStep(
+        d_dt,
+        D_REG_T,
+        D_REG_Y,
+        D_Y_MIN_DT
+      );
 
     if( zone.getProperty<double>( nnt::s_T9 ) > 10. )
       normalize_zone_abundances( zone );
@@ -410,6 +408,8 @@ int main( int argc, char * argv[] ) {
 
   }
         
+  output_writer.finalize();
+
   //============================================================================
   // Clean up and exit.
   //============================================================================
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to build the electron EOS table and compare the
+//!        interpolated quantities with Libstatmech at the centers of the
+//!        table cells.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <ctime>
+
+#include <boost/program_options.hpp>
+
+#include "user/electron_eos_table.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// Prototypes.
+//############################################################################*/
+
+double
+get_time_since( clock_t );
+
+double
+compute_eos_error( double, double );
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  double d_t9_min = D_ELECTRON_EOS_TABLE_T9_MIN;
+  double d_t9_max = D_ELECTRON_EOS_TABLE_T9_MAX;
+  double d_rhoye_min = D_ELECTRON_EOS_TABLE_RHOYE_MIN;
+  double d_rhoye_max = D_ELECTRON_EOS_TABLE_RHOYE_MAX;
+  size_t i_points_per_decade = I_ELECTRON_EOS_TABLE_POINTS_PER_DECADE;
+  size_t i_stride = 1;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: build the electron EOS table and compare the interpolated quantities with those computed by Libstatmech at the centers of the table cells.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "t9_min",
+       po::value<double>(),
+       "Minimum t9 of the table (default: 0.01)"
+      )
+      (
+       "t9_max",
+       po::value<double>(),
+       "Maximum t9 of the table (default: 10)"
+      )
+      (
+       "rhoye_min",
+       po::value<double>(),
+       "Minimum density (g/cc) times Ye of the table (default: 1)"
+      )
+      (
+       "rhoye_max",
+       po::value<double>(),
+       "Maximum density (g/cc) times Ye of the table (default: 1.e12)"
+      )
+      (
+       "points_per_decade",
+       po::value<size_t>(),
+       "Number of table points per decade (default: 10)"
+      )
+      (
+       "stride",
+       po::value<size_t>(),
+       "Compare at every stride-th cell in each direction (default: 1)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( vm.count("help") == 1 )
+    {
+      std::cout << "\nUsage: " << argv[0] << " [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    if( vm.count("t9_min") == 1 )
+    {
+      d_t9_min = vm["t9_min"].as<double>();
+    }
+
+    if( vm.count("t9_max") == 1 )
+    {
+      d_t9_max = vm["t9_max"].as<double>();
+    }
+
+    if( vm.count("rhoye_min") == 1 )
+    {
+      d_rhoye_min = vm["rhoye_min"].as<double>();
+    }
+
+    if( vm.count("rhoye_max") == 1 )
+    {
+      d_rhoye_max = vm["rhoye_max"].as<double>();
+    }
+
+    if( vm.count("points_per_decade") == 1 )
+    {
+      i_points_per_decade = vm["points_per_decade"].as<size_t>();
+    }
+
+    if( vm.count("stride") == 1 )
+    {
+      i_stride = vm["stride"].as<size_t>();
+    }
+
+    if( i_stride < 1 )
+    {
+      std::cerr << "Invalid stride." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Build the table.
+  //============================================================================
+
+  clock_t t_start = clock();
+
+  user::ElectronEosTable table(
+    d_t9_min, d_t9_max, d_rhoye_min, d_rhoye_max, i_points_per_decade
+  );
+
+  double d_build_time = get_time_since( t_start );
+
+  //============================================================================
+  // Compare at the cell centers.
+  //============================================================================
+
+  double d_exact_time = 0., d_table_time = 0.;
+  double d_err[7] = { 0., 0., 0., 0., 0., 0., 0. };
+  size_t i_compared = 0;
+
+  for( size_t i = 0; i < table.getNumberOfT9Points() - 1; i += i_stride )
+  {
+
+    double d_t9 =
+      pow(
+        10.,
+        table.getLog10T9Min() + ( (double) i + 0.5 ) * table.getLog10Step()
+      );
+
+    for( size_t j = 0; j < table.getNumberOfRhoYePoints() - 1; j += i_stride )
+    {
+
+      double d_rhoye =
+        pow(
+          10.,
+          table.getLog10RhoYeMin() +
+            ( (double) j + 0.5 ) * table.getLog10Step()
+        );
+
+      if( !table.isInRange( d_t9, d_rhoye ) ) continue;
+
+      t_start = clock();
+      user::electron_eos_t exact = user::compute_electron_eos( d_t9, d_rhoye );
+      d_exact_time += get_time_since( t_start );
+
+      t_start = clock();
+      user::electron_eos_t interp = table.interpolate( d_t9, d_rhoye );
+      d_table_time += get_time_since( t_start );
+
+      double v_err[7] =
+      {
+        fabs( interp.dEta - exact.dEta ) / GSL_MAX( fabs( exact.dEta ), 1. ),
+        compute_eos_error( interp.dEtaDerivative, exact.dEtaDerivative ),
+        compute_eos_error( interp.dPressure, exact.dPressure ),
+        compute_eos_error( interp.dDPDT, exact.dDPDT ),
+        compute_eos_error( interp.dEnergyDensity, exact.dEnergyDensity ),
+        compute_eos_error( interp.dEntropyDensity, exact.dEntropyDensity ),
+        compute_eos_error( interp.dDSDT, exact.dDSDT )
+      };
+
+      for( size_t l = 0; l < 7; l++ ) d_err[l] = GSL_MAX( d_err[l], v_err[l] );
+
+      i_compared++;
+
+    }
+
+  }
+
+  //============================================================================
+  // Print the comparison.
+  //============================================================================
+
+  fprintf(
+    stdout,
+    "\nTable: %lu x %lu points  Build (s): %e  Compared: %lu\n\n",
+    (unsigned long) table.getNumberOfT9Points(),
+    (unsigned long) table.getNumberOfRhoYePoints(),
+    d_build_time,
+    (unsigned long) i_compared
+  );
+
+  fprintf( stdout, "Largest relative errors:\n" );
+  fprintf( stdout, "  eta:                    %e\n", d_err[0] );
+  fprintf( stdout, "  d(eta)/dT:              %e\n", d_err[1] );
+  fprintf( stdout, "  pressure:               %e\n", d_err[2] );
+  fprintf( stdout, "  dP/dT:                  %e\n", d_err[3] );
+  fprintf( stdout, "  internal energy:        %e\n", d_err[4] );
+  fprintf( stdout, "  entropy:                %e\n", d_err[5] );
+  fprintf( stdout, "  d(entropy)/dT:          %e\n\n", d_err[6] );
+
+  fprintf(
+    stdout,
+    "%14s %14s %9s\n", "exact (s)", "table (s)", "speedup"
+  );
+
+  fprintf(
+    stdout,
+    "%14.6e %14.6e %9.2f\n",
+    d_exact_time,
+    d_table_time,
+    d_table_time > 0 ? d_exact_time / d_table_time : 0.
+  );
+
+  return EXIT_SUCCESS;
+
+}
+
+/*##############################################################################
+// compute_eos_error().
+//############################################################################*/
+
+double
+compute_eos_error( double d_interpolated, double d_exact )
+{
+
+  if( d_exact == 0. ) return fabs( d_interpolated );
+
+  return fabs( d_interpolated / d_exact - 1. );
+
+}
+
+/*##############################################################################
+// get_time_since().
+//############################################################################*/
+
+double
+get_time_since( clock_t t_start )
+{
+
+  return (double) ( clock() - t_start ) / CLOCKS_PER_SEC;
+
+}
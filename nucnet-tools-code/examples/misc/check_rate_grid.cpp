@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to build the log10(t9) rate grid for a network,
+//!        print its validation report, and compare the interpolated zone
+//!        rates with directly evaluated ones away from the grid points.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <ctime>
+
+#include <boost/program_options.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/iter.h"
+#include "user/remove_duplicate.h"
+#include "user/rate_grid.h"
+#include "user/user_rate_functions.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// Prototypes.
+//############################################################################*/
+
+double
+get_time_since( clock_t );
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet *p_my_nucnet;
+  nnt::Zone zone;
+  std::string s_nuc_xpath = "", s_reac_xpath = "";
+  double d_t9_min = D_RATE_GRID_T9_MIN, d_t9_max = D_RATE_GRID_T9_MAX;
+  double d_tolerance = D_RATE_GRID_TOLERANCE, d_rho = 1.;
+  size_t i_points_per_decade = I_RATE_GRID_POINTS_PER_DECADE, i_t9 = 1000;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: build the log10(t9) rate grid for the input net_xml and zone_xml files, print its validation report, and compare the interpolated zone rates with directly evaluated ones at t9 values between the grid points.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "nuc_xpath",
+       po::value<std::string>(),
+       "XPath to select nuclides (default: all nuclides)"
+      )
+      (
+       "reac_xpath",
+       po::value<std::string>(),
+       "XPath to select reaction (default: all reactions)"
+      )
+      (
+       "t9_min",
+       po::value<double>(),
+       "Minimum t9 of the grid (default: 0.01)"
+      )
+      (
+       "t9_max",
+       po::value<double>(),
+       "Maximum t9 of the grid (default: 10)"
+      )
+      (
+       "points_per_decade",
+       po::value<size_t>(),
+       "Number of grid points per decade in t9 (default: 100)"
+      )
+      (
+       "tolerance",
+       po::value<double>(),
+       "Largest relative error of a tabulated rate (default: 1.e-4)"
+      )
+      (
+       "n_t9",
+       po::value<size_t>(),
+       "Number of t9 values in the comparison (default: 1000)"
+      )
+      (
+       "rho",
+       po::value<double>(),
+       "Mass density (g/cc) for the zone rates (default: 1)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( argc < 3 || vm.count("help") == 1 )
+    {
+      std::cout <<
+        "\nUsage: " << argv[0] << " net_xml zone_xml [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    if( vm.count("nuc_xpath") == 1 )
+    {
+      s_nuc_xpath = vm["nuc_xpath"].as<std::string>();
+    }
+
+    if( vm.count("reac_xpath") == 1 )
+    {
+      s_reac_xpath = vm["reac_xpath"].as<std::string>();
+    }
+
+    if( vm.count("t9_min") == 1 )
+    {
+      d_t9_min = vm["t9_min"].as<double>();
+    }
+
+    if( vm.count("t9_max") == 1 )
+    {
+      d_t9_max = vm["t9_max"].as<double>();
+    }
+
+    if( vm.count("points_per_decade") == 1 )
+    {
+      i_points_per_decade = vm["points_per_decade"].as<size_t>();
+    }
+
+    if( vm.count("tolerance") == 1 )
+    {
+      d_tolerance = vm["tolerance"].as<double>();
+    }
+
+    if( vm.count("n_t9") == 1 )
+    {
+      i_t9 = vm["n_t9"].as<size_t>();
+    }
+
+    if( vm.count("rho") == 1 )
+    {
+      d_rho = vm["rho"].as<double>();
+    }
+
+    if( d_t9_min <= 0 || d_t9_max <= d_t9_min || i_t9 < 1 )
+    {
+      std::cerr << "Invalid t9 range." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Read and store input.
+  //============================================================================
+
+  p_my_nucnet = Libnucnet__new();
+
+  Libnucnet__Net__updateFromXml(
+    Libnucnet__getNet( p_my_nucnet ),
+    argv[1],
+    s_nuc_xpath.c_str(),
+    s_reac_xpath.c_str()
+  );
+
+  Libnucnet__assignZoneDataFromXml( p_my_nucnet, argv[2], NULL );
+
+  user::register_rate_functions(
+    Libnucnet__Net__getReac( Libnucnet__getNet( p_my_nucnet ) )
+  );
+
+  user::remove_duplicate_reactions(
+    Libnucnet__getNet( p_my_nucnet )
+  );
+
+  zone.setNucnetZone(
+    Libnucnet__getZoneByLabels( p_my_nucnet, "0", "0", "0" )
+  );
+
+  zone.updateProperty( nnt::s_RATE_GRID_T9_MIN, d_t9_min );
+  zone.updateProperty( nnt::s_RATE_GRID_T9_MAX, d_t9_max );
+  zone.updateProperty(
+    nnt::s_RATE_GRID_POINTS_PER_DECADE, i_points_per_decade
+  );
+  zone.updateProperty( nnt::s_RATE_GRID_TOLERANCE, d_tolerance );
+
+  user::get_rate_spline_cache_for_zone( zone );
+  user::get_non_smoker_rate_kernel_for_zone( zone );
+
+  //============================================================================
+  // Build the grid and print the validation report.
+  //============================================================================
+
+  boost::shared_ptr<user::ZoneRates> p_rates = user::get_zone_rates( zone );
+
+  clock_t t_start = clock();
+
+  boost::shared_ptr<user::RateGrid> p_grid =
+    user::get_rate_grid_for_zone( zone );
+
+  double d_build_time = get_time_since( t_start );
+
+  p_grid->printValidationReport( std::cout );
+
+  //============================================================================
+  // Compare at t9 values between the grid points.
+  //============================================================================
+
+  std::vector<double> v_t9, v_forward, v_reverse;
+
+  for( size_t i = 0; i < i_t9; i++ )
+    v_t9.push_back(
+      d_t9_min *
+      pow( d_t9_max / d_t9_min, ( (double) i + 0.37 ) / (double) i_t9 )
+    );
+
+  t_start = clock();
+
+  for( size_t i = 0; i < v_t9.size(); i++ )
+  {
+    p_rates->computeRates( zone.getNucnetZone(), v_t9[i], d_rho );
+    v_forward.insert(
+      v_forward.end(),
+      p_rates->getForwardRateVector().begin(),
+      p_rates->getForwardRateVector().end()
+    );
+    v_reverse.insert(
+      v_reverse.end(),
+      p_rates->getReverseRateVector().begin(),
+      p_rates->getReverseRateVector().end()
+    );
+  }
+
+  double d_direct_time = get_time_since( t_start );
+
+  double d_forward_diff = 0, d_reverse_diff = 0, d_grid_time = 0;
+  size_t i_rate = 0;
+
+  for( size_t i = 0; i < v_t9.size(); i++ )
+  {
+
+    t_start = clock();
+
+    p_rates->computeRates(
+      zone.getNucnetZone(), v_t9[i], d_rho, p_grid
+    );
+
+    d_grid_time += get_time_since( t_start );
+
+    for( size_t r = 0; r < p_rates->getNumberOfReactions(); r++ )
+    {
+      if( v_forward[i_rate] > 0 )
+        d_forward_diff =
+          GSL_MAX(
+            d_forward_diff,
+            fabs( p_rates->getForwardRateVector()[r] - v_forward[i_rate] ) /
+              v_forward[i_rate]
+          );
+      if( v_reverse[i_rate] > 0 )
+        d_reverse_diff =
+          GSL_MAX(
+            d_reverse_diff,
+            fabs( p_rates->getReverseRateVector()[r] - v_reverse[i_rate] ) /
+              v_reverse[i_rate]
+          );
+      i_rate++;
+    }
+
+  }
+
+  //============================================================================
+  // Print the comparison.
+  //============================================================================
+
+  fprintf(
+    stdout,
+    "\nReactions: %lu  Tabulated: %lu  t9 values: %lu  Grid build (s): %e\n\n",
+    (unsigned long) p_rates->getNumberOfReactions(),
+    (unsigned long) p_grid->getNumberOfTabulatedReactions(),
+    (unsigned long) v_t9.size(),
+    d_build_time
+  );
+
+  fprintf(
+    stdout,
+    "%14s %14s %9s %14s %14s\n",
+    "direct (s)", "grid (s)", "speedup", "forward diff", "reverse diff"
+  );
+
+  fprintf(
+    stdout,
+    "%14.6e %14.6e %9.2f %14.4e %14.4e\n",
+    d_direct_time,
+    d_grid_time,
+    d_grid_time > 0 ? d_direct_time / d_grid_time : 0.,
+    d_forward_diff,
+    d_reverse_diff
+  );
+
+  //============================================================================
+  // Clean up and exit.
+  //============================================================================
+
+  Libnucnet__free( p_my_nucnet );
+  return EXIT_SUCCESS;
+
+}
+
+/*##############################################################################
+// get_time_since().
+//############################################################################*/
+
+double
+get_time_since( clock_t t_start )
+{
+
+  return (double) ( clock() - t_start ) / CLOCKS_PER_SEC;
+
+}
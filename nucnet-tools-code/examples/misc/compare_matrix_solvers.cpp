@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to compare the timing and accuracy of the matrix
+//!        solvers for the Newton-Raphson matrix of a zone.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <ctime>
+
+#include <boost/program_options.hpp>
+
+#include <Libnucnet.h>
+
+#include "user/evolve.h"
+#include "user/remove_duplicate.h"
+#include "user/matrix_solver.h"
+#include "user/sparse_lu_solver.h"
+#include "user/user_rate_functions.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// Prototypes.
+//############################################################################*/
+
+void
+time_solver(
+  nnt::Zone&,
+  WnMatrix *,
+  gsl_vector *,
+  const char *,
+  size_t
+);
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet *p_my_nucnet;
+  nnt::Zone zone;
+  WnMatrix *p_matrix;
+  gsl_vector *p_rhs;
+  std::string s_nuc_xpath = "", s_reac_xpath = "";
+  std::string s_arrow_width = "3";
+  size_t i_repeats = 10;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: compare the time and residual of the dense, arrow, and sparse LU solutions of the Newton-Raphson matrix for the input net_xml and zone_xml files for the selected nuclei and reactions.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "nuc_xpath",
+       po::value<std::string>(),
+       "XPath to select nuclides (default: all nuclides)"
+      )
+      (
+       "reac_xpath",
+       po::value<std::string>(),
+       "XPath to select reaction (default: all reactions)"
+      )
+      (
+       "repeats",
+       po::value<size_t>(),
+       "Number of solves to time for each solver (default: 10)"
+      )
+      (
+       "arrow_width",
+       po::value<std::string>(),
+       "Width of the arrow matrix (default: 3)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( argc < 3 || vm.count("help") == 1 )
+    {
+      std::cout <<
+        "\nUsage: " << argv[0] << " net_xml zone_xml [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    if( vm.count("nuc_xpath") == 1 )
+    {
+      s_nuc_xpath = vm["nuc_xpath"].as<std::string>();
+    }
+
+    if( vm.count("reac_xpath") == 1 )
+    {
+      s_reac_xpath = vm["reac_xpath"].as<std::string>();
+    }
+
+    if( vm.count("repeats") == 1 )
+    {
+      i_repeats = vm["repeats"].as<size_t>();
+      if( i_repeats == 0 )
+      {
+        std::cerr << "Number of repeats must be positive." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+
+    if( vm.count("arrow_width") == 1 )
+    {
+      s_arrow_width = vm["arrow_width"].as<std::string>();
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Read and store input.
+  //============================================================================
+
+  p_my_nucnet = Libnucnet__new();
+
+  Libnucnet__Net__updateFromXml(
+    Libnucnet__getNet( p_my_nucnet ),
+    argv[1],
+    s_nuc_xpath.c_str(),
+    s_reac_xpath.c_str()
+  );
+
+  Libnucnet__assignZoneDataFromXml( p_my_nucnet, argv[2], NULL );
+
+  //============================================================================
+  // Register user-supplied rate functions.
+  //============================================================================
+
+  user::register_rate_functions(
+    Libnucnet__Net__getReac( Libnucnet__getNet( p_my_nucnet ) )
+  );
+
+  //============================================================================
+  // Remove duplicate reactions.
+  //============================================================================
+
+  user::remove_duplicate_reactions(
+    Libnucnet__getNet( p_my_nucnet )
+  );
+
+  //============================================================================
+  // Sort the nuclei so that the arrow solver applies.
+  //============================================================================
+
+  Libnucnet__Nuc__setSpeciesCompareFunction(
+    Libnucnet__Net__getNuc( Libnucnet__getNet( p_my_nucnet ) ),
+    (Libnucnet__Species__compare_function) nnt::species_sort_function
+  );
+
+  Libnucnet__Nuc__sortSpecies(
+    Libnucnet__Net__getNuc( Libnucnet__getNet( p_my_nucnet ) )
+  );
+
+  //============================================================================
+  // Get the zone.
+  //============================================================================
+
+  zone.setNucnetZone(
+    Libnucnet__getZoneByLabels( p_my_nucnet, "0", "0", "0" )
+  );
+
+  zone.updateProperty( nnt::s_ARROW_WIDTH, s_arrow_width );
+
+  //============================================================================
+  // Get matrix and rhs vector and add 1/dt to diagonal.
+  //============================================================================
+
+  boost::tie( p_matrix, p_rhs ) =
+    user::get_evolution_matrix_and_vector( zone );
+
+  WnMatrix__addValueToDiagonals(
+    p_matrix,
+    1.0 / zone.getProperty<double>( nnt::s_DTIME )
+  );
+
+  std::cout << std::endl << "Matrix rows: " <<
+    WnMatrix__getNumberOfRows( p_matrix ) << "  Non-zero elements: " <<
+    WnMatrix__getNumberOfElements( p_matrix ) << std::endl << std::endl;
+
+  //============================================================================
+  // Time the solvers.
+  //============================================================================
+
+  fprintf(
+    stdout,
+    "%12s   %14s   %14s\n",
+    "solver", "time/solve (s)", "rel. residual"
+  );
+
+  time_solver( zone, p_matrix, p_rhs, nnt::s_GSL, i_repeats );
+
+  time_solver( zone, p_matrix, p_rhs, nnt::s_ARROW, i_repeats );
+
+  time_solver( zone, p_matrix, p_rhs, nnt::s_SPARSE_LU, i_repeats );
+
+  //============================================================================
+  // Clean up and exit.
+  //============================================================================
+
+  WnMatrix__free( p_matrix );
+  gsl_vector_free( p_rhs );
+
+  Libnucnet__free( p_my_nucnet );
+  return EXIT_SUCCESS;
+
+}
+
+/*##############################################################################
+// time_solver().
+//############################################################################*/
+
+void
+time_solver(
+  nnt::Zone& zone,
+  WnMatrix * p_matrix,
+  gsl_vector * p_rhs,
+  const char * s_solver,
+  size_t i_repeats
+)
+{
+
+  gsl_vector * p_sol = NULL, * p_check;
+  double d_residual = 0, d_norm = 0;
+  clock_t t_start;
+
+  zone.updateProperty( nnt::s_SOLVER, s_solver );
+
+  t_start = clock();
+
+  for( size_t i = 0; i < i_repeats; i++ )
+  {
+    if( p_sol ) gsl_vector_free( p_sol );
+    p_sol = user::solve_matrix_for_zone( zone, p_matrix, p_rhs );
+  }
+
+  double d_time =
+    ( (double) ( clock() - t_start ) / CLOCKS_PER_SEC ) / (double) i_repeats;
+
+  //============================================================================
+  // Residual.
+  //============================================================================
+
+  p_check = WnMatrix__computeMatrixTimesVector( p_matrix, p_sol );
+
+  for( size_t i = 0; i < p_check->size; i++ )
+  {
+    double d_diff =
+      fabs( gsl_vector_get( p_check, i ) - gsl_vector_get( p_rhs, i ) );
+    if( d_diff > d_residual ) d_residual = d_diff;
+    if( fabs( gsl_vector_get( p_rhs, i ) ) > d_norm )
+      d_norm = fabs( gsl_vector_get( p_rhs, i ) );
+  }
+
+  if( d_norm > 0 ) d_residual /= d_norm;
+
+  fprintf( stdout, "%12s   %14.6e   %14.6e\n", s_solver, d_time, d_residual );
+
+  gsl_vector_free( p_check );
+  gsl_vector_free( p_sol );
+
+}
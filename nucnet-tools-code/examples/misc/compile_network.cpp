@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to compile a network xml file into a binary data
+//!        file that the network examples read directly.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <Libnucnet.h>
+
+#include "user/network_cache.h"
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet__Net * p_net;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  if( argc < 3 || argc > 5 )
+  {
+    fprintf(
+      stderr,
+      "\nUsage: %s net_file out_file nuc_xpath reac_xpath\n\n", argv[0]
+    );
+    fprintf(
+      stderr, "  net_file = input network xml filename\n\n"
+    );
+    fprintf(
+      stderr,
+      "  out_file = output binary data filename (\"cache\" to store in $%s)\n\n",
+      S_NETWORK_CACHE_DIR_ENV
+    );
+    fprintf(
+      stderr,
+      "  nuc_xpath = nuclear xpath expression (optional--required if reac_xpath specified)\n\n"
+    );
+    fprintf(
+      stderr, "  reac_xpath = reaction xpath expression (optional)\n\n"
+    );
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Get the output file.  For the cache, the file is the one that
+  // user::update_net_from_network_cache() looks for.
+  //============================================================================
+
+  std::string s_output = argv[2];
+
+  if( s_output == "cache" )
+  {
+
+    s_output =
+      user::get_network_cache_file(
+        user::get_net_cache_key(
+          argv[1],
+          argc > 3 ? argv[3] : NULL,
+          argc > 4 ? argv[4] : NULL
+        )
+      );
+
+    if( s_output.empty() )
+    {
+      std::cerr << S_NETWORK_CACHE_DIR_ENV << " is not set." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  }
+
+  //============================================================================
+  // Compile and write.
+  //============================================================================
+
+  p_net = Libnucnet__Net__new();
+
+  user::compile_net_from_xml(
+    p_net,
+    argv[1],
+    argc > 3 ? argv[3] : NULL,
+    argc > 4 ? argv[4] : NULL
+  );
+
+  user::write_network_cache( p_net, s_output );
+
+  std::cout << s_output << std::endl;
+
+  //============================================================================
+  // Clean up and done.
+  //============================================================================
+
+  Libnucnet__Net__free( p_net );
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to convert network and zone xml and a text trajectory
+//!        to the binary data format.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <fstream>
+
+#include <boost/program_options.hpp>
+
+#include <Libnucnet.h>
+
+#include "user/binary_data.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  std::string s_output, s_net, s_zone, s_trajectory;
+  std::string s_nuc_xpath = "", s_reac_xpath = "";
+  std::vector<double> time, t9, log10_rho;
+  user::BinaryDataWriter writer;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: convert network xml, zone xml, and a text trajectory (time, t9, and density columns) to a binary data file.  Any of the inputs may be omitted.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "output",
+       po::value<std::string>(),
+       "Name of the output binary data file (required)"
+      )
+      (
+       "net",
+       po::value<std::string>(),
+       "Name of the input network xml file"
+      )
+      (
+       "zone",
+       po::value<std::string>(),
+       "Name of the input zone xml file (requires net)"
+      )
+      (
+       "trajectory",
+       po::value<std::string>(),
+       "Name of the input trajectory text file"
+      )
+      (
+       "nuc_xpath",
+       po::value<std::string>(),
+       "XPath to select nuclides (default: all nuclides)"
+      )
+      (
+       "reac_xpath",
+       po::value<std::string>(),
+       "XPath to select reactions (default: all reactions)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( vm.count("help") == 1 || vm.count("output") == 0 )
+    {
+      std::cout << "\nUsage: " << argv[0] << " [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    s_output = vm["output"].as<std::string>();
+
+    if( vm.count("net") == 1 )
+    {
+      s_net = vm["net"].as<std::string>();
+    }
+
+    if( vm.count("zone") == 1 )
+    {
+      s_zone = vm["zone"].as<std::string>();
+    }
+
+    if( vm.count("trajectory") == 1 )
+    {
+      s_trajectory = vm["trajectory"].as<std::string>();
+    }
+
+    if( vm.count("nuc_xpath") == 1 )
+    {
+      s_nuc_xpath = vm["nuc_xpath"].as<std::string>();
+    }
+
+    if( vm.count("reac_xpath") == 1 )
+    {
+      s_reac_xpath = vm["reac_xpath"].as<std::string>();
+    }
+
+    if( !s_zone.empty() && s_net.empty() )
+    {
+      std::cerr << "Zone input requires network input." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Network and zones.
+  //============================================================================
+
+  if( !s_net.empty() )
+  {
+
+    Libnucnet * p_nucnet = Libnucnet__new();
+
+    Libnucnet__Net__updateFromXml(
+      Libnucnet__getNet( p_nucnet ),
+      s_net.c_str(),
+      s_nuc_xpath.c_str(),
+      s_reac_xpath.c_str()
+    );
+
+    if( !s_zone.empty() )
+      Libnucnet__assignZoneDataFromXml( p_nucnet, s_zone.c_str(), NULL );
+
+    writer.addNet( Libnucnet__getNet( p_nucnet ) );
+
+    writer.addZones( p_nucnet );
+
+    Libnucnet__free( p_nucnet );
+
+  }
+
+  //============================================================================
+  // Trajectory.
+  //============================================================================
+
+  if( !s_trajectory.empty() )
+  {
+
+    std::ifstream my_file;
+    double d_x1, d_x2, d_x3;
+
+    my_file.open( s_trajectory.c_str() );
+
+    if( !my_file.is_open() || my_file.bad() )
+    {
+      std::cerr << "Couldn't open file " << s_trajectory << "!" << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+    while( my_file >> d_x1 >> d_x2 >> d_x3 )
+    {
+      time.push_back( d_x1 );
+      t9.push_back( d_x2 );
+      log10_rho.push_back( log10( d_x3 ) );
+    }
+
+    my_file.close();
+
+    writer.addTrajectory( time, t9, log10_rho );
+
+  }
+
+  //============================================================================
+  // Write output.
+  //============================================================================
+
+  writer.write( s_output.c_str() );
+
+  return EXIT_SUCCESS;
+
+}
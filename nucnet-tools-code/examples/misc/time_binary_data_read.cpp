@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to compare the time to read a network and zones from
+//!        xml and from the binary data format.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <ctime>
+
+#include <Libnucnet.h>
+
+#include "user/binary_data.h"
+
+/*##############################################################################
+// Prototypes.
+//############################################################################*/
+
+double
+get_time_since( clock_t );
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet * p_xml_nucnet, * p_binary_nucnet;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  if( argc != 4 )
+  {
+    fprintf(
+      stderr,
+      "\nUsage: %s net_file zone_file binary_file\n\n", argv[0]
+    );
+    fprintf(
+      stderr, "  net_file = input network xml filename\n\n"
+    );
+    fprintf(
+      stderr, "  zone_file = input zone xml filename\n\n"
+    );
+    fprintf(
+      stderr,
+      "  binary_file = binary data file converted from net_file and zone_file\n\n"
+    );
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Read from xml.
+  //============================================================================
+
+  clock_t t_start = clock();
+
+  p_xml_nucnet = Libnucnet__new();
+
+  Libnucnet__Net__updateFromXml(
+    Libnucnet__getNet( p_xml_nucnet ), argv[1], NULL, NULL
+  );
+
+  Libnucnet__assignZoneDataFromXml( p_xml_nucnet, argv[2], NULL );
+
+  double d_xml_time = get_time_since( t_start );
+
+  //============================================================================
+  // Read from binary data.
+  //============================================================================
+
+  t_start = clock();
+
+  p_binary_nucnet = Libnucnet__new();
+
+  user::update_net_from_binary_data(
+    Libnucnet__getNet( p_binary_nucnet ), argv[3], NULL, NULL
+  );
+
+  user::assign_zone_data_from_binary_data( p_binary_nucnet, argv[3] );
+
+  double d_binary_time = get_time_since( t_start );
+
+  //============================================================================
+  // Compare.
+  //============================================================================
+
+  fprintf(
+    stdout,
+    "\n%10s %10s %10s %10s %14s\n",
+    "input", "species", "reactions", "zones", "read time (s)"
+  );
+
+  fprintf(
+    stdout,
+    "%10s %10lu %10lu %10lu %14.6e\n",
+    "xml",
+    (unsigned long) Libnucnet__Nuc__getNumberOfSpecies(
+      Libnucnet__Net__getNuc( Libnucnet__getNet( p_xml_nucnet ) )
+    ),
+    (unsigned long) Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac( Libnucnet__getNet( p_xml_nucnet ) )
+    ),
+    (unsigned long) Libnucnet__getNumberOfZones( p_xml_nucnet ),
+    d_xml_time
+  );
+
+  fprintf(
+    stdout,
+    "%10s %10lu %10lu %10lu %14.6e\n\n",
+    "binary",
+    (unsigned long) Libnucnet__Nuc__getNumberOfSpecies(
+      Libnucnet__Net__getNuc( Libnucnet__getNet( p_binary_nucnet ) )
+    ),
+    (unsigned long) Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac( Libnucnet__getNet( p_binary_nucnet ) )
+    ),
+    (unsigned long) Libnucnet__getNumberOfZones( p_binary_nucnet ),
+    d_binary_time
+  );
+
+  //============================================================================
+  // Clean up and done.
+  //============================================================================
+
+  Libnucnet__free( p_xml_nucnet );
+  Libnucnet__free( p_binary_nucnet );
+
+  return EXIT_SUCCESS;
+
+}
+
+/*##############################################################################
+// get_time_since().
+//############################################################################*/
+
+double
+get_time_since( clock_t t_start )
+{
+
+  return (double) ( clock() - t_start ) / CLOCKS_PER_SEC;
+
+}
@@ -0,0 +1,319 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to compare the time to build the network Jacobian
+//!        with Libnucnet and with the compiled sparse row assembly as a
+//!        function of network size.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <ctime>
+
+#include <boost/program_options.hpp>
+
+#include <Libnucnet.h>
+
+#include "user/evolve.h"
+#include "user/remove_duplicate.h"
+#include "user/network_jacobian.h"
+#include "user/user_rate_functions.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet *p_my_nucnet;
+  nnt::Zone zone;
+  std::string s_nuc_xpath = "", s_reac_xpath = "";
+  size_t i_repeats = 10;
+  unsigned int i_z_step = 10, i_z_max = 0;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: time the Libnucnet and compiled sparse row builds of the network Jacobian for the input net_xml and zone_xml files for networks of increasing maximum atomic number.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "nuc_xpath",
+       po::value<std::string>(),
+       "XPath to select nuclides (default: all nuclides)"
+      )
+      (
+       "reac_xpath",
+       po::value<std::string>(),
+       "XPath to select reaction (default: all reactions)"
+      )
+      (
+       "repeats",
+       po::value<size_t>(),
+       "Number of builds to time for each network (default: 10)"
+      )
+      (
+       "z_step",
+       po::value<unsigned int>(),
+       "Step in maximum atomic number between networks (default: 10)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( argc < 3 || vm.count("help") == 1 )
+    {
+      std::cout <<
+        "\nUsage: " << argv[0] << " net_xml zone_xml [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    if( vm.count("nuc_xpath") == 1 )
+    {
+      s_nuc_xpath = vm["nuc_xpath"].as<std::string>();
+    }
+
+    if( vm.count("reac_xpath") == 1 )
+    {
+      s_reac_xpath = vm["reac_xpath"].as<std::string>();
+    }
+
+    if( vm.count("repeats") == 1 )
+    {
+      i_repeats = vm["repeats"].as<size_t>();
+      if( i_repeats == 0 )
+      {
+        std::cerr << "Number of repeats must be positive." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+
+    if( vm.count("z_step") == 1 )
+    {
+      i_z_step = vm["z_step"].as<unsigned int>();
+      if( i_z_step == 0 )
+      {
+        std::cerr << "Atomic number step must be positive." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Read and store input.
+  //============================================================================
+
+  p_my_nucnet = Libnucnet__new();
+
+  Libnucnet__Net__updateFromXml(
+    Libnucnet__getNet( p_my_nucnet ),
+    argv[1],
+    s_nuc_xpath.c_str(),
+    s_reac_xpath.c_str()
+  );
+
+  Libnucnet__assignZoneDataFromXml( p_my_nucnet, argv[2], NULL );
+
+  user::register_rate_functions(
+    Libnucnet__Net__getReac( Libnucnet__getNet( p_my_nucnet ) )
+  );
+
+  user::remove_duplicate_reactions(
+    Libnucnet__getNet( p_my_nucnet )
+  );
+
+  zone.setNucnetZone(
+    Libnucnet__getZoneByLabels( p_my_nucnet, "0", "0", "0" )
+  );
+
+  //============================================================================
+  // Find the largest atomic number.
+  //============================================================================
+
+  BOOST_FOREACH(
+    nnt::Species species,
+    nnt::make_species_list(
+      Libnucnet__Net__getNuc( Libnucnet__getNet( p_my_nucnet ) )
+    )
+  )
+  {
+    if( Libnucnet__Species__getZ( species.getNucnetSpecies() ) > i_z_max )
+      i_z_max = Libnucnet__Species__getZ( species.getNucnetSpecies() );
+  }
+
+  //============================================================================
+  // Loop over networks.
+  //============================================================================
+
+  fprintf(
+    stdout,
+    "\n%5s %8s %9s %9s %14s %14s %14s %9s %12s\n",
+    "Z_max", "species", "reactions", "elements", "compile (s)",
+    "Libnucnet (s)", "compiled (s)", "speedup", "max rel diff"
+  );
+
+  for( unsigned int i_z = i_z_step; ; i_z += i_z_step )
+  {
+
+    if( i_z > i_z_max ) i_z = i_z_max;
+
+    std::string s_xpath =
+      "[z <= " + boost::lexical_cast<std::string>( i_z ) + "]";
+
+    Libnucnet__Zone__updateNetView(
+      zone.getNucnetZone(),
+      EVOLUTION_NETWORK,
+      NULL,
+      NULL,
+      Libnucnet__NetView__new(
+        Libnucnet__getNet( p_my_nucnet ),
+        s_xpath.c_str(),
+        ""
+      )
+    );
+
+    user::set_zone_for_evolution( zone );
+
+    user::update_libnucnet_rates_for_zone( zone );
+
+    gsl_vector * p_abunds =
+      Libnucnet__Zone__getAbundances( zone.getNucnetZone() );
+
+    //--------------------------------------------------------------------------
+    // Libnucnet build.
+    //--------------------------------------------------------------------------
+
+    clock_t t_start = clock();
+
+    for( size_t i = 0; i < i_repeats; i++ )
+    {
+      WnMatrix__free(
+        Libnucnet__Zone__computeJacobianMatrix( zone.getNucnetZone() )
+      );
+    }
+
+    double d_libnucnet =
+      ( (double) ( clock() - t_start ) / CLOCKS_PER_SEC ) / (double) i_repeats;
+
+    //--------------------------------------------------------------------------
+    // Compiled build.
+    //--------------------------------------------------------------------------
+
+    t_start = clock();
+
+    boost::shared_ptr<user::NetworkJacobian> p_jacobian =
+      user::get_network_jacobian_for_zone( zone );
+
+    double d_compile = (double) ( clock() - t_start ) / CLOCKS_PER_SEC;
+
+    t_start = clock();
+
+    for( size_t i = 0; i < i_repeats; i++ )
+      p_jacobian->computeMatrix( *user::get_zone_rates( zone ), p_abunds );
+
+    double d_compiled =
+      ( (double) ( clock() - t_start ) / CLOCKS_PER_SEC ) / (double) i_repeats;
+
+    //--------------------------------------------------------------------------
+    // Compare.
+    //--------------------------------------------------------------------------
+
+    WnMatrix * p_matrix =
+      Libnucnet__Zone__computeJacobianMatrix( zone.getNucnetZone() );
+
+    double d_max = 0, d_diff = 0;
+
+    for( size_t i = 0; i < p_jacobian->getNumberOfRows(); i++ )
+    {
+      for(
+        size_t p = p_jacobian->getRowPointerVector()[i];
+        p < p_jacobian->getRowPointerVector()[i+1];
+        p++
+      )
+      {
+        double d_value = p_jacobian->getValueVector()[p];
+        if( fabs( d_value ) > d_max ) d_max = fabs( d_value );
+        d_value -=
+          WnMatrix__getElement(
+            p_matrix,
+            i + 1,
+            p_jacobian->getColumnVector()[p] + 1
+          );
+        if( fabs( d_value ) > d_diff ) d_diff = fabs( d_value );
+      }
+    }
+
+    if( d_max > 0 ) d_diff /= d_max;
+
+    fprintf(
+      stdout,
+      "%5u %8lu %9lu %9lu %14.6e %14.6e %14.6e %9.2f %12.4e\n",
+      i_z,
+      (unsigned long) Libnucnet__Nuc__getNumberOfSpecies(
+        Libnucnet__Net__getNuc(
+          Libnucnet__NetView__getNet( p_jacobian->getNetView() )
+        )
+      ),
+      (unsigned long) p_jacobian->getNumberOfReactions(),
+      (unsigned long) p_jacobian->getNumberOfElements(),
+      d_compile,
+      d_libnucnet,
+      d_compiled,
+      d_compiled > 0 ? d_libnucnet / d_compiled : 0.,
+      d_diff
+    );
+
+    WnMatrix__free( p_matrix );
+    gsl_vector_free( p_abunds );
+
+    if( i_z == i_z_max ) break;
+
+  }
+
+  //============================================================================
+  // Clean up and exit.
+  //============================================================================
+
+  Libnucnet__free( p_my_nucnet );
+  return EXIT_SUCCESS;
+
+}
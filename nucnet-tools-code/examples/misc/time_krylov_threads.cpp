@@ -0,0 +1,361 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to time concurrent ILUT-preconditioned Krylov solves
+//!        of a zone's Newton-Raphson matrix as a function of the number of
+//!        threads.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#ifndef NO_OPENMP
+#include <omp.h>
+#endif
+
+#include <ctime>
+
+#include <boost/program_options.hpp>
+
+#include <Libnucnet.h>
+
+#include "user/evolve.h"
+#include "user/remove_duplicate.h"
+#include "user/krylov_solver.h"
+#include "user/user_rate_functions.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// Prototypes.
+//############################################################################*/
+
+double
+get_wall_time();
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet *p_my_nucnet;
+  nnt::Zone zone;
+  gsl_vector *p_rhs;
+  std::string s_nuc_xpath = "", s_reac_xpath = "";
+  std::string s_method = "";
+  size_t i_solves = 256, i_max_threads = 64;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: time concurrent ILUT-preconditioned Krylov solutions of the Newton-Raphson matrix for the input net_xml and zone_xml files on 1, 2, 4, ... threads.  The zone's iterative solver properties set the solver tolerances and the preconditioner.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "nuc_xpath",
+       po::value<std::string>(),
+       "XPath to select nuclides (default: all nuclides)"
+      )
+      (
+       "reac_xpath",
+       po::value<std::string>(),
+       "XPath to select reaction (default: all reactions)"
+      )
+      (
+       "method",
+       po::value<std::string>(),
+       "Krylov method, gmres or bcgstab (default: zone property or gmres)"
+      )
+      (
+       "solves",
+       po::value<size_t>(),
+       "Number of solves for each number of threads (default: 256)"
+      )
+      (
+       "max_threads",
+       po::value<size_t>(),
+       "Largest number of threads (default: 64)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( argc < 3 || vm.count("help") == 1 )
+    {
+      std::cout <<
+        "\nUsage: " << argv[0] << " net_xml zone_xml [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    if( vm.count("nuc_xpath") == 1 )
+    {
+      s_nuc_xpath = vm["nuc_xpath"].as<std::string>();
+    }
+
+    if( vm.count("reac_xpath") == 1 )
+    {
+      s_reac_xpath = vm["reac_xpath"].as<std::string>();
+    }
+
+    if( vm.count("method") == 1 )
+    {
+      s_method = vm["method"].as<std::string>();
+      if( !user::is_native_krylov_method( s_method ) )
+      {
+        std::cerr << "No such Krylov method: " << s_method << std::endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+
+    if( vm.count("solves") == 1 )
+    {
+      i_solves = vm["solves"].as<size_t>();
+      if( i_solves == 0 )
+      {
+        std::cerr << "Number of solves must be positive." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+
+    if( vm.count("max_threads") == 1 )
+    {
+      i_max_threads = vm["max_threads"].as<size_t>();
+      if( i_max_threads == 0 )
+      {
+        std::cerr << "Number of threads must be positive." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Read and store input.
+  //============================================================================
+
+  p_my_nucnet = Libnucnet__new();
+
+  Libnucnet__Net__updateFromXml(
+    Libnucnet__getNet( p_my_nucnet ),
+    argv[1],
+    s_nuc_xpath.c_str(),
+    s_reac_xpath.c_str()
+  );
+
+  Libnucnet__assignZoneDataFromXml( p_my_nucnet, argv[2], NULL );
+
+  user::register_rate_functions(
+    Libnucnet__Net__getReac( Libnucnet__getNet( p_my_nucnet ) )
+  );
+
+  user::remove_duplicate_reactions(
+    Libnucnet__getNet( p_my_nucnet )
+  );
+
+  zone.setNucnetZone(
+    Libnucnet__getZoneByLabels( p_my_nucnet, "0", "0", "0" )
+  );
+
+  if( !s_method.empty() )
+    zone.updateProperty( nnt::s_ITER_SOLVER, s_method );
+  else if( !zone.hasProperty( nnt::s_ITER_SOLVER ) )
+    zone.updateProperty( nnt::s_ITER_SOLVER, S_KRYLOV_GMRES );
+
+  user::krylov_solver_parameters_t params =
+    user::get_krylov_solver_parameters( zone );
+
+  //============================================================================
+  // Get the Newton-Raphson matrix in compressed sparse row form.
+  //============================================================================
+
+  boost::shared_ptr<user::NetworkJacobian> p_jacobian;
+
+  boost::tie( p_jacobian, p_rhs ) =
+    user::get_evolution_jacobian_and_vector( zone );
+
+  p_jacobian->addValueToDiagonals(
+    1.0 / zone.getProperty<double>( nnt::s_DTIME )
+  );
+
+  size_t i_rows = p_jacobian->getNumberOfRows();
+
+  std::cout << std::endl << "Matrix rows: " << i_rows <<
+    "  Non-zero elements: " << p_jacobian->getNumberOfElements() <<
+    "  Method: " << params.sMethod << std::endl << std::endl;
+
+  //============================================================================
+  // Reference solution.
+  //============================================================================
+
+  gsl_vector * p_reference = gsl_vector_alloc( i_rows );
+
+  if(
+    !user::krylov_solve(
+      i_rows,
+      p_jacobian->getRowPointerVector(),
+      p_jacobian->getColumnVector(),
+      p_jacobian->getValueVector(),
+      p_rhs,
+      p_reference,
+      params
+    )
+  )
+  {
+    std::cerr << "Krylov solver did not converge." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  params.bDebug = false;
+
+  //============================================================================
+  // Time the solves for increasing numbers of threads.  Each solve has its
+  // own solution vector, and all solutions must equal the reference.
+  //============================================================================
+
+  std::vector<gsl_vector *> solutions( i_solves );
+
+  for( size_t i = 0; i < i_solves; i++ )
+    solutions[i] = gsl_vector_alloc( i_rows );
+
+  fprintf(
+    stdout,
+    "%8s %14s %14s %9s %11s %9s %11s\n",
+    "threads", "time (s)", "time/solve (s)", "speedup", "efficiency",
+    "failures", "mismatches"
+  );
+
+  double d_serial = 0;
+
+  for( size_t i_threads = 1; i_threads <= i_max_threads; i_threads *= 2 )
+  {
+
+    int i_failures = 0;
+    size_t i_mismatches = 0;
+
+#ifndef NO_OPENMP
+    omp_set_num_threads( (int) i_threads );
+#else
+    if( i_threads > 1 ) break;
+#endif
+
+    for( size_t i = 0; i < i_solves; i++ ) gsl_vector_set_zero( solutions[i] );
+
+    double d_start = get_wall_time();
+
+#ifndef NO_OPENMP
+    #pragma omp parallel for schedule( dynamic, 1 ) reduction( +:i_failures )
+#endif
+      for( int i = 0; i < (int) i_solves; i++ )
+      {
+        if(
+          !user::krylov_solve(
+            i_rows,
+            p_jacobian->getRowPointerVector(),
+            p_jacobian->getColumnVector(),
+            p_jacobian->getValueVector(),
+            p_rhs,
+            solutions[(size_t) i],
+            params
+          )
+        )
+          i_failures++;
+      }
+
+    double d_time = get_wall_time() - d_start;
+
+    if( i_threads == 1 ) d_serial = d_time;
+
+    for( size_t i = 0; i < i_solves; i++ )
+    {
+      for( size_t j = 0; j < i_rows; j++ )
+      {
+        if(
+          gsl_vector_get( solutions[i], j ) !=
+          gsl_vector_get( p_reference, j )
+        )
+        {
+          i_mismatches++;
+          break;
+        }
+      }
+    }
+
+    fprintf(
+      stdout,
+      "%8lu %14.6e %14.6e %9.2f %11.2f %9d %11lu\n",
+      (unsigned long) i_threads,
+      d_time,
+      d_time / (double) i_solves,
+      d_time > 0 ? d_serial / d_time : 0.,
+      d_time > 0 ? d_serial / ( d_time * (double) i_threads ) : 0.,
+      i_failures,
+      (unsigned long) i_mismatches
+    );
+
+  }
+
+  //============================================================================
+  // Clean up and exit.
+  //============================================================================
+
+  for( size_t i = 0; i < i_solves; i++ ) gsl_vector_free( solutions[i] );
+
+  gsl_vector_free( p_reference );
+  gsl_vector_free( p_rhs );
+
+  Libnucnet__free( p_my_nucnet );
+  return EXIT_SUCCESS;
+
+}
+
+/*##############################################################################
+// get_wall_time().
+//############################################################################*/
+
+double
+get_wall_time()
+{
+
+#ifndef NO_OPENMP
+  return omp_get_wtime();
+#else
+  return (double) clock() / CLOCKS_PER_SEC;
+#endif
+
+}
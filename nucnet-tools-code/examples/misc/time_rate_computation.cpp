@@ -0,0 +1,485 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to compare the time to compute rate-table rates,
+//!        partition functions, non-smoker fit rates, and all zone rates
+//!        over a sweep in t9 with and without the cached splines and the
+//!        compiled non-smoker rate kernel.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <ctime>
+
+#include <boost/program_options.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/iter.h"
+#include "user/remove_duplicate.h"
+#include "user/rate_spline_cache.h"
+#include "user/non_smoker_rate_kernel.h"
+#include "user/user_rate_functions.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// Prototypes.
+//############################################################################*/
+
+double
+get_time_since( clock_t );
+
+void
+print_comparison( const char *, double, double, double );
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet *p_my_nucnet;
+  nnt::Zone zone;
+  std::string s_nuc_xpath = "", s_reac_xpath = "";
+  double d_t9_min = 0.1, d_t9_max = 10., d_rho = 1.;
+  size_t i_t9 = 100;
+  std::vector<double> v_t9, v_rate, v_partf, v_nsf;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: time the computation of rate-table rates, partition functions, non-smoker fit rates, and zone rates over a sweep in t9 with and without the cached splines and the compiled non-smoker rate kernel for the input net_xml and zone_xml files.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "nuc_xpath",
+       po::value<std::string>(),
+       "XPath to select nuclides (default: all nuclides)"
+      )
+      (
+       "reac_xpath",
+       po::value<std::string>(),
+       "XPath to select reaction (default: all reactions)"
+      )
+      (
+       "t9_min",
+       po::value<double>(),
+       "Minimum t9 of the sweep (default: 0.1)"
+      )
+      (
+       "t9_max",
+       po::value<double>(),
+       "Maximum t9 of the sweep (default: 10)"
+      )
+      (
+       "n_t9",
+       po::value<size_t>(),
+       "Number of t9 values in the sweep (default: 100)"
+      )
+      (
+       "rho",
+       po::value<double>(),
+       "Mass density (g/cc) for the zone rates (default: 1)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( argc < 3 || vm.count("help") == 1 )
+    {
+      std::cout <<
+        "\nUsage: " << argv[0] << " net_xml zone_xml [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    if( vm.count("nuc_xpath") == 1 )
+    {
+      s_nuc_xpath = vm["nuc_xpath"].as<std::string>();
+    }
+
+    if( vm.count("reac_xpath") == 1 )
+    {
+      s_reac_xpath = vm["reac_xpath"].as<std::string>();
+    }
+
+    if( vm.count("t9_min") == 1 )
+    {
+      d_t9_min = vm["t9_min"].as<double>();
+    }
+
+    if( vm.count("t9_max") == 1 )
+    {
+      d_t9_max = vm["t9_max"].as<double>();
+    }
+
+    if( vm.count("n_t9") == 1 )
+    {
+      i_t9 = vm["n_t9"].as<size_t>();
+    }
+
+    if( vm.count("rho") == 1 )
+    {
+      d_rho = vm["rho"].as<double>();
+    }
+
+    if( d_t9_min <= 0 || d_t9_max < d_t9_min || i_t9 < 2 )
+    {
+      std::cerr << "Invalid t9 sweep." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Read and store input.
+  //============================================================================
+
+  p_my_nucnet = Libnucnet__new();
+
+  Libnucnet__Net__updateFromXml(
+    Libnucnet__getNet( p_my_nucnet ),
+    argv[1],
+    s_nuc_xpath.c_str(),
+    s_reac_xpath.c_str()
+  );
+
+  Libnucnet__assignZoneDataFromXml( p_my_nucnet, argv[2], NULL );
+
+  user::register_rate_functions(
+    Libnucnet__Net__getReac( Libnucnet__getNet( p_my_nucnet ) )
+  );
+
+  user::remove_duplicate_reactions(
+    Libnucnet__getNet( p_my_nucnet )
+  );
+
+  zone.setNucnetZone(
+    Libnucnet__getZoneByLabels( p_my_nucnet, "0", "0", "0" )
+  );
+
+  for( size_t i = 0; i < i_t9; i++ )
+    v_t9.push_back(
+      d_t9_min *
+      pow( d_t9_max / d_t9_min, (double) i / (double) ( i_t9 - 1 ) )
+    );
+
+  nnt::reaction_list_t reaction_list =
+    nnt::make_reaction_list(
+      Libnucnet__Net__getReac( Libnucnet__getNet( p_my_nucnet ) )
+    );
+
+  nnt::species_list_t species_list =
+    nnt::make_species_list(
+      Libnucnet__Net__getNuc( Libnucnet__getNet( p_my_nucnet ) )
+    );
+
+  Libnucnet__NetView * p_evolution_view =
+    Libnucnet__Zone__getEvolutionNetView( zone.getNucnetZone() );
+
+  user::NonSmokerRateKernel kernel(
+    p_evolution_view,
+    user::get_view_revision( zone, p_evolution_view )
+  );
+
+  //============================================================================
+  // Uncached sweeps.  The zone has no cache or kernel yet, so the zone
+  // rates are computed by Libnucnet.
+  //============================================================================
+
+  clock_t t_start = clock();
+
+  BOOST_FOREACH( nnt::Reaction reaction, reaction_list )
+  {
+    if(
+      std::string(
+        Libnucnet__Reaction__getRateFunctionKey(
+          reaction.getNucnetReaction()
+        )
+      ) == RATE_TABLE_STRING
+    )
+    {
+      for( size_t i = 0; i < v_t9.size(); i++ )
+        v_rate.push_back(
+          Libnucnet__Reaction__computeRateFromTable(
+            reaction.getNucnetReaction(), v_t9[i], NULL
+          )
+        );
+    }
+  }
+
+  double d_rate_time = get_time_since( t_start );
+
+  t_start = clock();
+
+  BOOST_FOREACH( nnt::Species species, species_list )
+  {
+    for( size_t i = 0; i < v_t9.size(); i++ )
+      v_partf.push_back(
+        Libnucnet__Species__computePartitionFunction(
+          species.getNucnetSpecies(), v_t9[i]
+        )
+      );
+  }
+
+  double d_partf_time = get_time_since( t_start );
+
+  t_start = clock();
+
+  for( size_t i = 0; i < v_t9.size(); i++ )
+  {
+    BOOST_FOREACH(
+      Libnucnet__Reaction * p_reaction, kernel.getReactionVector()
+    )
+    {
+      v_nsf.push_back(
+        Libnucnet__Reaction__computeNonSmokerRate( p_reaction, v_t9[i], NULL )
+      );
+    }
+  }
+
+  double d_nsf_time = get_time_since( t_start );
+
+  t_start = clock();
+
+  for( size_t i = 0; i < v_t9.size(); i++ )
+    Libnucnet__Zone__computeRates( zone.getNucnetZone(), v_t9[i], d_rho );
+
+  double d_zone_time = get_time_since( t_start );
+
+  //============================================================================
+  // Build the cache and the kernel for the zone.
+  //============================================================================
+
+  t_start = clock();
+
+  user::RateSplineCache * p_cache =
+    user::get_rate_spline_cache_for_zone( zone );
+
+  double d_build_time = get_time_since( t_start );
+
+  if( !p_cache )
+  {
+    std::cerr << "Cached rate-table function not registered." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if( !user::get_non_smoker_rate_kernel_for_zone( zone ) )
+  {
+    std::cerr << "Compiled non-smoker rate function not registered." <<
+      std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //============================================================================
+  // Cached sweeps.
+  //============================================================================
+
+  double d_rate_diff = 0, d_partf_diff = 0, d_nsf_diff = 0;
+  size_t i_rate = 0, i_partf = 0, i_nsf = 0;
+
+  t_start = clock();
+
+  BOOST_FOREACH( nnt::Reaction reaction, reaction_list )
+  {
+    if(
+      std::string(
+        Libnucnet__Reaction__getRateFunctionKey(
+          reaction.getNucnetReaction()
+        )
+      ) == RATE_TABLE_STRING
+    )
+    {
+      for( size_t i = 0; i < v_t9.size(); i++ )
+      {
+        double d_rate =
+          p_cache->computeRateFromTable(
+            reaction.getNucnetReaction(), v_t9[i]
+          );
+        if( v_rate[i_rate] > 0 )
+          d_rate_diff =
+            GSL_MAX(
+              d_rate_diff,
+              fabs( d_rate - v_rate[i_rate] ) / v_rate[i_rate]
+            );
+        i_rate++;
+      }
+    }
+  }
+
+  double d_rate_cached = get_time_since( t_start );
+
+  t_start = clock();
+
+  BOOST_FOREACH( nnt::Species species, species_list )
+  {
+    for( size_t i = 0; i < v_t9.size(); i++ )
+    {
+      double d_partf =
+        p_cache->computePartitionFunction(
+          species.getNucnetSpecies(), v_t9[i]
+        );
+      d_partf_diff =
+        GSL_MAX(
+          d_partf_diff,
+          fabs( d_partf - v_partf[i_partf] ) / v_partf[i_partf]
+        );
+      i_partf++;
+    }
+  }
+
+  double d_partf_cached = get_time_since( t_start );
+
+  t_start = clock();
+
+  for( size_t i = 0; i < v_t9.size(); i++ )
+  {
+    kernel.computeRates( v_t9[i] );
+    BOOST_FOREACH( double d_rate, kernel.getRateVector() )
+    {
+      if( v_nsf[i_nsf] > 0 )
+        d_nsf_diff =
+          GSL_MAX(
+            d_nsf_diff,
+            fabs( d_rate - v_nsf[i_nsf] ) / v_nsf[i_nsf]
+          );
+      i_nsf++;
+    }
+  }
+
+  double d_nsf_cached = get_time_since( t_start );
+
+  t_start = clock();
+
+  for( size_t i = 0; i < v_t9.size(); i++ )
+    Libnucnet__Zone__computeRates( zone.getNucnetZone(), v_t9[i], d_rho );
+
+  double d_zone_cached = get_time_since( t_start );
+
+  //============================================================================
+  // Print the comparison.
+  //============================================================================
+
+  fprintf(
+    stdout,
+    "\nRate tables: %lu  Species: %lu  t9 values: %lu  Cache build (s): %e\n",
+    (unsigned long) p_cache->getNumberOfRateTables(),
+    (unsigned long) species_list.size(),
+    (unsigned long) v_t9.size(),
+    d_build_time
+  );
+
+  fprintf(
+    stdout,
+    "Non-smoker reactions: %lu  Non-smoker fit terms: %lu\n\n",
+    (unsigned long) kernel.getNumberOfReactions(),
+    (unsigned long) kernel.getNumberOfTerms()
+  );
+
+  fprintf(
+    stdout,
+    "%20s %14s %14s %9s %12s\n",
+    "sweep", "uncached (s)", "cached (s)", "speedup", "max rel diff"
+  );
+
+  print_comparison(
+    "rate tables", d_rate_time, d_rate_cached, d_rate_diff
+  );
+
+  print_comparison(
+    "partition functions", d_partf_time, d_partf_cached, d_partf_diff
+  );
+
+  print_comparison(
+    "non-smoker fits", d_nsf_time, d_nsf_cached, d_nsf_diff
+  );
+
+  print_comparison(
+    "zone rates", d_zone_time, d_zone_cached, -1.
+  );
+
+  //============================================================================
+  // Clean up and exit.
+  //============================================================================
+
+  Libnucnet__free( p_my_nucnet );
+  return EXIT_SUCCESS;
+
+}
+
+/*##############################################################################
+// get_time_since().
+//############################################################################*/
+
+double
+get_time_since( clock_t t_start )
+{
+
+  return (double) ( clock() - t_start ) / CLOCKS_PER_SEC;
+
+}
+
+/*##############################################################################
+// print_comparison().  A negative difference is not printed.
+//############################################################################*/
+
+void
+print_comparison(
+  const char * s_sweep,
+  double d_uncached,
+  double d_cached,
+  double d_diff
+)
+{
+
+  fprintf(
+    stdout,
+    "%20s %14.6e %14.6e %9.2f",
+    s_sweep,
+    d_uncached,
+    d_cached,
+    d_cached > 0 ? d_uncached / d_cached : 0.
+  );
+
+  if( d_diff >= 0 )
+    fprintf( stdout, " %12.4e\n", d_diff );
+  else
+    fprintf( stdout, " %12s\n", "-" );
+
+}
@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Example code to time the zone property accesses of a mock
+//!        evolution loop with string conversion on every access and with
+//!        the typed property cache of nnt::Zone.
+////////////////////////////////////////////////////////////////////////////////
+
+/*##############################################################################
+// Includes.
+//############################################################################*/
+
+#include <ctime>
+
+#include <boost/program_options.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/string_defs.h"
+
+namespace po = boost::program_options;
+
+/*##############################################################################
+// Prototypes.
+//############################################################################*/
+
+double
+get_property( Libnucnet__Zone *, const char * );
+
+void
+update_property( Libnucnet__Zone *, const char *, double );
+
+double
+get_time_since( clock_t );
+
+/*##############################################################################
+// main().
+//############################################################################*/
+
+int main( int argc, char * argv[] ) {
+
+  Libnucnet *p_my_nucnet;
+  Libnucnet__Zone * p_zone;
+  nnt::Zone zone;
+  size_t i_steps = 100000;
+  double d_sum_uncached = 0., d_sum_cached = 0.;
+
+  //============================================================================
+  // Check input.
+  //============================================================================
+
+  try
+  {
+
+    std::string s_purpose = "\nPurpose: time the zone property reads and writes of a mock evolution loop with string conversion on every access and with the typed property cache.";
+
+    po::options_description desc("\nAllowed options");
+    desc.add_options()
+      ( "help", "print out this help message and exit" )
+      (
+       "n_steps",
+       po::value<size_t>(),
+       "Number of mock evolution steps (default: 100000)"
+      )
+    ;
+
+    po::variables_map vm;
+    po::store(po::parse_command_line( argc, argv, desc), vm );
+    po::notify(vm);
+
+    if( vm.count("help") == 1 )
+    {
+      std::cout << "\nUsage: " << argv[0] << " [options]" << std::endl;
+      std::cout << s_purpose << std::endl;
+      std::cout << desc << "\n";
+      exit( EXIT_FAILURE );
+    }
+
+    if( vm.count("n_steps") == 1 )
+    {
+      i_steps = vm["n_steps"].as<size_t>();
+    }
+
+  }
+  catch( std::exception& e )
+  {
+    std::cerr << "error: " << e.what() << "\n";
+    exit( EXIT_FAILURE );
+  }
+  catch(...)
+  {
+    std::cerr << "Exception of unknown type!\n";
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Create the zone.
+  //============================================================================
+
+  p_my_nucnet = Libnucnet__new();
+
+  p_zone =
+    Libnucnet__Zone__new( Libnucnet__getNet( p_my_nucnet ), "0", "0", "0" );
+
+  Libnucnet__addZone( p_my_nucnet, p_zone );
+
+  zone.setNucnetZone( p_zone );
+
+  zone.updateProperty( nnt::s_TIME, 0. );
+  zone.updateProperty( nnt::s_DTIME, 1.e-10 );
+  zone.updateProperty( nnt::s_T9, 10. );
+  zone.updateProperty( nnt::s_RHO, 1.e8 );
+  zone.updateProperty( nnt::s_ITER_SOLVER_REL_TOL, 1.e-10 );
+  zone.updateProperty( nnt::s_ITER_SOLVER_T9, 2. );
+  zone.updateProperty( nnt::s_ILU_DROP_TOL, 1.e-3 );
+
+  //============================================================================
+  // Mock evolution with conversion on every access.  Each step reads the
+  // state and solver settings as the evolution routines do and updates the
+  // time, time step, temperature, and density.
+  //============================================================================
+
+  clock_t t_start = clock();
+
+  for( size_t i = 0; i < i_steps; i++ )
+  {
+
+    double d_t9 = get_property( p_zone, nnt::s_T9 );
+    double d_rho = get_property( p_zone, nnt::s_RHO );
+    double d_dt = get_property( p_zone, nnt::s_DTIME );
+
+    for( size_t j = 0; j < 4; j++ )
+    {
+      d_sum_uncached +=
+        get_property( p_zone, nnt::s_T9 ) +
+        get_property( p_zone, nnt::s_RHO ) +
+        get_property( p_zone, nnt::s_DTIME ) +
+        get_property( p_zone, nnt::s_ITER_SOLVER_REL_TOL ) +
+        get_property( p_zone, nnt::s_ITER_SOLVER_T9 ) +
+        get_property( p_zone, nnt::s_ILU_DROP_TOL );
+    }
+
+    update_property(
+      p_zone, nnt::s_TIME, get_property( p_zone, nnt::s_TIME ) + d_dt
+    );
+    update_property( p_zone, nnt::s_DTIME, d_dt * 1.001 );
+    update_property( p_zone, nnt::s_T9, d_t9 * 0.9999 );
+    update_property( p_zone, nnt::s_RHO, d_rho * 0.9997 );
+    update_property(
+      p_zone,
+      nnt::s_ITER_SOLVER_T9,
+      get_property( p_zone, nnt::s_ITER_SOLVER_T9 )
+    );
+
+  }
+
+  double d_uncached = get_time_since( t_start );
+
+  double d_time_uncached = get_property( p_zone, nnt::s_TIME );
+
+  //============================================================================
+  // Reset and repeat with the typed property cache.
+  //============================================================================
+
+  zone.updateProperty( nnt::s_TIME, 0. );
+  zone.updateProperty( nnt::s_DTIME, 1.e-10 );
+  zone.updateProperty( nnt::s_T9, 10. );
+  zone.updateProperty( nnt::s_RHO, 1.e8 );
+
+  t_start = clock();
+
+  for( size_t i = 0; i < i_steps; i++ )
+  {
+
+    double d_t9 = zone.getProperty<double>( nnt::s_T9 );
+    double d_rho = zone.getProperty<double>( nnt::s_RHO );
+    double d_dt = zone.getProperty<double>( nnt::s_DTIME );
+
+    for( size_t j = 0; j < 4; j++ )
+    {
+      d_sum_cached +=
+        zone.getProperty<double>( nnt::s_T9 ) +
+        zone.getProperty<double>( nnt::s_RHO ) +
+        zone.getProperty<double>( nnt::s_DTIME ) +
+        zone.getProperty<double>( nnt::s_ITER_SOLVER_REL_TOL ) +
+        zone.getProperty<double>( nnt::s_ITER_SOLVER_T9 ) +
+        zone.getProperty<double>( nnt::s_ILU_DROP_TOL );
+    }
+
+    zone.updateProperty(
+      nnt::s_TIME, zone.getProperty<double>( nnt::s_TIME ) + d_dt
+    );
+    zone.updateProperty( nnt::s_DTIME, d_dt * 1.001 );
+    zone.updateProperty( nnt::s_T9, d_t9 * 0.9999 );
+    zone.updateProperty( nnt::s_RHO, d_rho * 0.9997 );
+    zone.updateProperty(
+      nnt::s_ITER_SOLVER_T9,
+      zone.getProperty<double>( nnt::s_ITER_SOLVER_T9 )
+    );
+
+  }
+
+  double d_cached = get_time_since( t_start );
+
+  //============================================================================
+  // Print the comparison.  The final times and the sums of the values read
+  // must agree.
+  //============================================================================
+
+  fprintf(
+    stdout,
+    "\nSteps: %lu  Property reads per step: %d  Writes per step: %d\n\n",
+    (unsigned long) i_steps,
+    29,
+    5
+  );
+
+  fprintf(
+    stdout,
+    "%14s %14s %9s %12s %12s\n",
+    "uncached (s)", "cached (s)", "speedup", "time diff", "sum diff"
+  );
+
+  fprintf(
+    stdout,
+    "%14.6e %14.6e %9.2f %12.4e %12.4e\n",
+    d_uncached,
+    d_cached,
+    d_cached > 0 ? d_uncached / d_cached : 0.,
+    fabs( zone.getProperty<double>( nnt::s_TIME ) - d_time_uncached ),
+    fabs( d_sum_cached - d_sum_uncached )
+  );
+
+  //============================================================================
+  // Clean up and exit.
+  //============================================================================
+
+  Libnucnet__free( p_my_nucnet );
+  return EXIT_SUCCESS;
+
+}
+
+/*##############################################################################
+// get_property().  Converts the string value on every call.
+//############################################################################*/
+
+double
+get_property( Libnucnet__Zone * p_zone, const char * s_name )
+{
+
+  return
+    boost::lexical_cast<double>(
+      Libnucnet__Zone__getProperty( p_zone, s_name, NULL, NULL )
+    );
+
+}
+
+/*##############################################################################
+// update_property().  Converts the value to a string on every call.
+//############################################################################*/
+
+void
+update_property( Libnucnet__Zone * p_zone, const char * s_name, double d_x )
+{
+
+  Libnucnet__Zone__updateProperty(
+    p_zone,
+    s_name,
+    NULL,
+    NULL,
+    boost::lexical_cast<std::string>( d_x ).c_str()
+  );
+
+}
+
+/*##############################################################################
+// get_time_since().
+//############################################################################*/
+
+double
+get_time_since( clock_t t_start )
+{
+
+  return (double) ( clock() - t_start ) / CLOCKS_PER_SEC;
+
+}
@@ -306,23 +306,33 @@ int main( int argc, char * argv[] ) {
       user::swap_neutrinos( zone );
 
   //============================================================================
-  // Evolve abundances.
+  // Evolve abundances.  With coupled t9 evolution, t9 and the abundances
+  // come from one Newton-Raphson iteration; otherwise, or if that fails, t9
+  // is found by root finding with an evolution for each trial t9.
   //============================================================================
 
-    zone.updateProperty(
-      nnt::s_T9,
-      nnt::compute_1d_root(
-        boost::bind(
-          user::network_t9_from_entropy_root,
-          _1,
-          boost::ref( zone )
-        ),
-        zone.getProperty<double>( S_T9_PREVIOUS ),
-        1.001
-      )
-    );
+    if(
+      !user::is_coupled_t9_evolution( zone ) ||
+      user::evolve_with_t9( zone, user::compute_entropy_t9_residual ) < 0
+    )
+    {
+
+      zone.updateProperty(
+        nnt::s_T9,
+        nnt::compute_1d_root(
+          boost::bind(
+            user::network_t9_from_entropy_root,
+            _1,
+            boost::ref( zone )
+          ),
+          zone.getProperty<double>( S_T9_PREVIOUS ),
+          1.001
+        )
+      );
 
-    user::evolve( zone );
+      user::evolve( zone );
+
+    }
 
     zone.updateProperty(
       S_T9_PREVIOUS,
@@ -356,13 +366,13 @@ int main( int argc, char * argv[] ) {
   // Update timestep.
   //============================================================================
 
-    Libnucnet__Zone__updateTimeStep(
-      zone.getNucnetZone(),
-      &d_dt,
-      D_REG_T,
-      D_REG_Y,
-      D_Y_MIN_DT
-    );
+    d_dt =
+      user::get_zone_abundances( zone )->computeTimeStep(
+        d_dt,
+        D_REG_T,
+        D_REG_Y,
+        D_Y_MIN_DT
+      );
 
     if ( d_t + d_dt > d_tend ) {
 
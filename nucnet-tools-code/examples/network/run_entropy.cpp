@@ -37,6 +37,7 @@
 
 #include "nnt/two_d_weak_rates.h"
 #include "user/remove_duplicate.h"
+#include "user/network_cache.h"
 #include "user/user_rate_functions.h"
 #include "user/network_limiter.h"
 #include "user/flow_utilities.h"
@@ -290,7 +291,7 @@ get_input( int argc, char **argv )
 
     p_nucnet = Libnucnet__new();
 
-    Libnucnet__Net__updateFromXml(
+    user::update_net_from_network_cache(
       Libnucnet__getNet( p_nucnet ),
       argv[1],
       s_nuc_xpath.c_str(),
@@ -788,13 +789,13 @@ int main( int argc, char * argv[] ) {
         d_h = GSL_MIN( d_h, D_X_REG_T * d_dt / delta );
     }
 
-    Libnucnet__Zone__updateTimeStep(
-      zone.getNucnetZone(),
-      &d_dt,
-      D_REG_T,
-      D_REG_Y,
-      D_Y_MIN_DT
-    );
+    d_dt =
+      user::get_zone_abundances( zone )->computeTimeStep(
+        d_dt,
+        D_REG_T,
+        D_REG_Y,
+        D_Y_MIN_DT
+      );
 
     if( d_dt > d_h ) d_dt = d_h;
 
@@ -37,6 +37,7 @@
 #include "nnt/iter.h"
 
 #include "user/remove_duplicate.h"
+#include "user/network_cache.h"
 #include "user/screen.h"
 #include "user/nse_corr.h"
 #include "user/user_rate_functions.h"
@@ -290,20 +291,12 @@ int main( int argc, char * argv[] ) {
 
   p_my_nucnet = Libnucnet__new();
 
-  if( argc == 5 )
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_my_nucnet ),
-      argv[1],
-      argv[4],
-      NULL
-    );  
-  else
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_my_nucnet ),
-      argv[1],
-      NULL,
-      NULL
-    );  
+  user::update_net_from_network_cache(
+    Libnucnet__getNet( p_my_nucnet ),
+    argv[1],
+    argc == 5 ? argv[4] : NULL,
+    NULL
+  );
 
   Libnucnet__assignZoneDataFromXml(
     p_my_nucnet,
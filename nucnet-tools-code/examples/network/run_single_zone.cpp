@@ -32,6 +32,8 @@
 #include "user/rate_modifiers.h"
 #include "user/evolve.h"
 #include "user/hydro.h"
+#include "user/network_cache.h"
+#include "user/output_writer.h"
 
 //##############################################################################
 // Define some parameters.
@@ -41,7 +43,7 @@
 #define D_REG_T        0.15         // Time step change regulator for dt update
 #define D_REG_Y        0.15         // Abundance change regulator for dt update 
 #define D_Y_MIN_DT     1.e-10       // Smallest y for dt update
-#define S_SOLVER       nnt::s_ARROW // Solver type: ARROW or GSL
+#define S_SOLVER       nnt::s_ARROW // Solver type: ARROW, GSL, or SPARSE_LU
 
 #define S_DETAILED_WEAK_RATES  "detailed weak rates"
 #define S_FLOW_CURRENT_XML_FILE  "flow current xml file"
@@ -49,11 +51,6 @@
 #define S_SPECIES_REMOVAL_NUC_XPATH  "species removal nuclide xpath"
 #define S_SPECIES_REMOVAL_REAC_XPATH  "species removal reaction xpath"
 
-#define B_OUTPUT_EVERY_TIME_DUMP    false  // Change to true to write to xml
-                                           // every time dump.  False just
-                                           // writes output at end of
-                                           // calculation.
-
 //##############################################################################
 // main().
 //##############################################################################
@@ -62,7 +59,7 @@ int main( int argc, char * argv[] ) {
 
   int i_step, k = 0;
   double d_t, d_dt;
-  Libnucnet *p_my_nucnet = NULL, *p_my_output, *p_flow_current_nucnet = NULL;
+  Libnucnet *p_my_nucnet = NULL, *p_flow_current_nucnet = NULL;
   nnt::Zone zone, flow_current_zone;
   std::set<std::string> isolated_species_set;
 
@@ -133,10 +130,8 @@ int main( int argc, char * argv[] ) {
   if( zone.hasProperty( S_DETAILED_WEAK_RATES ) )
   {
 
-    Libnucnet__Reac__updateFromXml(
-      Libnucnet__Net__getReac(
-        Libnucnet__Zone__getNet( zone.getNucnetZone() )
-      ),
+    user::update_net_reactions_from_network_cache(
+      Libnucnet__Zone__getNet( zone.getNucnetZone() ),
       zone.getProperty<std::string>( S_DETAILED_WEAK_RATES ).c_str(),
       NULL
     );
@@ -223,7 +218,7 @@ int main( int argc, char * argv[] ) {
   user::set_rate_data_update_function( zone );
 
   //============================================================================
-  // Sort the nuclei if using the arrow solver.
+  // Sort the nuclei if using the arrow solver.  Set the solver.
   //============================================================================
 
   if( S_SOLVER == nnt::s_ARROW )
@@ -243,16 +238,19 @@ int main( int argc, char * argv[] ) {
     zone.updateProperty( nnt::s_ARROW_WIDTH, "3" );
 
   }
+  else if( std::string( S_SOLVER ) == nnt::s_SPARSE_LU )
+  {
+    zone.updateProperty( nnt::s_SOLVER, nnt::s_SPARSE_LU );
+  }
 
   //============================================================================
-  // Create output.
+  // Create output.  Each time dump is appended to the output file, which
+  // is complete after every dump.
   //============================================================================
 
-  p_my_output = nnt::create_network_copy( p_my_nucnet );
-
-  Libnucnet__setZoneCompareFunction(
-    p_my_output,
-    (Libnucnet__Zone__compare_function) nnt::zone_compare_by_first_label
+  user::XmlOutputWriter output_writer(
+    zone.getProperty<std::string>( S_OUTPUT_FILE ).c_str(),
+    Libnucnet__getNet( p_my_nucnet )
   );
 
   //============================================================================
@@ -395,27 +393,20 @@ int main( int argc, char * argv[] ) {
         NULL
       );
       nnt::print_zone_abundances( zone );
-      nnt::write_xml( p_my_output, zone.getNucnetZone() );
-      if( B_OUTPUT_EVERY_TIME_DUMP )
-      {
-        Libnucnet__writeToXmlFile(
-          p_my_output,
-          zone.getProperty<std::string>( S_OUTPUT_FILE ).c_str()
-        );
-      }
+      output_writer.appendZone( zone );
     }
 
   //============================================================================
   // Update timestep.
   //============================================================================
 
-    Libnucnet__Zone__updateTimeStep(
-      zone.getNucnetZone(),
-      &d_dt,
-      D_REG_T,
-      D_REG_Y,
-      D_Y_MIN_DT
-    );
+    d_dt =
+      user::get_zone_abundances( zone )->computeTimeStep(
+        d_dt,
+        D_REG_T,
+        D_REG_Y,
+        D_Y_MIN_DT
+      );
 
     if( zone.getProperty<double>( nnt::s_T9 ) > 10. )
       nnt::normalize_zone_abundances( zone );
@@ -454,21 +445,12 @@ int main( int argc, char * argv[] ) {
 
   }
         
-  Libnucnet__updateZoneXmlMassFractionFormat(
-    p_my_output,
-    "%.15e"
-  );
-
-  Libnucnet__writeToXmlFile(
-    p_my_output,
-    zone.getProperty<std::string>( S_OUTPUT_FILE ).c_str()
-  );
+  output_writer.finalize();
 
   //============================================================================
   // Clean up and exit.
   //============================================================================
 
-  Libnucnet__free( p_my_output );
   Libnucnet__free( p_my_nucnet );
 
   return EXIT_SUCCESS;
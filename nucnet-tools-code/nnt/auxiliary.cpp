@@ -419,6 +419,13 @@ set_zone_abundances_to_equilibrium( nnt::Zone& zone )
   boost::any correction_factor_data;
   Libnucnet__Species__nseCorrectionFactorFunction pf;
 
+  if(
+    zone.hasProperty( s_USE_NEWTON_EQUILIBRIUM ) &&
+    zone.getProperty<std::string>( s_USE_NEWTON_EQUILIBRIUM ) == "yes" &&
+    set_zone_abundances_to_equilibrium_by_newton( zone )
+  )
+    return;
+
   p_my_equil = get_zone_equilibrium( zone );
 
   pf = Libnucnet__Zone__getNseCorrectionFactorFunction( zone.getNucnetZone() );
@@ -465,6 +472,453 @@ set_zone_abundances_to_equilibrium( nnt::Zone& zone )
 
 }
 
+//##############################################################################
+// set_zone_abundances_to_equilibrium_by_newton().
+//##############################################################################
+
+/**
+ * \brief Sets a zone's abundances to nuclear statistical equilibrium by a
+ *        Newton iteration started from the zone's previous solution.
+ *
+ * The unknowns are the neutron, proton, and cluster chemical potentials
+ * (divided by kT), which start from the values stored in the zone by the
+ * previous equilibrium solve.  The mass, charge, and cluster constraints
+ * are solved together with an analytic Jacobian.  The NSE factors and any
+ * NSE correction factors are computed once, at the zone's t9, rho, and
+ * Ye.
+ *
+ * \param zone A NucNet Tools zone with t9, rho, Ye, and the chemical
+ *             potentials from a previous equilibrium solve.
+ * \return True if the iteration converged, in which case the zone's
+ *         abundances and chemical potentials have been updated, or false
+ *         if not (for example, if the zone has no previous solution), in
+ *         which case the zone has not been changed.
+ */
+
+bool
+set_zone_abundances_to_equilibrium_by_newton( nnt::Zone& zone )
+{
+
+  nse_newton_data_t data;
+  boost::any correction_factor_data;
+  Libnucnet__Species__nseCorrectionFactorFunction pf;
+  gsl_vector * p_x, * p_dx, * p_x_trial, * p_residual;
+  gsl_matrix * p_jacobian;
+  gsl_permutation * p_perm;
+  size_t i_clusters, i_unknowns;
+  double d_t9, d_rho, d_ye, d_norm;
+  int i_sign;
+  bool b_converged = false;
+
+  if(
+    !zone.hasProperty( s_YE ) ||
+    !zone.hasProperty( s_MUNKT ) ||
+    !zone.hasProperty( s_MUPKT )
+  )
+    return false;
+
+  Libnucnet__Nuc * p_nuc =
+    Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( zone.getNucnetZone() ) );
+
+  size_t i_species = Libnucnet__Nuc__getNumberOfSpecies( p_nuc );
+
+  d_t9 = zone.getProperty<double>( s_T9 );
+  d_rho = zone.getProperty<double>( s_RHO );
+  d_ye = zone.getProperty<double>( s_YE );
+
+  if( d_ye <= 0. ) return false;
+
+  //============================================================================
+  // Warm start.
+  //============================================================================
+
+  i_clusters = count_zone_clusters( zone );
+
+  std::vector<double> v_start( 2 );
+  std::vector<int> v_cluster_unknown( i_clusters, -2 );
+
+  v_start[0] = zone.getProperty<double>( s_MUNKT );
+  v_start[1] = zone.getProperty<double>( s_MUPKT );
+
+  data.vLogTarget.push_back( 0. );
+  data.vLogTarget.push_back( log( d_ye ) );
+
+  for( size_t i = 0; i < i_clusters; i++ )
+  {
+
+    std::string s_i = boost::lexical_cast<std::string>( i );
+
+    double d_constraint =
+      zone.getProperty<double>( s_CLUSTER_CONSTRAINT, s_i );
+
+    if( d_constraint < 0. ) return false;
+
+    if( d_constraint == 0. ) continue;
+
+    if( !zone.hasProperty( s_CLUSTER_CHEMICAL_POTENTIAL, s_i ) )
+      return false;
+
+    double d_mu =
+      zone.getProperty<double>( s_CLUSTER_CHEMICAL_POTENTIAL, s_i );
+
+    if( !gsl_finite( d_mu ) ) return false;
+
+    v_cluster_unknown[i] = (int) v_start.size() - 2;
+    v_start.push_back( d_mu );
+    data.vLogTarget.push_back( log( d_constraint ) );
+
+  }
+
+  for( size_t i = 0; i < v_start.size(); i++ )
+    if( !gsl_finite( v_start[i] ) ) return false;
+
+  i_unknowns = v_start.size();
+
+  //============================================================================
+  // Species data.
+  //============================================================================
+
+  data.vZ.resize( i_species );
+  data.vN.resize( i_species );
+  data.vLogFactor.resize( i_species );
+  data.vUnknown.assign( i_species, -1 );
+
+  pf = Libnucnet__Zone__getNseCorrectionFactorFunction( zone.getNucnetZone() );
+
+  if( pf )
+    correction_factor_data =
+      boost::any_cast<boost::function<boost::any()> >(
+        zone.getFunction( nnt::s_NSE_CORRECTION_FACTOR_DATA_FUNCTION )
+      )();
+
+  species_list_t species_list = make_species_list( p_nuc );
+
+  BOOST_FOREACH( Species species, species_list )
+  {
+
+    Libnucnet__Species * p_species = species.getNucnetSpecies();
+    size_t i = Libnucnet__Species__getIndex( p_species );
+
+    data.vZ[i] = (double) Libnucnet__Species__getZ( p_species );
+    data.vN[i] =
+      (double) Libnucnet__Species__getA( p_species ) - data.vZ[i];
+
+    data.vLogFactor[i] =
+      Libnucnet__Nuc__computeSpeciesNseFactor( p_nuc, p_species, d_t9, d_rho );
+
+    if( pf )
+      data.vLogFactor[i] +=
+        pf( p_species, d_t9, d_rho, d_ye, &correction_factor_data );
+
+  }
+
+  for( size_t i = 0; i < i_clusters; i++ )
+  {
+
+    Libnucnet__NucView * p_view =
+      Libnucnet__NucView__new(
+        p_nuc,
+        zone.getProperty<std::string>(
+          s_CLUSTER_XPATH,
+          boost::lexical_cast<std::string>( i )
+        ).c_str()
+      );
+
+    bool b_valid = true;
+
+    species_list_t cluster_list =
+      make_species_list( Libnucnet__NucView__getNuc( p_view ) );
+
+    BOOST_FOREACH( Species species, cluster_list )
+    {
+
+      Libnucnet__Species * p_species =
+        Libnucnet__Nuc__getSpeciesByName(
+          p_nuc,
+          Libnucnet__Species__getName( species.getNucnetSpecies() )
+        );
+
+      size_t j = Libnucnet__Species__getIndex( p_species );
+
+      if( data.vUnknown[j] != -1 || Libnucnet__Species__getA( p_species ) < 2 )
+        b_valid = false;
+
+      data.vUnknown[j] = v_cluster_unknown[i];
+
+    }
+
+    Libnucnet__NucView__free( p_view );
+
+    if( !b_valid ) return false;
+
+  }
+
+  //============================================================================
+  // Newton iteration.
+  //============================================================================
+
+  p_x = gsl_vector_alloc( i_unknowns );
+  p_dx = gsl_vector_alloc( i_unknowns );
+  p_x_trial = gsl_vector_alloc( i_unknowns );
+  p_residual = gsl_vector_alloc( i_unknowns );
+  p_jacobian = gsl_matrix_alloc( i_unknowns, i_unknowns );
+  p_perm = gsl_permutation_alloc( i_unknowns );
+
+  for( size_t i = 0; i < i_unknowns; i++ )
+    gsl_vector_set( p_x, i, v_start[i] );
+
+  d_norm = compute_nse_newton_residual( data, p_x, p_residual, p_jacobian );
+
+  for( size_t i_iter = 0; i_iter < i_NSE_NEWTON_ITER_MAX; i_iter++ )
+  {
+
+    if( d_norm < d_NSE_NEWTON_TOLERANCE )
+    {
+      b_converged = true;
+      break;
+    }
+
+    if( !gsl_finite( d_norm ) ) break;
+
+    //--------------------------------------------------------------------------
+    // Give up on a singular Jacobian, since gsl_linalg_LU_solve() would call
+    // the GSL error handler, so that the caller can fall back.
+    //--------------------------------------------------------------------------
+
+    gsl_linalg_LU_decomp( p_jacobian, p_perm, &i_sign );
+
+    bool b_singular = false;
+    for( size_t i = 0; i < i_unknowns; i++ )
+    {
+      double d_pivot = gsl_matrix_get( p_jacobian, i, i );
+      if( !gsl_finite( d_pivot ) || d_pivot == 0. )
+        b_singular = true;
+    }
+
+    if( b_singular ) break;
+
+    gsl_linalg_LU_solve( p_jacobian, p_perm, p_residual, p_dx );
+
+    double d_step = 0.;
+    for( size_t i = 0; i < i_unknowns; i++ )
+      d_step = GSL_MAX( d_step, fabs( gsl_vector_get( p_dx, i ) ) );
+
+    if( !gsl_finite( d_step ) ) break;
+
+    if( d_step > d_NSE_NEWTON_MAX_STEP )
+      gsl_vector_scale( p_dx, d_NSE_NEWTON_MAX_STEP / d_step );
+
+    //--------------------------------------------------------------------------
+    // Halve the step until the residual decreases.
+    //--------------------------------------------------------------------------
+
+    double d_trial_norm = GSL_POSINF;
+
+    for( size_t i_halve = 0; i_halve < i_NSE_NEWTON_HALVINGS; i_halve++ )
+    {
+
+      gsl_vector_memcpy( p_x_trial, p_x );
+      gsl_vector_sub( p_x_trial, p_dx );
+
+      d_trial_norm =
+        compute_nse_newton_residual(
+          data, p_x_trial, p_residual, p_jacobian
+        );
+
+      if( d_trial_norm < d_norm ) break;
+
+      gsl_vector_scale( p_dx, 0.5 );
+
+    }
+
+    if( !( d_trial_norm < d_norm ) ) break;
+
+    gsl_vector_memcpy( p_x, p_x_trial );
+
+    d_norm = d_trial_norm;
+
+  }
+
+  //============================================================================
+  // Update the zone.
+  //============================================================================
+
+  if( b_converged )
+  {
+
+    gsl_vector * p_abundances = gsl_vector_calloc( i_species );
+
+    double d_mun = gsl_vector_get( p_x, 0 );
+    double d_mup = gsl_vector_get( p_x, 1 );
+
+    for( size_t i = 0; i < i_species; i++ )
+    {
+      if( data.vUnknown[i] == -2 ) continue;
+      double d_exp =
+        data.vN[i] * d_mun + data.vZ[i] * d_mup + data.vLogFactor[i];
+      if( data.vUnknown[i] >= 0 )
+        d_exp += gsl_vector_get( p_x, (size_t) data.vUnknown[i] + 2 );
+      gsl_vector_set( p_abundances, i, exp( d_exp ) );
+    }
+
+    Libnucnet__Zone__updateAbundances( zone.getNucnetZone(), p_abundances );
+
+    gsl_vector_free( p_abundances );
+
+    zone.updateProperty( nnt::s_MUPKT, d_mup );
+
+    zone.updateProperty( nnt::s_MUNKT, d_mun );
+
+    for( size_t i = 0; i < i_clusters; i++ )
+      zone.updateProperty(
+        s_CLUSTER_CHEMICAL_POTENTIAL,
+        boost::lexical_cast<std::string>( i ),
+        v_cluster_unknown[i] < 0 ?
+          GSL_NEGINF :
+          gsl_vector_get( p_x, (size_t) v_cluster_unknown[i] + 2 )
+      );
+
+  }
+
+  gsl_vector_free( p_x );
+  gsl_vector_free( p_dx );
+  gsl_vector_free( p_x_trial );
+  gsl_vector_free( p_residual );
+  gsl_matrix_free( p_jacobian );
+  gsl_permutation_free( p_perm );
+
+  return b_converged;
+
+}
+
+//##############################################################################
+// compute_nse_newton_residual().
+//##############################################################################
+
+/**
+ * \brief Computes the residuals and Jacobian of the Newton equations for
+ *        nuclear statistical equilibrium.
+ *
+ * The equations are the logarithms of the sums of A * Y, Z * Y, and the
+ * cluster abundances less the logarithms of their targets.  Each sum is
+ * scaled by its largest term, so no abundance overflows or underflows.
+ *
+ * \param data The species data.
+ * \param p_x The neutron, proton, and cluster chemical potentials / kT.
+ * \param p_residual On return, the residuals.
+ * \param p_jacobian On return, the Jacobian of the residuals.
+ * \return The Euclidean norm of the residuals, or GSL_POSINF if a sum is
+ *         zero.
+ */
+
+double
+compute_nse_newton_residual(
+  const nse_newton_data_t& data,
+  const gsl_vector * p_x,
+  gsl_vector * p_residual,
+  gsl_matrix * p_jacobian
+)
+{
+
+  size_t i_species = data.vZ.size(), i_unknowns = p_x->size;
+  std::vector<double> v_exp( i_species ), v_max( i_unknowns, GSL_NEGINF );
+  std::vector<double> v_sum( i_unknowns, 0. );
+  double d_result = 0.;
+
+  gsl_matrix_set_zero( p_jacobian );
+
+  //============================================================================
+  // Exponents and the largest exponent in each sum.
+  //============================================================================
+
+  for( size_t i = 0; i < i_species; i++ )
+  {
+
+    if( data.vUnknown[i] == -2 ) continue;
+
+    v_exp[i] =
+      data.vN[i] * gsl_vector_get( p_x, 0 ) +
+      data.vZ[i] * gsl_vector_get( p_x, 1 ) +
+      data.vLogFactor[i];
+
+    if( data.vUnknown[i] >= 0 )
+    {
+      size_t k = (size_t) data.vUnknown[i] + 2;
+      v_exp[i] += gsl_vector_get( p_x, k );
+      v_max[k] = GSL_MAX( v_max[k], v_exp[i] );
+    }
+
+    v_max[0] = GSL_MAX( v_max[0], v_exp[i] );
+
+    if( data.vZ[i] > 0. ) v_max[1] = GSL_MAX( v_max[1], v_exp[i] );
+
+  }
+
+  //============================================================================
+  // Scaled sums and their derivatives.
+  //============================================================================
+
+  for( size_t i = 0; i < i_species; i++ )
+  {
+
+    if( data.vUnknown[i] == -2 ) continue;
+
+    double d_a = data.vZ[i] + data.vN[i];
+    double w = d_a * exp( v_exp[i] - v_max[0] );
+
+    v_sum[0] += w;
+    *gsl_matrix_ptr( p_jacobian, 0, 0 ) += data.vN[i] * w;
+    *gsl_matrix_ptr( p_jacobian, 0, 1 ) += data.vZ[i] * w;
+
+    if( data.vZ[i] > 0. )
+    {
+      w = data.vZ[i] * exp( v_exp[i] - v_max[1] );
+      v_sum[1] += w;
+      *gsl_matrix_ptr( p_jacobian, 1, 0 ) += data.vN[i] * w;
+      *gsl_matrix_ptr( p_jacobian, 1, 1 ) += data.vZ[i] * w;
+    }
+
+    if( data.vUnknown[i] >= 0 )
+    {
+      size_t k = (size_t) data.vUnknown[i] + 2;
+      *gsl_matrix_ptr( p_jacobian, 0, k ) +=
+        d_a * exp( v_exp[i] - v_max[0] );
+      if( data.vZ[i] > 0. )
+        *gsl_matrix_ptr( p_jacobian, 1, k ) +=
+          data.vZ[i] * exp( v_exp[i] - v_max[1] );
+      w = exp( v_exp[i] - v_max[k] );
+      v_sum[k] += w;
+      *gsl_matrix_ptr( p_jacobian, k, 0 ) += data.vN[i] * w;
+      *gsl_matrix_ptr( p_jacobian, k, 1 ) += data.vZ[i] * w;
+      *gsl_matrix_ptr( p_jacobian, k, k ) += w;
+    }
+
+  }
+
+  //============================================================================
+  // Residuals and the normalized Jacobian.
+  //============================================================================
+
+  for( size_t k = 0; k < i_unknowns; k++ )
+  {
+
+    if( !( v_sum[k] > 0. ) ) return GSL_POSINF;
+
+    gsl_vector_set(
+      p_residual, k, log( v_sum[k] ) + v_max[k] - data.vLogTarget[k]
+    );
+
+    for( size_t l = 0; l < i_unknowns; l++ )
+      *gsl_matrix_ptr( p_jacobian, k, l ) /= v_sum[k];
+
+    d_result += gsl_pow_2( gsl_vector_get( p_residual, k ) );
+
+  }
+
+  return sqrt( d_result );
+
+}
+
 //##############################################################################
 // get_zone_equilibrium(). 
 //##############################################################################
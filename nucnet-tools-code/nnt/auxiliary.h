@@ -40,6 +40,8 @@
 #include <boost/unordered_set.hpp>
 #include <boost/format.hpp>
 
+#include <gsl/gsl_linalg.h>
+
 #include <Libnucnet.h>
 #include <Libstatmech.h>
 #include <Libnuceq.h>
@@ -53,6 +55,23 @@
 namespace nnt
 {
 
+/**
+ * \brief The species data for a Newton solve of nuclear statistical
+ *        equilibrium.  The unknowns are the neutron, proton, and nonzero
+ *        cluster chemical potentials (divided by kT), and the equations are
+ *        the logarithms of the mass, charge, and cluster constraints.
+ */
+
+typedef struct nse_newton_data_t
+{
+  std::vector<double> vZ;           //!< Species charges.
+  std::vector<double> vN;           //!< Species neutron numbers.
+  std::vector<double> vLogFactor;   //!< Species log NSE factors.
+  std::vector<int> vUnknown;        //!< Cluster unknown of each species
+                                    //!< (-1 for none, -2 for zero).
+  std::vector<double> vLogTarget;   //!< Log of each constraint.
+} nse_newton_data_t;
+
 //############################################################################
 // Prototypes.
 //############################################################################
@@ -179,6 +198,17 @@ get_property_matrix(
 void
 set_zone_abundances_to_equilibrium( nnt::Zone& );
 
+bool
+set_zone_abundances_to_equilibrium_by_newton( nnt::Zone& );
+
+double
+compute_nse_newton_residual(
+  const nse_newton_data_t&,
+  const gsl_vector *,
+  gsl_vector *,
+  gsl_matrix *
+);
+
 Libnuceq *
 get_zone_equilibrium( nnt::Zone& );
 
@@ -42,6 +42,10 @@ namespace nnt
   const double d_EXP_LARGE     = 600.;
   const double d_Y_MIN_PRINT   = 1.e-30;
   const double d_REL_EPS       = 1.e-08;
+  const double d_NSE_NEWTON_TOLERANCE = 1.e-12;
+  const double d_NSE_NEWTON_MAX_STEP  = 5.;
+  const size_t i_NSE_NEWTON_ITER_MAX  = 100;
+  const size_t i_NSE_NEWTON_HALVINGS  = 20;
 
   const double d_ELECTRON_MASS_IN_MEV = \
     GSL_CONST_CGSM_MASS_ELECTRON * \
@@ -9,6 +9,7 @@ namespace nnt
 {
 
    const char s_ANTI_NEUTRINO_E[] = "anti-neutrino_e";
+   const char s_APPROXIMATE_WEAK_RATE_TABLES[] = "approximate weak rate tables";
    const char s_ARROW[] = "Arrow";
    const char s_ARROW_WIDTH[] = "Arrow width";
    const char s_AVERAGE_ENERGY_NUBAR_E[] = "av nubar_e energy";
@@ -18,17 +19,28 @@ namespace nnt
    const char s_BASE_EVOLUTION_REAC_XPATH[] = "base evolution reaction xpath";
    const char s_BETA_MINUS_XPATH[] = "[product = 'electron' and product = 'anti-neutrino_e']";
    const char s_BETA_PLUS_XPATH[] = "[product = 'positron' and product = 'neutrino_e']";
+   const char s_BLOCK_GAUSS_SEIDEL[] = "Block Gauss-Seidel";
+   const char s_BLOCK_JACOBI[] = "Block Jacobi";
    const char s_CHEMICAL_POTENTIAL_KT[] = "chemical potential in kT";
    const char s_CLUSTER_CHEMICAL_POTENTIAL[] = "muh_kT";
    const char s_CLUSTER_CONSTRAINT[] = "cluster constraint";
    const char s_CLUSTER_XPATH[] = "cluster xpath";
+   const char s_COUPLED_T9_EVOLUTION[] = "coupled t9 evolution";
+   const char s_COUPLED_T9_STEP_EVOLVED[] = "coupled t9 step evolved";
    const char s_CURRENTS_T_BEGIN[] = "currents_time_begin";
    const char s_CURRENTS_T_END[] = "currents_time_end";
    const char s_DPDT[] = "dPdT";
    const char s_DTIME[] = "dt";
    const char s_ELECTRON[] = "electron";
    const char s_ELECTRON_CAPTURE_XPATH[] = "[reactant = 'electron' and product = 'neutrino_e']";
+   const char s_ELECTRON_EOS_TABLE[] = "electron eos table";
+   const char s_ELECTRON_EOS_TABLE_POINTS_PER_DECADE[] = "electron eos table points per decade";
+   const char s_ELECTRON_EOS_TABLE_RHOYE_MAX[] = "electron eos table rhoye max";
+   const char s_ELECTRON_EOS_TABLE_RHOYE_MIN[] = "electron eos table rhoye min";
+   const char s_ELECTRON_EOS_TABLE_T9_MAX[] = "electron eos table t9 max";
+   const char s_ELECTRON_EOS_TABLE_T9_MIN[] = "electron eos table t9 min";
    const char s_ENTROPY_PER_NUCLEON[] = "entropy per nucleon";
+   const char s_EVOLUTION_WORKSPACE[] = "evolution workspace";
    const char s_EVOLVE_NSE_PLUS_WEAK_RATES[] = "evolve nse plus weak rates";
    const char s_EXPOSURE[] = "exposure";
    const char s_FACTOR[] = "factor";
@@ -60,6 +72,8 @@ namespace nnt
    const char s_MUNKT[] = "munkT";
    const char s_MUPKT[] = "mupkT";
    const char s_MU_NUE_KT[] = "munuekT";
+   const char s_NETWORK_JACOBIAN[] = "network Jacobian";
+   const char s_NETWORK_LIMITER[] = "network limiter";
    const char s_NET_FLOW[] = "net";
    const char s_NEUTRINO_E[] = "neutrino_e";
    const char s_NEWTON_RAPHSON_ABUNDANCE[] = "Newton-Raphson abundance minimum";
@@ -82,8 +96,14 @@ namespace nnt
    const char s_RADIUS_0[] = "radius_0";
    const char s_RATES_MODIFICATION_FUNCTION[] = "rates modificaton function";
    const char s_RATE_DATA_UPDATE_FUNCTION[] = "rate data update function";
+   const char s_RATE_GRID[] = "rate grid";
+   const char s_RATE_GRID_POINTS_PER_DECADE[] = "rate grid points per decade";
+   const char s_RATE_GRID_T9_MAX[] = "rate grid t9 max";
+   const char s_RATE_GRID_T9_MIN[] = "rate grid t9 min";
+   const char s_RATE_GRID_TOLERANCE[] = "rate grid tolerance";
    const char s_RATE_MODIFICATION_FUNCTION[] = "rate modificaton function";
    const char s_RATE_MODIFICATION_VIEW[] = "rate modification view";
+   const char s_REACTION_TOPOLOGY[] = "reaction topology";
    const char s_REAC_XPATH[] = "reaction xpath";
    const char s_REVERSE_FLOW[] = "reverse flow";
    const char s_RHO[] = "rho";
@@ -95,6 +115,8 @@ namespace nnt
    const char s_SMALL_RATES_THRESHOLD[] = "small rates threshold";
    const char s_SOLVER[] = "solver";
    const char s_SOLVER_PARAMETER_FUNCTION[] = "solver parameter function";
+   const char s_SPARSE_LU[] = "Sparse LU";
+   const char s_SPARSE_LU_SOLVER_CACHE[] = "sparse LU solver cache";
    const char s_SPECIFIC_ABUNDANCE[] = "specific abundance";
    const char s_SPECIFIC_HEAT_PER_NUCLEON[] = "cv";
    const char s_SPECIFIC_SPECIES[] = "specific species";
@@ -109,20 +131,28 @@ namespace nnt
    const char s_THERMO_NUC_VIEW[] = "thermo nuc view";
    const char s_TIME[] = "time";
    const char s_TOTAL[] = "total";
+   const char s_TRAJECTORY_INTERPOLATOR[] = "trajectory interpolator";
    const char s_TWO_D_WEAK_RATES[] = "two-d weak rates";
    const char s_TWO_D_WEAK_RATES_LOG10_FT[] = "two-d weak rates log10 ft";
    const char s_TWO_D_WEAK_XPATH[] = "[user_rate/@key = 'two-d weak rates log10 ft' or user_rate/@key = 'two-d weak rates']";
    const char s_T_DERIVATIVE_CHEMICAL_POTENTIAL_KT[] = "d chemical potential in kT dT";
    const char s_USE_APPROXIMATE_WEAK_RATES[] = "use approximate weak rates";
+   const char s_USE_APPROXIMATE_WEAK_RATE_TABLE[] = "use approximate weak rate table";
+   const char s_USE_ELECTRON_EOS_TABLE[] = "use electron eos table";
+   const char s_USE_NEWTON_EQUILIBRIUM[] = "use newton equilibrium";
    const char s_USE_NSE_CORRECTION[] = "use nse correction";
+   const char s_USE_RATE_GRID[] = "use rate grid";
    const char s_USE_SCREENING[] = "use screening";
    const char s_USE_WEAK_DETAILED_BALANCE[] = "use weak detailed balance";
+   const char s_VIEW_REVISIONS[] = "view revisions";
    const char s_WEAK_VIEW_FOR_LAB_RATE_TRANSITION[] = "weak view for lab rate transition";
    const char s_WEAK_XPATH[] = "[reactant = 'electron' or product = 'electron' or reactant = 'positron' or product = 'positron']";
    const char s_YE[] = "Ye";
    const char s_ZONE[] = "zone";
+   const char s_ZONE_ABUNDANCES[] = "zone abundances";
    const char s_ZONE_MASS[] = "zone mass";
    const char s_ZONE_MASS_CHANGE[] = "zone mass change";
+   const char s_ZONE_RATES[] = "zone rates";
 
 } // namespace nnt
 
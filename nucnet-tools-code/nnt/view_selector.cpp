@@ -0,0 +1,796 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this software; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307
+// USA
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//!
+//! \file
+//! \brief Code for compiled view selectors and the views made from them.
+//!
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cctype>
+#include <cstdlib>
+#include <map>
+
+#include <boost/foreach.hpp>
+
+#include "nnt/view_selector.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define I_AND               0
+#define I_OR                1
+#define I_NOT               2
+#define I_Z                 3
+#define I_A                 4
+#define I_REACTANT          5
+#define I_PRODUCT           6
+#define I_COUNT_REACTANT    7
+#define I_COUNT_PRODUCT     8
+#define I_USER_RATE_KEY     9
+#define I_RATE_ELEMENT      10
+
+#define I_EQ                0
+#define I_NE                1
+#define I_LT                2
+#define I_LE                3
+#define I_GT                4
+#define I_GE                5
+
+/**
+ * @brief The NucNet Tools namespace.
+ */
+namespace nnt
+{
+
+//##############################################################################
+// Types and storage for the selector cache.
+//##############################################################################
+
+typedef std::pair<std::string, int> selector_key_t;
+
+static std::map<selector_key_t, boost::shared_ptr<ViewSelector> >
+  selector_map;
+
+//##############################################################################
+// compare_view_values().
+//##############################################################################
+
+static bool
+compare_view_values( double d_lhs, int i_op, double d_rhs )
+{
+
+  switch( i_op )
+  {
+    case I_EQ: return d_lhs == d_rhs;
+    case I_NE: return d_lhs != d_rhs;
+    case I_LT: return d_lhs < d_rhs;
+    case I_LE: return d_lhs <= d_rhs;
+    case I_GT: return d_lhs > d_rhs;
+    default: return d_lhs >= d_rhs;
+  }
+
+}
+
+//##############################################################################
+// get_view_operator().
+//##############################################################################
+
+static int
+get_view_operator( const std::string& s_token )
+{
+
+  if( s_token == "=" ) return I_EQ;
+  if( s_token == "!=" ) return I_NE;
+  if( s_token == "<" ) return I_LT;
+  if( s_token == "<=" ) return I_LE;
+  if( s_token == ">" ) return I_GT;
+  if( s_token == ">=" ) return I_GE;
+
+  return -1;
+
+}
+
+//##############################################################################
+// is_view_literal().
+//##############################################################################
+
+static bool
+is_view_literal( const std::string& s_token )
+{
+
+  return
+    !s_token.empty() &&
+    (
+      s_token[0] == '\'' ||
+      s_token[0] == '"' ||
+      isdigit( (unsigned char) s_token[0] ) ||
+      s_token[0] == '.'
+    );
+
+}
+
+//##############################################################################
+// ViewSelector::ViewSelector().
+//##############################################################################
+
+/**
+ * \brief Compile a view XPath expression.
+ * \param s_xpath The XPath predicate expression, as passed to
+ *        Libnucnet__NetView__new().  An empty expression selects everything.
+ * \param i_target NUCLIDE_SELECTOR or REACTION_SELECTOR.
+ */
+
+ViewSelector::ViewSelector(
+  const std::string& s_xpath,
+  view_selector_targets i_target
+) : iTarget( i_target ), bCompiled( true ), bUsesElements( false ), iToken( 0 )
+{
+
+  size_t i_predicates = 0;
+
+  if( !tokenize( s_xpath ) ) bCompiled = false;
+
+  while( bCompiled && iToken < vTokens.size() )
+  {
+
+    if( vTokens[iToken++] != "[" || !parseOr() )
+    {
+      bCompiled = false;
+      break;
+    }
+
+    if( iToken >= vTokens.size() || vTokens[iToken++] != "]" )
+    {
+      bCompiled = false;
+      break;
+    }
+
+    if( i_predicates++ > 0 )
+    {
+      instruction_t instruction = { I_AND, I_EQ, 0., "" };
+      vProgram.push_back( instruction );
+    }
+
+  }
+
+  if( !bCompiled ) vProgram.clear();
+
+  vTokens.clear();
+
+}
+
+//##############################################################################
+// ViewSelector::tokenize().
+//##############################################################################
+
+bool
+ViewSelector::tokenize( const std::string& s_xpath )
+{
+
+  size_t i = 0;
+
+  while( i < s_xpath.size() )
+  {
+
+    char c = s_xpath[i];
+
+    if( isspace( (unsigned char) c ) )
+    {
+      i++;
+    }
+    else if( c == '[' || c == ']' || c == '(' || c == ')' || c == '=' )
+    {
+      vTokens.push_back( std::string( 1, c ) );
+      i++;
+    }
+    else if( c == '!' || c == '<' || c == '>' )
+    {
+      if( i + 1 < s_xpath.size() && s_xpath[i+1] == '=' )
+      {
+        vTokens.push_back( s_xpath.substr( i, 2 ) );
+        i += 2;
+      }
+      else if( c != '!' )
+      {
+        vTokens.push_back( std::string( 1, c ) );
+        i++;
+      }
+      else
+        return false;
+    }
+    else if( c == '\'' || c == '"' )
+    {
+      size_t i_end = s_xpath.find( c, i + 1 );
+      if( i_end == std::string::npos ) return false;
+      vTokens.push_back( s_xpath.substr( i, i_end - i ) );
+      i = i_end + 1;
+    }
+    else if( isdigit( (unsigned char) c ) || c == '.' )
+    {
+      size_t i_end = i;
+      while(
+        i_end < s_xpath.size() &&
+        ( isdigit( (unsigned char) s_xpath[i_end] ) || s_xpath[i_end] == '.' )
+      )
+        i_end++;
+      vTokens.push_back( s_xpath.substr( i, i_end - i ) );
+      i = i_end;
+    }
+    else if( isalpha( (unsigned char) c ) || c == '_' || c == '@' )
+    {
+      size_t i_end = i;
+      while(
+        i_end < s_xpath.size() &&
+        (
+          isalnum( (unsigned char) s_xpath[i_end] ) ||
+          s_xpath[i_end] == '_' ||
+          s_xpath[i_end] == '-' ||
+          s_xpath[i_end] == '/' ||
+          s_xpath[i_end] == '@'
+        )
+      )
+        i_end++;
+      vTokens.push_back( s_xpath.substr( i, i_end - i ) );
+      i = i_end;
+    }
+    else
+      return false;
+
+  }
+
+  return true;
+
+}
+
+//##############################################################################
+// ViewSelector::parseOr().
+//##############################################################################
+
+bool
+ViewSelector::parseOr()
+{
+
+  if( !parseAnd() ) return false;
+
+  while( iToken < vTokens.size() && vTokens[iToken] == "or" )
+  {
+    iToken++;
+    if( !parseAnd() ) return false;
+    instruction_t instruction = { I_OR, I_EQ, 0., "" };
+    vProgram.push_back( instruction );
+  }
+
+  return true;
+
+}
+
+//##############################################################################
+// ViewSelector::parseAnd().
+//##############################################################################
+
+bool
+ViewSelector::parseAnd()
+{
+
+  if( !parseUnary() ) return false;
+
+  while( iToken < vTokens.size() && vTokens[iToken] == "and" )
+  {
+    iToken++;
+    if( !parseUnary() ) return false;
+    instruction_t instruction = { I_AND, I_EQ, 0., "" };
+    vProgram.push_back( instruction );
+  }
+
+  return true;
+
+}
+
+//##############################################################################
+// ViewSelector::parseUnary().
+//##############################################################################
+
+bool
+ViewSelector::parseUnary()
+{
+
+  if( iToken >= vTokens.size() ) return false;
+
+  const std::string& s_token = vTokens[iToken];
+
+  bool b_next_is_open =
+    iToken + 1 < vTokens.size() && vTokens[iToken + 1] == "(";
+
+  if( s_token == "not" && b_next_is_open )
+  {
+    iToken += 2;
+    if( !parseOr() ) return false;
+    if( iToken >= vTokens.size() || vTokens[iToken++] != ")" ) return false;
+    instruction_t instruction = { I_NOT, I_EQ, 0., "" };
+    vProgram.push_back( instruction );
+    return true;
+  }
+
+  if( s_token == "(" )
+  {
+    iToken++;
+    if( !parseOr() ) return false;
+    return iToken < vTokens.size() && vTokens[iToken++] == ")";
+  }
+
+  //============================================================================
+  // A bare rate element is true if the reaction has that kind of rate.
+  //============================================================================
+
+  if(
+    iTarget == REACTION_SELECTOR &&
+    (
+      s_token == NON_SMOKER_STRING ||
+      s_token == RATE_TABLE_STRING ||
+      s_token == SINGLE_RATE_STRING ||
+      s_token == USER_RATE_STRING
+    )
+    &&
+    (
+      iToken + 1 >= vTokens.size() ||
+      get_view_operator( vTokens[iToken + 1] ) < 0
+    )
+  )
+  {
+    instruction_t instruction = { I_RATE_ELEMENT, I_EQ, 0., s_token };
+    vProgram.push_back( instruction );
+    iToken++;
+    return true;
+  }
+
+  return parseComparison();
+
+}
+
+//##############################################################################
+// ViewSelector::parseComparison().
+//##############################################################################
+
+bool
+ViewSelector::parseComparison()
+{
+
+  std::string s_lhs, s_rhs;
+
+  if( !parseTerm( s_lhs ) || iToken >= vTokens.size() ) return false;
+
+  int i_op = get_view_operator( vTokens[iToken++] );
+
+  if( i_op < 0 || !parseTerm( s_rhs ) ) return false;
+
+  if( is_view_literal( s_rhs ) && !is_view_literal( s_lhs ) )
+    return addComparison( s_lhs, i_op, s_rhs );
+
+  if( is_view_literal( s_lhs ) && !is_view_literal( s_rhs ) )
+  {
+    int v_flip[6] = { I_EQ, I_NE, I_GT, I_GE, I_LT, I_LE };
+    return addComparison( s_rhs, v_flip[i_op], s_lhs );
+  }
+
+  return false;
+
+}
+
+//##############################################################################
+// ViewSelector::parseTerm().
+//##############################################################################
+
+bool
+ViewSelector::parseTerm( std::string& s_term )
+{
+
+  if( iToken >= vTokens.size() ) return false;
+
+  if(
+    vTokens[iToken] == "count" &&
+    iToken + 3 < vTokens.size() &&
+    vTokens[iToken + 1] == "(" &&
+    vTokens[iToken + 3] == ")"
+  )
+  {
+    s_term = "count(" + vTokens[iToken + 2] + ")";
+    iToken += 4;
+  }
+  else
+    s_term = vTokens[iToken++];
+
+  return true;
+
+}
+
+//##############################################################################
+// ViewSelector::addComparison().
+//##############################################################################
+
+bool
+ViewSelector::addComparison(
+  const std::string& s_field,
+  int i_op,
+  const std::string& s_literal
+)
+{
+
+  bool b_string = s_literal[0] == '\'' || s_literal[0] == '"';
+  instruction_t instruction = { -1, i_op, 0., "" };
+
+  if( b_string )
+    instruction.sValue = s_literal.substr( 1 );
+  else
+  {
+    char * p_end;
+    instruction.dValue = strtod( s_literal.c_str(), &p_end );
+    if( *p_end != '\0' ) return false;
+  }
+
+  if( iTarget == NUCLIDE_SELECTOR )
+  {
+    if( b_string ) return false;
+    if( s_field == ATOMIC_NUMBER )
+      instruction.iCode = I_Z;
+    else if( s_field == MASS_NUMBER )
+      instruction.iCode = I_A;
+  }
+  else if( b_string )
+  {
+    if( i_op != I_EQ && i_op != I_NE ) return false;
+    if( s_field == REACTANT )
+      instruction.iCode = I_REACTANT;
+    else if( s_field == PRODUCT )
+      instruction.iCode = I_PRODUCT;
+    else if( s_field == std::string( USER_RATE_STRING ) + "/@" FUNCTION_KEY )
+      instruction.iCode = I_USER_RATE_KEY;
+  }
+  else
+  {
+    if( s_field == std::string( "count(" ) + REACTANT + ")" )
+      instruction.iCode = I_COUNT_REACTANT;
+    else if( s_field == std::string( "count(" ) + PRODUCT + ")" )
+      instruction.iCode = I_COUNT_PRODUCT;
+  }
+
+  if( instruction.iCode < 0 ) return false;
+
+  if( instruction.iCode >= I_REACTANT && instruction.iCode <= I_COUNT_PRODUCT )
+    bUsesElements = true;
+
+  vProgram.push_back( instruction );
+
+  return true;
+
+}
+
+//##############################################################################
+// ViewSelector::isSelected().
+//##############################################################################
+
+/**
+ * \brief Determine whether a species is selected by the compiled expression.
+ * \param p_species A pointer to the species.
+ * \return True if the species is selected, false if not.
+ */
+
+bool
+ViewSelector::isSelected( Libnucnet__Species * p_species ) const
+{
+
+  std::vector<std::string> v_empty;
+
+  return evaluate( p_species, NULL, v_empty, v_empty );
+
+}
+
+/**
+ * \brief Determine whether a reaction is selected by the compiled
+ *        expression.
+ * \param p_reaction A pointer to the reaction.
+ * \return True if the reaction is selected, false if not.
+ */
+
+bool
+ViewSelector::isSelected( Libnucnet__Reaction * p_reaction ) const
+{
+
+  std::vector<std::string> v_reactants, v_products;
+
+  if( bUsesElements )
+  {
+
+    BOOST_FOREACH(
+      ReactionElement element, make_reaction_reactant_list( p_reaction )
+    )
+    {
+      v_reactants.push_back(
+        Libnucnet__Reaction__Element__getName(
+          element.getNucnetReactionElement()
+        )
+      );
+    }
+
+    BOOST_FOREACH(
+      ReactionElement element, make_reaction_product_list( p_reaction )
+    )
+    {
+      v_products.push_back(
+        Libnucnet__Reaction__Element__getName(
+          element.getNucnetReactionElement()
+        )
+      );
+    }
+
+  }
+
+  return evaluate( NULL, p_reaction, v_reactants, v_products );
+
+}
+
+//##############################################################################
+// ViewSelector::evaluate().
+//##############################################################################
+
+bool
+ViewSelector::evaluate(
+  Libnucnet__Species * p_species,
+  Libnucnet__Reaction * p_reaction,
+  const std::vector<std::string>& v_reactants,
+  const std::vector<std::string>& v_products
+) const
+{
+
+  std::vector<char> v_stack;
+
+  if( vProgram.empty() ) return true;
+
+  v_stack.reserve( vProgram.size() );
+
+  BOOST_FOREACH( const instruction_t& instruction, vProgram )
+  {
+
+    bool b_result = false;
+
+    switch( instruction.iCode )
+    {
+
+      case I_AND:
+        b_result = v_stack[v_stack.size() - 2] && v_stack.back();
+        v_stack.resize( v_stack.size() - 2 );
+        break;
+
+      case I_OR:
+        b_result = v_stack[v_stack.size() - 2] || v_stack.back();
+        v_stack.resize( v_stack.size() - 2 );
+        break;
+
+      case I_NOT:
+        b_result = !v_stack.back();
+        v_stack.pop_back();
+        break;
+
+      case I_Z:
+        b_result =
+          compare_view_values(
+            (double) Libnucnet__Species__getZ( p_species ),
+            instruction.iOp,
+            instruction.dValue
+          );
+        break;
+
+      case I_A:
+        b_result =
+          compare_view_values(
+            (double) Libnucnet__Species__getA( p_species ),
+            instruction.iOp,
+            instruction.dValue
+          );
+        break;
+
+      //------------------------------------------------------------------------
+      // As in XPath, a comparison with a node set is true if it is true for
+      // any member.
+      //------------------------------------------------------------------------
+
+      case I_REACTANT:
+      case I_PRODUCT:
+        {
+          const std::vector<std::string>& v_elements =
+            instruction.iCode == I_REACTANT ? v_reactants : v_products;
+          for( size_t i = 0; i < v_elements.size() && !b_result; i++ )
+            b_result =
+              ( v_elements[i] == instruction.sValue ) ==
+              ( instruction.iOp == I_EQ );
+        }
+        break;
+
+      case I_COUNT_REACTANT:
+        b_result =
+          compare_view_values(
+            (double) v_reactants.size(), instruction.iOp, instruction.dValue
+          );
+        break;
+
+      case I_COUNT_PRODUCT:
+        b_result =
+          compare_view_values(
+            (double) v_products.size(), instruction.iOp, instruction.dValue
+          );
+        break;
+
+      case I_USER_RATE_KEY:
+        {
+          const char * s_key =
+            Libnucnet__Reaction__getRateFunctionKey( p_reaction );
+          b_result =
+            Libnucnet__Reac__is_user_defined_rate_function( s_key ) &&
+            ( instruction.sValue == s_key ) == ( instruction.iOp == I_EQ );
+        }
+        break;
+
+      case I_RATE_ELEMENT:
+        {
+          const char * s_key =
+            Libnucnet__Reaction__getRateFunctionKey( p_reaction );
+          if( instruction.sValue == USER_RATE_STRING )
+            b_result = Libnucnet__Reac__is_user_defined_rate_function( s_key );
+          else
+            b_result = instruction.sValue == s_key;
+        }
+        break;
+
+      default:
+        std::cerr << "Invalid view selector instruction." << std::endl;
+        exit( EXIT_FAILURE );
+
+    }
+
+    v_stack.push_back( b_result );
+
+  }
+
+  return v_stack.back();
+
+}
+
+//##############################################################################
+// get_view_selector().
+//##############################################################################
+
+/**
+ * \brief Retrieve the compiled selector for an XPath expression.
+ *
+ * Each expression is compiled once per target and kept for the rest of the
+ * run.
+ *
+ * \param s_xpath The XPath predicate expression.
+ * \param i_target NUCLIDE_SELECTOR or REACTION_SELECTOR.
+ * \return A shared pointer to the selector.
+ */
+
+boost::shared_ptr<ViewSelector>
+get_view_selector(
+  const std::string& s_xpath,
+  view_selector_targets i_target
+)
+{
+
+  boost::shared_ptr<ViewSelector> p_selector;
+
+#ifndef NO_OPENMP
+  #pragma omp critical(nnt_view_selector)
+#endif
+  {
+
+    selector_key_t key( s_xpath, (int) i_target );
+
+    std::map<selector_key_t, boost::shared_ptr<ViewSelector> >::iterator it =
+      selector_map.find( key );
+
+    if( it == selector_map.end() )
+    {
+      p_selector =
+        boost::shared_ptr<ViewSelector>(
+          new ViewSelector( s_xpath, i_target )
+        );
+      selector_map[key] = p_selector;
+    }
+    else
+      p_selector = it->second;
+
+  }
+
+  return p_selector;
+
+}
+
+//##############################################################################
+// new_net_view().
+//##############################################################################
+
+/**
+ * \brief Create a network view, as Libnucnet__NetView__new(), with a
+ *        compiled reaction selector.
+ *
+ * The view is made by Libnucnet from the nuclear XPath expression and, if
+ * the reaction expression does not compile, the reaction expression.
+ * Otherwise the reactions the compiled selector rejects are removed from
+ * the view.  Libnucnet offers no call that removes a species from a view
+ * without freeing it, so nuclear expressions are always left to Libnucnet.
+ * No view is kept here; Zone::getNetView() keeps its views with the zone,
+ * and they are freed with the zone.
+ *
+ * \param p_net A pointer to the network.
+ * \param s_nuc_xpath The nuclear XPath expression.
+ * \param s_reac_xpath The reaction XPath expression.
+ * \return A new view.  The caller owns it and frees it with
+ *         Libnucnet__NetView__free().
+ */
+
+Libnucnet__NetView *
+new_net_view(
+  Libnucnet__Net * p_net,
+  const char * s_nuc_xpath,
+  const char * s_reac_xpath
+)
+{
+
+  boost::shared_ptr<ViewSelector> p_reac_selector =
+    get_view_selector(
+      s_reac_xpath ? s_reac_xpath : "",
+      REACTION_SELECTOR
+    );
+
+  Libnucnet__NetView * p_view =
+    Libnucnet__NetView__new(
+      p_net,
+      s_nuc_xpath,
+      p_reac_selector->isCompiled() ? "" : s_reac_xpath
+    );
+
+  if( !p_reac_selector->isCompiled() || p_reac_selector->isSelectingAll() )
+    return p_view;
+
+  //============================================================================
+  // Remove the reactions not selected.
+  //============================================================================
+
+  BOOST_FOREACH(
+    Reaction reaction,
+    make_reaction_list(
+      Libnucnet__Net__getReac( Libnucnet__NetView__getNet( p_view ) )
+    )
+  )
+  {
+    if( !p_reac_selector->isSelected( reaction.getNucnetReaction() ) )
+      Libnucnet__NetView__removeReaction(
+        p_view, reaction.getNucnetReaction()
+      );
+  }
+
+  return p_view;
+
+}
+
+} // namespace nnt
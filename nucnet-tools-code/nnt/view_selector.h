@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this software; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307
+// USA
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//!
+//! \file
+//! \brief A header file for compiled view selectors and the network
+//!        views made from them.
+//!
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NNT_VIEW_SELECTOR_H
+#define NNT_VIEW_SELECTOR_H
+
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/iter.h"
+
+namespace nnt
+{
+
+//##############################################################################
+// Selector targets.
+//##############################################################################
+
+enum view_selector_targets { NUCLIDE_SELECTOR, REACTION_SELECTOR };
+
+//##############################################################################
+// ViewSelector.
+//##############################################################################
+
+/**
+ * \brief An XPath view predicate compiled to a direct test on species or
+ *        reactions.
+ *
+ * Libnucnet builds the XML document of the whole nuclide or reaction
+ * collection and runs libxml2 XPath on it each time a view with a non-empty
+ * XPath expression is created.  The common predicates only test the Z and
+ * A of a nuclide or the reactants, products, and rate function of a
+ * reaction, so this class parses them once into a postfix program that is
+ * evaluated directly on the Libnucnet structures.  The recognized forms are
+ * one or more bracketed predicates combining, with and, or, not(), and
+ * parentheses,
+ *
+ *   - for nuclides, comparisons of z or a with numbers;
+ *   - for reactions, reactant or product = (or !=) a string,
+ *     count(reactant) or count(product) compared with a number,
+ *     user_rate/@key = (or !=) a string, and the rate elements
+ *     non_smoker_fit, rate_table, single_rate, and user_rate.
+ *
+ * Any other expression is left uncompiled, and the view is made from it
+ * with XPath as before.
+ */
+
+class ViewSelector : private boost::noncopyable
+{
+
+  public:
+    ViewSelector( const std::string&, view_selector_targets );
+    bool isCompiled() const { return bCompiled; }
+    bool isSelectingAll() const { return bCompiled && vProgram.empty(); }
+    bool isSelected( Libnucnet__Species * ) const;
+    bool isSelected( Libnucnet__Reaction * ) const;
+
+  private:
+    typedef struct
+    {
+      int iCode;
+      int iOp;
+      double dValue;
+      std::string sValue;
+    } instruction_t;
+
+    view_selector_targets iTarget;
+    bool bCompiled;
+    bool bUsesElements;
+    std::vector<instruction_t> vProgram;
+    std::vector<std::string> vTokens;
+    size_t iToken;
+
+    bool tokenize( const std::string& );
+    bool parseOr();
+    bool parseAnd();
+    bool parseUnary();
+    bool parseComparison();
+    bool parseTerm( std::string& );
+    bool addComparison( const std::string&, int, const std::string& );
+    bool evaluate(
+      Libnucnet__Species *,
+      Libnucnet__Reaction *,
+      const std::vector<std::string>&,
+      const std::vector<std::string>&
+    ) const;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+boost::shared_ptr<ViewSelector>
+get_view_selector( const std::string&, view_selector_targets );
+
+Libnucnet__NetView *
+new_net_view( Libnucnet__Net *, const char *, const char * );
+
+} // namespace nnt
+
+#endif // NNT_VIEW_SELECTOR_H
@@ -29,6 +29,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "nnt/wrappers.hpp"
+#include "nnt/view_selector.h"
 
 /**
  * @brief The NucNet Tools namespace.
@@ -110,6 +111,117 @@ Libnucnet__Species * Species::getNucnetSpecies()
   return pSpecies;
 }
 
+//##############################################################################
+// zone_property_cache methods.
+//##############################################################################
+
+/**
+ * A method that creates an empty property cache and its lock.
+ */
+
+zone_property_cache::zone_property_cache()
+{
+#ifndef NO_OPENMP
+  omp_init_lock( &property_lock );
+#endif
+}
+
+/**
+ * A method that copies a property cache.  The copy gets its own lock.
+ * \param other The cache to copy.
+ */
+
+zone_property_cache::zone_property_cache( const zone_property_cache& other )
+{
+#ifndef NO_OPENMP
+  omp_init_lock( &property_lock );
+#endif
+  zone_property_cache_lock lock( other );
+  property_map = other.property_map;
+}
+
+/**
+ * A method that assigns the entries of another property cache.
+ * \param other The cache to copy.
+ * \return A reference to this cache.
+ */
+
+zone_property_cache&
+zone_property_cache::operator=( const zone_property_cache& other )
+{
+
+  if( this == &other ) return *this;
+
+  property_cache_t entries;
+
+  {
+    zone_property_cache_lock lock( other );
+    entries = other.property_map;
+  }
+
+  zone_property_cache_lock lock( *this );
+  property_map.swap( entries );
+
+  return *this;
+
+}
+
+/**
+ * A method that destroys the cache's lock.
+ */
+
+zone_property_cache::~zone_property_cache()
+{
+#ifndef NO_OPENMP
+  omp_destroy_lock( &property_lock );
+#endif
+}
+
+/**
+ * A method that locks the cache.
+ */
+
+void zone_property_cache::lock() const
+{
+#ifndef NO_OPENMP
+  omp_set_lock( &property_lock );
+#endif
+}
+
+/**
+ * A method that unlocks the cache.
+ */
+
+void zone_property_cache::unlock() const
+{
+#ifndef NO_OPENMP
+  omp_unset_lock( &property_lock );
+#endif
+}
+
+/**
+ * A method that removes all entries from the cache.
+ */
+
+void zone_property_cache::clear()
+{
+  zone_property_cache_lock lock( *this );
+  property_map.clear();
+}
+
+/**
+ * A method that returns the entry for a key, adding an empty entry if the
+ * key is not present.  The caller must hold the cache's lock.
+ * \param s_key The key.
+ * \return A reference to the entry.
+ */
+
+zone_property_value&
+zone_property_cache::getEntry( const std::string& s_key )
+{
+  return property_map[s_key];
+}
+
 //##############################################################################
 // Zone methods.
 //##############################################################################
@@ -122,6 +234,7 @@ Libnucnet__Species * Species::getNucnetSpecies()
 void Zone::setNucnetZone( Libnucnet__Zone * p_zone )
 {
   pZone = p_zone;
+  property_cache.clear();
 }
 
 /**
@@ -173,7 +286,7 @@ Zone::getNetView(
   if( strcmp( s_label1, EVOLUTION_NETWORK ) == 0 )
   {
     p_new_view =
-      Libnucnet__NetView__new(
+      new_net_view(
         Libnucnet__Zone__getNet( this->getNucnetZone() ),
         "",
         ""
@@ -182,7 +295,7 @@ Zone::getNetView(
   else
   {
     p_new_view =
-      Libnucnet__NetView__new(
+      new_net_view(
         Libnucnet__Zone__getNet( this->getNucnetZone() ),
         s_label1,
         s_label2
@@ -529,4 +642,135 @@ Zone::getListOfFunctions( )
 
 } 
 
+//############################################################################
+// Zone::hasData().
+//############################################################################
+
+/**
+ * \brief Determines whether a zone has the data with the given key.
+ *
+ * \param s_key A string giving the key.
+ * \return true if the data are present and false if not.
+ */
+
+bool
+Zone::hasData( const std::string s_key )
+{
+
+  if( this->data_map.find( s_key ) != this->data_map.end() )
+    return true;
+  else
+    return false;
+
+} 
+
+//############################################################################
+// Zone::updateData().
+//############################################################################
+
+/**
+ * \brief Update the data for a zone with the given key.  Data are
+ *        typically work structures or caches that persist over the
+ *        evolution of the zone.  To share the data between copies of
+ *        the zone, store a boost::shared_ptr.
+ *
+ * \param s_key A string giving the key.
+ * \param data The data to update with.
+ */
+
+void
+Zone::updateData( const std::string s_key, boost::any data )
+{
+
+  this->data_map[s_key] = data;
+
+} 
+
+//############################################################################
+// Zone::getData().
+//############################################################################
+
+/**
+ * \brief Retrieve the data with the given key.
+ *
+ * \param s_key A string giving the key.
+ * \return The data with the given key or exit with an error if there are
+ *         no data.
+ */
+
+boost::any
+Zone::getData( const std::string s_key )
+{
+
+  std::map<std::string, boost::any>::iterator it = this->data_map.find( s_key );
+
+  if( it != this->data_map.end() )
+  {
+    return it->second;
+  }
+  else
+  {
+    std::cerr << "No data: " << s_key << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }  
+
+} 
+
+//############################################################################
+// Zone::removeData().
+//############################################################################
+
+/**
+ * \brief Remove the data with the given key.
+ *
+ * \param s_key A string giving the key.
+ */
+
+void
+Zone::removeData( const std::string s_key )
+{
+
+  this->data_map.erase( s_key );
+
+}
+
+//############################################################################
+// Zone::makePropertyKey().
+//############################################################################
+
+/**
+ * \brief Make the key of a property in the zone's property cache.
+ *
+ * \param s_name A string giving the name of the property.
+ * \param s_tag1 A string giving the first tag (may be NULL).
+ * \param s_tag2 A string giving the second tag (may be NULL).
+ * \return The key.
+ */
+
+std::string
+Zone::makePropertyKey(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2
+)
+{
+
+  std::string s_key = s_name;
+
+  if( s_tag1 )
+  {
+    s_key += '\n';
+    s_key += s_tag1;
+  }
+
+  if( s_tag2 )
+  {
+    s_key += '\n';
+    s_key += s_tag2;
+  }
+
+  return s_key;
+
+} 
+
 } //namespace nnt
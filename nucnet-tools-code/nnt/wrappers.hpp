@@ -31,7 +31,12 @@
 #ifndef NNT_WRAPPERS_H
 #define NNT_WRAPPERS_H
 
+#ifndef NO_OPENMP
+#include <omp.h>
+#endif
+
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -42,6 +47,9 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
 
 #include <Libnucnet.h>
 #include <Libstatmech.h>
@@ -105,6 +113,69 @@ namespace nnt
     >
   > function_map_t;
 
+  /**
+   * A cached zone property value: the string stored in the zone's property
+   * hash and the value it was converted to or from.
+   */
+
+  class zone_property_value
+  {
+
+    public:
+      std::string sValue;
+      boost::any value;
+
+  };
+
+  typedef
+    boost::unordered_map<std::string, zone_property_value> property_cache_t;
+
+  /**
+   * A zone's cache of converted property values.  getProperty() is const
+   * and may be called on one zone from several threads, so the cache is
+   * guarded by a lock when OpenMP is used.  A copy gets its own lock.
+   * Member functions are defined in wrappers.cpp.
+   */
+
+  class zone_property_cache
+  {
+
+    public:
+      zone_property_cache();
+      zone_property_cache( const zone_property_cache& );
+      zone_property_cache& operator=( const zone_property_cache& );
+      ~zone_property_cache();
+      void lock() const;
+      void unlock() const;
+      void clear();
+      zone_property_value& getEntry( const std::string& );
+
+    private:
+      property_cache_t property_map;
+#ifndef NO_OPENMP
+      mutable omp_lock_t property_lock;
+#endif
+
+  };
+
+  /**
+   * A scoped lock on a zone's property cache.  The cache is unlocked when
+   * the lock goes out of scope, including when a conversion throws.
+   */
+
+  class zone_property_cache_lock : private boost::noncopyable
+  {
+
+    public:
+      explicit zone_property_cache_lock( const zone_property_cache& cache ) :
+        rCache( cache ) { rCache.lock(); }
+      ~zone_property_cache_lock() { rCache.unlock(); }
+
+    private:
+      const zone_property_cache& rCache;
+
+  };
+
   //############################################################################
   // ReactionElement.
   //############################################################################
@@ -197,6 +268,10 @@ namespace nnt
       std::string getFunctionTag( const std::string );
       std::vector<std::string> getListOfFunctions( const std::string );
       std::vector<std::string> getListOfFunctions( );
+      bool hasData( const std::string );
+      void updateData( const std::string, boost::any );
+      boost::any getData( const std::string );
+      void removeData( const std::string );
       Libnucnet__NetView *
         getNetView( const char *, const char *, const char * );
       Libnucnet__NetView * getNetView( const char *, const char * );
@@ -241,6 +316,42 @@ namespace nnt
     protected:
       Libnucnet__Zone * pZone;
       function_map_t function_map;
+      std::map<std::string, boost::any> data_map;
+      mutable zone_property_cache property_cache;
+
+    private:
+      static std::string
+        makePropertyKey( const char *, const char *, const char * );
+      template<class R>
+        R convertProperty(
+          const char *, const char *, const char *, const char *
+        ) const;
+      template<class R>
+        R convertProperty(
+          const char *,
+          const char *,
+          const char *,
+          const char *,
+          boost::true_type
+        ) const;
+      template<class R>
+        R convertProperty(
+          const char *,
+          const char *,
+          const char *,
+          const char *,
+          boost::false_type
+        ) const;
+      template<class T>
+        int storeProperty( const char *, const char *, const char *, T );
+      template<class T>
+        int storeProperty(
+          const char *, const char *, const char *, T, boost::true_type
+        );
+      template<class T>
+        int storeProperty(
+          const char *, const char *, const char *, T, boost::false_type
+        );
 
   };
 
@@ -291,13 +402,7 @@ Zone::updateProperty(
 {
 
   return
-    Libnucnet__Zone__updateProperty(
-      this->getNucnetZone(),
-      s_name.c_str(),
-      s_tag1.c_str(),
-      s_tag2.c_str(),
-      boost::lexical_cast<std::string>( value ).c_str()
-    );
+    storeProperty( s_name.c_str(), s_tag1.c_str(), s_tag2.c_str(), value );
 
 } 
 
@@ -310,14 +415,7 @@ Zone::updateProperty(
 )
 {
 
-  return
-    Libnucnet__Zone__updateProperty(
-      this->getNucnetZone(),
-      s_name.c_str(),
-      s_tag1.c_str(),
-      NULL,
-      boost::lexical_cast<std::string>( value ).c_str()
-    );
+  return storeProperty( s_name.c_str(), s_tag1.c_str(), NULL, value );
 
 } 
 
@@ -329,14 +427,7 @@ Zone::updateProperty(
 )
 {
 
-  return
-    Libnucnet__Zone__updateProperty(
-      this->getNucnetZone(),
-      s_name.c_str(),
-      NULL,
-      NULL,
-      boost::lexical_cast<std::string>( value ).c_str()
-    );
+  return storeProperty( s_name.c_str(), NULL, NULL, value );
 
 } 
 
@@ -370,7 +461,10 @@ Zone::getProperty(
     );
 
   if( s_value )
-    return boost::lexical_cast<R>( s_value );
+    return
+      convertProperty<R>(
+        s_name.c_str(), s_tag1.c_str(), s_tag2.c_str(), s_value
+      );
   else
   {
 
@@ -398,7 +492,7 @@ Zone::getProperty(
     );
 
   if( s_value )
-    return boost::lexical_cast<R>( s_value );
+    return convertProperty<R>( s_name.c_str(), s_tag1.c_str(), NULL, s_value );
   else
   {
 
@@ -425,7 +519,7 @@ Zone::getProperty(
     );
 
   if( s_value )
-    return boost::lexical_cast<R>( s_value );
+    return convertProperty<R>( s_name.c_str(), NULL, NULL, s_value );
   else
   {
 
@@ -439,6 +533,177 @@ Zone::getProperty(
 
 }
 
+//############################################################################
+// Zone::convertProperty().
+//############################################################################
+
+/**
+  \brief Converts the string value of a zone property.  Arithmetic values
+         are cached with the zone and only converted anew when the string
+         stored in the zone's property hash changes.
+*/
+
+template<class R>
+R
+Zone::convertProperty(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  const char * s_value
+) const
+{
+
+  return
+    convertProperty<R>(
+      s_name,
+      s_tag1,
+      s_tag2,
+      s_value,
+      typename boost::is_arithmetic<R>::type()
+    );
+
+}
+
+template<class R>
+R
+Zone::convertProperty(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  const char * s_value,
+  boost::true_type
+) const
+{
+
+  zone_property_cache_lock lock( property_cache );
+
+  zone_property_value& entry =
+    property_cache.getEntry( makePropertyKey( s_name, s_tag1, s_tag2 ) );
+
+  if( entry.sValue == s_value )
+  {
+    const R * p_value = boost::any_cast<R>( &entry.value );
+    if( p_value ) return *p_value;
+  }
+
+  R value = boost::lexical_cast<R>( s_value );
+
+  entry.sValue = s_value;
+  entry.value = value;
+
+  return value;
+
+}
+
+template<class R>
+R
+Zone::convertProperty(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  const char * s_value,
+  boost::false_type
+) const
+{
+
+  return boost::lexical_cast<R>( s_value );
+
+}
+
+//############################################################################
+// Zone::storeProperty().
+//############################################################################
+
+/**
+  \brief Stores the value of a zone property in the zone's property hash.
+         Arithmetic values are cached with the zone, and storing the cached
+         value again does not convert it to a string or update the hash.
+*/
+
+template<class T>
+int
+Zone::storeProperty(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  T value
+)
+{
+
+  return
+    storeProperty(
+      s_name,
+      s_tag1,
+      s_tag2,
+      value,
+      typename boost::is_arithmetic<T>::type()
+    );
+
+}
+
+template<class T>
+int
+Zone::storeProperty(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  T value,
+  boost::true_type
+)
+{
+
+  zone_property_cache_lock lock( property_cache );
+
+  zone_property_value& entry =
+    property_cache.getEntry( makePropertyKey( s_name, s_tag1, s_tag2 ) );
+
+  const char * s_current =
+    Libnucnet__Zone__getProperty(
+      this->getNucnetZone(), s_name, s_tag1, s_tag2
+    );
+
+  if( s_current && entry.sValue == s_current )
+  {
+    const T * p_value = boost::any_cast<T>( &entry.value );
+    if( p_value && *p_value == value ) return 1;
+  }
+
+  entry.sValue = boost::lexical_cast<std::string>( value );
+  entry.value = value;
+
+  return
+    Libnucnet__Zone__updateProperty(
+      this->getNucnetZone(),
+      s_name,
+      s_tag1,
+      s_tag2,
+      entry.sValue.c_str()
+    );
+
+}
+
+template<class T>
+int
+Zone::storeProperty(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  T value,
+  boost::false_type
+)
+{
+
+  return
+    Libnucnet__Zone__updateProperty(
+      this->getNucnetZone(),
+      s_name,
+      s_tag1,
+      s_tag2,
+      boost::lexical_cast<std::string>( value ).c_str()
+    );
+
+}
+
 } // namespace nnt
 
 #endif // NNT_WRAPPERS_H
@@ -227,16 +227,34 @@ double rho_post( double rho, nnt::Zone& zone )
 } 
 
 //##############################################################################
-// update_zone_properties().
+// get_zone_trajectory().
 //##############################################################################
 
-void
-update_zone_properties(
+/**
+ * \brief Retrieve a zone's trajectory.  The shock data do not change
+ *        during a run, so the trajectory is built from the zone vectors
+ *        on the first call and the one kept with the zone's interpolator
+ *        is returned after that.
+ * \param zone The zone.
+ * \param p_nucnet The Libnucnet structure holding the shock zones.
+ * \return A shared pointer to the zone's trajectory.
+ */
+
+boost::shared_ptr<user::Trajectory>
+get_zone_trajectory(
   nnt::Zone& zone,
   Libnucnet * p_nucnet
 )
 {
 
+  if( zone.hasData( nnt::s_TRAJECTORY_INTERPOLATOR ) )
+  {
+    return
+      boost::any_cast<boost::shared_ptr<user::TrajectoryInterpolator> >(
+        zone.getData( nnt::s_TRAJECTORY_INTERPOLATOR )
+      )->getTrajectory();
+  }
+
   boost::tuple<
     std::vector<double>,
     std::vector<double>,
@@ -244,12 +262,27 @@ update_zone_properties(
   > t =
     get_zone_vectors( zone, p_nucnet );
 
+  return
+    boost::shared_ptr<user::Trajectory>(
+      new user::Trajectory( "linear", t.get<0>(), t.get<1>(), t.get<2>() )
+    );
+
+}
+
+//##############################################################################
+// update_zone_properties().
+//##############################################################################
+
+void
+update_zone_properties(
+  nnt::Zone& zone,
+  Libnucnet * p_nucnet
+)
+{
+
   user::update_t9_rho_in_zone_by_interpolation(
     zone,
-    "linear",
-    t.get<0>(),
-    t.get<1>(),
-    t.get<2>()
+    get_zone_trajectory( zone, p_nucnet )
   );
 
   double d_velocity =
@@ -70,6 +70,12 @@ get_zone_vectors(
   Libnucnet *
 );
 
+boost::shared_ptr<user::Trajectory>
+get_zone_trajectory(
+  nnt::Zone&,
+  Libnucnet *
+);
+
 double T9_post( double, nnt::Zone& );
 
 double rho_post( double, nnt::Zone& );
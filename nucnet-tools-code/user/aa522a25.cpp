@@ -28,6 +28,8 @@
 //!
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <climits>
+
 #include "aa522a25.h"
 
 using namespace std;
@@ -379,54 +381,40 @@ aa522a25__update_reactions(
 }
 
 //##############################################################################
-// aa522a25__compute_rate().
+// Aa522a25PhaseSpaceTable::Aa522a25PhaseSpaceTable().
 //##############################################################################
 
-double
-aa522a25__compute_rate(
+/**
+ * \brief Find the constant data of an aa522a25 reaction.
+ * \param p_reaction A pointer to the reaction.
+ * \param p_net A pointer to the network containing the reaction.
+ * \param d_electron_mass The electron rest mass (MeV).
+ */
+
+Aa522a25PhaseSpaceTable::Aa522a25PhaseSpaceTable(
   Libnucnet__Reaction * p_reaction,
   Libnucnet__Net * p_net,
-  double d_electron_mass,
-  double d_t9,
-  double d_eta_F,
-  double d_mu_nue_kT
-)
+  double d_electron_mass
+) : dElectronMass( d_electron_mass )
 {
 
-  double d_result =
-        aa522a25__compute_integral(
-          p_reaction,
-          p_net,
-          d_electron_mass,
-          d_t9,
-          d_eta_F,
-          d_mu_nue_kT,
-          2
-        );
-  if(
-      !Libnucnet__Reaction__getUserRateFunctionProperty(
-        p_reaction,
-        s_AA522A25_B_FACTOR,
-        NULL,
-        NULL
-      )
-  )
+  const char * s_b =
+    Libnucnet__Reaction__getUserRateFunctionProperty(
+      p_reaction,
+      s_AA522A25_B_FACTOR,
+      NULL,
+      NULL
+    );
+
+  if( !s_b )
   {
     std::cerr <<
       "No such user rate property." << std::endl;
     exit( EXIT_FAILURE );
   }
 
-  return
-    d_result *
-    atof(
-      Libnucnet__Reaction__getUserRateFunctionProperty(
-        p_reaction,
-        s_AA522A25_B_FACTOR,
-        NULL,
-        NULL
-      )
-    ) *
+  dPrefactor =
+    atof( s_b ) *
     M_LN2 /
     (
       gsl_pow_5( d_electron_mass )
@@ -434,6 +422,495 @@ aa522a25__compute_rate(
       d_AA522A25_WEAK_K
     );
 
+  dQ =
+    nnt::compute_reaction_nuclear_Qvalue(
+      p_net,
+      p_reaction,
+      d_electron_mass
+    );
+
+  bAllowed = true;
+
+  if( nnt::is_electron_capture_reaction( p_reaction ) )
+  {
+    iChannel = i_AA522A25_ELECTRON_CAPTURE;
+    dQ *= -1;
+  }
+  else if( nnt::is_beta_plus_reaction( p_reaction ) )
+  {
+    iChannel = i_AA522A25_BETA_PLUS;
+    dQ *= -1;
+    if( d_electron_mass > -dQ ) bAllowed = false;
+  }
+  else if( nnt::is_positron_capture_reaction( p_reaction ) )
+  {
+    iChannel = i_AA522A25_POSITRON_CAPTURE;
+  }
+  else if( nnt::is_beta_minus_reaction( p_reaction ) )
+  {
+    iChannel = i_AA522A25_BETA_MINUS;
+    if( d_electron_mass > dQ ) bAllowed = false;
+  }
+  else
+  {
+    std::cerr <<
+      "No such rate for AA522A25 reaction rate function." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+}
+
+//##############################################################################
+// Aa522a25PhaseSpaceTable::computeIntegral().
+//##############################################################################
+
+/**
+ * \brief Compute a phase-space integral of the reaction by quadrature.
+ * \param d_t9 The t9.
+ * \param d_eta_F The electron chemical potential (including the rest mass)
+ *        divided by kT.
+ * \param d_mu_nue_kT The electron neutrino chemical potential divided by
+ *        kT (GSL_NEGINF for no neutrino blocking).
+ * \param i_neutrino_exponent The power of the neutrino energy in the
+ *        integrand.
+ * \return The integral.
+ */
+
+double
+Aa522a25PhaseSpaceTable::computeIntegral(
+  double d_t9,
+  double d_eta_F,
+  double d_mu_nue_kT,
+  int i_neutrino_exponent
+) const
+{
+
+  double d_result = 0, d_error;
+  gsl_function F;
+  aa522a25_function_data function_data;
+
+  if( !bAllowed ) return 0.;
+
+  gsl_integration_workspace * p_work_space =
+    gsl_integration_workspace_alloc( (size_t) i_AA522A25_WORKSPACE );
+
+  function_data.dkT = nnt::compute_kT_in_MeV( d_t9 );
+
+  function_data.dEtaF = d_eta_F;
+
+  function_data.dMunuekT = d_mu_nue_kT;
+
+  function_data.iNeutrinoExponent = i_neutrino_exponent;
+
+  function_data.dQ = dQ;
+
+  F.params = &function_data;
+
+  if( iChannel == i_AA522A25_ELECTRON_CAPTURE )
+  {
+
+    F.function = &aa522a25__electron_capture_integrand;
+
+    gsl_integration_qagiu(
+      &F,
+      GSL_MAX_DBL( dQ, dElectronMass ),
+      d_AA522A25_EPSABS,
+      d_AA522A25_EPSREL,
+      (size_t) i_AA522A25_LIMIT,
+      p_work_space,
+      &d_result,
+      &d_error
+    );
+
+  }
+  else if( iChannel == i_AA522A25_BETA_PLUS )
+  {
+
+    F.function = &aa522a25__beta_plus_integrand;
+
+    gsl_integration_qags(
+      &F,
+      dElectronMass,
+      -dQ,
+      d_AA522A25_EPSABS,
+      d_AA522A25_EPSREL,
+      (size_t) i_AA522A25_LIMIT,
+      p_work_space,
+      &d_result,
+      &d_error
+    );
+
+  }
+  else if( iChannel == i_AA522A25_POSITRON_CAPTURE )
+  {
+
+    F.function = &aa522a25__positron_capture_integrand;
+
+    gsl_integration_qagiu(
+      &F,
+      GSL_MAX_DBL( -dQ, dElectronMass ),
+      d_AA522A25_EPSABS,
+      d_AA522A25_EPSREL,
+      (size_t) i_AA522A25_LIMIT,
+      p_work_space,
+      &d_result,
+      &d_error
+    );
+
+  }
+  else
+  {
+
+    F.function = &aa522a25__beta_minus_integrand;
+
+    gsl_integration_qags(
+      &F,
+      dElectronMass,
+      dQ,
+      d_AA522A25_EPSABS,
+      d_AA522A25_EPSREL,
+      (size_t) i_AA522A25_LIMIT,
+      p_work_space,
+      &d_result,
+      &d_error
+    );
+
+  }
+
+  gsl_integration_workspace_free( p_work_space );
+
+  return d_result;
+
+}
+
+//##############################################################################
+// Aa522a25PhaseSpaceTable::computeNode().
+//##############################################################################
+
+aa522a25_node_t
+Aa522a25PhaseSpaceTable::computeNode( const node_key_t& key ) const
+{
+
+  aa522a25_node_t node;
+  double d_t9, d_eta_F, d_mu_nue_kT, d_integral;
+
+  d_t9 = pow( 10., (double) key.get<0>() * d_AA522A25_TABLE_LOG10_T9_STEP );
+  d_eta_F = (double) key.get<1>() * d_AA522A25_TABLE_ETA_STEP;
+
+  if( key.get<2>() == LONG_MIN )
+    d_mu_nue_kT = GSL_NEGINF;
+  else
+    d_mu_nue_kT = (double) key.get<2>() * d_AA522A25_TABLE_MU_NUE_STEP;
+
+  d_integral = computeIntegral( d_t9, d_eta_F, d_mu_nue_kT, 2 );
+
+  node.dLogRateIntegral =
+    d_integral > 0. ? log( d_integral ) : GSL_LOG_DBL_MIN;
+
+  d_integral = computeIntegral( d_t9, d_eta_F, d_mu_nue_kT, 3 );
+
+  node.dLogEnergyIntegral =
+    d_integral > 0. ? log( d_integral ) : GSL_LOG_DBL_MIN;
+
+  return node;
+
+}
+
+//##############################################################################
+// aa522a25__compute_lagrange_weights().
+//##############################################################################
+
+void
+aa522a25__compute_lagrange_weights(
+  double d_x,
+  long * p_k,
+  double * w
+)
+{
+
+  long i_k = (long) floor( d_x ) - 1;
+
+  double t = d_x - (double) i_k;
+
+  w[0] = -( t - 1. ) * ( t - 2. ) * ( t - 3. ) / 6.;
+  w[1] = t * ( t - 2. ) * ( t - 3. ) / 2.;
+  w[2] = -t * ( t - 1. ) * ( t - 3. ) / 2.;
+  w[3] = t * ( t - 1. ) * ( t - 2. ) / 6.;
+
+  *p_k = i_k;
+
+}
+
+//##############################################################################
+// Aa522a25PhaseSpaceTable::interpolate().
+//##############################################################################
+
+/**
+ * \brief Interpolate the phase-space integrals of the reaction from the
+ *        table, computing any missing nodes.
+ * \param d_t9 The t9.
+ * \param d_eta_F The electron chemical potential (including the rest mass)
+ *        divided by kT.
+ * \param d_mu_nue_kT The electron neutrino chemical potential divided by
+ *        kT (GSL_NEGINF for no neutrino blocking).
+ * \param d_rate_integral On return, the integral with neutrino energy
+ *        exponent two.
+ * \param d_energy_integral On return, the integral with neutrino energy
+ *        exponent three.
+ */
+
+void
+Aa522a25PhaseSpaceTable::interpolate(
+  double d_t9,
+  double d_eta_F,
+  double d_mu_nue_kT,
+  double& d_rate_integral,
+  double& d_energy_integral
+)
+{
+
+  long i_t9, i_eta, i_mu;
+  double w_t9[4], w_eta[4], w_mu[4];
+  size_t i_mu_points, i_nodes;
+  node_key_t keys[64];
+  aa522a25_node_t nodes[64];
+
+  d_rate_integral = 0.;
+  d_energy_integral = 0.;
+
+  if( !bAllowed ) return;
+
+  aa522a25__compute_lagrange_weights(
+    log10( d_t9 ) / d_AA522A25_TABLE_LOG10_T9_STEP, &i_t9, w_t9
+  );
+
+  aa522a25__compute_lagrange_weights(
+    d_eta_F / d_AA522A25_TABLE_ETA_STEP, &i_eta, w_eta
+  );
+
+  if( d_mu_nue_kT == GSL_NEGINF )
+  {
+    i_mu = LONG_MIN;
+    w_mu[0] = 1.;
+    i_mu_points = 1;
+  }
+  else
+  {
+    aa522a25__compute_lagrange_weights(
+      d_mu_nue_kT / d_AA522A25_TABLE_MU_NUE_STEP, &i_mu, w_mu
+    );
+    i_mu_points = 4;
+  }
+
+  i_nodes = 16 * i_mu_points;
+
+  for( size_t l = 0; l < i_nodes; l++ )
+  {
+    size_t k = l % i_mu_points;
+    keys[l] =
+      boost::make_tuple(
+        i_t9 + (long) ( l / ( 4 * i_mu_points ) ),
+        i_eta + (long) ( ( l / i_mu_points ) % 4 ),
+        i_mu_points == 1 ? i_mu : i_mu + (long) k
+      );
+  }
+
+  //============================================================================
+  // Get the nodes, computing and storing the missing ones.
+  //============================================================================
+
+  for( size_t l = 0; l < i_nodes; l++ )
+  {
+    std::map<node_key_t, aa522a25_node_t>::iterator it =
+      nodeMap.find( keys[l] );
+    if( it == nodeMap.end() )
+      it =
+        nodeMap.insert(
+          std::make_pair( keys[l], computeNode( keys[l] ) )
+        ).first;
+    nodes[l] = it->second;
+  }
+
+  //============================================================================
+  // Interpolate.
+  //============================================================================
+
+  double d_log_rate = 0., d_log_energy = 0.;
+
+  for( size_t l = 0; l < i_nodes; l++ )
+  {
+    double w =
+      w_t9[l / ( 4 * i_mu_points )] *
+      w_eta[( l / i_mu_points ) % 4] *
+      w_mu[l % i_mu_points];
+    d_log_rate += w * nodes[l].dLogRateIntegral;
+    d_log_energy += w * nodes[l].dLogEnergyIntegral;
+  }
+
+  if( d_log_rate > GSL_LOG_DBL_MIN ) d_rate_integral = exp( d_log_rate );
+
+  if( d_log_energy > GSL_LOG_DBL_MIN )
+    d_energy_integral = exp( d_log_energy );
+
+}
+
+//##############################################################################
+// Aa522a25PhaseSpaceTables::Aa522a25PhaseSpaceTables().
+//##############################################################################
+
+/**
+ * \brief Create the phase-space tables of the aa522a25 reactions in a
+ *        network.
+ * \param p_net A pointer to the network.
+ * \param d_electron_mass The electron rest mass (MeV).
+ */
+
+Aa522a25PhaseSpaceTables::Aa522a25PhaseSpaceTables(
+  Libnucnet__Net * p_net,
+  double d_electron_mass
+) : pNet( p_net ), dElectronMass( d_electron_mass )
+{
+
+  iReacUpdate = Libnucnet__Net__getReac( p_net )->iUpdate;
+  iNucUpdate = Libnucnet__Net__getNuc( p_net )->iUpdate;
+  iNetReactions =
+    Libnucnet__Reac__getNumberOfReactions( Libnucnet__Net__getReac( p_net ) );
+
+  nnt::reaction_list_t reaction_list =
+    nnt::make_reaction_list( Libnucnet__Net__getReac( p_net ) );
+
+  BOOST_FOREACH( nnt::Reaction reaction, reaction_list )
+  {
+
+    if(
+      strcmp(
+        Libnucnet__Reaction__getRateFunctionKey(
+          reaction.getNucnetReaction()
+        ),
+        s_AA522A25
+      ) == 0
+    )
+      table_map[reaction.getNucnetReaction()].reset(
+        new Aa522a25PhaseSpaceTable(
+          reaction.getNucnetReaction(),
+          p_net,
+          d_electron_mass
+        )
+      );
+
+  }
+
+}
+
+//##############################################################################
+// Aa522a25PhaseSpaceTables::isValidFor().
+//##############################################################################
+
+/**
+ * \brief Check whether the tables apply to a network and electron mass.
+ * \param p_net A pointer to the network.
+ * \param d_electron_mass The electron rest mass (MeV).
+ * \return True if the tables were created for the network and electron mass
+ *         and the network's reactions and nuclei have not been updated
+ *         since, false if not.
+ */
+
+bool
+Aa522a25PhaseSpaceTables::isValidFor(
+  Libnucnet__Net * p_net,
+  double d_electron_mass
+) const
+{
+
+  return
+    p_net == pNet &&
+    d_electron_mass == dElectronMass &&
+    Libnucnet__Net__getReac( p_net )->iUpdate == iReacUpdate &&
+    Libnucnet__Net__getNuc( p_net )->iUpdate == iNucUpdate &&
+    Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac( p_net )
+    ) == iNetReactions;
+
+}
+
+//##############################################################################
+// Aa522a25PhaseSpaceTables::getTable().
+//##############################################################################
+
+/**
+ * \brief Get the phase-space table of a reaction.
+ * \param p_reaction A pointer to the reaction.
+ * \return A pointer to the table, or NULL if the reaction is not an
+ *         aa522a25 reaction of the network.
+ */
+
+Aa522a25PhaseSpaceTable *
+Aa522a25PhaseSpaceTables::getTable(
+  const Libnucnet__Reaction * p_reaction
+) const
+{
+
+  boost::unordered_map<
+    const Libnucnet__Reaction *,
+    boost::shared_ptr<Aa522a25PhaseSpaceTable>
+  >::const_iterator it = table_map.find( p_reaction );
+
+  if( it == table_map.end() ) return NULL;
+
+  return it->second.get();
+
+}
+
+//##############################################################################
+// aa522a25__compute_rate().
+//##############################################################################
+
+/**
+ * \brief Compute an aa522a25 rate.
+ * \param p_reaction A pointer to the reaction.
+ * \param p_net A pointer to the network containing the reaction.
+ * \param d_electron_mass The electron rest mass (MeV).
+ * \param d_t9 The t9.
+ * \param d_eta_F The electron chemical potential (including the rest mass)
+ *        divided by kT.
+ * \param d_mu_nue_kT The electron neutrino chemical potential divided by
+ *        kT.
+ * \param p_tables A pointer to the phase-space tables of the network, or
+ *        NULL.  If the tables hold the reaction, the rate is interpolated
+ *        from its table; otherwise it is computed by quadrature.
+ * \return The rate (per second).
+ */
+
+double
+aa522a25__compute_rate(
+  Libnucnet__Reaction * p_reaction,
+  Libnucnet__Net * p_net,
+  double d_electron_mass,
+  double d_t9,
+  double d_eta_F,
+  double d_mu_nue_kT,
+  Aa522a25PhaseSpaceTables * p_tables
+)
+{
+
+  double d_rate_integral, d_energy_integral;
+
+  Aa522a25PhaseSpaceTable * p_table =
+    p_tables ? p_tables->getTable( p_reaction ) : NULL;
+
+  if( p_table )
+  {
+    p_table->interpolate(
+      d_t9, d_eta_F, d_mu_nue_kT, d_rate_integral, d_energy_integral
+    );
+    return d_rate_integral * p_table->getRatePrefactor();
+  }
+
+  Aa522a25PhaseSpaceTable table( p_reaction, p_net, d_electron_mass );
+
+  return
+    table.computeIntegral( d_t9, d_eta_F, d_mu_nue_kT, 2 ) *
+    table.getRatePrefactor();
 
 }
 
@@ -602,133 +1079,10 @@ aa522a25__compute_integral(
 )
 {
 
-  double d_result = 0, d_error, d_limit;
-  gsl_integration_workspace * p_work_space =
-    gsl_integration_workspace_alloc( (size_t) i_AA522A25_WORKSPACE );
-  gsl_function F;
-  aa522a25_function_data function_data;
-
-  function_data.dkT = nnt::compute_kT_in_MeV( d_t9 );
-
-  function_data.dEtaF = d_eta_F;
-
-  function_data.dMunuekT = d_mu_nue_kT;
-
-  function_data.iNeutrinoExponent = i_neutrino_exponent;
-
-  function_data.dQ =
-    nnt::compute_reaction_nuclear_Qvalue(
-      p_net,
-      p_reaction,
-      d_electron_mass
-    );
-
-  F.params = &function_data;
-
-  if( nnt::is_electron_capture_reaction( p_reaction ) )
-  {
-
-    F.function = &aa522a25__electron_capture_integrand;
-
-    function_data.dQ *= -1;
-
-    d_limit =
-      GSL_MAX_DBL(
-        function_data.dQ,
-        d_electron_mass
-      );
-
-    gsl_integration_qagiu(
-      &F,
-      d_limit,
-      d_AA522A25_EPSABS,
-      d_AA522A25_EPSREL,
-      (size_t) i_AA522A25_LIMIT,
-      p_work_space,
-      &d_result,
-      &d_error
-    );
-
-  }
-  else if( nnt::is_beta_plus_reaction( p_reaction ) )
-  {
-
-    F.function = &aa522a25__beta_plus_integrand;
-
-    function_data.dQ *= -1;
-
-    if( 
-      d_electron_mass > -function_data.dQ
-    )
-      d_result = 0.;
-    else
-      gsl_integration_qags(
-        &F,
-        d_electron_mass,
-        -function_data.dQ,
-        d_AA522A25_EPSABS,
-        d_AA522A25_EPSREL,
-        (size_t) i_AA522A25_LIMIT,
-        p_work_space,
-        &d_result,
-        &d_error
-      );
-
-  }
-  else if( nnt::is_positron_capture_reaction( p_reaction ) )
-  {
-
-    F.function = &aa522a25__positron_capture_integrand;
-
-    gsl_integration_qagiu(
-      &F,
-      GSL_MAX_DBL(
-        -function_data.dQ,
-        d_electron_mass
-      ),
-      d_AA522A25_EPSABS,
-      d_AA522A25_EPSREL,
-      (size_t) i_AA522A25_LIMIT,
-      p_work_space,
-      &d_result,
-      &d_error
-    );
-
-  }
-  else if( nnt::is_beta_minus_reaction( p_reaction ) )
-  {
-
-    F.function = &aa522a25__beta_minus_integrand;
-
-    if( 
-      d_electron_mass >
-      function_data.dQ
-    )
-      d_result = 0.;
-    else
-      gsl_integration_qags(
-        &F,
-        d_electron_mass,
-        function_data.dQ,
-        d_AA522A25_EPSABS,
-        d_AA522A25_EPSREL,
-        (size_t) i_AA522A25_LIMIT,
-        p_work_space,
-        &d_result,
-        &d_error
-      );
-
-  }
-  else
-  {
-    std::cerr <<
-      "No such rate for AA522A25 reaction rate function." << std::endl;
-    exit( EXIT_FAILURE );
-  }
-
-  gsl_integration_workspace_free( p_work_space );
+  Aa522a25PhaseSpaceTable table( p_reaction, p_net, d_electron_mass );
 
-  return d_result;
+  return
+    table.computeIntegral( d_t9, d_eta_F, d_mu_nue_kT, i_neutrino_exponent );
 
 }
 
@@ -736,6 +1090,22 @@ aa522a25__compute_integral(
 // aa522a25__compute_reaction_neutrino_energy_loss_rate().
 //##############################################################################
 
+/**
+ * \brief Compute the neutrino energy-loss rate of an aa522a25 reaction.
+ * \param p_reaction A pointer to the reaction.
+ * \param p_net A pointer to the network containing the reaction.
+ * \param d_electron_mass The electron rest mass (MeV).
+ * \param d_t9 The t9.
+ * \param d_eta_F The electron chemical potential (including the rest mass)
+ *        divided by kT.
+ * \param d_mu_nue_kT The electron neutrino chemical potential divided by
+ *        kT.
+ * \param p_tables A pointer to the phase-space tables of the network, or
+ *        NULL.  If the tables hold the reaction, the rate is interpolated
+ *        from its table; otherwise it is computed by quadrature.
+ * \return The energy-loss rate (MeV per second).
+ */
+
 double
 aa522a25__compute_reaction_neutrino_energy_loss_rate(
   Libnucnet__Reaction * p_reaction,
@@ -743,167 +1113,29 @@ aa522a25__compute_reaction_neutrino_energy_loss_rate(
   double d_electron_mass,
   double d_t9,
   double d_eta_F,
-  double d_mu_nue_kT
+  double d_mu_nue_kT,
+  Aa522a25PhaseSpaceTables * p_tables
 )
 {
 
-  double d_result = 0, d_error, d_limit;
-  gsl_integration_workspace * p_work_space =
-    gsl_integration_workspace_alloc( (size_t) i_AA522A25_WORKSPACE );
-  gsl_function F;
-  aa522a25_function_data function_data;
-
-  function_data.dkT = nnt::compute_kT_in_MeV( d_t9 );
-
-  function_data.dEtaF = d_eta_F;
-
-  function_data.dMunuekT = d_mu_nue_kT;
-
-  function_data.iNeutrinoExponent = 3;
+  double d_rate_integral, d_energy_integral;
 
-  function_data.dQ =
-    nnt::compute_reaction_nuclear_Qvalue(
-      p_net,
-      p_reaction,
-      d_electron_mass
-    );
-
-  F.params = &function_data;
+  Aa522a25PhaseSpaceTable * p_table =
+    p_tables ? p_tables->getTable( p_reaction ) : NULL;
 
-  if( nnt::is_electron_capture_reaction( p_reaction ) )
+  if( p_table )
   {
-
-    F.function = &aa522a25__electron_capture_integrand;
-
-    function_data.dQ *= -1;
-
-    d_limit =
-      GSL_MAX_DBL(
-        function_data.dQ,
-        d_electron_mass
-      );
-
-    gsl_integration_qagiu(
-      &F,
-      d_limit,
-      d_AA522A25_EPSABS,
-      d_AA522A25_EPSREL,
-      (size_t) i_AA522A25_LIMIT,
-      p_work_space,
-      &d_result,
-      &d_error
+    p_table->interpolate(
+      d_t9, d_eta_F, d_mu_nue_kT, d_rate_integral, d_energy_integral
     );
-
-  }
-  else if( nnt::is_beta_plus_reaction( p_reaction ) )
-  {
-
-    F.function = &aa522a25__beta_plus_integrand;
-
-    function_data.dQ *= -1;
-
-    if( 
-      d_electron_mass > -function_data.dQ
-    )
-      d_result = 0.;
-    else
-      gsl_integration_qags(
-        &F,
-        d_electron_mass,
-        -function_data.dQ,
-        d_AA522A25_EPSABS,
-        d_AA522A25_EPSREL,
-        (size_t) i_AA522A25_LIMIT,
-        p_work_space,
-        &d_result,
-        &d_error
-      );
-
+    return d_energy_integral * p_table->getRatePrefactor();
   }
-  else if( nnt::is_positron_capture_reaction( p_reaction ) )
-  {
 
-    F.function = &aa522a25__positron_capture_integrand;
-
-    gsl_integration_qagiu(
-      &F,
-      GSL_MAX_DBL(
-        -function_data.dQ,
-        d_electron_mass
-      ),
-      d_AA522A25_EPSABS,
-      d_AA522A25_EPSREL,
-      (size_t) i_AA522A25_LIMIT,
-      p_work_space,
-      &d_result,
-      &d_error
-    );
-
-  }
-  else if( nnt::is_beta_minus_reaction( p_reaction ) )
-  {
-
-    F.function = &aa522a25__beta_minus_integrand;
-
-    if( 
-      d_electron_mass >
-      function_data.dQ
-    )
-      d_result = 0.;
-    else
-      gsl_integration_qags(
-        &F,
-        d_electron_mass,
-        function_data.dQ,
-        d_AA522A25_EPSABS,
-        d_AA522A25_EPSREL,
-        (size_t) i_AA522A25_LIMIT,
-        p_work_space,
-        &d_result,
-        &d_error
-      );
-
-  }
-  else
-  {
-    std::cerr <<
-      "No such rate for AA522A25 reaction rate function." << std::endl;
-    exit( EXIT_FAILURE );
-  }
-
-  gsl_integration_workspace_free( p_work_space );
-
-  if(
-      !Libnucnet__Reaction__getUserRateFunctionProperty(
-        p_reaction,
-        s_AA522A25_B_FACTOR,
-        NULL,
-        NULL
-      )
-  )
-  {
-    std::cerr <<
-      "No such user rate property." << std::endl;
-    exit( EXIT_FAILURE );
-  }
+  Aa522a25PhaseSpaceTable table( p_reaction, p_net, d_electron_mass );
 
   return
-    d_result *
-    atof(
-      Libnucnet__Reaction__getUserRateFunctionProperty(
-        p_reaction,
-        s_AA522A25_B_FACTOR,
-        NULL,
-        NULL
-      )
-    ) *
-    M_LN2 /
-    (
-      gsl_pow_5( d_electron_mass )
-      *
-      d_AA522A25_WEAK_K
-    );
-
+    table.computeIntegral( d_t9, d_eta_F, d_mu_nue_kT, 3 ) *
+    table.getRatePrefactor();
 
 }
 
@@ -911,6 +1143,23 @@ aa522a25__compute_reaction_neutrino_energy_loss_rate(
 // aa522a25__compute_reaction_average_neutrino_energy().
 //##############################################################################
 
+/**
+ * \brief Compute the average neutrino energy of an aa522a25 reaction.
+ * \param p_reaction A pointer to the reaction.
+ * \param p_net A pointer to the network containing the reaction.
+ * \param d_electron_mass The electron rest mass (MeV).
+ * \param d_t9 The t9.
+ * \param d_eta_F The electron chemical potential (including the rest mass)
+ *        divided by kT.
+ * \param d_mu_nue_kT The electron neutrino chemical potential divided by
+ *        kT.
+ * \param p_tables A pointer to the phase-space tables of the network, or
+ *        NULL.  If the tables hold the reaction, the integrals are
+ *        interpolated from its table; otherwise they are computed by
+ *        quadrature.
+ * \return The average energy (MeV).
+ */
+
 double
 aa522a25__compute_reaction_average_neutrino_energy(
   Libnucnet__Reaction * p_reaction,
@@ -918,39 +1167,36 @@ aa522a25__compute_reaction_average_neutrino_energy(
   double d_electron_mass,
   double d_t9,
   double d_eta_F,
-  double d_mu_nue_kT
+  double d_mu_nue_kT,
+  Aa522a25PhaseSpaceTables * p_tables
 )
 {
 
   double d_numerator, d_denominator;
 
-  d_denominator =
-    aa522a25__compute_integral(
-      p_reaction,
-      p_net,
-      d_electron_mass,
-      d_t9,
-      d_eta_F,
-      d_mu_nue_kT,
-      2
+  Aa522a25PhaseSpaceTable * p_table =
+    p_tables ? p_tables->getTable( p_reaction ) : NULL;
+
+  if( p_table )
+  {
+    p_table->interpolate(
+      d_t9, d_eta_F, d_mu_nue_kT, d_denominator, d_numerator
     );
+    if( d_denominator <= 0. ) return 0;
+    return d_numerator / d_denominator;
+  }
+
+  Aa522a25PhaseSpaceTable table( p_reaction, p_net, d_electron_mass );
+
+  d_denominator = table.computeIntegral( d_t9, d_eta_F, d_mu_nue_kT, 2 );
 
   if( GSL_SIGN( d_denominator ) == GSL_SIGN( -d_denominator ) )
     return 0;
 
-  d_numerator =
-    aa522a25__compute_integral(
-      p_reaction,
-      p_net,
-      d_electron_mass,
-      d_t9,
-      d_eta_F,
-      d_mu_nue_kT,
-      3
-    );
+  d_numerator = table.computeIntegral( d_t9, d_eta_F, d_mu_nue_kT, 3 );
 
   return d_numerator / d_denominator;
 
 }
-     
+
 } // namespace user
@@ -31,6 +31,14 @@
 #define NNT_AA522A25_H
 
 #include <iostream>
+#include <map>
+#include <string>
+
+#include <boost/unordered_map.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
 
 #include <Libnucnet.h>
 
@@ -50,6 +58,15 @@ const size_t i_AA522A25_LIMIT     = 1000;
 const double d_AA522A25_EC_CUTOFF = 1.e-100;
 const double d_AA522A25_EC_LIMIT  = 1.01;
 
+const double d_AA522A25_TABLE_LOG10_T9_STEP = 0.05;
+const double d_AA522A25_TABLE_ETA_STEP      = 0.25;
+const double d_AA522A25_TABLE_MU_NUE_STEP   = 0.25;
+
+const int i_AA522A25_ELECTRON_CAPTURE       = 0;
+const int i_AA522A25_BETA_PLUS              = 1;
+const int i_AA522A25_POSITRON_CAPTURE       = 2;
+const int i_AA522A25_BETA_MINUS             = 3;
+
 const char s_AA522A25_B_FACTOR[]            = "aa522a25 B factor";
 
 const char s_AA522A25[]                     = "aa522a25";
@@ -63,6 +80,95 @@ typedef struct
   int iNeutrinoExponent;
 } aa522a25_function_data;
 
+/**
+ * \brief The phase-space integrals (with neutrino energy exponents two and
+ *        three) at a node of an aa522a25 phase-space table, stored as
+ *        natural logarithms.
+ */
+
+typedef struct aa522a25_node_t
+{
+  double dLogRateIntegral;       //!< ln of the exponent-two integral.
+  double dLogEnergyIntegral;     //!< ln of the exponent-three integral.
+} aa522a25_node_t;
+
+//##############################################################################
+// Class for the phase-space table of an aa522a25 reaction.
+//##############################################################################
+
+/**
+ * \brief The constant data and the tabulated phase-space integrals of an
+ *        aa522a25 reaction.
+ *
+ * The weak channel, the Q value, and the rate prefactor (which includes
+ * the B factor) of a reaction are found once, when the table is created.
+ * The integrals are tabulated on a grid uniform in log10 t9, eta_F, and,
+ * when neutrinos block the final states, mu_nue / kT.  The grid is
+ * unbounded: a node is computed by quadrature the first time an
+ * interpolation needs it and is kept for later interpolations, so a table
+ * only holds the nodes near the conditions the reaction has seen.  The
+ * logarithms of the integrals are interpolated with four-point Lagrange
+ * polynomials in each direction.  A table is not locked, so a table whose
+ * nodes are filled by interpolate() must only be used by one thread.
+ */
+
+class Aa522a25PhaseSpaceTable : private boost::noncopyable
+{
+
+  public:
+    Aa522a25PhaseSpaceTable(
+      Libnucnet__Reaction *,
+      Libnucnet__Net *,
+      double
+    );
+    int getChannel() const { return iChannel; }
+    double getQ() const { return dQ; }
+    double getRatePrefactor() const { return dPrefactor; }
+    bool isAllowed() const { return bAllowed; }
+    size_t getNumberOfNodes() const { return nodeMap.size(); }
+    double computeIntegral( double, double, double, int ) const;
+    void interpolate( double, double, double, double&, double& );
+
+  private:
+    typedef boost::tuple<long, long, long> node_key_t;
+    double dElectronMass, dQ, dPrefactor;
+    int iChannel;
+    bool bAllowed;
+    std::map<node_key_t, aa522a25_node_t> nodeMap;
+    aa522a25_node_t computeNode( const node_key_t& ) const;
+
+};
+
+/**
+ * \brief The phase-space tables of all the aa522a25 reactions in a network.
+ *
+ * The tables are created together, for one electron mass, and are valid as
+ * long as the reactions and nuclei of the network are not updated.  A zone
+ * keeps its own set in its data and passes it to the aa522a25 rate function
+ * through the function's data, so the tables are found without locking and
+ * are never shared between threads.
+ */
+
+class Aa522a25PhaseSpaceTables : private boost::noncopyable
+{
+
+  public:
+    Aa522a25PhaseSpaceTables( Libnucnet__Net *, double );
+    bool isValidFor( Libnucnet__Net *, double ) const;
+    size_t getNumberOfTables() const { return table_map.size(); }
+    Aa522a25PhaseSpaceTable * getTable( const Libnucnet__Reaction * ) const;
+
+  private:
+    Libnucnet__Net * pNet;
+    double dElectronMass;
+    size_t iReacUpdate, iNucUpdate, iNetReactions;
+    boost::unordered_map<
+      const Libnucnet__Reaction *,
+      boost::shared_ptr<Aa522a25PhaseSpaceTable>
+    > table_map;
+
+};
+
 void
 aa522a25__update_net(
   Libnucnet__Net *,
@@ -87,7 +193,8 @@ aa522a25__compute_rate(
   double,
   double,
   double,
-  double
+  double,
+  Aa522a25PhaseSpaceTables * = NULL
 );
 
 double
@@ -132,7 +239,8 @@ aa522a25__compute_reaction_neutrino_energy_loss_rate(
   double,
   double,
   double,
-  double
+  double,
+  Aa522a25PhaseSpaceTables * = NULL
 );
 
 double
@@ -142,7 +250,8 @@ aa522a25__compute_reaction_average_neutrino_energy(
   double,
   double,
   double,
-  double
+  double,
+  Aa522a25PhaseSpaceTables * = NULL
 );
 
 } // namespace user
@@ -0,0 +1,1266 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the binary network, zone, and trajectory format.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "user/binary_data.h"
+#include "user/non_smoker_rate_kernel.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// get_section_data().
+//##############################################################################
+
+template<class T>
+const void *
+get_section_data( const std::vector<T>& v )
+{
+
+  return v.empty() ? NULL : &v[0];
+
+}
+
+//##############################################################################
+// add_binary_property().
+//##############################################################################
+
+void
+add_binary_property(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  const char * s_value,
+  BinaryDataWriter * p_writer
+)
+{
+
+  p_writer->addProperty( s_name, s_tag1, s_tag2, s_value );
+
+}
+
+//##############################################################################
+// BinaryDataWriter::BinaryDataWriter().
+//##############################################################################
+
+BinaryDataWriter::BinaryDataWriter() {}
+
+//##############################################################################
+// BinaryDataWriter::addString().
+//##############################################################################
+
+/**
+ * \brief Add a string to the string section.
+ * \param s_string The string.
+ * \return The offset of the string, or I_BINARY_DATA_NULL if the string is
+ *         NULL.
+ */
+
+uint64_t
+BinaryDataWriter::addString( const char * s_string )
+{
+
+  if( !s_string ) return I_BINARY_DATA_NULL;
+
+  boost::unordered_map<std::string, uint64_t>::iterator it =
+    string_map.find( s_string );
+
+  if( it != string_map.end() ) return it->second;
+
+  uint64_t i_offset = vStrings.size();
+
+  vStrings.insert( vStrings.end(), s_string, s_string + strlen( s_string ) );
+  vStrings.push_back( '\0' );
+
+  string_map[s_string] = i_offset;
+
+  return i_offset;
+
+}
+
+//##############################################################################
+// BinaryDataWriter::addDoubles().
+//##############################################################################
+
+/**
+ * \brief Add values to the double section.
+ * \param p_values The values.
+ * \param i_count The number of values.
+ * \return The index of the first value.
+ */
+
+uint64_t
+BinaryDataWriter::addDoubles( const double * p_values, size_t i_count )
+{
+
+  uint64_t i_offset = vDoubles.size();
+
+  vDoubles.insert( vDoubles.end(), p_values, p_values + i_count );
+
+  return i_offset;
+
+}
+
+//##############################################################################
+// BinaryDataWriter::addProperty().
+//##############################################################################
+
+/**
+ * \brief Add a property to the property section.
+ * \param s_name The property name.
+ * \param s_tag1 The first tag (may be NULL).
+ * \param s_tag2 The second tag (may be NULL).
+ * \param s_value The value.
+ */
+
+void
+BinaryDataWriter::addProperty(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  const char * s_value
+)
+{
+
+  binary_property_t property;
+
+  property.iName = addString( s_name );
+  property.iTag1 = addString( s_tag1 );
+  property.iTag2 = addString( s_tag2 );
+  property.iValue = addString( s_value );
+
+  vProperties.push_back( property );
+
+}
+
+//##############################################################################
+// BinaryDataWriter::addNet().
+//##############################################################################
+
+/**
+ * \brief Add the species and reactions of a network.
+ * \param p_net The network.
+ */
+
+void
+BinaryDataWriter::addNet( Libnucnet__Net * p_net )
+{
+
+  //============================================================================
+  // Species.
+  //============================================================================
+
+  BOOST_FOREACH(
+    nnt::Species species,
+    nnt::make_species_list( Libnucnet__Net__getNuc( p_net ) )
+  )
+  {
+
+    Libnucnet__Species * p_species = species.getNucnetSpecies();
+
+    binary_species_t record;
+
+    record.iZ = Libnucnet__Species__getZ( p_species );
+    record.iA = Libnucnet__Species__getA( p_species );
+    record.iSource = addString( Libnucnet__Species__getSource( p_species ) );
+    record.iState =
+      addString( Libnucnet__Species__getStateString( p_species ) );
+    record.dMassExcess = Libnucnet__Species__getMassExcess( p_species );
+    record.dSpin = Libnucnet__Species__getSpin( p_species );
+
+    gsl_vector * p_t9 = Libnucnet__Species__getPartitionFunctionT9( p_species );
+    gsl_vector * p_log10_partf =
+      Libnucnet__Species__getPartitionFunctionLog10( p_species );
+
+    record.iPartf = vDoubles.size();
+    record.iPartfPoints = p_t9 ? p_t9->size : 0;
+
+    for( size_t i = 0; i < record.iPartfPoints; i++ )
+      vDoubles.push_back( gsl_vector_get( p_t9, i ) );
+    for( size_t i = 0; i < record.iPartfPoints; i++ )
+      vDoubles.push_back( gsl_vector_get( p_log10_partf, i ) );
+
+    vSpecies.push_back( record );
+
+  }
+
+  //============================================================================
+  // Reactions.
+  //============================================================================
+
+  BOOST_FOREACH(
+    nnt::Reaction reaction,
+    nnt::make_reaction_list( Libnucnet__Net__getReac( p_net ) )
+  )
+  {
+
+    Libnucnet__Reaction * p_reaction = reaction.getNucnetReaction();
+
+    const char * s_key = Libnucnet__Reaction__getRateFunctionKey( p_reaction );
+
+    Libnucnet__Reaction__RateData * p_rd = p_reaction->pRd;
+
+    if( !s_key || !p_rd ) continue;
+
+    binary_reaction_t record = binary_reaction_t();
+
+    record.iSource = addString( Libnucnet__Reaction__getSource( p_reaction ) );
+    record.iKey = addString( s_key );
+    record.iElements = vElements.size();
+    record.iData = vDoubles.size();
+    record.iFits = vFits.size();
+    record.iProperties = vProperties.size();
+
+    BOOST_FOREACH(
+      nnt::ReactionElement element,
+      nnt::make_reaction_reactant_list( p_reaction )
+    )
+    {
+      vElements.push_back(
+        addString(
+          Libnucnet__Reaction__Element__getName(
+            element.getNucnetReactionElement()
+          )
+        )
+      );
+      record.iReactants++;
+    }
+
+    BOOST_FOREACH(
+      nnt::ReactionElement element,
+      nnt::make_reaction_product_list( p_reaction )
+    )
+    {
+      vElements.push_back(
+        addString(
+          Libnucnet__Reaction__Element__getName(
+            element.getNucnetReactionElement()
+          )
+        )
+      );
+      record.iProducts++;
+    }
+
+    if( strcmp( s_key, SINGLE_RATE_STRING ) == 0 && p_rd->pSingle )
+    {
+      addDoubles( &p_rd->pSingle->dSingleRate, 1 );
+      record.iDataPoints = 1;
+    }
+    else if( strcmp( s_key, RATE_TABLE_STRING ) == 0 && p_rd->pRt )
+    {
+      record.iDataPoints = p_rd->pRt->pT9->size;
+      for( size_t i = 0; i < record.iDataPoints; i++ )
+        vDoubles.push_back( gsl_vector_get( p_rd->pRt->pT9, i ) );
+      for( size_t i = 0; i < record.iDataPoints; i++ )
+        vDoubles.push_back( gsl_vector_get( p_rd->pRt->pRate, i ) );
+      for( size_t i = 0; i < record.iDataPoints; i++ )
+        vDoubles.push_back( gsl_vector_get( p_rd->pRt->pSef, i ) );
+    }
+    else if( strcmp( s_key, NON_SMOKER_STRING ) == 0 && p_rd->pNsfHash )
+    {
+
+      std::vector<Libnucnet__Reaction__NonSmokerFit *> v_fits;
+
+      xmlHashScan(
+        p_rd->pNsfHash,
+        (xmlHashScanner) collect_non_smoker_fit,
+        &v_fits
+      );
+
+      BOOST_FOREACH( Libnucnet__Reaction__NonSmokerFit * p_fit, v_fits )
+      {
+        binary_non_smoker_fit_t fit;
+        fit.iNote = addString( (const char *) p_fit->sxNote );
+        for( size_t i = 0; i < I_NSF; i++ ) fit.a[i] = p_fit->a[i];
+        fit.dSpint = *p_fit->pSpint;
+        fit.dSpinf = *p_fit->pSpinf;
+        fit.dTlowHf = *p_fit->pTlowHf;
+        fit.dTlowfit = *p_fit->pTlowfit;
+        fit.dThighfit = *p_fit->pThighfit;
+        fit.dAcc = *p_fit->pAcc;
+        vFits.push_back( fit );
+      }
+
+      record.iFitCount = v_fits.size();
+
+    }
+    else
+    {
+
+      Libnucnet__Reaction__iterateUserRateFunctionProperties(
+        p_reaction,
+        NULL,
+        NULL,
+        NULL,
+        (Libnucnet__Reaction__user_rate_property_iterate_function)
+          add_binary_property,
+        this
+      );
+
+      record.iPropertyCount = vProperties.size() - record.iProperties;
+
+    }
+
+    vReactions.push_back( record );
+
+  }
+
+}
+
+//##############################################################################
+// BinaryDataWriter::addZones().
+//##############################################################################
+
+/**
+ * \brief Add the labels, properties, and non-zero abundances of the zones.
+ * \param p_nucnet The Libnucnet structure with the zones.
+ */
+
+void
+BinaryDataWriter::addZones( Libnucnet * p_nucnet )
+{
+
+  nnt::species_list_t species_list =
+    nnt::make_species_list(
+      Libnucnet__Net__getNuc( Libnucnet__getNet( p_nucnet ) )
+    );
+
+  nnt::zone_list_t zone_list = nnt::make_zone_list( p_nucnet );
+
+  BOOST_FOREACH( nnt::Zone& zone, zone_list )
+  {
+
+    binary_zone_t record;
+
+    for( int i = 0; i < 3; i++ )
+      record.iLabel[i] =
+        addString( Libnucnet__Zone__getLabel( zone.getNucnetZone(), i + 1 ) );
+
+    record.iProperties = vProperties.size();
+
+    Libnucnet__Zone__iterateOptionalProperties(
+      zone.getNucnetZone(),
+      NULL,
+      NULL,
+      NULL,
+      (Libnucnet__Zone__optional_property_iterate_function)
+        add_binary_property,
+      this
+    );
+
+    record.iPropertyCount = vProperties.size() - record.iProperties;
+
+    record.iAbundances = vAbundances.size();
+
+    BOOST_FOREACH( nnt::Species species, species_list )
+    {
+
+      binary_abundance_t abundance;
+
+      abundance.dAbundance =
+        Libnucnet__Zone__getSpeciesAbundance(
+          zone.getNucnetZone(),
+          species.getNucnetSpecies()
+        );
+
+      if( abundance.dAbundance == 0. ) continue;
+
+      abundance.iSpecies =
+        addString( Libnucnet__Species__getName( species.getNucnetSpecies() ) );
+
+      vAbundances.push_back( abundance );
+
+    }
+
+    record.iAbundanceCount = vAbundances.size() - record.iAbundances;
+
+    vZones.push_back( record );
+
+  }
+
+}
+
+//##############################################################################
+// BinaryDataWriter::addTrajectory().
+//##############################################################################
+
+/**
+ * \brief Add a trajectory, stored as time, t9, and log10 rho columns.
+ * \param time The times.
+ * \param t9 The t9 values.
+ * \param log10_rho The log10 mass densities (g/cc).
+ */
+
+void
+BinaryDataWriter::addTrajectory(
+  const std::vector<double>& time,
+  const std::vector<double>& t9,
+  const std::vector<double>& log10_rho
+)
+{
+
+  if( t9.size() != time.size() || log10_rho.size() != time.size() )
+  {
+    std::cerr << "Invalid trajectory." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  vTime = time;
+  vT9 = t9;
+  vLog10Rho = log10_rho;
+
+}
+
+//##############################################################################
+// BinaryDataWriter::write().
+//##############################################################################
+
+/**
+ * \brief Write the header, the offset table, and the non-empty sections.
+ * \param s_file The name of the output file.
+ */
+
+void
+BinaryDataWriter::write( const char * s_file ) const
+{
+
+  typedef struct
+  {
+    int iType;
+    size_t iRecordSize;
+    const void * pData;
+    size_t iCount;
+  } section_data_t;
+
+  section_data_t v_all[] =
+  {
+    {
+      BINARY_STRINGS,
+      1,
+      get_section_data( vStrings ),
+      vStrings.size()
+    },
+    {
+      BINARY_DOUBLES,
+      sizeof( double ),
+      get_section_data( vDoubles ),
+      vDoubles.size()
+    },
+    {
+      BINARY_SPECIES,
+      sizeof( binary_species_t ),
+      get_section_data( vSpecies ),
+      vSpecies.size()
+    },
+    {
+      BINARY_REACTIONS,
+      sizeof( binary_reaction_t ),
+      get_section_data( vReactions ),
+      vReactions.size()
+    },
+    {
+      BINARY_REACTION_ELEMENTS,
+      sizeof( uint64_t ),
+      get_section_data( vElements ),
+      vElements.size()
+    },
+    {
+      BINARY_NON_SMOKER_FITS,
+      sizeof( binary_non_smoker_fit_t ),
+      get_section_data( vFits ),
+      vFits.size()
+    },
+    {
+      BINARY_PROPERTIES,
+      sizeof( binary_property_t ),
+      get_section_data( vProperties ),
+      vProperties.size()
+    },
+    {
+      BINARY_ZONES,
+      sizeof( binary_zone_t ),
+      get_section_data( vZones ),
+      vZones.size()
+    },
+    {
+      BINARY_ABUNDANCES,
+      sizeof( binary_abundance_t ),
+      get_section_data( vAbundances ),
+      vAbundances.size()
+    },
+    {
+      BINARY_TRAJECTORY_TIME,
+      sizeof( double ),
+      get_section_data( vTime ),
+      vTime.size()
+    },
+    {
+      BINARY_TRAJECTORY_T9,
+      sizeof( double ),
+      get_section_data( vT9 ),
+      vT9.size()
+    },
+    {
+      BINARY_TRAJECTORY_LOG10_RHO,
+      sizeof( double ),
+      get_section_data( vLog10Rho ),
+      vLog10Rho.size()
+    }
+  };
+
+  std::vector<section_data_t> v_sections;
+
+  for( size_t i = 0; i < sizeof( v_all ) / sizeof( v_all[0] ); i++ )
+    if( v_all[i].iCount > 0 ) v_sections.push_back( v_all[i] );
+
+  //============================================================================
+  // Header and offset table.
+  //============================================================================
+
+  binary_data_header_t header;
+
+  memset( &header, 0, sizeof( header ) );
+  strncpy( header.sMagic, S_BINARY_DATA_MAGIC, sizeof( header.sMagic ) );
+  header.iByteOrder = I_BINARY_DATA_BYTE_ORDER;
+  header.iVersion = I_BINARY_DATA_VERSION;
+  header.iSections = v_sections.size();
+
+  std::vector<binary_data_section_t> v_table( v_sections.size() );
+
+  uint64_t i_offset =
+    sizeof( header ) + v_sections.size() * sizeof( binary_data_section_t );
+
+  for( size_t i = 0; i < v_sections.size(); i++ )
+  {
+    v_table[i].iType = v_sections[i].iType;
+    v_table[i].iRecordSize = v_sections[i].iRecordSize;
+    v_table[i].iOffset = i_offset;
+    v_table[i].iCount = v_sections[i].iCount;
+    i_offset +=
+      ( ( v_sections[i].iCount * v_sections[i].iRecordSize + 7 ) / 8 ) * 8;
+  }
+
+  //============================================================================
+  // Write.
+  //============================================================================
+
+  FILE * p_file = fopen( s_file, "wb" );
+
+  if( !p_file )
+  {
+    std::cerr << "Couldn't open file " << s_file << "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  const char v_pad[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+  bool b_ok = fwrite( &header, sizeof( header ), 1, p_file ) == 1;
+
+  if( !v_table.empty() )
+    b_ok &=
+      fwrite(
+        &v_table[0], sizeof( binary_data_section_t ), v_table.size(), p_file
+      ) == v_table.size();
+
+  for( size_t i = 0; i < v_sections.size(); i++ )
+  {
+    size_t i_bytes = v_sections[i].iCount * v_sections[i].iRecordSize;
+    b_ok &= fwrite( v_sections[i].pData, 1, i_bytes, p_file ) == i_bytes;
+    if( i_bytes % 8 )
+      b_ok &=
+        fwrite( v_pad, 1, 8 - i_bytes % 8, p_file ) == 8 - i_bytes % 8;
+  }
+
+  if( fclose( p_file ) != 0 || !b_ok )
+  {
+    std::cerr << "Couldn't write file " << s_file << "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+}
+
+//##############################################################################
+// BinaryDataFile::BinaryDataFile().
+//##############################################################################
+
+/**
+ * \brief Map a binary data file into memory and check its header and offset
+ *        table.
+ * \param s_file The name of the file.
+ */
+
+BinaryDataFile::BinaryDataFile( const char * s_file ) : sFile( s_file )
+{
+
+  struct stat file_stat;
+
+  int i_fd = open( s_file, O_RDONLY );
+
+  if( i_fd < 0 || fstat( i_fd, &file_stat ) != 0 )
+  {
+    std::cerr << "Couldn't open file " << s_file << "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  iSize = file_stat.st_size;
+
+  if( iSize < sizeof( binary_data_header_t ) )
+  {
+    std::cerr << s_file << " is not a binary data file." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  void * p_map = mmap( NULL, iSize, PROT_READ, MAP_PRIVATE, i_fd, 0 );
+
+  close( i_fd );
+
+  if( p_map == MAP_FAILED )
+  {
+    std::cerr << "Couldn't map file " << s_file << "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  pData = (const char *) p_map;
+
+  //============================================================================
+  // Check header.
+  //============================================================================
+
+  const binary_data_header_t * p_header =
+    reinterpret_cast<const binary_data_header_t *>( pData );
+
+  if( strncmp( p_header->sMagic, S_BINARY_DATA_MAGIC, 8 ) != 0 )
+  {
+    std::cerr << s_file << " is not a binary data file." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  if( p_header->iByteOrder != I_BINARY_DATA_BYTE_ORDER )
+  {
+    std::cerr << s_file << " was written with a different byte order." <<
+      std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  if( p_header->iVersion != I_BINARY_DATA_VERSION )
+  {
+    std::cerr << s_file << " has unsupported version " <<
+      p_header->iVersion << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  //============================================================================
+  // Check offset table.
+  //============================================================================
+
+  if(
+    p_header->iSections >
+      ( iSize - sizeof( binary_data_header_t ) ) /
+      sizeof( binary_data_section_t )
+  )
+  {
+    std::cerr << "Invalid offset table in " << s_file << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  const binary_data_section_t * p_table =
+    reinterpret_cast<const binary_data_section_t *>(
+      pData + sizeof( binary_data_header_t )
+    );
+
+  for( size_t i = 0; i < p_header->iSections; i++ )
+  {
+    if(
+      p_table[i].iRecordSize == 0 ||
+      p_table[i].iOffset % 8 != 0 ||
+      p_table[i].iOffset > iSize ||
+      p_table[i].iCount > ( iSize - p_table[i].iOffset ) /
+        p_table[i].iRecordSize
+    )
+    {
+      std::cerr << "Invalid section in " << s_file << "." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  uint64_t i_strings;
+  const char * p_strings = getRecords<char>( BINARY_STRINGS, i_strings );
+
+  if( p_strings && p_strings[i_strings - 1] != '\0' )
+  {
+    std::cerr << "Invalid string section in " << s_file << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+}
+
+//##############################################################################
+// BinaryDataFile::~BinaryDataFile().
+//##############################################################################
+
+BinaryDataFile::~BinaryDataFile()
+{
+
+  munmap( const_cast<char *>( pData ), iSize );
+
+}
+
+//##############################################################################
+// BinaryDataFile::getSection().
+//##############################################################################
+
+const binary_data_section_t *
+BinaryDataFile::getSection( int i_type ) const
+{
+
+  const binary_data_header_t * p_header =
+    reinterpret_cast<const binary_data_header_t *>( pData );
+
+  const binary_data_section_t * p_table =
+    reinterpret_cast<const binary_data_section_t *>(
+      pData + sizeof( binary_data_header_t )
+    );
+
+  for( size_t i = 0; i < p_header->iSections; i++ )
+    if( (int) p_table[i].iType == i_type ) return &p_table[i];
+
+  return NULL;
+
+}
+
+//##############################################################################
+// BinaryDataFile::hasSection().
+//##############################################################################
+
+bool
+BinaryDataFile::hasSection( int i_type ) const
+{
+
+  return getSection( i_type ) != NULL;
+
+}
+
+//##############################################################################
+// BinaryDataFile::getString().
+//##############################################################################
+
+/**
+ * \brief Get a string from the string section.  The string must be
+ *        terminated within the section.
+ * \param i_offset The offset of the string.
+ * \return The string, or NULL for I_BINARY_DATA_NULL.
+ */
+
+const char *
+BinaryDataFile::getString( uint64_t i_offset ) const
+{
+
+  uint64_t i_count;
+
+  if( i_offset == I_BINARY_DATA_NULL ) return NULL;
+
+  const char * p_strings = getRecords<char>( BINARY_STRINGS, i_count );
+
+  if(
+    i_offset >= i_count ||
+    !memchr( p_strings + i_offset, '\0', i_count - i_offset )
+  )
+  {
+    std::cerr << "Invalid string in " << sFile << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  return p_strings + i_offset;
+
+}
+
+//##############################################################################
+// BinaryDataFile::getDoubles().
+//##############################################################################
+
+/**
+ * \brief Get values from the double section.
+ * \param i_index The index of the first value.
+ * \param i_values The number of values.
+ * \return A pointer to the first value.
+ */
+
+const double *
+BinaryDataFile::getDoubles( uint64_t i_index, uint64_t i_values ) const
+{
+
+  uint64_t i_count;
+
+  const double * p_doubles = getRecords<double>( BINARY_DOUBLES, i_count );
+
+  if( i_index > i_count || i_values > i_count - i_index )
+  {
+    std::cerr << "Invalid data in " << sFile << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  return p_doubles + i_index;
+
+}
+
+//##############################################################################
+// is_binary_data_file().
+//##############################################################################
+
+/**
+ * \brief Check whether a file is a binary data file.
+ * \param s_file The name of the file.
+ * \return True if the file begins with the binary data magic string, false
+ *         if not or if it cannot be read.
+ */
+
+bool
+is_binary_data_file( const char * s_file )
+{
+
+  char s_magic[8];
+
+  FILE * p_file = fopen( s_file, "rb" );
+
+  if( !p_file ) return false;
+
+  bool b_result =
+    fread( s_magic, 1, sizeof( s_magic ), p_file ) == sizeof( s_magic ) &&
+    strncmp( s_magic, S_BINARY_DATA_MAGIC, sizeof( s_magic ) ) == 0;
+
+  fclose( p_file );
+
+  return b_result;
+
+}
+
+//##############################################################################
+// get_binary_data_selector().
+//##############################################################################
+
+boost::shared_ptr<nnt::ViewSelector>
+get_binary_data_selector(
+  const char * s_xpath,
+  nnt::view_selector_targets i_target
+)
+{
+
+  boost::shared_ptr<nnt::ViewSelector> p_selector =
+    nnt::get_view_selector( s_xpath ? s_xpath : "", i_target );
+
+  if( !p_selector->isCompiled() )
+  {
+    std::cerr << "XPath expression " << s_xpath <<
+      " cannot be applied to binary data." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  return p_selector;
+
+}
+
+//##############################################################################
+// update_net_from_binary_data().
+//##############################################################################
+
+/**
+ * \brief Update a network with the species and reactions in a binary data
+ *        file.
+ * \param p_net The network.
+ * \param s_file The name of the binary data file.
+ * \param s_nuc_xpath An XPath expression selecting the species (may be
+ *        NULL).  Only the expressions nnt::ViewSelector compiles are allowed.
+ * \param s_reac_xpath An XPath expression selecting the reactions (may be
+ *        NULL), with the same restriction.
+ */
+
+void
+update_net_from_binary_data(
+  Libnucnet__Net * p_net,
+  const char * s_file,
+  const char * s_nuc_xpath,
+  const char * s_reac_xpath
+)
+{
+
+  BinaryDataFile data( s_file );
+
+  uint64_t i_count;
+
+  Libnucnet__Nuc * p_nuc = Libnucnet__Net__getNuc( p_net );
+  Libnucnet__Reac * p_reac = Libnucnet__Net__getReac( p_net );
+
+  boost::shared_ptr<nnt::ViewSelector> p_nuc_selector =
+    get_binary_data_selector( s_nuc_xpath, nnt::NUCLIDE_SELECTOR );
+  boost::shared_ptr<nnt::ViewSelector> p_reac_selector =
+    get_binary_data_selector( s_reac_xpath, nnt::REACTION_SELECTOR );
+
+  //============================================================================
+  // Species.
+  //============================================================================
+
+  const binary_species_t * p_species_records =
+    data.getRecords<binary_species_t>( BINARY_SPECIES, i_count );
+
+  for( size_t i = 0; i < i_count; i++ )
+  {
+
+    const binary_species_t& record = p_species_records[i];
+
+    gsl_vector * p_t9 = NULL, * p_log10_partf = NULL;
+    gsl_vector_view t9_view, log10_partf_view;
+
+    if( record.iPartfPoints > 0 )
+    {
+      double * p_partf =
+        const_cast<double *>(
+          data.getDoubles( record.iPartf, 2 * record.iPartfPoints )
+        );
+      t9_view = gsl_vector_view_array( p_partf, record.iPartfPoints );
+      log10_partf_view =
+        gsl_vector_view_array(
+          p_partf + record.iPartfPoints, record.iPartfPoints
+        );
+      p_t9 = &t9_view.vector;
+      p_log10_partf = &log10_partf_view.vector;
+    }
+
+    const char * s_state = data.getString( record.iState );
+
+    Libnucnet__Species * p_species =
+      Libnucnet__Species__new(
+        record.iZ,
+        record.iA,
+        data.getString( record.iSource ),
+        s_state ? 1 : 0,
+        s_state,
+        record.dMassExcess,
+        record.dSpin,
+        p_t9,
+        p_log10_partf
+      );
+
+    if( !p_nuc_selector->isSelected( p_species ) )
+    {
+      Libnucnet__Species__free( p_species );
+      continue;
+    }
+
+    if( !Libnucnet__Nuc__updateSpecies( p_nuc, p_species ) )
+    {
+      std::cerr << "Couldn't update species." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+  }
+
+  //============================================================================
+  // Reactions.
+  //============================================================================
+
+  uint64_t i_elements, i_fits, i_properties;
+
+  const binary_reaction_t * p_reaction_records =
+    data.getRecords<binary_reaction_t>( BINARY_REACTIONS, i_count );
+  const uint64_t * p_elements =
+    data.getRecords<uint64_t>( BINARY_REACTION_ELEMENTS, i_elements );
+  const binary_non_smoker_fit_t * p_fits =
+    data.getRecords<binary_non_smoker_fit_t>( BINARY_NON_SMOKER_FITS, i_fits );
+  const binary_property_t * p_properties =
+    data.getRecords<binary_property_t>( BINARY_PROPERTIES, i_properties );
+
+  for( size_t i = 0; i < i_count; i++ )
+  {
+
+    const binary_reaction_t& record = p_reaction_records[i];
+
+    const char * s_key = data.getString( record.iKey );
+
+    if(
+      !s_key ||
+      record.iElements > i_elements ||
+      (uint64_t) record.iReactants + record.iProducts >
+        i_elements - record.iElements ||
+      record.iFits > i_fits ||
+      record.iFitCount > i_fits - record.iFits ||
+      record.iProperties > i_properties ||
+      record.iPropertyCount > i_properties - record.iProperties
+    )
+    {
+      std::cerr << "Invalid reaction in " << s_file << "." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+    Libnucnet__Reaction * p_reaction = Libnucnet__Reaction__new();
+
+    if( record.iSource != I_BINARY_DATA_NULL )
+      Libnucnet__Reaction__updateSource(
+        p_reaction, data.getString( record.iSource )
+      );
+
+    for( size_t j = 0; j < record.iReactants; j++ )
+      Libnucnet__Reaction__addReactant(
+        p_reaction, data.getString( p_elements[record.iElements + j] )
+      );
+
+    for( size_t j = 0; j < record.iProducts; j++ )
+      Libnucnet__Reaction__addProduct(
+        p_reaction,
+        data.getString( p_elements[record.iElements + record.iReactants + j] )
+      );
+
+    if( strcmp( s_key, SINGLE_RATE_STRING ) == 0 )
+    {
+      Libnucnet__Reaction__updateSingleRate(
+        p_reaction, *data.getDoubles( record.iData, 1 )
+      );
+    }
+    else if( strcmp( s_key, RATE_TABLE_STRING ) == 0 )
+    {
+      if( record.iDataPoints == 0 )
+      {
+        std::cerr << "Empty rate table in " << s_file << "." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+      double * p_table =
+        const_cast<double *>(
+          data.getDoubles( record.iData, 3 * record.iDataPoints )
+        );
+      gsl_vector_view t9_view =
+        gsl_vector_view_array( p_table, record.iDataPoints );
+      gsl_vector_view rate_view =
+        gsl_vector_view_array(
+          p_table + record.iDataPoints, record.iDataPoints
+        );
+      gsl_vector_view sef_view =
+        gsl_vector_view_array(
+          p_table + 2 * record.iDataPoints, record.iDataPoints
+        );
+      Libnucnet__Reaction__updateRateTable(
+        p_reaction, &t9_view.vector, &rate_view.vector, &sef_view.vector
+      );
+    }
+    else if( strcmp( s_key, NON_SMOKER_STRING ) == 0 )
+    {
+      for( size_t j = record.iFits; j < record.iFits + record.iFitCount; j++ )
+      {
+        double * a = (double *) malloc( sizeof( double ) * I_NSF );
+        memcpy( a, p_fits[j].a, sizeof( double ) * I_NSF );
+        Libnucnet__Reaction__addNonSmokerFit(
+          p_reaction,
+          data.getString( p_fits[j].iNote ),
+          a,
+          p_fits[j].dSpint,
+          p_fits[j].dSpinf,
+          p_fits[j].dTlowHf,
+          p_fits[j].dTlowfit,
+          p_fits[j].dThighfit,
+          p_fits[j].dAcc
+        );
+      }
+    }
+    else
+    {
+      Libnucnet__Reaction__setUserRateFunctionKey( p_reaction, s_key );
+      for(
+        size_t j = record.iProperties;
+        j < record.iProperties + record.iPropertyCount;
+        j++
+      )
+        Libnucnet__Reaction__updateUserRateFunctionProperty(
+          p_reaction,
+          data.getString( p_properties[j].iName ),
+          data.getString( p_properties[j].iTag1 ),
+          data.getString( p_properties[j].iTag2 ),
+          data.getString( p_properties[j].iValue )
+        );
+    }
+
+    if( !p_reac_selector->isSelected( p_reaction ) )
+    {
+      Libnucnet__Reaction__free( p_reaction );
+      continue;
+    }
+
+    if( !Libnucnet__Reac__updateReaction( p_reac, p_reaction ) )
+    {
+      std::cerr << "Couldn't update reaction." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+  }
+
+}
+
+//##############################################################################
+// assign_zone_data_from_binary_data().
+//##############################################################################
+
+/**
+ * \brief Create the zones in a binary data file.  The network must already
+ *        contain the species with non-zero abundances in the zones.
+ * \param p_nucnet The Libnucnet structure.
+ * \param s_file The name of the binary data file.
+ */
+
+void
+assign_zone_data_from_binary_data( Libnucnet * p_nucnet, const char * s_file )
+{
+
+  BinaryDataFile data( s_file );
+
+  uint64_t i_count, i_properties, i_abundances;
+
+  Libnucnet__Nuc * p_nuc =
+    Libnucnet__Net__getNuc( Libnucnet__getNet( p_nucnet ) );
+
+  const binary_zone_t * p_zones =
+    data.getRecords<binary_zone_t>( BINARY_ZONES, i_count );
+  const binary_property_t * p_properties =
+    data.getRecords<binary_property_t>( BINARY_PROPERTIES, i_properties );
+  const binary_abundance_t * p_abundances =
+    data.getRecords<binary_abundance_t>( BINARY_ABUNDANCES, i_abundances );
+
+  for( size_t i = 0; i < i_count; i++ )
+  {
+
+    const binary_zone_t& record = p_zones[i];
+
+    if(
+      record.iProperties > i_properties ||
+      record.iPropertyCount > i_properties - record.iProperties ||
+      record.iAbundances > i_abundances ||
+      record.iAbundanceCount > i_abundances - record.iAbundances
+    )
+    {
+      std::cerr << "Invalid zone in " << s_file << "." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+    Libnucnet__Zone * p_zone =
+      Libnucnet__Zone__new(
+        Libnucnet__getNet( p_nucnet ),
+        data.getString( record.iLabel[0] ),
+        data.getString( record.iLabel[1] ),
+        data.getString( record.iLabel[2] )
+      );
+
+    for(
+      size_t j = record.iProperties;
+      j < record.iProperties + record.iPropertyCount;
+      j++
+    )
+      Libnucnet__Zone__updateProperty(
+        p_zone,
+        data.getString( p_properties[j].iName ),
+        data.getString( p_properties[j].iTag1 ),
+        data.getString( p_properties[j].iTag2 ),
+        data.getString( p_properties[j].iValue )
+      );
+
+    for(
+      size_t j = record.iAbundances;
+      j < record.iAbundances + record.iAbundanceCount;
+      j++
+    )
+    {
+
+      const char * s_species = data.getString( p_abundances[j].iSpecies );
+
+      Libnucnet__Species * p_species =
+        Libnucnet__Nuc__getSpeciesByName( p_nuc, s_species );
+
+      if( !p_species )
+      {
+        std::cerr << "Species " << s_species << " not present." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+
+      Libnucnet__Zone__updateSpeciesAbundance(
+        p_zone, p_species, p_abundances[j].dAbundance
+      );
+
+    }
+
+    if( !Libnucnet__addZone( p_nucnet, p_zone ) )
+    {
+      std::cerr << "Couldn't add zone." << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+  }
+
+}
+
+//##############################################################################
+// get_trajectory_from_binary_data().
+//##############################################################################
+
+/**
+ * \brief Get the trajectory columns in a binary data file.
+ * \param s_file The name of the binary data file.
+ * \param time On return, the times.
+ * \param t9 On return, the t9 values.
+ * \param log10_rho On return, the log10 mass densities (g/cc).
+ */
+
+void
+get_trajectory_from_binary_data(
+  const char * s_file,
+  std::vector<double>& time,
+  std::vector<double>& t9,
+  std::vector<double>& log10_rho
+)
+{
+
+  BinaryDataFile data( s_file );
+
+  uint64_t i_time, i_t9, i_log10_rho;
+
+  const double * p_time =
+    data.getRecords<double>( BINARY_TRAJECTORY_TIME, i_time );
+  const double * p_t9 =
+    data.getRecords<double>( BINARY_TRAJECTORY_T9, i_t9 );
+  const double * p_log10_rho =
+    data.getRecords<double>( BINARY_TRAJECTORY_LOG10_RHO, i_log10_rho );
+
+  if( !p_time || i_t9 != i_time || i_log10_rho != i_time )
+  {
+    std::cerr << "No valid trajectory in " << s_file << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  time.assign( p_time, p_time + i_time );
+  t9.assign( p_t9, p_t9 + i_t9 );
+  log10_rho.assign( p_log10_rho, p_log10_rho + i_log10_rho );
+
+}
+
+} // namespace user
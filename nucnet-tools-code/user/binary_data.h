@@ -0,0 +1,352 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the binary network, zone, and trajectory
+//!        format.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINARY_DATA_H
+#define BINARY_DATA_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <stdint.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+#include "nnt/view_selector.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define S_BINARY_DATA_MAGIC          "NNTBIN"
+#define I_BINARY_DATA_VERSION        1
+#define I_BINARY_DATA_BYTE_ORDER     0x01020304
+#define I_BINARY_DATA_NULL           (~(uint64_t) 0)
+
+namespace user
+{
+
+//##############################################################################
+// Section types.
+//##############################################################################
+
+enum binary_data_sections
+{
+  BINARY_STRINGS = 1,
+  BINARY_DOUBLES,
+  BINARY_SPECIES,
+  BINARY_REACTIONS,
+  BINARY_REACTION_ELEMENTS,
+  BINARY_NON_SMOKER_FITS,
+  BINARY_PROPERTIES,
+  BINARY_ZONES,
+  BINARY_ABUNDANCES,
+  BINARY_TRAJECTORY_TIME,
+  BINARY_TRAJECTORY_T9,
+  BINARY_TRAJECTORY_LOG10_RHO
+};
+
+//##############################################################################
+// File layout.
+//##############################################################################
+
+/**
+ * \brief The file header.  The byte order is written as
+ *        I_BINARY_DATA_BYTE_ORDER in the writer's byte order.  A file read on a
+ *        machine with a different byte order or written with a different
+ *        version is rejected.
+ */
+
+typedef struct binary_data_header_t
+{
+  char sMagic[8];
+  uint32_t iByteOrder;
+  uint32_t iVersion;
+  uint64_t iSections;
+} binary_data_header_t;
+
+/**
+ * \brief An entry of the offset table that follows the header.  The offset
+ *        is from the start of the file and is a multiple of eight; the
+ *        record size lets the reader check the record layout.
+ */
+
+typedef struct binary_data_section_t
+{
+  uint32_t iType;
+  uint32_t iRecordSize;
+  uint64_t iOffset;
+  uint64_t iCount;
+} binary_data_section_t;
+
+//##############################################################################
+// Records.  Strings are offsets into the string section, with
+// I_BINARY_DATA_NULL for none.  Arrays are index ranges into the double or
+// other record sections.
+//##############################################################################
+
+/**
+ * \brief A species.  The partition function t9 values are followed in the
+ *        double section by the log10 partition function values.
+ */
+
+typedef struct binary_species_t
+{
+  uint32_t iZ;
+  uint32_t iA;
+  uint64_t iSource;
+  uint64_t iState;
+  double dMassExcess;
+  double dSpin;
+  uint64_t iPartf;
+  uint64_t iPartfPoints;
+} binary_species_t;
+
+/**
+ * \brief A reaction.  The reactant names are followed in the element section
+ *        by the product names.  The rate data are given by the rate
+ *        function key: a single rate is one double, a rate table is its t9,
+ *        rate, and sef columns, non-smoker fits are a range of fit records,
+ *        and a user rate is a range of property records.
+ */
+
+typedef struct binary_reaction_t
+{
+  uint64_t iSource;
+  uint64_t iKey;
+  uint64_t iElements;
+  uint32_t iReactants;
+  uint32_t iProducts;
+  uint64_t iData;
+  uint64_t iDataPoints;
+  uint64_t iFits;
+  uint64_t iFitCount;
+  uint64_t iProperties;
+  uint64_t iPropertyCount;
+} binary_reaction_t;
+
+/**
+ * \brief A non-smoker fit.
+ */
+
+typedef struct binary_non_smoker_fit_t
+{
+  uint64_t iNote;
+  double a[8];
+  double dSpint;
+  double dSpinf;
+  double dTlowHf;
+  double dTlowfit;
+  double dThighfit;
+  double dAcc;
+} binary_non_smoker_fit_t;
+
+/**
+ * \brief A user rate function or zone property.
+ */
+
+typedef struct binary_property_t
+{
+  uint64_t iName;
+  uint64_t iTag1;
+  uint64_t iTag2;
+  uint64_t iValue;
+} binary_property_t;
+
+/**
+ * \brief A zone.
+ */
+
+typedef struct binary_zone_t
+{
+  uint64_t iLabel[3];
+  uint64_t iProperties;
+  uint64_t iPropertyCount;
+  uint64_t iAbundances;
+  uint64_t iAbundanceCount;
+} binary_zone_t;
+
+/**
+ * \brief A non-zero abundance in a zone.
+ */
+
+typedef struct binary_abundance_t
+{
+  uint64_t iSpecies;
+  double dAbundance;
+} binary_abundance_t;
+
+//##############################################################################
+// Class for writing binary data.
+//##############################################################################
+
+/**
+ * \brief Collects networks, zones, and trajectories in the binary layout and
+ *        writes them to a file.  Equal strings are stored once.
+ */
+
+class BinaryDataWriter : private boost::noncopyable
+{
+
+  public:
+    BinaryDataWriter();
+    uint64_t addString( const char * );
+    uint64_t addDoubles( const double *, size_t );
+    void addProperty(
+      const char *, const char *, const char *, const char *
+    );
+    void addNet( Libnucnet__Net * );
+    void addZones( Libnucnet * );
+    void addTrajectory(
+      const std::vector<double>&,
+      const std::vector<double>&,
+      const std::vector<double>&
+    );
+    void write( const char * ) const;
+
+  private:
+    std::vector<char> vStrings;
+    boost::unordered_map<std::string, uint64_t> string_map;
+    std::vector<double> vDoubles;
+    std::vector<binary_species_t> vSpecies;
+    std::vector<binary_reaction_t> vReactions;
+    std::vector<uint64_t> vElements;
+    std::vector<binary_non_smoker_fit_t> vFits;
+    std::vector<binary_property_t> vProperties;
+    std::vector<binary_zone_t> vZones;
+    std::vector<binary_abundance_t> vAbundances;
+    std::vector<double> vTime, vT9, vLog10Rho;
+
+};
+
+//##############################################################################
+// Class for reading binary data.
+//##############################################################################
+
+/**
+ * \brief A binary data file mapped into memory.  The header and offset
+ *        table are checked when the file is opened; the records are then
+ *        used in place.
+ */
+
+class BinaryDataFile : private boost::noncopyable
+{
+
+  public:
+    BinaryDataFile( const char * );
+    ~BinaryDataFile();
+    bool hasSection( int ) const;
+    const char * getString( uint64_t ) const;
+    const double * getDoubles( uint64_t, uint64_t ) const;
+    template<class T> const T * getRecords( int, uint64_t&  ) const;
+
+  private:
+    std::string sFile;
+    const char * pData;
+    size_t iSize;
+    const binary_data_section_t * getSection( int ) const;
+
+};
+
+//##############################################################################
+// BinaryDataFile::getRecords().
+//##############################################################################
+
+/**
+ * \brief Get the records of a section.
+ * \param i_type The section type.
+ * \param i_count On return, the number of records.
+ * \return A pointer to the first record, or NULL if the section is absent.
+ */
+
+template<class T>
+const T *
+BinaryDataFile::getRecords( int i_type, uint64_t& i_count ) const
+{
+
+  const binary_data_section_t * p_section = getSection( i_type );
+
+  i_count = 0;
+
+  if( !p_section ) return NULL;
+
+  if( p_section->iRecordSize != sizeof( T ) )
+  {
+    std::cerr << "Invalid record size in " << sFile << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  i_count = p_section->iCount;
+
+  return reinterpret_cast<const T *>( pData + p_section->iOffset );
+
+}
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+void
+add_binary_property(
+  const char *,
+  const char *,
+  const char *,
+  const char *,
+  BinaryDataWriter *
+);
+
+bool
+is_binary_data_file( const char * );
+
+boost::shared_ptr<nnt::ViewSelector>
+get_binary_data_selector( const char *, nnt::view_selector_targets );
+
+void
+update_net_from_binary_data(
+  Libnucnet__Net *,
+  const char *,
+  const char *,
+  const char *
+);
+
+void
+assign_zone_data_from_binary_data( Libnucnet *, const char * );
+
+void
+get_trajectory_from_binary_data(
+  const char *,
+  std::vector<double>&,
+  std::vector<double>&,
+  std::vector<double>&
+);
+
+} // namespace user
+
+#endif // BINARY_DATA_H
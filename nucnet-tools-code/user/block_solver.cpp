@@ -0,0 +1,482 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the block-structured solver of multi-zone matrix
+//!        equations.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "user/block_solver.h"
+
+/**
+ * @brief A NucNet Tools namespace for extra (potentially user-supplied)
+ *        codes.
+ */
+namespace user
+{
+
+//##############################################################################
+// BlockSolver::BlockSolver().
+//##############################################################################
+
+/**
+ * \brief Create a block solver.
+ * \param i_blocks The number of diagonal blocks.
+ * \param i_block_size The number of rows in each block.
+ * \param b_gauss_seidel True for the block Gauss-Seidel preconditioner,
+ *        false (the default) for block Jacobi.
+ */
+
+BlockSolver::BlockSolver(
+  size_t i_blocks,
+  size_t i_block_size,
+  bool b_gauss_seidel
+) : iBlockSize( i_block_size ), bGaussSeidel( b_gauss_seidel )
+{
+
+  vBlocks.resize( i_blocks );
+
+  vCouplingRowPtr.assign( i_blocks * i_block_size + 1, 0 );
+
+}
+
+//##############################################################################
+// BlockSolver::setBlock().
+//##############################################################################
+
+/**
+ * \brief Set the entries of a diagonal block from a matrix in zero-based
+ *        CSR form.  The previous entries of the block are removed.  Blocks
+ *        may be set at the same time in different threads.
+ * \param i_block The block.
+ * \param i_offset The row and column in the block of the first row and
+ *        column of the matrix.
+ * \param row_ptr The CSR row pointer vector.
+ * \param col The CSR column index vector.
+ * \param values The matrix values.
+ */
+
+void
+BlockSolver::setBlock(
+  size_t i_block,
+  size_t i_offset,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col,
+  const std::vector<double>& values
+)
+{
+
+  matrix_block_t& block = vBlocks[i_block];
+
+  if( i_offset + row_ptr.size() - 1 > iBlockSize )
+  {
+    std::cerr << "Matrix does not fit in block." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  block.vRow.clear();
+  block.vCol.clear();
+  block.vEntries.clear();
+
+  for( size_t i = 0; i + 1 < row_ptr.size(); i++ )
+  {
+    for( size_t p = row_ptr[i]; p < row_ptr[i+1]; p++ )
+    {
+      block.vRow.push_back( i + i_offset );
+      block.vCol.push_back( col[p] + i_offset );
+      block.vEntries.push_back( values[p] );
+    }
+  }
+
+}
+
+//##############################################################################
+// BlockSolver::setCoupling().
+//##############################################################################
+
+/**
+ * \brief Add a matrix of the full size, such as the mixing matrix of a
+ *        multi-zone calculation.  Its elements within a diagonal block are
+ *        added to the block; the rest become the coupling operator, which
+ *        replaces any previous one.  This must follow the setBlock() calls.
+ * \param p_matrix The matrix.
+ */
+
+void
+BlockSolver::setCoupling( WnMatrix * p_matrix )
+{
+
+  std::vector<size_t> row_ptr, col;
+  std::vector<double> values;
+
+  if( WnMatrix__getNumberOfRows( p_matrix ) != getNumberOfRows() )
+  {
+    std::cerr << "Coupling matrix is of the wrong size." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  get_csr_from_wn_matrix( p_matrix, row_ptr, col, values );
+
+  vCouplingRowPtr.assign( row_ptr.size(), 0 );
+  vCouplingCol.clear();
+  vCouplingValues.clear();
+
+  for( size_t i = 0; i + 1 < row_ptr.size(); i++ )
+  {
+
+    size_t i_block = i / iBlockSize;
+
+    for( size_t p = row_ptr[i]; p < row_ptr[i+1]; p++ )
+    {
+      if( col[p] / iBlockSize == i_block )
+      {
+        vBlocks[i_block].vRow.push_back( i % iBlockSize );
+        vBlocks[i_block].vCol.push_back( col[p] % iBlockSize );
+        vBlocks[i_block].vEntries.push_back( values[p] );
+      }
+      else
+      {
+        vCouplingCol.push_back( col[p] );
+        vCouplingValues.push_back( values[p] );
+      }
+    }
+
+    vCouplingRowPtr[i+1] = vCouplingCol.size();
+
+  }
+
+}
+
+//##############################################################################
+// BlockSolver::addValueToDiagonals().
+//##############################################################################
+
+/**
+ * \brief Add a value to the diagonal elements of the blocks.
+ * \param d_value The value.
+ */
+
+void
+BlockSolver::addValueToDiagonals( double d_value )
+{
+
+  BOOST_FOREACH( matrix_block_t& block, vBlocks )
+  {
+    for( size_t i = 0; i < iBlockSize; i++ )
+    {
+      block.vRow.push_back( i );
+      block.vCol.push_back( i );
+      block.vEntries.push_back( d_value );
+    }
+  }
+
+}
+
+//##############################################################################
+// BlockSolver::assembleBlock().
+//##############################################################################
+
+/**
+ * \brief Assemble the CSR form of a block, with the columns of each row in
+ *        increasing order and repeated entries summed.
+ * \param block The block.
+ */
+
+void
+BlockSolver::assembleBlock( matrix_block_t& block ) const
+{
+
+  std::vector<size_t> row_ptr( iBlockSize + 1, 0 );
+  std::vector<std::pair<size_t, double> > entries( block.vEntries.size() );
+
+  for( size_t p = 0; p < block.vRow.size(); p++ )
+    row_ptr[block.vRow[p] + 1]++;
+
+  for( size_t i = 0; i < iBlockSize; i++ )
+    row_ptr[i+1] += row_ptr[i];
+
+  std::vector<size_t> next( row_ptr.begin(), row_ptr.end() - 1 );
+
+  for( size_t p = 0; p < block.vRow.size(); p++ )
+    entries[next[block.vRow[p]]++] =
+      std::make_pair( block.vCol[p], block.vEntries[p] );
+
+  block.vCsrRowPtr.assign( iBlockSize + 1, 0 );
+  block.vCsrCol.clear();
+  block.vCsrValues.clear();
+
+  for( size_t i = 0; i < iBlockSize; i++ )
+  {
+
+    std::sort( entries.begin() + row_ptr[i], entries.begin() + row_ptr[i+1] );
+
+    for( size_t p = row_ptr[i]; p < row_ptr[i+1]; p++ )
+    {
+      if(
+        p > row_ptr[i] &&
+        entries[p].first == block.vCsrCol.back()
+      )
+        block.vCsrValues.back() += entries[p].second;
+      else
+      {
+        block.vCsrCol.push_back( entries[p].first );
+        block.vCsrValues.push_back( entries[p].second );
+      }
+    }
+
+    block.vCsrRowPtr[i+1] = block.vCsrCol.size();
+
+  }
+
+}
+
+//##############################################################################
+// BlockSolver::factor().
+//##############################################################################
+
+/**
+ * \brief Assemble and factor the blocks in parallel.  A block's symbolic
+ *        factorization is reused if its pattern is unchanged.
+ * \return True if all the blocks were factored, false if not.
+ */
+
+bool
+BlockSolver::factor()
+{
+
+  int i_failures = 0;
+
+#ifndef NO_OPENMP
+  #pragma omp parallel for schedule( dynamic, 1 ) reduction( +:i_failures )
+#endif
+    for( int i = 0; i < (int) vBlocks.size(); i++ )
+    {
+
+      matrix_block_t& block = vBlocks[(size_t) i];
+
+      assembleBlock( block );
+
+      if(
+        !block.pLU ||
+        !block.pLU->hasPattern(
+          iBlockSize, block.vCsrRowPtr, block.vCsrCol
+        )
+      )
+        block.pLU.reset(
+          new SparseLUSolver( iBlockSize, block.vCsrRowPtr, block.vCsrCol )
+        );
+
+      if( !block.pLU->factor( block.vCsrValues ) ) i_failures++;
+
+    }
+
+  return i_failures == 0;
+
+}
+
+//##############################################################################
+// BlockSolver::multiply().
+//##############################################################################
+
+/**
+ * \brief Multiply the full matrix, the blocks plus the coupling operator,
+ *        into a vector.  The blocks must be assembled by factor().
+ * \param x The vector.
+ * \param y The product.
+ */
+
+void
+BlockSolver::multiply( const double * x, std::vector<double>& y ) const
+{
+
+#ifndef NO_OPENMP
+  #pragma omp parallel for schedule( static )
+#endif
+    for( int i = 0; i < (int) vBlocks.size(); i++ )
+    {
+
+      const matrix_block_t& block = vBlocks[(size_t) i];
+      size_t i_start = (size_t) i * iBlockSize;
+
+      for( size_t j = 0; j < iBlockSize; j++ )
+      {
+
+        double d_sum = 0;
+
+        for( size_t p = block.vCsrRowPtr[j]; p < block.vCsrRowPtr[j+1]; p++ )
+          d_sum += block.vCsrValues[p] * x[i_start + block.vCsrCol[p]];
+
+        size_t i_row = i_start + j;
+
+        for(
+          size_t p = vCouplingRowPtr[i_row];
+          p < vCouplingRowPtr[i_row + 1];
+          p++
+        )
+          d_sum += vCouplingValues[p] * x[vCouplingCol[p]];
+
+        y[i_row] = d_sum;
+
+      }
+
+    }
+
+}
+
+//##############################################################################
+// BlockSolver::solve().
+//##############################################################################
+
+/**
+ * \brief Apply the preconditioner.  For block Jacobi, each block is solved
+ *        with its factorization, in parallel.  For block Gauss-Seidel, the
+ *        coupling to earlier blocks is moved to the right-hand side of each
+ *        block with the earlier solutions, in block order.
+ * \param r The vector.
+ * \param z The preconditioned vector.
+ */
+
+void
+BlockSolver::solve(
+  const std::vector<double>& r,
+  std::vector<double>& z
+) const
+{
+
+  if( bGaussSeidel )
+  {
+
+    std::vector<double> work( iBlockSize );
+
+    for( size_t i = 0; i < vBlocks.size(); i++ )
+    {
+
+      size_t i_start = i * iBlockSize;
+
+      for( size_t j = 0; j < iBlockSize; j++ )
+      {
+
+        size_t i_row = i_start + j;
+        double d_sum = r[i_row];
+
+        for(
+          size_t p = vCouplingRowPtr[i_row];
+          p < vCouplingRowPtr[i_row + 1];
+          p++
+        )
+        {
+          if( vCouplingCol[p] < i_start )
+            d_sum -= vCouplingValues[p] * z[vCouplingCol[p]];
+        }
+
+        work[j] = d_sum;
+
+      }
+
+      gsl_vector_const_view rhs_view =
+        gsl_vector_const_view_array( &work[0], iBlockSize );
+      gsl_vector_view sol_view =
+        gsl_vector_view_array( &z[i_start], iBlockSize );
+
+      vBlocks[i].pLU->solve( &rhs_view.vector, &sol_view.vector );
+
+    }
+
+    return;
+
+  }
+
+#ifndef NO_OPENMP
+  #pragma omp parallel for schedule( dynamic, 1 )
+#endif
+    for( int i = 0; i < (int) vBlocks.size(); i++ )
+    {
+
+      size_t i_start = (size_t) i * iBlockSize;
+
+      gsl_vector_const_view rhs_view =
+        gsl_vector_const_view_array( &r[i_start], iBlockSize );
+      gsl_vector_view sol_view =
+        gsl_vector_view_array( &z[i_start], iBlockSize );
+
+      vBlocks[(size_t) i].pLU->solve( &rhs_view.vector, &sol_view.vector );
+
+    }
+
+}
+
+//##############################################################################
+// BlockSolver::krylovSolve().
+//##############################################################################
+
+/**
+ * \brief Solve the full matrix equation with a Krylov solver preconditioned
+ *        by the block factorizations.  The blocks must be factored.
+ * \param p_rhs The right-hand-side vector.
+ * \param p_sol The vector to hold the solution.
+ * \param params The Krylov solver parameters.  The ILUT parameters are not
+ *        used.
+ * \return True if the solution converged, false if not.
+ */
+
+bool
+BlockSolver::krylovSolve(
+  const gsl_vector * p_rhs,
+  gsl_vector * p_sol,
+  const krylov_solver_parameters_t& params
+) const
+{
+
+  size_t i_rows = getNumberOfRows(), i_iter;
+  std::vector<double> b( i_rows ), x( i_rows );
+  double d_resid;
+  bool b_converged;
+
+  if( i_rows == 0 ) return false;
+
+  for( size_t i = 0; i < i_rows; i++ ) b[i] = gsl_vector_get( p_rhs, i );
+
+  if( params.sMethod == S_KRYLOV_GMRES )
+    b_converged =
+      krylov_gmres( *this, *this, b, x, params, i_iter, d_resid );
+  else
+    b_converged =
+      krylov_bcgstab( *this, *this, b, x, params, i_iter, d_resid );
+
+  if( params.bDebug )
+    fprintf(
+      stdout,
+      "block %s: %lu blocks, %lu iterations, residual = %g%s\n",
+      params.sMethod.c_str(),
+      (unsigned long) vBlocks.size(),
+      (unsigned long) i_iter,
+      d_resid,
+      b_converged ? "" : " (not converged)"
+    );
+
+  if( !b_converged ) return false;
+
+  for( size_t i = 0; i < i_rows; i++ ) gsl_vector_set( p_sol, i, x[i] );
+
+  return true;
+
+}
+
+} // namespace user
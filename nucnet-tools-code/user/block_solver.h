@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the block-structured solver of multi-zone
+//!        matrix equations.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BLOCK_SOLVER_H
+#define BLOCK_SOLVER_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#ifndef NO_OPENMP
+#include <omp.h>
+#endif
+
+#include <iostream>
+#include <vector>
+
+#include <boost/foreach.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <WnMatrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "user/sparse_lu_solver.h"
+#include "user/krylov_solver.h"
+
+namespace user
+{
+
+//##############################################################################
+// Types.
+//##############################################################################
+
+/**
+ * \brief A diagonal block of a block-structured matrix.  The entries are
+ *        collected in coordinate form, with repeated entries summed, and
+ *        assembled in compressed sparse row (CSR) form when factored.
+ */
+
+typedef struct matrix_block_t
+{
+  std::vector<size_t> vRow;            //!< Row indices of the entries.
+  std::vector<size_t> vCol;            //!< Column indices of the entries.
+  std::vector<double> vEntries;        //!< Values of the entries.
+  std::vector<size_t> vCsrRowPtr;      //!< Assembled CSR row pointers.
+  std::vector<size_t> vCsrCol;         //!< Assembled CSR column indices.
+  std::vector<double> vCsrValues;      //!< Assembled CSR values.
+  boost::shared_ptr<SparseLUSolver> pLU;  //!< LU factorization of the block.
+} matrix_block_t;
+
+//##############################################################################
+// Class for the block solver.
+//##############################################################################
+
+/**
+ * \brief A solver for a matrix made of equal-sized diagonal blocks, one per
+ *        zone, and a sparse operator coupling the blocks.
+ *
+ * The blocks are never assembled into one matrix.  Each block is factored
+ * with its own sparse LU solver, and the factorizations, whose symbolic
+ * analyses are kept from one factorization to the next, are the block
+ * Jacobi or block Gauss-Seidel preconditioner of a Krylov solve of the full
+ * system.  The blocks are assembled and factored, and the block Jacobi
+ * preconditioner and the matrix are applied, in parallel over the blocks.
+ * The block Gauss-Seidel preconditioner is a forward sweep over the
+ * blocks, so it is applied in block order.  Memory and work scale linearly
+ * with the number of blocks.
+ */
+
+class BlockSolver : private boost::noncopyable
+{
+
+  public:
+    BlockSolver( size_t, size_t, bool = false );
+    size_t getNumberOfBlocks() const { return vBlocks.size(); }
+    size_t getBlockSize() const { return iBlockSize; }
+    size_t getNumberOfRows() const { return vBlocks.size() * iBlockSize; }
+    void setBlock(
+      size_t,
+      size_t,
+      const std::vector<size_t>&,
+      const std::vector<size_t>&,
+      const std::vector<double>&
+    );
+    void setCoupling( WnMatrix * );
+    void addValueToDiagonals( double );
+    bool factor();
+    void multiply( const double *, std::vector<double>& ) const;
+    void solve( const std::vector<double>&, std::vector<double>& ) const;
+    bool krylovSolve(
+      const gsl_vector *,
+      gsl_vector *,
+      const krylov_solver_parameters_t&
+    ) const;
+
+  private:
+    size_t iBlockSize;
+    bool bGaussSeidel;
+    std::vector<matrix_block_t> vBlocks;
+    std::vector<size_t> vCouplingRowPtr;
+    std::vector<size_t> vCouplingCol;
+    std::vector<double> vCouplingValues;
+    void assembleBlock( matrix_block_t& ) const;
+
+};
+
+} // namespace user
+
+#endif // BLOCK_SOLVER_H
@@ -0,0 +1,713 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the tabulated electron equation of state.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/electron_eos_table.h"
+#include "user/thermo.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define I_EOS_ETA           0
+#define I_EOS_ETA_DERIV     1
+#define I_EOS_PRESSURE      2
+#define I_EOS_DPDT          3
+#define I_EOS_ENERGY        4
+#define I_EOS_ENTROPY       5
+#define I_EOS_DSDT          6
+#define I_EOS_QUANTITIES    7
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// compute_lagrange_weights().
+//##############################################################################
+
+void
+compute_lagrange_weights(
+  double d_x,
+  size_t i_points,
+  size_t * p_k,
+  double * w
+)
+{
+
+  long i_k = (long) floor( d_x ) - 1;
+
+  if( i_k < 0 ) i_k = 0;
+  if( i_k > (long) i_points - 4 ) i_k = (long) i_points - 4;
+
+  double t = d_x - (double) i_k;
+
+  w[0] = -( t - 1. ) * ( t - 2. ) * ( t - 3. ) / 6.;
+  w[1] = t * ( t - 2. ) * ( t - 3. ) / 2.;
+  w[2] = -t * ( t - 1. ) * ( t - 3. ) / 2.;
+  w[3] = t * ( t - 1. ) * ( t - 2. ) / 6.;
+
+  *p_k = (size_t) i_k;
+
+}
+
+//##############################################################################
+// compute_electron_eos().
+//##############################################################################
+
+/**
+ * \brief Compute the electron quantities with Libstatmech.
+ * \param p_electron The electron fermion.
+ * \param d_t9 The t9.
+ * \param d_rhoye The mass density (g/cc) times Ye.
+ * \return The quantities.
+ */
+
+electron_eos_t
+compute_electron_eos(
+  Libstatmech__Fermion * p_electron,
+  double d_t9,
+  double d_rhoye
+)
+{
+
+  electron_eos_t eos;
+
+  double d_T = d_t9 * GSL_CONST_NUM_GIGA;
+  double d_n = d_rhoye * GSL_CONST_NUM_AVOGADRO;
+
+  eos.dEta =
+    Libstatmech__Fermion__computeChemicalPotential(
+      p_electron, d_T, d_n, NULL, NULL
+    );
+
+  eos.dEtaDerivative =
+    Libstatmech__Fermion__computeTemperatureDerivative(
+      p_electron, S_CHEMICAL_POTENTIAL, d_T, d_n, NULL, NULL
+    );
+
+  eos.dPressure =
+    Libstatmech__Fermion__computeQuantity(
+      p_electron, S_PRESSURE, d_T, eos.dEta, NULL, NULL
+    );
+
+  eos.dDPDT =
+    Libstatmech__Fermion__computeTemperatureDerivative(
+      p_electron, S_PRESSURE, d_T, d_n, NULL, NULL
+    );
+
+  eos.dEnergyDensity =
+    Libstatmech__Fermion__computeQuantity(
+      p_electron, S_INTERNAL_ENERGY_DENSITY, d_T, eos.dEta, NULL, NULL
+    );
+
+  eos.dEntropyDensity =
+    Libstatmech__Fermion__computeQuantity(
+      p_electron, S_ENTROPY_DENSITY, d_T, eos.dEta, NULL, NULL
+    );
+
+  eos.dDSDT =
+    Libstatmech__Fermion__computeTemperatureDerivative(
+      p_electron, S_ENTROPY_DENSITY, d_T, d_n, NULL, NULL
+    );
+
+  return eos;
+
+}
+
+/**
+ * \brief Compute the electron quantities with Libstatmech using the
+ *        integral accuracy of the default thermo functions.
+ * \param d_t9 The t9.
+ * \param d_rhoye The mass density (g/cc) times Ye.
+ * \return The quantities.
+ */
+
+electron_eos_t
+compute_electron_eos( double d_t9, double d_rhoye )
+{
+
+  Libstatmech__Fermion * p_electron =
+    Libstatmech__Fermion__new(
+      nnt::s_ELECTRON, nnt::d_ELECTRON_MASS_IN_MEV, 2, -1.
+    );
+
+  Libstatmech__Fermion__updateQuantityIntegralAccuracy(
+    p_electron, S_PRESSURE, 0., nnt::d_REL_EPS
+  );
+
+  Libstatmech__Fermion__updateQuantityIntegralAccuracy(
+    p_electron, S_INTERNAL_ENERGY_DENSITY, 0., nnt::d_REL_EPS
+  );
+
+  Libstatmech__Fermion__updateQuantityIntegralAccuracy(
+    p_electron, S_ENTROPY_DENSITY, 0., nnt::d_REL_EPS
+  );
+
+  electron_eos_t eos = compute_electron_eos( p_electron, d_t9, d_rhoye );
+
+  Libstatmech__Fermion__free( p_electron );
+
+  return eos;
+
+}
+
+//##############################################################################
+// ElectronEosTable::ElectronEosTable().
+//##############################################################################
+
+/**
+ * \brief Compute the table.
+ * \param d_t9_min The smallest t9.
+ * \param d_t9_max The largest t9.
+ * \param d_rhoye_min The smallest density times Ye.
+ * \param d_rhoye_max The largest density times Ye.
+ * \param i_points_per_decade The number of points per decade in each
+ *        direction.
+ */
+
+ElectronEosTable::ElectronEosTable(
+  double d_t9_min,
+  double d_t9_max,
+  double d_rhoye_min,
+  double d_rhoye_max,
+  size_t i_points_per_decade
+) : dT9Min( d_t9_min ), dT9Max( d_t9_max ),
+    dRhoYeMin( d_rhoye_min ), dRhoYeMax( d_rhoye_max ),
+    iPointsPerDecade( i_points_per_decade )
+{
+
+  if(
+    d_t9_min <= 0. ||
+    d_t9_max <= d_t9_min ||
+    d_rhoye_min <= 0. ||
+    d_rhoye_max <= d_rhoye_min ||
+    i_points_per_decade == 0
+  )
+  {
+    std::cerr << "Invalid electron EOS table limits." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  dStep = 1. / (double) i_points_per_decade;
+  dLog10T9Min = log10( d_t9_min );
+  dLog10RhoYeMin = log10( d_rhoye_min );
+
+  iT9Points =
+    GSL_MAX(
+      (size_t) ceil( ( log10( d_t9_max ) - dLog10T9Min ) / dStep ) + 1, 4
+    );
+  iRhoYePoints =
+    GSL_MAX(
+      (size_t) ceil( ( log10( d_rhoye_max ) - dLog10RhoYeMin ) / dStep ) + 1,
+      4
+    );
+
+  vTable.resize( iT9Points * iRhoYePoints * I_EOS_QUANTITIES );
+
+  Libstatmech__Fermion * p_electron =
+    Libstatmech__Fermion__new(
+      nnt::s_ELECTRON, nnt::d_ELECTRON_MASS_IN_MEV, 2, -1.
+    );
+
+  Libstatmech__Fermion__updateQuantityIntegralAccuracy(
+    p_electron, S_PRESSURE, 0., nnt::d_REL_EPS
+  );
+
+  Libstatmech__Fermion__updateQuantityIntegralAccuracy(
+    p_electron, S_INTERNAL_ENERGY_DENSITY, 0., nnt::d_REL_EPS
+  );
+
+  Libstatmech__Fermion__updateQuantityIntegralAccuracy(
+    p_electron, S_ENTROPY_DENSITY, 0., nnt::d_REL_EPS
+  );
+
+  for( size_t i = 0; i < iT9Points; i++ )
+  {
+
+    double d_t9 = pow( 10., dLog10T9Min + (double) i * dStep );
+    double d_T = d_t9 * GSL_CONST_NUM_GIGA;
+
+    for( size_t j = 0; j < iRhoYePoints; j++ )
+    {
+
+      electron_eos_t eos =
+        compute_electron_eos(
+          p_electron,
+          d_t9,
+          pow( 10., dLog10RhoYeMin + (double) j * dStep )
+        );
+
+      if(
+        eos.dPressure <= 0. ||
+        eos.dDPDT <= 0. ||
+        eos.dEnergyDensity <= 0. ||
+        eos.dEntropyDensity <= 0. ||
+        eos.dDSDT <= 0.
+      )
+      {
+        std::cerr << "Electron EOS table quantity not positive at t9 = " <<
+          d_t9 << "." << std::endl;
+        exit( EXIT_FAILURE );
+      }
+
+      double * p = &vTable[( i * iRhoYePoints + j ) * I_EOS_QUANTITIES];
+
+      p[I_EOS_ETA] = d_t9 * eos.dEta;
+      p[I_EOS_ETA_DERIV] = d_t9 * d_t9 * GSL_CONST_NUM_GIGA *
+                           eos.dEtaDerivative;
+      p[I_EOS_PRESSURE] = log10( eos.dPressure );
+      p[I_EOS_DPDT] = log10( d_T * eos.dDPDT );
+      p[I_EOS_ENERGY] = log10( eos.dEnergyDensity );
+      p[I_EOS_ENTROPY] = log10( eos.dEntropyDensity );
+      p[I_EOS_DSDT] = log10( d_T * eos.dDSDT );
+
+    }
+
+  }
+
+  Libstatmech__Fermion__free( p_electron );
+
+}
+
+//##############################################################################
+// ElectronEosTable::isValidFor().
+//##############################################################################
+
+/**
+ * \brief Check whether the table was computed with the given limits.
+ * \param d_t9_min The smallest t9.
+ * \param d_t9_max The largest t9.
+ * \param d_rhoye_min The smallest density times Ye.
+ * \param d_rhoye_max The largest density times Ye.
+ * \param i_points_per_decade The number of points per decade.
+ * \return True if the limits are those of the table, false if not.
+ */
+
+bool
+ElectronEosTable::isValidFor(
+  double d_t9_min,
+  double d_t9_max,
+  double d_rhoye_min,
+  double d_rhoye_max,
+  size_t i_points_per_decade
+) const
+{
+
+  return
+    d_t9_min == dT9Min &&
+    d_t9_max == dT9Max &&
+    d_rhoye_min == dRhoYeMin &&
+    d_rhoye_max == dRhoYeMax &&
+    i_points_per_decade == iPointsPerDecade;
+
+}
+
+//##############################################################################
+// ElectronEosTable::isInRange().
+//##############################################################################
+
+/**
+ * \brief Check whether a point lies in the table.
+ * \param d_t9 The t9.
+ * \param d_rhoye The density times Ye.
+ * \return True if the point is within the table limits, false if not.
+ */
+
+bool
+ElectronEosTable::isInRange( double d_t9, double d_rhoye ) const
+{
+
+  return
+    d_t9 >= dT9Min && d_t9 <= dT9Max &&
+    d_rhoye >= dRhoYeMin && d_rhoye <= dRhoYeMax;
+
+}
+
+//##############################################################################
+// ElectronEosTable::interpolate().
+//##############################################################################
+
+/**
+ * \brief Interpolate the electron quantities.
+ * \param d_t9 The t9, which must be in range.
+ * \param d_rhoye The density times Ye, which must be in range.
+ * \return The quantities.
+ */
+
+electron_eos_t
+ElectronEosTable::interpolate( double d_t9, double d_rhoye ) const
+{
+
+  size_t i_k, j_k;
+  double w_t[4], w_r[4], q[I_EOS_QUANTITIES];
+  electron_eos_t eos;
+
+  compute_lagrange_weights(
+    ( log10( d_t9 ) - dLog10T9Min ) / dStep, iT9Points, &i_k, w_t
+  );
+
+  compute_lagrange_weights(
+    ( log10( d_rhoye ) - dLog10RhoYeMin ) / dStep, iRhoYePoints, &j_k, w_r
+  );
+
+  for( size_t l = 0; l < I_EOS_QUANTITIES; l++ ) q[l] = 0.;
+
+  for( size_t i = 0; i < 4; i++ )
+  {
+    for( size_t j = 0; j < 4; j++ )
+    {
+      const double * p =
+        &vTable[( ( i_k + i ) * iRhoYePoints + j_k + j ) * I_EOS_QUANTITIES];
+      double w = w_t[i] * w_r[j];
+      for( size_t l = 0; l < I_EOS_QUANTITIES; l++ ) q[l] += w * p[l];
+    }
+  }
+
+  double d_T = d_t9 * GSL_CONST_NUM_GIGA;
+
+  eos.dEta = q[I_EOS_ETA] / d_t9;
+  eos.dEtaDerivative = q[I_EOS_ETA_DERIV] / ( d_t9 * d_T );
+  eos.dPressure = pow( 10., q[I_EOS_PRESSURE] );
+  eos.dDPDT = pow( 10., q[I_EOS_DPDT] ) / d_T;
+  eos.dEnergyDensity = pow( 10., q[I_EOS_ENERGY] );
+  eos.dEntropyDensity = pow( 10., q[I_EOS_ENTROPY] );
+  eos.dDSDT = pow( 10., q[I_EOS_DSDT] ) / d_T;
+
+  return eos;
+
+}
+
+//##############################################################################
+// is_using_electron_eos_table().
+//##############################################################################
+
+/**
+ * \brief Check whether a zone interpolates the electron quantities from
+ *        the electron EOS table.
+ * \param zone The zone.
+ * \return True if the zone's use electron eos table property is "yes",
+ *         false if not.
+ */
+
+bool
+is_using_electron_eos_table( nnt::Zone& zone )
+{
+
+  return
+    zone.hasProperty( nnt::s_USE_ELECTRON_EOS_TABLE ) &&
+    zone.getProperty<std::string>( nnt::s_USE_ELECTRON_EOS_TABLE ) == "yes";
+
+}
+
+//##############################################################################
+// get_electron_eos_table().
+//##############################################################################
+
+/**
+ * \brief Retrieve the electron EOS table for a zone.
+ * \param zone The zone.
+ * \return A shared pointer to the table.  The table does not depend on the
+ *         zone's composition, so one table is shared by all zones and only
+ *         computed anew when the limits requested by a zone's properties
+ *         change.  The zone keeps the table it was given, so later calls
+ *         neither read the limits nor lock; remove the zone's electron eos
+ *         table data after changing the limits to get a new table.
+ */
+
+boost::shared_ptr<ElectronEosTable>
+get_electron_eos_table( nnt::Zone& zone )
+{
+
+  static boost::shared_ptr<ElectronEosTable> p_table;
+  boost::shared_ptr<ElectronEosTable> p_result;
+
+  if( zone.hasData( nnt::s_ELECTRON_EOS_TABLE ) )
+    return
+      boost::any_cast<boost::shared_ptr<ElectronEosTable> >(
+        zone.getData( nnt::s_ELECTRON_EOS_TABLE )
+      );
+
+  double d_t9_min = D_ELECTRON_EOS_TABLE_T9_MIN;
+  double d_t9_max = D_ELECTRON_EOS_TABLE_T9_MAX;
+  double d_rhoye_min = D_ELECTRON_EOS_TABLE_RHOYE_MIN;
+  double d_rhoye_max = D_ELECTRON_EOS_TABLE_RHOYE_MAX;
+  size_t i_points_per_decade = I_ELECTRON_EOS_TABLE_POINTS_PER_DECADE;
+
+  if( zone.hasProperty( nnt::s_ELECTRON_EOS_TABLE_T9_MIN ) )
+    d_t9_min = zone.getProperty<double>( nnt::s_ELECTRON_EOS_TABLE_T9_MIN );
+
+  if( zone.hasProperty( nnt::s_ELECTRON_EOS_TABLE_T9_MAX ) )
+    d_t9_max = zone.getProperty<double>( nnt::s_ELECTRON_EOS_TABLE_T9_MAX );
+
+  if( zone.hasProperty( nnt::s_ELECTRON_EOS_TABLE_RHOYE_MIN ) )
+    d_rhoye_min =
+      zone.getProperty<double>( nnt::s_ELECTRON_EOS_TABLE_RHOYE_MIN );
+
+  if( zone.hasProperty( nnt::s_ELECTRON_EOS_TABLE_RHOYE_MAX ) )
+    d_rhoye_max =
+      zone.getProperty<double>( nnt::s_ELECTRON_EOS_TABLE_RHOYE_MAX );
+
+  if( zone.hasProperty( nnt::s_ELECTRON_EOS_TABLE_POINTS_PER_DECADE ) )
+    i_points_per_decade =
+      zone.getProperty<size_t>( nnt::s_ELECTRON_EOS_TABLE_POINTS_PER_DECADE );
+
+#ifndef NO_OPENMP
+  #pragma omp critical( electron_eos_table )
+#endif
+  {
+
+    if(
+      !p_table ||
+      !p_table->isValidFor(
+        d_t9_min, d_t9_max, d_rhoye_min, d_rhoye_max, i_points_per_decade
+      )
+    )
+      p_table.reset(
+        new ElectronEosTable(
+          d_t9_min, d_t9_max, d_rhoye_min, d_rhoye_max, i_points_per_decade
+        )
+      );
+
+    p_result = p_table;
+
+  }
+
+  zone.updateData( nnt::s_ELECTRON_EOS_TABLE, p_result );
+
+  return p_result;
+
+}
+
+//##############################################################################
+// get_tabulated_electron_eos().
+//##############################################################################
+
+bool
+get_tabulated_electron_eos( nnt::Zone& zone, electron_eos_t& eos )
+{
+
+  double d_t9 = zone.getProperty<double>( nnt::s_T9 );
+  double d_rhoye =
+    zone.getProperty<double>( nnt::s_RHO ) *
+    Libnucnet__Zone__computeZMoment( zone.getNucnetZone(), 1 );
+
+  boost::shared_ptr<ElectronEosTable> p_table =
+    get_electron_eos_table( zone );
+
+  if( !p_table->isInRange( d_t9, d_rhoye ) ) return false;
+
+  eos = p_table->interpolate( d_t9, d_rhoye );
+
+  return true;
+
+}
+
+//##############################################################################
+// compute_tabulated_electron_chemical_potential_kT().
+//##############################################################################
+
+/**
+ * \brief Compute the electron chemical potential (less the rest mass)
+ *        divided by kT from the electron EOS table.  Outside the table,
+ *        compute_electron_chemical_potential_kT() is used.
+ * \param zone A NucNet Tools zone.
+ * \return A double giving the chemical potential / kT.
+ */
+
+double
+compute_tabulated_electron_chemical_potential_kT( nnt::Zone& zone )
+{
+
+  electron_eos_t eos;
+
+  if( get_tabulated_electron_eos( zone, eos ) ) return eos.dEta;
+
+  return compute_electron_chemical_potential_kT( zone );
+
+}
+
+//##############################################################################
+// compute_tabulated_electron_chemical_potential_kT_temperature_derivative().
+//##############################################################################
+
+/**
+ * \brief Compute the temperature derivative of the electron chemical
+ *        potential (less the rest mass) divided by kT from the electron EOS
+ *        table.  Outside the table, the Libstatmech value is used.
+ * \param zone A NucNet Tools zone.
+ * \return A double giving the d(chemical potential / kT)/dT.
+ */
+
+double
+compute_tabulated_electron_chemical_potential_kT_temperature_derivative(
+  nnt::Zone& zone
+)
+{
+
+  electron_eos_t eos;
+
+  if( get_tabulated_electron_eos( zone, eos ) ) return eos.dEtaDerivative;
+
+  return
+    compute_electron_eos(
+      zone.getProperty<double>( nnt::s_T9 ),
+      zone.getProperty<double>( nnt::s_RHO ) *
+        Libnucnet__Zone__computeZMoment( zone.getNucnetZone(), 1 )
+    ).dEtaDerivative;
+
+}
+
+//##############################################################################
+// compute_tabulated_electron_pressure().
+//##############################################################################
+
+/**
+ * \brief Compute the electron pressure from the electron EOS table.
+ *        Outside the table, compute_electron_pressure() is used.
+ * \param zone A NucNet Tools zone.
+ * \return A double giving the electron pressure (dynes/cm^2).
+ */
+
+double
+compute_tabulated_electron_pressure( nnt::Zone& zone )
+{
+
+  electron_eos_t eos;
+
+  if( get_tabulated_electron_eos( zone, eos ) ) return eos.dPressure;
+
+  return compute_electron_pressure( zone );
+
+}
+
+//##############################################################################
+// compute_tabulated_electron_dPdT().
+//##############################################################################
+
+/**
+ * \brief Compute the derivative of the electron pressure with temperature
+ *        from the electron EOS table.  Outside the table,
+ *        compute_electron_dPdT() is used.
+ * \param zone A NucNet Tools zone.
+ * \return A double giving the electron dPdT (dynes/cm^2/K).
+ */
+
+double
+compute_tabulated_electron_dPdT( nnt::Zone& zone )
+{
+
+  electron_eos_t eos;
+
+  if( get_tabulated_electron_eos( zone, eos ) ) return eos.dDPDT;
+
+  return compute_electron_dPdT( zone );
+
+}
+
+//##############################################################################
+// compute_tabulated_electron_internal_energy_density().
+//##############################################################################
+
+/**
+ * \brief Compute the electron internal energy density from the electron
+ *        EOS table.  Outside the table,
+ *        compute_electron_internal_energy_density() is used.
+ * \param zone A NucNet Tools zone.
+ * \return A double giving the electron internal energy density (ergs/cc).
+ */
+
+double
+compute_tabulated_electron_internal_energy_density( nnt::Zone& zone )
+{
+
+  electron_eos_t eos;
+
+  if( get_tabulated_electron_eos( zone, eos ) ) return eos.dEnergyDensity;
+
+  return compute_electron_internal_energy_density( zone );
+
+}
+
+//##############################################################################
+// compute_tabulated_electron_entropy_per_nucleon().
+//##############################################################################
+
+/**
+ * \brief Compute the electron entropy per nucleon from the electron EOS
+ *        table.  Outside the table, compute_electron_entropy_per_nucleon()
+ *        is used.
+ * \param zone A NucNet Tools zone.
+ * \return A double giving the electron entropy (per k_B per nucleon).
+ */
+
+double
+compute_tabulated_electron_entropy_per_nucleon( nnt::Zone& zone )
+{
+
+  electron_eos_t eos;
+
+  if( !get_tabulated_electron_eos( zone, eos ) )
+    return compute_electron_entropy_per_nucleon( zone );
+
+  return
+    eos.dEntropyDensity /
+    (
+      zone.getProperty<double>( nnt::s_RHO ) *
+      GSL_CONST_NUM_AVOGADRO *
+      GSL_CONST_CGSM_BOLTZMANN
+    );
+
+}
+
+//##############################################################################
+// compute_tabulated_electron_specific_heat_per_nucleon().
+//##############################################################################
+
+/**
+ * \brief Compute the electron specific heat per nucleon from the electron
+ *        EOS table.  Outside the table,
+ *        compute_electron_specific_heat_per_nucleon() is used.
+ * \param zone A NucNet Tools zone.
+ * \return A double giving the electron specific heat
+ *         (per k_B per K per nucleon).
+ */
+
+double
+compute_tabulated_electron_specific_heat_per_nucleon( nnt::Zone& zone )
+{
+
+  electron_eos_t eos;
+
+  if( !get_tabulated_electron_eos( zone, eos ) )
+    return compute_electron_specific_heat_per_nucleon( zone );
+
+  return
+    zone.getProperty<double>( nnt::s_T9 ) * GSL_CONST_NUM_GIGA * eos.dDSDT /
+    (
+      zone.getProperty<double>( nnt::s_RHO ) *
+      GSL_CONST_NUM_AVOGADRO *
+      GSL_CONST_CGSM_BOLTZMANN
+    );
+
+}
+
+} // namespace user
@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the tabulated electron equation of state.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ELECTRON_EOS_TABLE_H
+#define ELECTRON_EOS_TABLE_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Libnucnet.h>
+#include <Libstatmech.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/string_defs.h"
+#include "nnt/param_defs.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define D_ELECTRON_EOS_TABLE_T9_MIN             1.e-2
+#define D_ELECTRON_EOS_TABLE_T9_MAX             1.e1
+#define D_ELECTRON_EOS_TABLE_RHOYE_MIN          1.
+#define D_ELECTRON_EOS_TABLE_RHOYE_MAX          1.e12
+#define I_ELECTRON_EOS_TABLE_POINTS_PER_DECADE  10
+
+namespace user
+{
+
+//##############################################################################
+// Structure for the electron thermodynamic quantities.
+//##############################################################################
+
+/**
+ * \brief The electron (and positron) thermodynamic quantities at a
+ *        temperature and electron number density.
+ */
+
+typedef struct electron_eos_t
+{
+  double dEta;              //!< Chemical potential (less rest mass) / kT.
+  double dEtaDerivative;    //!< d(dEta)/dT (K^-1).
+  double dPressure;         //!< Pressure (dynes/cm^2).
+  double dDPDT;             //!< dP/dT (dynes/cm^2/K).
+  double dEnergyDensity;    //!< Internal energy density (ergs/cc).
+  double dEntropyDensity;   //!< Entropy density (ergs/K/cc).
+  double dDSDT;             //!< d(entropy density)/dT (ergs/K^2/cc).
+} electron_eos_t;
+
+//##############################################################################
+// Class for the electron EOS table.
+//##############################################################################
+
+/**
+ * \brief The electron thermodynamic quantities tabulated on a uniform
+ *        (log10 t9, log10 rho Ye) grid.
+ *
+ * The table is computed once with the same Libstatmech fermion and
+ * integral accuracy as the default thermo functions in user/thermo.cpp, so
+ * all the quantities come from one equation of state.  The pressure,
+ * energy, entropy, and their temperature derivatives are tabulated as
+ * log10 values.  The chemical potential is tabulated as t9 * eta and its
+ * derivative as t9^2 * d(eta)/dt9, which are nearly independent of t9 when
+ * the electrons are degenerate.  All quantities are interpolated with
+ * four-point Lagrange polynomials in each direction.
+ */
+
+class ElectronEosTable : private boost::noncopyable
+{
+
+  public:
+    ElectronEosTable( double, double, double, double, size_t );
+    bool isValidFor( double, double, double, double, size_t ) const;
+    bool isInRange( double, double ) const;
+    size_t getNumberOfT9Points() const { return iT9Points; }
+    size_t getNumberOfRhoYePoints() const { return iRhoYePoints; }
+    double getLog10Step() const { return dStep; }
+    double getLog10T9Min() const { return dLog10T9Min; }
+    double getLog10RhoYeMin() const { return dLog10RhoYeMin; }
+    electron_eos_t interpolate( double, double ) const;
+
+  private:
+    double dT9Min, dT9Max, dRhoYeMin, dRhoYeMax;
+    double dLog10T9Min, dLog10RhoYeMin, dStep;
+    size_t iPointsPerDecade, iT9Points, iRhoYePoints;
+    std::vector<double> vTable;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+electron_eos_t
+compute_electron_eos( Libstatmech__Fermion *, double, double );
+
+electron_eos_t
+compute_electron_eos( double, double );
+
+bool
+is_using_electron_eos_table( nnt::Zone& );
+
+boost::shared_ptr<ElectronEosTable>
+get_electron_eos_table( nnt::Zone& );
+
+double
+compute_tabulated_electron_chemical_potential_kT( nnt::Zone& );
+
+double
+compute_tabulated_electron_chemical_potential_kT_temperature_derivative(
+  nnt::Zone&
+);
+
+double
+compute_tabulated_electron_pressure( nnt::Zone& );
+
+double
+compute_tabulated_electron_dPdT( nnt::Zone& );
+
+double
+compute_tabulated_electron_internal_energy_density( nnt::Zone& );
+
+double
+compute_tabulated_electron_entropy_per_nucleon( nnt::Zone& );
+
+double
+compute_tabulated_electron_specific_heat_per_nucleon( nnt::Zone& );
+
+} // namespace user
+
+#endif // ELECTRON_EOS_TABLE_H
@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the preallocated evolution workspace.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/evolution_workspace.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// EvolutionWorkspace::EvolutionWorkspace().
+//##############################################################################
+
+/**
+ * \brief Allocate the workspace vectors for a zone.
+ * \param p_zone The zone.
+ */
+
+EvolutionWorkspace::EvolutionWorkspace( Libnucnet__Zone * p_zone )
+{
+
+  pNuc = Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) );
+  iNucUpdate = pNuc->iUpdate;
+  iSpecies = Libnucnet__Nuc__getNumberOfSpecies( pNuc );
+
+  pYOld = gsl_vector_calloc( iSpecies );
+  pRhs = gsl_vector_calloc( iSpecies );
+  pSol = gsl_vector_calloc( iSpecies );
+  pWork = gsl_vector_calloc( iSpecies );
+
+}
+
+//##############################################################################
+// EvolutionWorkspace::~EvolutionWorkspace().
+//##############################################################################
+
+EvolutionWorkspace::~EvolutionWorkspace()
+{
+
+  gsl_vector_free( pYOld );
+  gsl_vector_free( pRhs );
+  gsl_vector_free( pSol );
+  gsl_vector_free( pWork );
+
+}
+
+//##############################################################################
+// EvolutionWorkspace::isValidFor().
+//##############################################################################
+
+/**
+ * \brief Check whether the workspace applies to a zone.
+ * \param p_zone The zone.
+ * \return True if the zone's nuclide collection is the one the workspace
+ *         was sized for and has not changed since, false if not.
+ */
+
+bool
+EvolutionWorkspace::isValidFor( Libnucnet__Zone * p_zone ) const
+{
+
+  Libnucnet__Nuc * p_nuc =
+    Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) );
+
+  return
+    p_nuc == pNuc &&
+    p_nuc->iUpdate == iNucUpdate &&
+    Libnucnet__Nuc__getNumberOfSpecies( p_nuc ) == iSpecies;
+
+}
+
+//##############################################################################
+// get_evolution_workspace_for_zone().
+//##############################################################################
+
+/**
+ * \brief Retrieve the evolution workspace for a zone.  The workspace is
+ *        stored with the zone and only allocated anew when the zone's
+ *        nuclide collection changes.
+ * \param zone The zone.
+ * \return A shared pointer to the workspace.
+ */
+
+boost::shared_ptr<EvolutionWorkspace>
+get_evolution_workspace_for_zone( nnt::Zone& zone )
+{
+
+  if( zone.hasData( nnt::s_EVOLUTION_WORKSPACE ) )
+  {
+
+    boost::shared_ptr<EvolutionWorkspace> p_workspace =
+      boost::any_cast<boost::shared_ptr<EvolutionWorkspace> >(
+        zone.getData( nnt::s_EVOLUTION_WORKSPACE )
+      );
+
+    if( p_workspace->isValidFor( zone.getNucnetZone() ) ) return p_workspace;
+
+  }
+
+  boost::shared_ptr<EvolutionWorkspace> p_workspace(
+    new EvolutionWorkspace( zone.getNucnetZone() )
+  );
+
+  zone.updateData( nnt::s_EVOLUTION_WORKSPACE, p_workspace );
+
+  return p_workspace;
+
+}
+
+} // namespace user
@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the preallocated evolution workspace.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EVOLUTION_WORKSPACE_H
+#define EVOLUTION_WORKSPACE_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Libnucnet.h>
+#include <gsl/gsl_vector.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/string_defs.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for the evolution workspace.
+//##############################################################################
+
+/**
+ * \brief The vectors used in the Newton-Raphson iterations of a zone.
+ *
+ * The workspace owns the old abundance, right-hand-side, solution, and work
+ * vectors, all sized to the zone's nuclide collection, so that the
+ * iterations need not allocate them anew.  The current abundances are in
+ * the zone's ZoneAbundances arrays.
+ */
+
+class EvolutionWorkspace : private boost::noncopyable
+{
+
+  public:
+    EvolutionWorkspace( Libnucnet__Zone * );
+    ~EvolutionWorkspace();
+    bool isValidFor( Libnucnet__Zone * ) const;
+    gsl_vector * getOldAbundances() { return pYOld; }
+    gsl_vector * getRhs() { return pRhs; }
+    gsl_vector * getSolution() { return pSol; }
+    gsl_vector * getWork() { return pWork; }
+
+  private:
+    Libnucnet__Nuc * pNuc;
+    size_t iNucUpdate;
+    size_t iSpecies;
+    gsl_vector * pYOld;
+    gsl_vector * pRhs;
+    gsl_vector * pSol;
+    gsl_vector * pWork;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+boost::shared_ptr<EvolutionWorkspace>
+get_evolution_workspace_for_zone( nnt::Zone& );
+
+} // namespace user
+
+#endif // EVOLUTION_WORKSPACE_H
@@ -48,9 +48,8 @@ evolve(
   nnt::Zone& zone
 ) {
 
-  WnMatrix *p_matrix; 
+  boost::shared_ptr<NetworkJacobian> p_jacobian;
   size_t i_iter;
-  gsl_vector *p_y_old, *p_rhs, *p_sol, *p_work;
   double d_dt;
   std::pair<double,double> check;
   
@@ -58,15 +57,38 @@ evolve(
   // Evolve NSE + weak rates, if appropriate.
   //==========================================================================
 
+  boost::shared_ptr<ZoneAbundances> p_abunds = get_zone_abundances( zone );
+
   if(
     zone.hasProperty( nnt::s_EVOLVE_NSE_PLUS_WEAK_RATES ) &&
     zone.getProperty<std::string>( nnt::s_EVOLVE_NSE_PLUS_WEAK_RATES ) == "yes"
   )
   {
     evolve_nse_plus_weak_rates( zone );
+    p_abunds->readAbundances( zone.getNucnetZone() );
+    p_abunds->readAbundanceChanges( zone.getNucnetZone() );
     return 1;
   }
 
+  //============================================================================
+  // Get the workspace.  Its vectors persist with the zone, so the
+  // iterations below do not allocate them.  The current abundances are
+  // iterated in the zone's dense abundance array, which is only written to
+  // the zone before the rates are updated and on return.
+  //============================================================================
+
+  boost::shared_ptr<EvolutionWorkspace> p_workspace =
+    get_evolution_workspace_for_zone( zone );
+
+  gsl_vector_view y_view = p_abunds->getAbundanceView();
+  gsl_vector_view dy_view = p_abunds->getAbundanceChangeView();
+
+  gsl_vector * p_y_old = p_workspace->getOldAbundances();
+  gsl_vector * p_y = &y_view.vector;
+  gsl_vector * p_rhs = p_workspace->getRhs();
+  gsl_vector * p_sol = p_workspace->getSolution();
+  gsl_vector * p_work = p_workspace->getWork();
+
   //============================================================================
   // Get timestep. 
   //============================================================================
@@ -77,7 +99,9 @@ evolve(
   // Save the old abundances.
   //============================================================================
 
-  p_y_old = Libnucnet__Zone__getAbundances( zone.getNucnetZone() );
+  p_abunds->readAbundances( zone.getNucnetZone() );
+
+  gsl_vector_memcpy( p_y_old, p_y );
 
   //============================================================================
   // Newton-Raphson Iterations.
@@ -89,14 +113,14 @@ evolve(
     // Get matrix and rhs vector.
     //--------------------------------------------------------------------------
 
-    boost::tie( p_matrix, p_rhs ) = get_evolution_matrix_and_vector( zone );
+    p_jacobian =
+      compute_evolution_jacobian_and_vector( zone, *p_abunds, *p_workspace );
 
     //--------------------------------------------------------------------------
     // Add 1/dt to diagonal.
     //--------------------------------------------------------------------------
 
-    WnMatrix__addValueToDiagonals(
-      p_matrix,
+    p_jacobian->addValueToDiagonals(
       1.0 / zone.getProperty<double>( nnt::s_DTIME )
     );
 
@@ -104,47 +128,30 @@ evolve(
     // Correct vector for iteration.
     //--------------------------------------------------------------------------
 
-    p_work = Libnucnet__Zone__getAbundances( zone.getNucnetZone() );
+    gsl_vector_memcpy( p_work, p_y );
     gsl_vector_sub( p_work, p_y_old );
     gsl_vector_scale( p_work, 1. / d_dt );
     gsl_vector_sub( p_rhs, p_work );
 
-    gsl_vector_free( p_work );
-
     //--------------------------------------------------------------------------
     // Solve matrix equation.
     //--------------------------------------------------------------------------
 
-    p_sol = solve_matrix_for_zone( zone, p_matrix, p_rhs );
+    solve_matrix_for_zone( zone, *p_jacobian, p_rhs, p_sol );
 
     //--------------------------------------------------------------------------
     // Check solution.
     //--------------------------------------------------------------------------
 
-    check = check_matrix_solution( zone, p_sol );
+    check = check_matrix_solution( zone, *p_abunds, p_sol );
 
     //--------------------------------------------------------------------------
     // Update abundances.
     //--------------------------------------------------------------------------
 
-    p_work = Libnucnet__Zone__getAbundances( zone.getNucnetZone() );
-
-    gsl_vector_add( p_work, p_sol );
+    gsl_vector_add( p_y, p_sol );
 
-    Libnucnet__Zone__updateAbundances( zone.getNucnetZone(), p_work );
-
-    gsl_vector_free( p_work );
-
-    //--------------------------------------------------------------------------
-    // Free matrix, p_rhs, and p_sol. Remember
-    // Libnucnet__Zone__computeJacobianMatrix returns a new matrix and
-    // Libnucnet__computeFlowVector and WnMatrix__solve return new gsl_vectors
-    // each time they are called.
-    //--------------------------------------------------------------------------
-
-    WnMatrix__free( p_matrix ); 
-    gsl_vector_free( p_rhs );
-    gsl_vector_free( p_sol );
+    p_abunds->markAbundancesChanged();
 
     //--------------------------------------------------------------------------
     // Exit iterations if converged.
@@ -168,33 +175,351 @@ evolve(
 
     if( zone.hasProperty( nnt::s_LARGE_NEG_ABUND_THRESHOLD ) )
     {
-      if( !is_nonneg_abunds( zone ) ) return -1;
+      if(
+        !p_abunds->zeroSmallNegativeAbundances(
+          zone.getProperty<double>( nnt::s_LARGE_NEG_ABUND_THRESHOLD )
+        )
+      )
+      {
+        p_abunds->syncAbundances( zone.getNucnetZone() );
+        return -1;
+      }
     }
       
   }
 
   //==========================================================================
-  // Update abundance changes.
+  // Write the abundances and update abundance changes.
   //==========================================================================
 
-  p_work = Libnucnet__Zone__getAbundances( zone.getNucnetZone() );
+  p_abunds->syncAbundances( zone.getNucnetZone() );
 
-  gsl_vector_sub( p_work, p_y_old );
+  gsl_vector_memcpy( &dy_view.vector, p_y );
 
-  Libnucnet__Zone__updateAbundanceChanges( zone.getNucnetZone(), p_work );
+  gsl_vector_sub( &dy_view.vector, p_y_old );
+
+  p_abunds->writeAbundanceChanges( zone.getNucnetZone() );
+
+  return (int) i_iter;
+
+}
+
+//##############################################################################
+// evolve_with_t9()
+//##############################################################################
+
+/**
+ * \brief Evolve a Nucnet Tools zone over the currently defined time
+ *        step (property s_DTIME) with t9 as an extra unknown of the
+ *        Newton-Raphson iterations.
+ *
+ * The extra equation is the zero of the input t9 residual.  The abundance
+ * equations are bordered by the derivative of the flows with respect to
+ * t9, and the bordered system is solved by block elimination with two
+ * solves of the usual abundance matrix, so the zone's matrix solver
+ * settings apply unchanged.  The t9 derivatives of the flows and of the
+ * residual, and the changes in the residual along the two abundance
+ * solutions, are finite differences.  The residual function is called
+ * with the zone's abundances and t9 set to the trial values and with the
+ * rates computed at that t9.
+ *
+ * \param zone A Nucnet Tools zone.  Its t9 on input is the initial guess.
+ * \param residual The t9 residual function.  It takes the zone as its
+ *        argument.
+ * \return Number of iterations if successful, -1 if not successful.  If not
+ *         successful, the zone's abundances and t9 are restored.
+ */
+
+int
+evolve_with_t9(
+  nnt::Zone& zone,
+  const boost::function<double( nnt::Zone& )>& residual
+)
+{
+
+  boost::shared_ptr<NetworkJacobian> p_jacobian;
+  size_t i_iter;
+  double d_dt, d_t9, d_t9_old, d_tol = D_MIN;
+  bool b_converged = false;
+  std::pair<double,double> check;
+
+  //============================================================================
+  // Get the abundances and workspace as in evolve().  The derivative of the
+  // flows with respect to t9 and the matrix solution for it are the extra
+  // columns of the bordered system.
+  //============================================================================
+
+  boost::shared_ptr<ZoneAbundances> p_abunds = get_zone_abundances( zone );
+
+  boost::shared_ptr<EvolutionWorkspace> p_workspace =
+    get_evolution_workspace_for_zone( zone );
+
+  gsl_vector_view y_view = p_abunds->getAbundanceView();
+  gsl_vector_view dy_view = p_abunds->getAbundanceChangeView();
+
+  gsl_vector * p_y_old = p_workspace->getOldAbundances();
+  gsl_vector * p_y = &y_view.vector;
+  gsl_vector * p_rhs = p_workspace->getRhs();
+  gsl_vector * p_sol = p_workspace->getSolution();
+  gsl_vector * p_work = p_workspace->getWork();
+
+  gsl_vector * p_column = gsl_vector_alloc( p_y->size );
+  gsl_vector * p_t9_sol = gsl_vector_alloc( p_y->size );
+
+  d_dt = zone.getProperty<double>( nnt::s_DTIME );
+
+  d_t9_old = zone.getProperty<double>( nnt::s_T9 );
+  d_t9 = d_t9_old;
+
+  if( zone.hasProperty( nnt::s_NEWTON_RAPHSON_CONVERGE ) )
+    d_tol = zone.getProperty<double>( nnt::s_NEWTON_RAPHSON_CONVERGE );
+
+  p_abunds->readAbundances( zone.getNucnetZone() );
+
+  gsl_vector_memcpy( p_y_old, p_y );
+
+  //============================================================================
+  // Newton-Raphson Iterations.
+  //============================================================================
+
+  for( i_iter = 1; i_iter <= I_ITMAX; i_iter++ ) {
+
+    //--------------------------------------------------------------------------
+    // Flows and residual at the displaced t9.  This comes first so that the
+    // zone's rates are those at t9 for the rest of the iteration.
+    //--------------------------------------------------------------------------
+
+    double d_delta = D_T9_DELTA * d_t9;
+
+    zone.updateProperty( nnt::s_T9, d_t9 + d_delta );
+
+    p_abunds->syncAbundances( zone.getNucnetZone() );
+
+    set_zone_for_evolution( zone );
+
+    get_network_jacobian_for_zone( zone )->computeFlowVector(
+      *get_zone_rates( zone ), p_y, p_column
+    );
+
+    double d_residual_delta = residual( zone );
+
+    //--------------------------------------------------------------------------
+    // Matrix, flows, and residual at t9.
+    //--------------------------------------------------------------------------
+
+    zone.updateProperty( nnt::s_T9, d_t9 );
+
+    p_jacobian =
+      compute_evolution_jacobian_and_vector( zone, *p_abunds, *p_workspace );
+
+    double d_residual = residual( zone );
+
+    gsl_vector_sub( p_column, p_rhs );
+    gsl_vector_scale( p_column, 1. / d_delta );
+
+    p_jacobian->addValueToDiagonals( 1.0 / d_dt );
+
+    gsl_vector_memcpy( p_work, p_y );
+    gsl_vector_sub( p_work, p_y_old );
+    gsl_vector_scale( p_work, 1. / d_dt );
+    gsl_vector_sub( p_rhs, p_work );
+
+    //--------------------------------------------------------------------------
+    // Solve for the abundance correction at fixed t9 and for the abundance
+    // change per unit change in t9.
+    //--------------------------------------------------------------------------
+
+    solve_matrix_for_zone( zone, *p_jacobian, p_rhs, p_sol );
+
+    solve_matrix_for_zone( zone, *p_jacobian, p_column, p_t9_sol );
+
+    //--------------------------------------------------------------------------
+    // Eliminate the abundance corrections from the t9 equation.
+    //--------------------------------------------------------------------------
+
+    double d_denom =
+      ( d_residual_delta - d_residual ) / d_delta
+      +
+      compute_t9_residual_change(
+        zone, *p_abunds, residual, d_residual, p_t9_sol, p_work
+      );
+
+    if( WnMatrix__value_is_zero( d_denom ) ) break;
+
+    double d_t9_change =
+      -(
+        d_residual
+        +
+        compute_t9_residual_change(
+          zone, *p_abunds, residual, d_residual, p_sol, p_work
+        )
+      ) / d_denom;
+
+    if( fabs( d_t9_change ) > D_T9_MAX * d_t9 )
+      d_t9_change = GSL_SIGN( d_t9_change ) * D_T9_MAX * d_t9;
+
+    for( size_t i = 0; i < p_sol->size; i++ )
+      gsl_vector_set(
+        p_sol,
+        i,
+        gsl_vector_get( p_sol, i ) +
+          d_t9_change * gsl_vector_get( p_t9_sol, i )
+      );
+
+    //--------------------------------------------------------------------------
+    // Check solution and update abundances and t9.
+    //--------------------------------------------------------------------------
+
+    check = check_matrix_solution( zone, *p_abunds, p_sol );
+
+    gsl_vector_add( p_y, p_sol );
+
+    p_abunds->markAbundancesChanged();
+
+    d_t9 += d_t9_change;
+
+    zone.updateProperty( nnt::s_T9, d_t9 );
+
+    //--------------------------------------------------------------------------
+    // Exit iterations if converged.
+    //--------------------------------------------------------------------------
+
+    if( check.first < d_tol && fabs( d_t9_change ) < d_tol * d_t9 )
+    {
+      b_converged = true;
+      break;
+    }
+
+    //--------------------------------------------------------------------------
+    // Stop if large negative abundances.
+    //--------------------------------------------------------------------------
+
+    if(
+      zone.hasProperty( nnt::s_LARGE_NEG_ABUND_THRESHOLD ) &&
+      !p_abunds->zeroSmallNegativeAbundances(
+        zone.getProperty<double>( nnt::s_LARGE_NEG_ABUND_THRESHOLD )
+      )
+    )
+      break;
+
+  }
+
+  gsl_vector_free( p_column );
+  gsl_vector_free( p_t9_sol );
 
-  gsl_vector_free( p_work );
-  
   //==========================================================================
-  // Free allocated memory and return.
+  // Restore the zone if not converged.
   //==========================================================================
 
-  gsl_vector_free( p_y_old );
+  if( !b_converged )
+  {
+    gsl_vector_memcpy( p_y, p_y_old );
+    p_abunds->writeAbundances( zone.getNucnetZone() );
+    zone.updateProperty( nnt::s_T9, d_t9_old );
+    return -1;
+  }
+
+  //==========================================================================
+  // Write the abundances and update abundance changes.
+  //==========================================================================
+
+  p_abunds->syncAbundances( zone.getNucnetZone() );
+
+  gsl_vector_memcpy( &dy_view.vector, p_y );
+
+  gsl_vector_sub( &dy_view.vector, p_y_old );
+
+  p_abunds->writeAbundanceChanges( zone.getNucnetZone() );
 
   return (int) i_iter;
 
 }
 
+//##############################################################################
+// compute_t9_residual_change()
+//##############################################################################
+
+/**
+ * \brief Compute the change in a t9 residual along an abundance change, that
+ *        is, the product of the residual's abundance gradient with the
+ *        change, by a finite difference.  The step is scaled so that the
+ *        largest relative change of the abundances that count in
+ *        check_matrix_solution() is D_T9_DELTA.
+ *
+ * \param zone A Nucnet Tools zone.
+ * \param abunds The zone's dense abundance arrays.  They are restored on
+ *        return, and the zone is brought up to date with them at the next
+ *        sync.
+ * \param residual The t9 residual function.
+ * \param d_residual The residual at the current abundances.
+ * \param p_change The abundance change.
+ * \param p_save A vector to hold the current abundances.
+ * \return The change in the residual per unit step along the change.
+ */
+
+double
+compute_t9_residual_change(
+  nnt::Zone& zone,
+  ZoneAbundances& abunds,
+  const boost::function<double( nnt::Zone& )>& residual,
+  double d_residual,
+  const gsl_vector * p_change,
+  gsl_vector * p_save
+)
+{
+
+  double d_check = check_matrix_solution( zone, abunds, p_change ).first;
+
+  if( WnMatrix__value_is_zero( d_check ) ) return 0.;
+
+  double d_step = D_T9_DELTA / d_check;
+
+  gsl_vector_view y_view = abunds.getAbundanceView();
+
+  gsl_vector_memcpy( p_save, &y_view.vector );
+
+  for( size_t i = 0; i < p_save->size; i++ )
+    gsl_vector_set(
+      &y_view.vector,
+      i,
+      gsl_vector_get( p_save, i ) + d_step * gsl_vector_get( p_change, i )
+    );
+
+  abunds.writeAbundances( zone.getNucnetZone() );
+
+  double d_result = ( residual( zone ) - d_residual ) / d_step;
+
+  gsl_vector_memcpy( &y_view.vector, p_save );
+
+  abunds.markAbundancesChanged();
+
+  return d_result;
+
+}
+
+//##############################################################################
+// is_coupled_t9_evolution()
+//##############################################################################
+
+/**
+ * \brief Determine whether t9 and the abundances in a zone should be found
+ *        in one coupled Newton-Raphson iteration (property
+ *        s_COUPLED_T9_EVOLUTION set to "yes").
+ *
+ * \param zone A Nucnet Tools zone.
+ * \return True if coupled, false if not.
+ */
+
+bool
+is_coupled_t9_evolution( nnt::Zone& zone )
+{
+
+  return
+    zone.hasProperty( nnt::s_COUPLED_T9_EVOLUTION ) &&
+    zone.getProperty<std::string>( nnt::s_COUPLED_T9_EVOLUTION ) == "yes";
+
+}
+
 //##############################################################################
 // default_safe_evolve_check_function()
 //##############################################################################
@@ -239,7 +564,7 @@ safe_evolve(
 )
 {
 
-  gsl_vector *p_y, *p_y_old;
+  gsl_vector *p_y_old;
   double d_t;
   boost::function<bool( nnt::Zone& )> check_f;
 
@@ -304,18 +629,24 @@ safe_evolve(
     );
   }
 
-  p_y = Libnucnet__Zone__getAbundances( p_zone );
+  boost::shared_ptr<ZoneAbundances> p_abunds = get_zone_abundances( zone );
+
+  p_abunds->readAbundances( p_zone );
 
-  gsl_vector_sub( p_y, p_y_old );
+  gsl_vector_view y_view = p_abunds->getAbundanceView();
+  gsl_vector_view dy_view = p_abunds->getAbundanceChangeView();
 
-  Libnucnet__Zone__updateAbundanceChanges( p_zone, p_y );
+  gsl_vector_memcpy( &dy_view.vector, &y_view.vector );
+
+  gsl_vector_sub( &dy_view.vector, p_y_old );
+
+  p_abunds->writeAbundanceChanges( p_zone );
 
   zone.updateProperty(
     nnt::s_DTIME,
     d_dt
   );
 
-  gsl_vector_free( p_y );
   gsl_vector_free( p_y_old );
 
 }
@@ -548,13 +879,8 @@ evolve_zone( nnt::Zone& zone, double d_t_end )
   // Update timestep.
   //============================================================================
 
-    Libnucnet__Zone__updateTimeStep(
-      zone.getNucnetZone(),
-      &d_dt,
-      0.15,
-      0.15,
-      1.e-10
-    );
+    d_dt =
+      get_zone_abundances( zone )->computeTimeStep( d_dt, 0.15, 0.15, 1.e-10 );
 
     if ( d_t + d_dt > d_t_end ) {
 
@@ -586,7 +912,7 @@ evolve_zone( nnt::Zone& zone, double d_t_end )
     ) %
       Libnucnet__Zone__getLabel( zone.getNucnetZone(), 1 ) %
       i_steps %
-      ( 1. - Libnucnet__Zone__computeAMoment( zone.getNucnetZone(), 1 ) );
+      ( 1. - get_zone_abundances( zone )->computeAMoment( 1 ) );
 
   return 0;
 
@@ -738,11 +1064,7 @@ set_zone_for_evolution( nnt::Zone& zone )
   // Compute rates.
   //--------------------------------------------------------------------------
 
-  Libnucnet__Zone__computeRates(
-    zone.getNucnetZone(),
-    zone.getProperty<double>( nnt::s_T9 ),
-    zone.getProperty<double>( nnt::s_RHO )
-  ); 
+  compute_rates_for_zone( zone );
 
   //--------------------------------------------------------------------------
   // Set weak detailed balance.
@@ -787,17 +1109,16 @@ std::pair< WnMatrix *, gsl_vector *>
 get_evolution_matrix_and_vector( nnt::Zone& zone )
 {
 
-  set_zone_for_evolution( zone );
+  boost::shared_ptr<NetworkJacobian> p_jacobian;
+  gsl_vector * p_rhs;
+
+  boost::tie( p_jacobian, p_rhs ) = get_evolution_jacobian_and_vector( zone );
 
   //--------------------------------------------------------------------------
   // Return pair.
   //--------------------------------------------------------------------------
 
-  return
-    std::make_pair(
-      Libnucnet__Zone__computeJacobianMatrix( zone.getNucnetZone() ),
-      Libnucnet__Zone__computeFlowVector( zone.getNucnetZone() )
-    );
+  return std::make_pair( p_jacobian->getWnMatrix(), p_rhs );
 
 }
 
@@ -809,13 +1130,99 @@ WnMatrix *
 get_evolution_matrix( nnt::Zone& zone )
 {
 
-  set_zone_for_evolution( zone );
+  boost::shared_ptr<NetworkJacobian> p_jacobian;
+  gsl_vector * p_rhs;
+
+  boost::tie( p_jacobian, p_rhs ) = get_evolution_jacobian_and_vector( zone );
+
+  gsl_vector_free( p_rhs );
 
   //--------------------------------------------------------------------------
   // Return matrix.
   //--------------------------------------------------------------------------
 
-  return Libnucnet__Zone__computeJacobianMatrix( zone.getNucnetZone() );
+  return p_jacobian->getWnMatrix();
+
+}
+
+//##############################################################################
+// get_evolution_jacobian_and_vector().
+//##############################################################################
+
+/**
+ * \brief Set the zone for evolution and compute the compiled network
+ *        Jacobian and the flow vector.
+ *
+ * \param zone A Nucnet Tools zone.
+ * \return A pair with a shared pointer to the zone's network Jacobian and
+ *         a new gsl_vector containing the flows.  The caller must free the
+ *         vector.
+ */
+
+std::pair< boost::shared_ptr<NetworkJacobian>, gsl_vector * >
+get_evolution_jacobian_and_vector( nnt::Zone& zone )
+{
+
+  gsl_vector * p_abunds, * p_rhs;
+
+  set_zone_for_evolution( zone );
+
+  boost::shared_ptr<NetworkJacobian> p_jacobian =
+    get_network_jacobian_for_zone( zone );
+
+  p_abunds = Libnucnet__Zone__getAbundances( zone.getNucnetZone() );
+
+  boost::shared_ptr<ZoneRates> p_rates = get_zone_rates( zone );
+
+  p_jacobian->computeMatrix( *p_rates, p_abunds );
+
+  p_rhs = p_jacobian->computeFlowVector( *p_rates, p_abunds );
+
+  gsl_vector_free( p_abunds );
+
+  return std::make_pair( p_jacobian, p_rhs );
+
+}
+
+/**
+ * \brief Set the zone for evolution and compute the compiled network
+ *        Jacobian and the flow vector into an evolution workspace.
+ *
+ * \param zone A Nucnet Tools zone.
+ * \param abunds The zone's dense abundance arrays.  The abundance array
+ *        is written to the zone first if it was changed, since the rate
+ *        and screening data functions read the zone.
+ * \param workspace The zone's evolution workspace.  On return, the
+ *        right-hand-side vector holds the flows.
+ * \return A shared pointer to the zone's network Jacobian.
+ */
+
+boost::shared_ptr<NetworkJacobian>
+compute_evolution_jacobian_and_vector(
+  nnt::Zone& zone,
+  ZoneAbundances& abunds,
+  EvolutionWorkspace& workspace
+)
+{
+
+  abunds.syncAbundances( zone.getNucnetZone() );
+
+  set_zone_for_evolution( zone );
+
+  boost::shared_ptr<NetworkJacobian> p_jacobian =
+    get_network_jacobian_for_zone( zone );
+
+  gsl_vector_view y_view = abunds.getAbundanceView();
+
+  boost::shared_ptr<ZoneRates> p_rates = get_zone_rates( zone );
+
+  p_jacobian->computeMatrix( *p_rates, &y_view.vector );
+
+  p_jacobian->computeFlowVector(
+    *p_rates, &y_view.vector, workspace.getRhs()
+  );
+
+  return p_jacobian;
 
 }
 
@@ -875,6 +1282,55 @@ check_matrix_solution( nnt::Zone& zone, gsl_vector * p_sol )
 
 }
        
+/**
+ * \brief Check a Newton-Raphson correction against the dense abundance
+ *        array.  The result is the same as that of
+ *        check_matrix_solution( zone, p_sol ) when the array matches the
+ *        zone's abundances.
+ *
+ * \param zone A Nucnet Tools zone.
+ * \param abunds The zone's dense abundance arrays.
+ * \param p_sol The correction.
+ * \return A pair giving the largest relative abundance change and the
+ *         norm of the mass-weighted changes.
+ */
+
+std::pair<double,double>
+check_matrix_solution(
+  nnt::Zone& zone,
+  const ZoneAbundances& abunds,
+  const gsl_vector * p_sol
+)
+{
+
+  double d_check = 0, d_total = 0, d_y_min = D_Y_MIN;
+
+  const std::vector<double>& v_y = abunds.getAbundanceVector();
+  const std::vector<double>& v_a = abunds.getMassNumberVector();
+
+  if( zone.hasProperty( nnt::s_NEWTON_RAPHSON_ABUNDANCE ) )
+    d_y_min = zone.getProperty<double>( nnt::s_NEWTON_RAPHSON_ABUNDANCE );
+
+  for( size_t i = 0; i < v_a.size(); i++ )
+  {
+
+    double d_abund = v_y[i];
+    double d_dy = gsl_vector_get( p_sol, i );
+
+    if( d_abund > d_y_min )
+    {
+      double d_checkT = fabs( d_dy / d_abund );
+      if( d_checkT > d_check ) d_check = d_checkT;
+    }
+
+    d_total += gsl_pow_2( d_dy * v_a[i] );
+
+  }
+
+  return std::make_pair( d_check, sqrt( d_total ) );
+
+}
+       
 //##############################################################################
 // network_t9_from_entropy_root(). 
 //##############################################################################
@@ -964,4 +1420,77 @@ network_density_from_entropy_root(
 
 }
 
+//##############################################################################
+// compute_entropy_t9_residual().
+//##############################################################################
+
+/**
+ * \brief The t9 residual for evolution at the zone's entropy per nucleon
+ *        (property s_ENTROPY_PER_NUCLEON).  This is the residual of
+ *        network_t9_from_entropy_root() without the evolution, for use
+ *        with evolve_with_t9().
+ *
+ * \param zone A Nucnet Tools zone.
+ * \return The entropy per nucleon at the zone's t9 and abundances minus the
+ *         zone's entropy per nucleon.
+ */
+
+double
+compute_entropy_t9_residual( nnt::Zone& zone )
+{
+
+  return
+    compute_thermo_quantity(
+      zone,
+      nnt::s_ENTROPY_PER_NUCLEON,
+      nnt::s_TOTAL
+    )
+    -
+    zone.getProperty<double>( nnt::s_ENTROPY_PER_NUCLEON );
+
+}
+
+//##############################################################################
+// compute_self_heating_t9_residual().
+//##############################################################################
+
+/**
+ * \brief The t9 residual for evolution with heating by the network.  The
+ *        entropy per nucleon changes over the time step (property s_DTIME)
+ *        by the energy generation rate from
+ *        compute_energy_generation_rate_per_nucleon() for the evolution
+ *        network divided by kT, evaluated at the end of the step.
+ *
+ * \param zone A Nucnet Tools zone.
+ * \param d_entropy_old The entropy per nucleon at the start of the step.
+ *        Any entropy change from other sources should be included.
+ * \return The residual of the backward-Euler entropy equation.
+ */
+
+double
+compute_self_heating_t9_residual( nnt::Zone& zone, double d_entropy_old )
+{
+
+  return
+    compute_thermo_quantity(
+      zone,
+      nnt::s_ENTROPY_PER_NUCLEON,
+      nnt::s_TOTAL
+    )
+    -
+    d_entropy_old
+    -
+    zone.getProperty<double>( nnt::s_DTIME ) *
+    compute_energy_generation_rate_per_nucleon(
+      zone,
+      zone.getNetView( EVOLUTION_NETWORK )
+    ) /
+    (
+      GSL_CONST_CGSM_BOLTZMANN *
+      zone.getProperty<double>( nnt::s_T9 ) *
+      GSL_CONST_NUM_GIGA
+    );
+
+}
+
 } // namespace user
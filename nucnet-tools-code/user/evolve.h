@@ -40,8 +40,12 @@
 #include "user/nse_corr.h"
 #include "user/network_limiter.h"
 #include "user/matrix_solver.h"
+#include "user/network_jacobian.h"
+#include "user/evolution_workspace.h"
+#include "user/zone_abundances.h"
 #include "user/weak_utilities.h"
 #include "user/rate_modifiers.h"
+#include "user/flow_utilities.h"
 
 
 namespace user
@@ -55,6 +59,8 @@ namespace user
 #define D_X_EPS        1.e-08  // Xsum check for safe evolve
 #define D_Y_MIN        1.e-10  // Smallest y for convergence
 #define I_ITMAX        30      // Maximum number of Newton-Raphson iterations
+#define D_T9_DELTA     1.e-06  // Relative step for coupled t9 derivatives
+#define D_T9_MAX       0.1     // Largest relative t9 change per coupled step
 
 //##############################################################################
 // Enumeration.
@@ -69,6 +75,21 @@ enum solvers { ARROW, GSL };
 int
 evolve( nnt::Zone& );
 
+int
+evolve_with_t9( nnt::Zone&, const boost::function<double( nnt::Zone& )>& );
+
+double
+compute_t9_residual_change(
+  nnt::Zone&,
+  ZoneAbundances&,
+  const boost::function<double( nnt::Zone& )>&,
+  double,
+  const gsl_vector *,
+  gsl_vector *
+);
+
+bool is_coupled_t9_evolution( nnt::Zone& );
+
 void
 safe_evolve( nnt::Zone&, double, const double, const double );
 
@@ -99,16 +120,31 @@ get_evolution_matrix( nnt::Zone& );
 std::pair< WnMatrix *, gsl_vector * >
 get_evolution_matrix_and_vector( nnt::Zone& );
 
+std::pair< boost::shared_ptr<NetworkJacobian>, gsl_vector * >
+get_evolution_jacobian_and_vector( nnt::Zone& );
+
+boost::shared_ptr<NetworkJacobian>
+compute_evolution_jacobian_and_vector(
+  nnt::Zone&, ZoneAbundances&, EvolutionWorkspace&
+);
+
 std::pair<double,double>
 check_matrix_solution(
   nnt::Zone&,
   gsl_vector *
 );
 
+std::pair<double,double>
+check_matrix_solution( nnt::Zone&, const ZoneAbundances&, const gsl_vector * );
+
 double network_t9_from_entropy_root( double, nnt::Zone& );
 
 double network_density_from_entropy_root( double, nnt::Zone& );
 
+double compute_entropy_t9_residual( nnt::Zone& );
+
+double compute_self_heating_t9_residual( nnt::Zone&, double );
+
 } // namespace user
 
 #endif // EVOLVE_H
@@ -1177,24 +1177,50 @@ compute_energy_generation_rate_per_nucleon(
       nnt::s_ELECTRON
     );
 
-  nnt::reaction_list_t reaction_list =
-    nnt::make_reaction_list(
-      Libnucnet__Net__getReac(
-        Libnucnet__NetView__getNet( p_net_view )
-      )
-    );
+  //============================================================================
+  // The Q values and the changes in nuclide number and charge come from the
+  // compiled topology of the view.
+  //============================================================================
+
+  boost::shared_ptr<ReactionTopology> p_topology =
+    get_reaction_topology( zone, p_net_view );
+
+  const std::vector<Libnucnet__Reaction *>& v_reactions =
+    p_topology->getReactionVector();
+  const std::vector<double>& v_q = p_topology->getQValueVector();
+  const std::vector<int>& v_y = p_topology->getNuclideNumberChangeVector();
+  const std::vector<int>& v_z = p_topology->getChargeChangeVector();
+
+  double d_kinetic_part =
+    1.5 *
+    GSL_CONST_CGSM_BOLTZMANN *
+    zone.getProperty<double>( nnt::s_T9 ) *
+    GSL_CONST_NUM_GIGA;
+
+  double d_charge_part =
+    d_electron_energy_part
+    +
+    nnt::d_ELECTRON_MASS_IN_MEV *
+    GSL_CONST_CGSM_ELECTRON_VOLT *
+    GSL_CONST_NUM_MEGA;
 
   flow_data_tuple_t flow_data_tuple = make_flow_data_tuple( zone );
 
-  BOOST_FOREACH( nnt::Reaction reaction, reaction_list )
+  for( size_t r = 0; r < v_reactions.size(); r++ )
   {
+
+    std::pair<double,double> flows =
+      compute_flows_for_reaction( zone, v_reactions[r], flow_data_tuple );
+
     d_result +=
-      compute_energy_generation_rate_per_nucleon_for_reaction(
-        zone,
-        reaction.getNucnetReaction(),
-        d_electron_energy_part,
-        flow_data_tuple
-      );
+      (
+        v_q[r] * GSL_CONST_CGSM_ELECTRON_VOLT * GSL_CONST_NUM_MEGA
+        +
+        v_y[r] * d_kinetic_part
+        +
+        v_z[r] * d_charge_part
+      ) * ( flows.first - flows.second );
+
   }
 
   return d_result;
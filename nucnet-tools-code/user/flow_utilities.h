@@ -40,6 +40,7 @@
 
 #include "thermo.h"
 #include "user/rate_modifiers.h"
+#include "user/reaction_topology.h"
 #include "screen.h"
 #include "nse_corr.h"
 #include "weak_utilities.h"
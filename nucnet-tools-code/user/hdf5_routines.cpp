@@ -69,6 +69,24 @@ append_zones(
   Libnucnet * p_nucnet,
   const char * s_group
 )
+{
+
+  H5::H5File file( s_file, H5F_ACC_RDWR );
+
+  append_zones( file, p_nucnet, s_group );
+
+}
+
+//##############################################################################
+// append_zones()
+//##############################################################################
+
+void
+append_zones(
+  H5::H5File& file,
+  Libnucnet * p_nucnet,
+  const char * s_group
+)
 {
 
   H5::DataSpace dataspace;
@@ -83,11 +101,9 @@ append_zones(
   H5::StrType string_type( H5::PredType::C_S1, I_HDF5_BUF );
 
   //===========================================================================
-  // Open file and create group.
+  // Create group.
   //===========================================================================
 
-  H5::H5File file( s_file, H5F_ACC_RDWR );
-
   H5::Group group = file.createGroup( s_group );
 
   nnt::species_list_t species_list =
@@ -267,6 +283,85 @@ append_zones(
 
 }
 
+//##############################################################################
+// Hdf5OutputWriter::Hdf5OutputWriter().
+//##############################################################################
+
+/**
+ * \brief Create an hdf5 output file and write the nuclide data to it.  The
+ *        file stays open until the writer is finalized.
+ * \param s_file The output file.
+ * \param p_nucnet The Libnucnet structure whose network is written.
+ */
+
+Hdf5OutputWriter::Hdf5OutputWriter(
+  const char * s_file,
+  Libnucnet * p_nucnet
+) : file( s_file, H5F_ACC_TRUNC ), iGroups( 0 ), bOpen( true )
+{
+
+  write_nuclide_data( file, p_nucnet );
+
+  file.flush( H5F_SCOPE_GLOBAL );
+
+}
+
+//##############################################################################
+// Hdf5OutputWriter::~Hdf5OutputWriter().
+//##############################################################################
+
+Hdf5OutputWriter::~Hdf5OutputWriter()
+{
+
+  finalize();
+
+}
+
+//##############################################################################
+// Hdf5OutputWriter::appendZones().
+//##############################################################################
+
+/**
+ * \brief Append the zones of a step as the next step group and flush the
+ *        file.  The groups are counted by the writer rather than in the
+ *        file.
+ * \param p_nucnet The Libnucnet structure containing the zones.
+ */
+
+void
+Hdf5OutputWriter::appendZones( Libnucnet * p_nucnet )
+{
+
+  if( !bOpen )
+  {
+    std::cerr << "Hdf5 output file was finalized." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  append_zones(
+    file, p_nucnet, create_group_label( iGroups++ ).c_str()
+  );
+
+  file.flush( H5F_SCOPE_GLOBAL );
+
+}
+
+//##############################################################################
+// Hdf5OutputWriter::finalize().
+//##############################################################################
+
+void
+Hdf5OutputWriter::finalize()
+{
+
+  if( !bOpen ) return;
+
+  file.close();
+
+  bOpen = false;
+
+}
+
 //##############################################################################
 // populate_zone_properties().
 //##############################################################################
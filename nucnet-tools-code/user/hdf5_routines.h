@@ -51,6 +51,7 @@
 #include "nnt/auxiliary.h"
 
 #include "user/containers.h"
+#include "user/output_writer.h"
 
 namespace user
 {
@@ -203,6 +204,32 @@ typedef boost::multi_index::multi_index_container<
   >
 > zone_properties_hash;
 
+//##############################################################################
+// Class for hdf5 output.
+//##############################################################################
+
+/**
+ * \brief An output writer for the hdf5 layout of create_output() and
+ *        append_zones().  Each step is written as the next step group of a
+ *        file that is kept open.
+ */
+
+class Hdf5OutputWriter : public OutputWriter
+{
+
+  public:
+    Hdf5OutputWriter( const char *, Libnucnet * );
+    ~Hdf5OutputWriter();
+    void appendZones( Libnucnet * );
+    void finalize();
+
+  private:
+    H5::H5File file;
+    size_t iGroups;
+    bool bOpen;
+
+};
+
 //##############################################################################
 // Prototypes.
 //############################################################################*/
@@ -213,6 +240,8 @@ void append_zones( const char *, Libnucnet *, const char * );
 
 void append_zones( const char *, Libnucnet * );
 
+void append_zones( H5::H5File&, Libnucnet *, const char * );
+
 void
 populate_zone_properties(
   const char *,
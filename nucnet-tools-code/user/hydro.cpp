@@ -83,7 +83,7 @@ get_nucnet( int argc, char **argv )
       argv[0]
     );
     fprintf(
-      stderr, "  net_file = input network data xml filename\n\n"
+      stderr, "  net_file = input network xml or binary data filename\n\n"
     );
     fprintf(
       stderr, "  zone_file = input single zone data xml filename\n\n"
@@ -111,7 +111,7 @@ get_nucnet( int argc, char **argv )
   // Validate input net file.
   //============================================================================
 
-  if( strcmp( VALIDATE, "yes" ) == 0 )
+  if( strcmp( VALIDATE, "yes" ) == 0 && !is_binary_data_file( argv[1] ) )
   {
     if( !Libnucnet__Net__is_valid_input_xml( argv[1] ) ) {
       fprintf( stderr, "Not valid libnucnet net input!\n" );
@@ -132,38 +132,17 @@ get_nucnet( int argc, char **argv )
   }
 
   //============================================================================
-  // Read and store input.
+  // Read and store input.  The network is read through the network cache.
   //============================================================================
 
   p_nucnet = Libnucnet__new();
 
-  if( argc == 4 )
-  {
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_nucnet ),
-      argv[1],
-      NULL,
-      NULL
-    );
-  }
-  else if( argc == 5 )
-  {
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_nucnet ),
-      argv[1],
-      argv[4],
-      NULL
-    );
-  }
-  else
-  {
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_nucnet ),
-      argv[1],
-      argv[4],
-      argv[5]
-    );
-  }
+  update_net_from_network_cache(
+    Libnucnet__getNet( p_nucnet ),
+    argv[1],
+    argc > 4 ? argv[4] : NULL,
+    argc > 5 ? argv[5] : NULL
+  );
 
   Libnucnet__assignZoneDataFromXml( p_nucnet, argv[2], NULL );
 
@@ -354,6 +333,7 @@ set_zone( Libnucnet * p_nucnet, nnt::Zone& zone, char ** argv )
 //##############################################################################
 
 std::vector<double> time, t9, log10_rho;
+boost::shared_ptr<Trajectory> p_trajectory;
 
 //##############################################################################
 // get_nucnet().
@@ -408,13 +388,13 @@ get_nucnet( int argc, char **argv )
       argv[0]
     );
     fprintf(
-      stderr, "  net_file = input network data xml filename\n\n"
+      stderr, "  net_file = input network xml or binary data filename\n\n"
     );
     fprintf(
-      stderr, "  zone_file = input zone data xml filename\n\n"
+      stderr, "  zone_file = input zone xml or binary data filename\n\n"
     );
     fprintf(
-      stderr, "  traj_file = trajectory text file\n\n"
+      stderr, "  traj_file = trajectory text or binary data file\n\n"
     );
 #ifdef HDF5
     fprintf(
@@ -439,7 +419,7 @@ get_nucnet( int argc, char **argv )
   // Validate input net file.
   //============================================================================
 
-  if( strcmp( VALIDATE, "yes" ) == 0 )
+  if( strcmp( VALIDATE, "yes" ) == 0 && !is_binary_data_file( argv[1] ) )
   {
     if( !Libnucnet__Net__is_valid_input_xml( argv[1] ) ) {
       fprintf( stderr, "Not valid libnucnet input!\n" );
@@ -451,7 +431,7 @@ get_nucnet( int argc, char **argv )
   // Validate input zone file.
   //============================================================================
 
-  if( strcmp( VALIDATE, "yes" ) == 0 )
+  if( strcmp( VALIDATE, "yes" ) == 0 && !is_binary_data_file( argv[2] ) )
   {
     if( !Libnucnet__is_valid_zone_data_xml( argv[2] ) ) {
       fprintf( stderr, "Not valid libnucnet zone data input!\n" );
@@ -460,22 +440,29 @@ get_nucnet( int argc, char **argv )
   }
 
   //============================================================================
-  // Read and store input.
+  // Read and store input.  The network may be given in the binary data
+  // format, in which case the xpath expressions must be ones that
+  // nnt::ViewSelector compiles.  An xml network is read through the
+  // network cache.
   //============================================================================
 
-  if( argc == 5 ) {
-    p_nucnet = Libnucnet__new_from_xml( argv[1], NULL, NULL, NULL );
-  } else if( argc == 6 ) {
-    p_nucnet = Libnucnet__new_from_xml( argv[1], argv[5], NULL, NULL );
-  } else {
-    p_nucnet = Libnucnet__new_from_xml( argv[1], argv[5], argv[6], NULL );
-  }
+  p_nucnet = Libnucnet__new();
+
+  update_net_from_network_cache(
+    Libnucnet__getNet( p_nucnet ),
+    argv[1],
+    argc > 5 ? argv[5] : NULL,
+    argc > 6 ? argv[6] : NULL
+  );
 
   //============================================================================
   // Get zone data.
   //============================================================================
 
-  Libnucnet__assignZoneDataFromXml( p_nucnet, argv[2], NULL );
+  if( is_binary_data_file( argv[2] ) )
+    assign_zone_data_from_binary_data( p_nucnet, argv[2] );
+  else
+    Libnucnet__assignZoneDataFromXml( p_nucnet, argv[2], NULL );
 
   //============================================================================
   // Get trajectory data.
@@ -483,6 +470,8 @@ get_nucnet( int argc, char **argv )
 
   get_trajectory_data( argv[3] );
 
+  p_trajectory.reset( new Trajectory( "spline", time, t9, log10_rho ) );
+
   //============================================================================
   // Done.
   //============================================================================
@@ -502,6 +491,16 @@ get_trajectory_data( char *s_file )
   std::ifstream my_file;
   double d_x1, d_x2, d_x3;
 
+  //============================================================================
+  // Binary trajectory.
+  //============================================================================
+
+  if( is_binary_data_file( s_file ) )
+  {
+    get_trajectory_from_binary_data( s_file, time, t9, log10_rho );
+    return;
+  }
+
   //============================================================================
   // Open file thermodynamics file.
   //============================================================================
@@ -549,13 +548,7 @@ initialize_zone( nnt::Zone& zone, char ** argv )
     argv[4]
   );
 
-  update_t9_rho_in_zone_by_interpolation(
-    zone,
-    "spline",
-    time,
-    t9,
-    log10_rho
-  );
+  update_t9_rho_in_zone_by_interpolation( zone, p_trajectory );
 
   return;
 
@@ -664,7 +657,7 @@ get_nucnet( int argc, char **argv )
       argv[0]
     );
     fprintf(
-      stderr, "  net_file = input network data xml filename\n\n"
+      stderr, "  net_file = input network xml or binary data filename\n\n"
     );
     fprintf(
       stderr, "  zone_file = input single zone data xml filename\n\n"
@@ -697,7 +690,7 @@ get_nucnet( int argc, char **argv )
   // Validate input net file.
   //============================================================================
 
-  if( strcmp( VALIDATE, "yes" ) == 0 )
+  if( strcmp( VALIDATE, "yes" ) == 0 && !is_binary_data_file( argv[1] ) )
   {
     if( !Libnucnet__Net__is_valid_input_xml( argv[1] ) ) {
       fprintf( stderr, "Not valid libnucnet net input!\n" );
@@ -718,38 +711,17 @@ get_nucnet( int argc, char **argv )
   }
 
   //============================================================================
-  // Read and store input.
+  // Read and store input.  The network is read through the network cache.
   //============================================================================
 
   p_nucnet = Libnucnet__new();
 
-  if( argc == 4 )
-  {
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_nucnet ),
-      argv[1],
-      NULL,
-      NULL
-    );
-  }
-  else if( argc == 5 )
-  {
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_nucnet ),
-      argv[1],
-      argv[4],
-      NULL
-    );
-  }
-  else
-  {
-    Libnucnet__Net__updateFromXml(
-      Libnucnet__getNet( p_nucnet ),
-      argv[1],
-      argv[4],
-      argv[5]
-    );
-  }
+  update_net_from_network_cache(
+    Libnucnet__getNet( p_nucnet ),
+    argv[1],
+    argc > 4 ? argv[4] : NULL,
+    argc > 5 ? argv[5] : NULL
+  );
 
   Libnucnet__assignZoneDataFromXml( p_nucnet, argv[2], NULL );
 
@@ -29,6 +29,8 @@
 #include "nnt/string_defs.h"
 #include "nnt/math.h"
 
+#include "user/binary_data.h"
+#include "user/network_cache.h"
 #include "user/network_utilities.h"
 #include "user/neutrino_rate_functions.h"
 
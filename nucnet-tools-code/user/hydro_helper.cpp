@@ -82,6 +82,18 @@ evolve_function(
 )
 {
 
+  //============================================================================
+  // The abundances were already evolved over this step if t9 was found by
+  // coupled_t9_from_entropy().  The flag is consumed so that it only skips
+  // the one step.
+  //============================================================================
+
+  if( zone.hasData( nnt::s_COUPLED_T9_STEP_EVOLVED ) )
+  {
+    zone.removeData( nnt::s_COUPLED_T9_STEP_EVOLVED );
+    return;
+  }
+
   if(
     Libnucnet__Reac__getNumberOfReactions(
       Libnucnet__Net__getReac(
@@ -165,9 +177,51 @@ t9_from_entropy_root(
 
 }
     
+double
+coupled_t9_from_entropy( nnt::Zone& zone )
+{
+
+  //============================================================================
+  // The coupled iteration restores the zone if it fails.  On success, the
+  // evolved abundances are kept and the step is flagged so that
+  // evolve_function() does not evolve them again.
+  //============================================================================
+
+  if( evolve_with_t9( zone, compute_entropy_t9_residual ) < 0 ) return -1;
+
+  zone.updateData( nnt::s_COUPLED_T9_STEP_EVOLVED, true );
+
+  return zone.getProperty<double>( nnt::s_T9 );
+
+}
+
 double t9_function( nnt::Zone& zone, Libnucnet__NetView * p_view )
 {
 
+  //============================================================================
+  // Clear any flag left from an earlier step, so that only a coupled
+  // iteration on this attempt can mark the abundances as evolved.
+  //============================================================================
+
+  zone.removeData( nnt::s_COUPLED_T9_STEP_EVOLVED );
+
+  if(
+    is_coupled_t9_evolution( zone ) &&
+    Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac(
+        Libnucnet__NetView__getNet( p_view )
+      )
+    ) != 0 &&
+    zone.getProperty<double>( nnt::s_DTIME ) > 1.e-50
+  )
+  {
+
+    double d_t9 = coupled_t9_from_entropy( zone );
+
+    if( d_t9 > 0 ) return d_t9;
+
+  }
+
   double t9 =
     nnt::compute_1d_root(
       boost::bind(
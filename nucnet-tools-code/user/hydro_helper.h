@@ -68,6 +68,8 @@ double t9_from_entropy_root( double, nnt::Zone&, Libnucnet__NetView * );
 
 double compute_entropy( nnt::Zone& );
 
+double coupled_t9_from_entropy( nnt::Zone& );
+
 double t9_function( nnt::Zone&, Libnucnet__NetView * );
 
 void
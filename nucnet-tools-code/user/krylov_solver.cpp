@@ -0,0 +1,597 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the re-entrant ILUT-preconditioned Krylov solvers.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include <gsl/gsl_math.h>
+
+#include "krylov_solver.h"
+#include "sparse_lu_solver.h"
+
+/**
+ * @brief A NucNet Tools namespace for extra (potentially user-supplied)
+ *        codes.
+ */
+namespace user
+{
+
+//##############################################################################
+// ilut_magnitude_greater().
+//##############################################################################
+
+/**
+ * \brief A comparison that orders column indices by decreasing magnitude of
+ *        the corresponding entries of a dense work row.
+ */
+
+class ilut_magnitude_greater
+{
+
+  public:
+    ilut_magnitude_greater( const std::vector<double>& w ) : vW( w ) {}
+    bool operator()( size_t i, size_t j ) const
+      { return fabs( vW[i] ) > fabs( vW[j] ); }
+
+  private:
+    const std::vector<double>& vW;
+
+};
+
+//##############################################################################
+// IlutPreconditioner::IlutPreconditioner().
+//##############################################################################
+
+/**
+ * \brief Compute the ILUT factorization of a matrix.
+ * \param i_rows The number of rows (and columns) in the matrix.
+ * \param row_ptr The zero-based CSR row pointer vector (size i_rows + 1).
+ * \param col The zero-based CSR column index vector.
+ * \param values The matrix values.
+ * \param i_lfil The largest number of entries kept in each row of L and U.
+ * \param d_droptol The drop tolerance.
+ */
+
+IlutPreconditioner::IlutPreconditioner(
+  size_t i_rows,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col,
+  const std::vector<double>& values,
+  size_t i_lfil,
+  double d_droptol
+) : iRows( i_rows )
+{
+
+  std::vector<double> w( iRows, 0. );
+  std::vector<char> is_present( iRows, 0 );
+  std::vector<size_t> lower, upper;
+
+  if( row_ptr.size() != iRows + 1 || row_ptr[iRows] != col.size() )
+  {
+    std::cerr << "Invalid CSR matrix for ILUT preconditioner." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  vLRowPtr.assign( 1, 0 );
+  vURowPtr.assign( 1, 0 );
+  vInverseDiagonal.resize( iRows );
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+
+    double d_tnorm = 0;
+
+    lower.clear();
+    upper.clear();
+
+    //--------------------------------------------------------------------------
+    // Load the row.  The diagonal is always present.
+    //--------------------------------------------------------------------------
+
+    is_present[i] = 1;
+
+    for( size_t p = row_ptr[i]; p < row_ptr[i+1]; p++ )
+    {
+      size_t j = col[p];
+      d_tnorm += fabs( values[p] );
+      w[j] += values[p];
+      if( is_present[j] ) continue;
+      is_present[j] = 1;
+      if( j < i )
+        lower.push_back( j );
+      else
+        upper.push_back( j );
+    }
+
+    if( row_ptr[i+1] > row_ptr[i] )
+      d_tnorm /= (double) ( row_ptr[i+1] - row_ptr[i] );
+
+    if( d_tnorm == 0 ) d_tnorm = 1.;
+
+    double d_drop = d_droptol * d_tnorm;
+
+    //--------------------------------------------------------------------------
+    // Eliminate the lower entries in increasing column order.  Fill-in may
+    // add lower entries, so the next column is found by a search.
+    //--------------------------------------------------------------------------
+
+    for( size_t jj = 0; jj < lower.size(); jj++ )
+    {
+
+      std::iter_swap(
+        lower.begin() + (long) jj,
+        std::min_element( lower.begin() + (long) jj, lower.end() )
+      );
+
+      size_t k = lower[jj];
+
+      double d_fact = w[k] * vInverseDiagonal[k];
+
+      if( fabs( d_fact ) <= d_drop )
+      {
+        w[k] = 0;
+        continue;
+      }
+
+      for( size_t q = vURowPtr[k]; q < vURowPtr[k+1]; q++ )
+      {
+        size_t j = vUCol[q];
+        w[j] -= d_fact * vU[q];
+        if( is_present[j] ) continue;
+        is_present[j] = 1;
+        if( j < i )
+          lower.push_back( j );
+        else
+          upper.push_back( j );
+      }
+
+      w[k] = d_fact;
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Keep the largest lfil multipliers in L.
+    //--------------------------------------------------------------------------
+
+    std::vector<size_t> kept;
+
+    for( size_t jj = 0; jj < lower.size(); jj++ )
+      if( w[lower[jj]] != 0 ) kept.push_back( lower[jj] );
+
+    if( kept.size() > i_lfil )
+    {
+      std::nth_element(
+        kept.begin(),
+        kept.begin() + (long) i_lfil,
+        kept.end(),
+        ilut_magnitude_greater( w )
+      );
+      kept.resize( i_lfil );
+    }
+
+    std::sort( kept.begin(), kept.end() );
+
+    for( size_t jj = 0; jj < kept.size(); jj++ )
+    {
+      vLCol.push_back( kept[jj] );
+      vL.push_back( w[kept[jj]] );
+    }
+
+    vLRowPtr.push_back( vLCol.size() );
+
+    //--------------------------------------------------------------------------
+    // Drop small entries of U and keep the largest lfil.
+    //--------------------------------------------------------------------------
+
+    kept.clear();
+
+    for( size_t jj = 0; jj < upper.size(); jj++ )
+      if( upper[jj] != i && fabs( w[upper[jj]] ) > d_drop )
+        kept.push_back( upper[jj] );
+
+    if( kept.size() > i_lfil )
+    {
+      std::nth_element(
+        kept.begin(),
+        kept.begin() + (long) i_lfil,
+        kept.end(),
+        ilut_magnitude_greater( w )
+      );
+      kept.resize( i_lfil );
+    }
+
+    std::sort( kept.begin(), kept.end() );
+
+    for( size_t jj = 0; jj < kept.size(); jj++ )
+    {
+      vUCol.push_back( kept[jj] );
+      vU.push_back( w[kept[jj]] );
+    }
+
+    vURowPtr.push_back( vUCol.size() );
+
+    //--------------------------------------------------------------------------
+    // Store the inverse diagonal, fixing a zero pivot as ilut does.
+    //--------------------------------------------------------------------------
+
+    if( w[i] == 0 ) w[i] = ( 1.e-4 + d_droptol ) * d_tnorm;
+
+    vInverseDiagonal[i] = 1. / w[i];
+
+    //--------------------------------------------------------------------------
+    // Reset the work row.
+    //--------------------------------------------------------------------------
+
+    w[i] = 0;
+    is_present[i] = 0;
+
+    for( size_t jj = 0; jj < lower.size(); jj++ )
+    {
+      w[lower[jj]] = 0;
+      is_present[lower[jj]] = 0;
+    }
+
+    for( size_t jj = 0; jj < upper.size(); jj++ )
+    {
+      w[upper[jj]] = 0;
+      is_present[upper[jj]] = 0;
+    }
+
+  }
+
+}
+
+//##############################################################################
+// IlutPreconditioner::solve().
+//##############################################################################
+
+/**
+ * \brief Apply the preconditioner, that is, solve (LU) x = b.
+ * \param b The input vector.
+ * \param x The solution vector on return.  It may not be b.
+ */
+
+void
+IlutPreconditioner::solve(
+  const std::vector<double>& b,
+  std::vector<double>& x
+) const
+{
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+    double d_sum = b[i];
+    for( size_t p = vLRowPtr[i]; p < vLRowPtr[i+1]; p++ )
+      d_sum -= vL[p] * x[vLCol[p]];
+    x[i] = d_sum;
+  }
+
+  for( size_t i = iRows; i-- > 0; )
+  {
+    double d_sum = x[i];
+    for( size_t p = vURowPtr[i]; p < vURowPtr[i+1]; p++ )
+      d_sum -= vU[p] * x[vUCol[p]];
+    x[i] = d_sum * vInverseDiagonal[i];
+  }
+
+}
+
+//##############################################################################
+// is_native_krylov_method().
+//##############################################################################
+
+/**
+ * \brief Determine whether an iterative solver method is one of the
+ *        re-entrant Krylov solvers.
+ * \param s_method The method name.
+ * \return True if the method is S_KRYLOV_GMRES or S_KRYLOV_BCGSTAB.
+ */
+
+bool
+is_native_krylov_method( const std::string& s_method )
+{
+
+  return s_method == S_KRYLOV_GMRES || s_method == S_KRYLOV_BCGSTAB;
+
+}
+
+//##############################################################################
+// get_krylov_solver_parameters().
+//##############################################################################
+
+/**
+ * \brief Get the Krylov solver parameters from the zone properties.  The
+ *        properties and defaults are those of the Sparskit2 solver.
+ * \param zone The zone.
+ * \return The parameters.
+ */
+
+krylov_solver_parameters_t
+get_krylov_solver_parameters( nnt::Zone& zone )
+{
+
+  krylov_solver_parameters_t params;
+
+  if( !zone.hasProperty( nnt::s_ITER_SOLVER ) )
+  {
+    std::cerr << "No sparse solver set." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  params.sMethod = zone.getProperty<std::string>( nnt::s_ITER_SOLVER );
+
+  if( !is_native_krylov_method( params.sMethod ) )
+  {
+    std::cerr << "No such Krylov solver: " << params.sMethod << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  params.iMaxIterations =
+    zone.hasProperty( nnt::s_ITER_SOLVER_MAX_ITERATIONS ) ?
+    zone.getProperty<size_t>( nnt::s_ITER_SOLVER_MAX_ITERATIONS ) :
+    I_KRYLOV_MAX_ITERATIONS;
+
+  params.dRelTol =
+    zone.hasProperty( nnt::s_ITER_SOLVER_REL_TOL ) ?
+    zone.getProperty<double>( nnt::s_ITER_SOLVER_REL_TOL ) :
+    1.e-16;
+
+  params.dAbsTol =
+    zone.hasProperty( nnt::s_ITER_SOLVER_ABS_TOL ) ?
+    zone.getProperty<double>( nnt::s_ITER_SOLVER_ABS_TOL ) :
+    0.;
+
+  params.bRhsConvergence = false;
+
+  if( zone.hasProperty( nnt::s_ITER_SOLVER_CONVERGENCE_METHOD ) )
+  {
+    std::string s_converge =
+      zone.getProperty<std::string>( nnt::s_ITER_SOLVER_CONVERGENCE_METHOD );
+    if( s_converge == S_KRYLOV_CONVERGE_RHS )
+      params.bRhsConvergence = true;
+    else if( s_converge != S_KRYLOV_CONVERGE_INITIAL )
+    {
+      std::cerr << "No such convergence method: " << s_converge << std::endl;
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  params.bDebug =
+    zone.hasProperty( nnt::s_ITER_SOLVER_DEBUG ) &&
+    zone.getProperty<std::string>( nnt::s_ITER_SOLVER_DEBUG ) == "yes";
+
+  params.iDelta =
+    zone.hasProperty( nnt::s_ILU_DELTA ) ?
+    zone.getProperty<size_t>( nnt::s_ILU_DELTA ) :
+    1;
+
+  params.dDropTol =
+    zone.hasProperty( nnt::s_ILU_DROP_TOL ) ?
+    zone.getProperty<double>( nnt::s_ILU_DROP_TOL ) :
+    0.;
+
+  return params;
+
+}
+
+//##############################################################################
+// CsrOperator::multiply().
+//##############################################################################
+
+/**
+ * \brief Multiply the matrix into a vector.
+ * \param x The vector, which has one element per matrix row.
+ * \param y The product.
+ */
+
+void
+CsrOperator::multiply( const double * x, std::vector<double>& y ) const
+{
+
+  for( size_t i = 0; i < y.size(); i++ )
+  {
+    double d_sum = 0;
+    for( size_t p = vRowPtr[i]; p < vRowPtr[i+1]; p++ )
+      d_sum += vValues[p] * x[vCol[p]];
+    y[i] = d_sum;
+  }
+
+}
+
+//##############################################################################
+// krylov_dot().
+//##############################################################################
+
+double
+krylov_dot( const double * x, const double * y, size_t i_size )
+{
+
+  double d_sum = 0;
+
+  for( size_t i = 0; i < i_size; i++ ) d_sum += x[i] * y[i];
+
+  return d_sum;
+
+}
+
+//##############################################################################
+// krylov_solve().
+//##############################################################################
+
+/**
+ * \brief Solve a matrix equation with an ILUT-preconditioned Krylov solver.
+ *        The preconditioner keeps lfil = (elements / rows) + delta entries
+ *        in each row of L and U, as in the Sparskit2 solver.  All the
+ *        workspace is allocated in the call, so the routine is re-entrant
+ *        and many zones may be solved at once in different threads.
+ * \param i_rows The number of rows in the matrix.
+ * \param row_ptr The zero-based CSR row pointer vector.
+ * \param col The zero-based CSR column index vector.
+ * \param values The matrix values.
+ * \param p_rhs The right-hand-side vector.
+ * \param p_sol The vector to hold the solution.
+ * \param params The solver parameters.
+ * \return True if the solution converged, false if not.
+ */
+
+bool
+krylov_solve(
+  size_t i_rows,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col,
+  const std::vector<double>& values,
+  const gsl_vector * p_rhs,
+  gsl_vector * p_sol,
+  const krylov_solver_parameters_t& params
+)
+{
+
+  std::vector<double> b( i_rows ), x( i_rows );
+  size_t i_iter;
+  double d_resid;
+  bool b_converged;
+
+  if( i_rows == 0 ) return false;
+
+  IlutPreconditioner precond(
+    i_rows,
+    row_ptr,
+    col,
+    values,
+    col.size() / i_rows + params.iDelta,
+    params.dDropTol
+  );
+
+  CsrOperator matrix( row_ptr, col, values );
+
+  for( size_t i = 0; i < i_rows; i++ ) b[i] = gsl_vector_get( p_rhs, i );
+
+  if( params.sMethod == S_KRYLOV_GMRES )
+    b_converged =
+      krylov_gmres( matrix, precond, b, x, params, i_iter, d_resid );
+  else
+    b_converged =
+      krylov_bcgstab( matrix, precond, b, x, params, i_iter, d_resid );
+
+  if( params.bDebug )
+    fprintf(
+      stdout,
+      "%s: %lu iterations, residual = %g%s\n",
+      params.sMethod.c_str(),
+      (unsigned long) i_iter,
+      d_resid,
+      b_converged ? "" : " (not converged)"
+    );
+
+  if( !b_converged ) return false;
+
+  for( size_t i = 0; i < i_rows; i++ ) gsl_vector_set( p_sol, i, x[i] );
+
+  return true;
+
+}
+
+//##############################################################################
+// krylov_solve_for_zone().
+//##############################################################################
+
+/**
+ * \brief Solve a zone's matrix equation with the Krylov solver set by the
+ *        zone's iterative solver properties.
+ * \param zone The zone.
+ * \param i_rows The number of rows in the matrix.
+ * \param row_ptr The zero-based CSR row pointer vector.
+ * \param col The zero-based CSR column index vector.
+ * \param values The matrix values.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution or NULL if the solver
+ *         did not converge.
+ */
+
+gsl_vector *
+krylov_solve_for_zone(
+  nnt::Zone& zone,
+  size_t i_rows,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col,
+  const std::vector<double>& values,
+  const gsl_vector * p_rhs
+)
+{
+
+  gsl_vector * p_sol = gsl_vector_alloc( i_rows );
+
+  if(
+    !krylov_solve(
+      i_rows,
+      row_ptr,
+      col,
+      values,
+      p_rhs,
+      p_sol,
+      get_krylov_solver_parameters( zone )
+    )
+  )
+  {
+    gsl_vector_free( p_sol );
+    return NULL;
+  }
+
+  return p_sol;
+
+}
+
+/**
+ * \brief Solve a zone's WnMatrix equation with the Krylov solver set by the
+ *        zone's iterative solver properties.
+ * \param zone The zone.
+ * \param p_matrix A pointer to the WnMatrix.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution or NULL if the solver
+ *         did not converge.
+ */
+
+gsl_vector *
+krylov_solve_for_zone(
+  nnt::Zone& zone,
+  WnMatrix * p_matrix,
+  const gsl_vector * p_rhs
+)
+{
+
+  std::vector<size_t> row_ptr, col;
+  std::vector<double> values;
+
+  get_csr_from_wn_matrix( p_matrix, row_ptr, col, values );
+
+  return
+    krylov_solve_for_zone(
+      zone,
+      WnMatrix__getNumberOfRows( p_matrix ),
+      row_ptr,
+      col,
+      values,
+      p_rhs
+    );
+
+}
+
+} // namespace user
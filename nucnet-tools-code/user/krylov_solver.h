@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the re-entrant ILUT-preconditioned Krylov
+//!        solvers.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef KRYLOV_SOLVER_H
+#define KRYLOV_SOLVER_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <WnMatrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/string_defs.h"
+
+//##############################################################################
+// Defines.  The method and convergence names are those of WnSparseSolve so
+// that the same zone properties select either solver.
+//##############################################################################
+
+#define S_KRYLOV_GMRES              "gmres"
+#define S_KRYLOV_BCGSTAB            "bcgstab"
+#define S_KRYLOV_CONVERGE_INITIAL   "initial residual"
+#define S_KRYLOV_CONVERGE_RHS       "rhs"
+
+#define I_KRYLOV_MAX_ITERATIONS     100
+#define I_KRYLOV_RESTART            16
+
+namespace user
+{
+
+//##############################################################################
+// Solver parameters.
+//##############################################################################
+
+/**
+ * \brief The parameters of a Krylov solve.
+ */
+
+typedef struct krylov_solver_parameters_t
+{
+  std::string sMethod;      //!< S_KRYLOV_GMRES or S_KRYLOV_BCGSTAB.
+  size_t iMaxIterations;    //!< Maximum number of iterations.
+  double dRelTol;           //!< Relative residual tolerance.
+  double dAbsTol;           //!< Absolute residual tolerance.
+  bool bRhsConvergence;     //!< Relative to the rhs, not initial residual.
+  bool bDebug;              //!< Print the iteration count and residual.
+  size_t iDelta;            //!< ILUT fill beyond the average row length.
+  double dDropTol;          //!< ILUT drop tolerance.
+} krylov_solver_parameters_t;
+
+//##############################################################################
+// Class for the ILUT preconditioner.
+//##############################################################################
+
+/**
+ * \brief An incomplete LU factorization with dual threshold dropping
+ *        (ILUT).
+ *
+ * This is Saad's ILUT algorithm as in the SPARSKIT2 ilut routine.  In
+ * each row, entries smaller than the drop tolerance times the average
+ * absolute value of the matrix row are dropped, and only the largest
+ * lfil entries of each of the L and U parts are kept.  A zero pivot is
+ * replaced by a small multiple of the row average.  The matrix is given in
+ * compressed sparse row (CSR) form with zero-based row pointers and
+ * column indices.  All the workspace belongs to the object, so different
+ * threads may factor and apply their own preconditioners at once.
+ */
+
+class IlutPreconditioner : private boost::noncopyable
+{
+
+  public:
+    IlutPreconditioner(
+      size_t,
+      const std::vector<size_t>&,
+      const std::vector<size_t>&,
+      const std::vector<double>&,
+      size_t,
+      double
+    );
+    void solve( const std::vector<double>&, std::vector<double>& ) const;
+    size_t getNumberOfRows() const { return iRows; }
+    size_t getNumberOfFactorElements() const
+      { return vLCol.size() + vUCol.size() + iRows; }
+
+  private:
+    size_t iRows;
+    std::vector<size_t> vLRowPtr;
+    std::vector<size_t> vLCol;
+    std::vector<double> vL;
+    std::vector<size_t> vURowPtr;
+    std::vector<size_t> vUCol;
+    std::vector<double> vU;
+    std::vector<double> vInverseDiagonal;
+
+};
+
+//##############################################################################
+// Class for a matrix operator.
+//##############################################################################
+
+/**
+ * \brief A matrix in compressed sparse row (CSR) form with zero-based row
+ *        pointers and column indices, as an operator for the Krylov
+ *        iterations.  The operator refers to the input vectors, which must
+ *        outlive it.
+ */
+
+class CsrOperator
+{
+
+  public:
+    CsrOperator(
+      const std::vector<size_t>& row_ptr,
+      const std::vector<size_t>& col,
+      const std::vector<double>& values
+    ) : vRowPtr( row_ptr ), vCol( col ), vValues( values ) {}
+    void multiply( const double *, std::vector<double>& ) const;
+
+  private:
+    const std::vector<size_t>& vRowPtr;
+    const std::vector<size_t>& vCol;
+    const std::vector<double>& vValues;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+double
+krylov_dot( const double *, const double *, size_t );
+
+bool
+is_native_krylov_method( const std::string& );
+
+krylov_solver_parameters_t
+get_krylov_solver_parameters( nnt::Zone& );
+
+bool
+krylov_solve(
+  size_t,
+  const std::vector<size_t>&,
+  const std::vector<size_t>&,
+  const std::vector<double>&,
+  const gsl_vector *,
+  gsl_vector *,
+  const krylov_solver_parameters_t&
+);
+
+gsl_vector *
+krylov_solve_for_zone(
+  nnt::Zone&,
+  size_t,
+  const std::vector<size_t>&,
+  const std::vector<size_t>&,
+  const std::vector<double>&,
+  const gsl_vector *
+);
+
+gsl_vector *
+krylov_solve_for_zone( nnt::Zone&, WnMatrix *, const gsl_vector * );
+
+} // namespace user
+
+#include "user/krylov_solver_impl.hpp"
+
+#endif // KRYLOV_SOLVER_H
@@ -0,0 +1,285 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the Krylov iterations, which work on any
+//!        operator and preconditioner.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef KRYLOV_SOLVER_HPP
+#define KRYLOV_SOLVER_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include <gsl/gsl_math.h>
+
+namespace user
+{
+
+//##############################################################################
+// krylov_gmres().
+//##############################################################################
+
+/**
+ * \brief Restarted GMRES on the left-preconditioned system, starting from
+ *        a zero guess.  The residual tested is that of the preconditioned
+ *        system; it is compared with the initial residual or, as in
+ *        Sparskit2, with the norm of the unpreconditioned right-hand side.
+ *        The matrix is applied by the operator's multiply() and the
+ *        preconditioner by its solve(), as in CsrOperator and
+ *        IlutPreconditioner.
+ * \return True if the solution converged, false if not.
+ */
+
+template<class Operator, class Preconditioner>
+bool
+krylov_gmres(
+  const Operator& matrix,
+  const Preconditioner& precond,
+  const std::vector<double>& b,
+  std::vector<double>& x,
+  const krylov_solver_parameters_t& params,
+  size_t& i_iter,
+  double& d_resid
+)
+{
+
+  size_t n = b.size(), m = I_KRYLOV_RESTART;
+  std::vector<double> v( n * ( m + 1 ) ), h( ( m + 1 ) * m );
+  std::vector<double> cs( m ), sn( m ), g( m + 1 ), y( m );
+  std::vector<double> r( n ), z( n );
+
+  std::fill( x.begin(), x.end(), 0. );
+
+  precond.solve( b, z );
+
+  double d_beta = sqrt( krylov_dot( &z[0], &z[0], n ) );
+
+  double d_ref =
+    params.bRhsConvergence ? sqrt( krylov_dot( &b[0], &b[0], n ) ) : d_beta;
+
+  double d_tol = params.dRelTol * d_ref + params.dAbsTol;
+
+  i_iter = 0;
+  d_resid = d_beta;
+
+  while( gsl_finite( d_resid ) )
+  {
+
+    if( d_resid <= d_tol ) return true;
+
+    if( i_iter >= params.iMaxIterations || d_beta == 0 ) return false;
+
+    //--------------------------------------------------------------------------
+    // Arnoldi process with modified Gram-Schmidt and Givens rotations.
+    //--------------------------------------------------------------------------
+
+    for( size_t i = 0; i < n; i++ ) v[i] = z[i] / d_beta;
+
+    std::fill( g.begin(), g.end(), 0. );
+    g[0] = d_beta;
+
+    size_t k = 0;
+
+    while( k < m && i_iter < params.iMaxIterations )
+    {
+
+      double * v_k = &v[k * n], * w = &v[( k + 1 ) * n];
+
+      matrix.multiply( v_k, r );
+
+      precond.solve( r, z );
+
+      for( size_t i = 0; i <= k; i++ )
+      {
+        double d_h = krylov_dot( &z[0], &v[i * n], n );
+        h[i * m + k] = d_h;
+        for( size_t l = 0; l < n; l++ ) z[l] -= d_h * v[i * n + l];
+      }
+
+      double d_norm = sqrt( krylov_dot( &z[0], &z[0], n ) );
+
+      if( d_norm > 0 )
+        for( size_t l = 0; l < n; l++ ) w[l] = z[l] / d_norm;
+
+      for( size_t i = 0; i < k; i++ )
+      {
+        double d_t = cs[i] * h[i * m + k] + sn[i] * h[( i + 1 ) * m + k];
+        h[( i + 1 ) * m + k] =
+          -sn[i] * h[i * m + k] + cs[i] * h[( i + 1 ) * m + k];
+        h[i * m + k] = d_t;
+      }
+
+      double d_denom =
+        sqrt( h[k * m + k] * h[k * m + k] + d_norm * d_norm );
+
+      if( d_denom == 0 ) return false;
+
+      cs[k] = h[k * m + k] / d_denom;
+      sn[k] = d_norm / d_denom;
+      h[k * m + k] = d_denom;
+
+      g[k + 1] = -sn[k] * g[k];
+      g[k] *= cs[k];
+
+      k++;
+      i_iter++;
+
+      d_resid = fabs( g[k] );
+
+      if( d_resid <= d_tol || d_norm == 0 ) break;
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Update the solution from the least-squares problem.
+    //--------------------------------------------------------------------------
+
+    for( size_t i = k; i-- > 0; )
+    {
+      double d_sum = g[i];
+      for( size_t l = i + 1; l < k; l++ ) d_sum -= h[i * m + l] * y[l];
+      y[i] = d_sum / h[i * m + i];
+    }
+
+    for( size_t i = 0; i < k; i++ )
+      for( size_t l = 0; l < n; l++ ) x[l] += y[i] * v[i * n + l];
+
+    //--------------------------------------------------------------------------
+    // Restart from the true (preconditioned) residual.
+    //--------------------------------------------------------------------------
+
+    matrix.multiply( &x[0], r );
+
+    for( size_t i = 0; i < n; i++ ) r[i] = b[i] - r[i];
+
+    precond.solve( r, z );
+
+    d_beta = sqrt( krylov_dot( &z[0], &z[0], n ) );
+
+    d_resid = d_beta;
+
+  }
+
+  return false;
+
+}
+
+//##############################################################################
+// krylov_bcgstab().
+//##############################################################################
+
+/**
+ * \brief BiCGSTAB on the left-preconditioned system, starting from a zero
+ *        guess.  The residual is tested as in krylov_gmres().
+ * \return True if the solution converged, false if not.
+ */
+
+template<class Operator, class Preconditioner>
+bool
+krylov_bcgstab(
+  const Operator& matrix,
+  const Preconditioner& precond,
+  const std::vector<double>& b,
+  std::vector<double>& x,
+  const krylov_solver_parameters_t& params,
+  size_t& i_iter,
+  double& d_resid
+)
+{
+
+  size_t n = b.size();
+  std::vector<double> r( n ), r0( n ), p( n, 0. ), v( n, 0. );
+  std::vector<double> s( n ), t( n ), work( n );
+  double d_rho = 1., d_alpha = 1., d_omega = 1.;
+
+  std::fill( x.begin(), x.end(), 0. );
+
+  precond.solve( b, r );
+
+  r0 = r;
+
+  d_resid = sqrt( krylov_dot( &r[0], &r[0], n ) );
+
+  double d_ref =
+    params.bRhsConvergence ? sqrt( krylov_dot( &b[0], &b[0], n ) ) : d_resid;
+
+  double d_tol = params.dRelTol * d_ref + params.dAbsTol;
+
+  for( i_iter = 0; gsl_finite( d_resid ); i_iter++ )
+  {
+
+    if( d_resid <= d_tol ) return true;
+
+    if( i_iter >= params.iMaxIterations ) return false;
+
+    double d_rho_new = krylov_dot( &r0[0], &r[0], n );
+
+    if( d_rho_new == 0 || d_omega == 0 ) return false;
+
+    double d_beta = ( d_rho_new / d_rho ) * ( d_alpha / d_omega );
+
+    for( size_t i = 0; i < n; i++ )
+      p[i] = r[i] + d_beta * ( p[i] - d_omega * v[i] );
+
+    matrix.multiply( &p[0], work );
+    precond.solve( work, v );
+
+    double d_r0v = krylov_dot( &r0[0], &v[0], n );
+
+    if( d_r0v == 0 ) return false;
+
+    d_alpha = d_rho_new / d_r0v;
+
+    for( size_t i = 0; i < n; i++ ) s[i] = r[i] - d_alpha * v[i];
+
+    double d_snorm = sqrt( krylov_dot( &s[0], &s[0], n ) );
+
+    if( d_snorm <= d_tol )
+    {
+      for( size_t i = 0; i < n; i++ ) x[i] += d_alpha * p[i];
+      d_resid = d_snorm;
+      i_iter++;
+      return true;
+    }
+
+    matrix.multiply( &s[0], work );
+    precond.solve( work, t );
+
+    double d_tt = krylov_dot( &t[0], &t[0], n );
+
+    d_omega = d_tt > 0 ? krylov_dot( &t[0], &s[0], n ) / d_tt : 0.;
+
+    for( size_t i = 0; i < n; i++ )
+    {
+      x[i] += d_alpha * p[i] + d_omega * s[i];
+      r[i] = s[i] - d_omega * t[i];
+    }
+
+    d_rho = d_rho_new;
+
+    d_resid = sqrt( krylov_dot( &r[0], &r[0], n ) );
+
+  }
+
+  return false;
+
+}
+
+} // namespace user
+
+#endif // KRYLOV_SOLVER_HPP
@@ -153,20 +153,24 @@ solve_matrix_for_zone(
 {
 
   gsl_vector * p_sol;
-  WnMatrix__Arrow * p_arrow;
 
 #ifndef SPARSKIT2
   if(
-    zone.hasProperty( nnt::s_ITER_SOLVER ) ||
-    zone.hasProperty( nnt::s_ITER_SOLVER_T9 )
+    (
+      zone.hasProperty( nnt::s_ITER_SOLVER ) ||
+      zone.hasProperty( nnt::s_ITER_SOLVER_T9 )
+    ) &&
+    !is_native_krylov_solver_for_zone( zone )
   )
   {
     std::cerr << std::endl;
     std::cerr << "Code was not compiled against Sparskit2. Either recompile"
        << std::endl;
-    std::cerr << "the code with Sparskit2 or remove the iterative solver zone"
+    std::cerr << "the code with Sparskit2, set the iterative solver method to"
        << std::endl;
-    std::cerr << "properties." << std::endl << std::endl;
+    std::cerr << S_KRYLOV_GMRES << " or " << S_KRYLOV_BCGSTAB <<
+       ", or remove the iterative solver zone properties." << std::endl <<
+       std::endl;
     exit( EXIT_FAILURE );
   }
 #endif
@@ -182,23 +186,26 @@ solve_matrix_for_zone(
     )( p_matrix, p_rhs );
   }
 
-#ifdef SPARSKIT2
-
   //============================================================================
-  // Try iterative solver, if set.
+  // Try iterative solver, if set.  The native Krylov solvers are re-entrant
+  // and run concurrently in different zones.
   //============================================================================
 
-  if(
-    zone.hasProperty( nnt::s_ITER_SOLVER ) &&
-    zone.hasProperty( nnt::s_ITER_SOLVER_T9 ) &&
-    zone.getProperty<double>( nnt::s_T9 )
-    <
-    zone.getProperty<double>( nnt::s_ITER_SOLVER_T9 )
-  )
+  if( is_native_krylov_solver_for_zone( zone ) )
+  {
+    p_sol = krylov_solve_for_zone( zone, p_matrix, p_rhs );
+    if( p_sol ) return p_sol;
+    return solve_matrix_for_zone_directly( zone, p_matrix, p_rhs );
+  }
+
+#ifdef SPARSKIT2
+
+  if( is_iterative_solver_for_zone( zone ) )
   {
 
     //--------------------------------------------------------------------------
-    // Get solution.
+    // Get solution.  The Sparskit2 routines keep their state in Fortran
+    // SAVE variables, so only one zone may use them at a time.
     //--------------------------------------------------------------------------
     
     #pragma omp critical
@@ -240,9 +247,33 @@ solve_matrix_for_zone(
 
 #endif
 
-  //============================================================================
-  // Normal solver.
-  //============================================================================
+  return solve_matrix_for_zone_directly( zone, p_matrix, p_rhs );
+
+}
+
+//##############################################################################
+// solve_matrix_for_zone_directly().
+//##############################################################################
+
+/**
+ * \brief Solve the matrix equation for a zone with the zone's direct
+ *        solver, ignoring any iterative solver settings.
+ * \param zone The zone.
+ * \param p_matrix A pointer to the WnMatrix.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution.
+ */
+
+gsl_vector *
+solve_matrix_for_zone_directly(
+  nnt::Zone& zone,
+  WnMatrix * p_matrix,
+  gsl_vector * p_rhs
+)
+{
+
+  gsl_vector * p_sol;
+  WnMatrix__Arrow * p_arrow;
 
   if(
     zone.hasProperty( nnt::s_SOLVER ) &&
@@ -257,6 +288,14 @@ solve_matrix_for_zone(
     p_sol = WnMatrix__Arrow__solve( p_arrow, p_rhs );
     WnMatrix__Arrow__free( p_arrow );
   }
+  else if(
+    zone.hasProperty( nnt::s_SOLVER ) &&
+    zone.getProperty<std::string>( nnt::s_SOLVER ) == nnt::s_SPARSE_LU
+  )
+  {
+    p_sol = sparse_lu_solve_for_zone( zone, p_matrix, p_rhs );
+    if( !p_sol ) p_sol = WnMatrix__solve( p_matrix, p_rhs );
+  }
   else
   {
     p_sol = WnMatrix__solve( p_matrix, p_rhs );
@@ -266,6 +305,250 @@ solve_matrix_for_zone(
 
 }
 
+//##############################################################################
+// is_iterative_solver_for_zone().
+//##############################################################################
+
+/**
+ * \brief Determine whether the iterative solver applies to a zone, that is,
+ *        whether the method is set and the zone's t9 is below the t9 for
+ *        the iterative solver.
+ * \param zone The zone.
+ * \return True if the iterative solver applies, false if not.
+ */
+
+bool
+is_iterative_solver_for_zone( nnt::Zone& zone )
+{
+
+  return
+    zone.hasProperty( nnt::s_ITER_SOLVER ) &&
+    zone.hasProperty( nnt::s_ITER_SOLVER_T9 ) &&
+    zone.getProperty<double>( nnt::s_T9 )
+    <
+    zone.getProperty<double>( nnt::s_ITER_SOLVER_T9 );
+
+}
+
+//##############################################################################
+// is_native_krylov_solver_for_zone().
+//##############################################################################
+
+/**
+ * \brief Determine whether a zone uses the re-entrant Krylov solvers, that
+ *        is, whether the iterative solver applies with a native method and
+ *        no solver parameter function, which works only on Sparskit2.
+ * \param zone The zone.
+ * \return True if the native Krylov solver applies, false if not.
+ */
+
+bool
+is_native_krylov_solver_for_zone( nnt::Zone& zone )
+{
+
+  return
+    is_iterative_solver_for_zone( zone ) &&
+    is_native_krylov_method(
+      zone.getProperty<std::string>( nnt::s_ITER_SOLVER )
+    ) &&
+    !zone.hasProperty( nnt::s_SOLVER_PARAMETER_FUNCTION ) &&
+    !zone.hasFunction( nnt::s_SOLVER_PARAMETER_FUNCTION );
+
+}
+
+//##############################################################################
+// is_csr_sparse_lu_for_zone().
+//##############################################################################
+
+/**
+ * \brief Determine whether a zone's compiled network Jacobian may be solved
+ *        directly with the sparse LU solver, that is, whether the sparse LU
+ *        solver is set and neither a matrix modification function nor the
+ *        iterative solver applies.
+ * \param zone The zone.
+ * \return True if the solver may work on the CSR arrays, false if not.
+ */
+
+bool
+is_csr_sparse_lu_for_zone( nnt::Zone& zone )
+{
+
+  return
+    !zone.hasFunction( nnt::s_MATRIX_MODIFICATION_FUNCTION ) &&
+    !is_iterative_solver_for_zone( zone ) &&
+    zone.hasProperty( nnt::s_SOLVER ) &&
+    zone.getProperty<std::string>( nnt::s_SOLVER ) == nnt::s_SPARSE_LU;
+
+}
+
+//##############################################################################
+// is_csr_krylov_for_zone().
+//##############################################################################
+
+/**
+ * \brief Determine whether a zone's compiled network Jacobian may be solved
+ *        directly with the native Krylov solver, that is, whether that
+ *        solver applies and no matrix modification function is set.
+ * \param zone The zone.
+ * \return True if the solver may work on the CSR arrays, false if not.
+ */
+
+bool
+is_csr_krylov_for_zone( nnt::Zone& zone )
+{
+
+  return
+    !zone.hasFunction( nnt::s_MATRIX_MODIFICATION_FUNCTION ) &&
+    is_native_krylov_solver_for_zone( zone );
+
+}
+
+//##############################################################################
+// solve_matrix_for_zone().
+//##############################################################################
+
+/**
+ * \brief Solve the matrix equation for a zone with the matrix given as a
+ *        compiled network Jacobian.  The sparse LU and native Krylov
+ *        solvers work on the compressed sparse row arrays directly.
+ *        Otherwise, or if a matrix modification function is set, the matrix
+ *        is converted to a WnMatrix for the other solvers.
+ * \param zone The zone.
+ * \param jacobian The network Jacobian.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution.
+ */
+
+gsl_vector *
+solve_matrix_for_zone(
+  nnt::Zone& zone,
+  NetworkJacobian& jacobian,
+  gsl_vector * p_rhs
+)
+{
+
+  gsl_vector * p_sol;
+  WnMatrix * p_matrix;
+
+  if( is_csr_krylov_for_zone( zone ) )
+  {
+    p_sol =
+      krylov_solve_for_zone(
+        zone,
+        jacobian.getNumberOfRows(),
+        jacobian.getRowPointerVector(),
+        jacobian.getColumnVector(),
+        jacobian.getValueVector(),
+        p_rhs
+      );
+    if( p_sol ) return p_sol;
+    p_matrix = jacobian.getWnMatrix();
+    p_sol = solve_matrix_for_zone_directly( zone, p_matrix, p_rhs );
+    WnMatrix__free( p_matrix );
+    return p_sol;
+  }
+
+  if( is_csr_sparse_lu_for_zone( zone ) )
+  {
+    p_sol =
+      sparse_lu_solve_for_zone(
+        zone,
+        jacobian.getNumberOfRows(),
+        jacobian.getRowPointerVector(),
+        jacobian.getColumnVector(),
+        jacobian.getValueVector(),
+        p_rhs
+      );
+    if( p_sol ) return p_sol;
+  }
+
+  p_matrix = jacobian.getWnMatrix();
+
+  p_sol = solve_matrix_for_zone( zone, p_matrix, p_rhs );
+
+  WnMatrix__free( p_matrix );
+
+  return p_sol;
+
+}
+
+//##############################################################################
+// solve_matrix_for_zone().
+//##############################################################################
+
+/**
+ * \brief Solve the matrix equation for a zone with the matrix given as a
+ *        compiled network Jacobian into an existing vector.  With the
+ *        sparse LU solver, no memory is allocated; the native Krylov solver
+ *        allocates only its own workspace.  The other solvers work
+ *        on a WnMatrix and return a new vector, which is copied into the
+ *        solution vector and freed.
+ * \param zone The zone.
+ * \param jacobian The network Jacobian.
+ * \param p_rhs The right-hand-side vector.
+ * \param p_sol The vector to hold the solution.
+ */
+
+void
+solve_matrix_for_zone(
+  nnt::Zone& zone,
+  NetworkJacobian& jacobian,
+  gsl_vector * p_rhs,
+  gsl_vector * p_sol
+)
+{
+
+  gsl_vector * p_new_sol;
+  WnMatrix * p_matrix;
+
+  if(
+    is_csr_krylov_for_zone( zone ) &&
+    krylov_solve(
+      jacobian.getNumberOfRows(),
+      jacobian.getRowPointerVector(),
+      jacobian.getColumnVector(),
+      jacobian.getValueVector(),
+      p_rhs,
+      p_sol,
+      get_krylov_solver_parameters( zone )
+    )
+  )
+    return;
+
+  if(
+    is_csr_sparse_lu_for_zone( zone ) &&
+    sparse_lu_solve_for_zone(
+      zone,
+      jacobian.getNumberOfRows(),
+      jacobian.getRowPointerVector(),
+      jacobian.getColumnVector(),
+      jacobian.getValueVector(),
+      p_rhs,
+      p_sol
+    )
+  )
+    return;
+
+  //============================================================================
+  // If the Krylov solve failed, go straight to the direct solver rather than
+  // trying the Krylov solver again on the WnMatrix.
+  //============================================================================
+
+  p_matrix = jacobian.getWnMatrix();
+
+  if( is_csr_krylov_for_zone( zone ) )
+    p_new_sol = solve_matrix_for_zone_directly( zone, p_matrix, p_rhs );
+  else
+    p_new_sol = solve_matrix_for_zone( zone, p_matrix, p_rhs );
+
+  WnMatrix__free( p_matrix );
+
+  gsl_vector_memcpy( p_sol, p_new_sol );
+
+  gsl_vector_free( p_new_sol );
+
+}
+
 #ifdef SPARSKIT2
 
 //##############################################################################
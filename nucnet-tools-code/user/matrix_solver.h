@@ -33,6 +33,10 @@
 #include "nnt/wrappers.hpp"
 #include "nnt/string_defs.h"
 
+#include "user/sparse_lu_solver.h"
+#include "user/krylov_solver.h"
+#include "user/network_jacobian.h"
+
 #ifdef SPARSKIT2
 #include <WnSparseSolve.h>
 #endif
@@ -40,9 +44,26 @@
 namespace user
 {
 
+bool
+is_iterative_solver_for_zone( nnt::Zone& );
+
+bool
+is_native_krylov_solver_for_zone( nnt::Zone& );
+
 gsl_vector *
 solve_matrix_for_zone( nnt::Zone&, WnMatrix *, gsl_vector * );
 
+gsl_vector *
+solve_matrix_for_zone_directly( nnt::Zone&, WnMatrix *, gsl_vector * );
+
+gsl_vector *
+solve_matrix_for_zone( nnt::Zone&, NetworkJacobian&, gsl_vector * );
+
+void
+solve_matrix_for_zone(
+  nnt::Zone&, NetworkJacobian&, gsl_vector *, gsl_vector *
+);
+
 #ifdef SPARSKIT2
 gsl_vector *
 phi__solve__parallel(
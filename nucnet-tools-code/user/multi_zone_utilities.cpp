@@ -539,6 +539,206 @@ get_zone_jacobian_matrices( std::vector<nnt::Zone>& zones )
 
 }
 
+//##############################################################################
+// is_block_multi_zone_solver().
+//##############################################################################
+
+/**
+ * \brief Determine whether the multi-zone matrix equation is to be solved
+ *        with the zone blocks kept separate, that is, whether the solver
+ *        property of the first zone is s_BLOCK_JACOBI or
+ *        s_BLOCK_GAUSS_SEIDEL.
+ * \param zones The zones.
+ * \return True if the blocks are kept separate, false if not.
+ */
+
+bool
+is_block_multi_zone_solver( std::vector<nnt::Zone>& zones )
+{
+
+  if( !zones[0].hasProperty( nnt::s_SOLVER ) ) return false;
+
+  std::string s_solver = zones[0].getProperty<std::string>( nnt::s_SOLVER );
+
+  return
+    s_solver == nnt::s_BLOCK_JACOBI || s_solver == nnt::s_BLOCK_GAUSS_SEIDEL;
+
+}
+
+//##############################################################################
+// new_multi_zone_block_solver().
+//##############################################################################
+
+/**
+ * \brief Create the block solver for the multi-zone matrix equation.  There
+ *        is one block per zone, with the zone mass first in a multi-mass
+ *        calculation.
+ * \param zones The zones.
+ * \return A shared pointer to the new block solver.
+ */
+
+boost::shared_ptr<BlockSolver>
+new_multi_zone_block_solver( std::vector<nnt::Zone>& zones )
+{
+
+  size_t i_offset =
+    Libnucnet__Nuc__getNumberOfSpecies(
+      Libnucnet__Net__getNuc(
+        Libnucnet__Zone__getNet( zones[0].getNucnetZone() )
+      )
+    );
+
+  if( is_multi_mass_calculation( zones ) ) i_offset++;
+
+  return
+    boost::shared_ptr<BlockSolver>(
+      new BlockSolver(
+        zones.size(),
+        i_offset,
+        zones[0].getProperty<std::string>( nnt::s_SOLVER ) ==
+          nnt::s_BLOCK_GAUSS_SEIDEL
+      )
+    );
+
+}
+
+//##############################################################################
+// set_multi_zone_blocks().
+//##############################################################################
+
+/**
+ * \brief Set and factor the blocks of the multi-zone matrix equation.  The
+ *        zones' Jacobians are computed, set as the blocks, and their flow
+ *        vectors added to the right-hand-side vector in parallel over the
+ *        zones.  The mixing matrix becomes the coupling between the blocks.
+ * \param zones The zones.
+ * \param solver The block solver.
+ * \param p_matrix The mixing matrix.
+ * \param p_vector The right-hand-side vector, to which the zones' flows are
+ *        added.
+ * \param d_dt The timestep.
+ * \return True if the blocks were factored, false if not.
+ */
+
+bool
+set_multi_zone_blocks(
+  std::vector<nnt::Zone>& zones,
+  BlockSolver& solver,
+  WnMatrix * p_matrix,
+  gsl_vector * p_vector,
+  double d_dt
+)
+{
+
+  gsl_vector * p_mass_numbers = NULL;
+  size_t i_delta = 0;
+
+  if( is_multi_mass_calculation( zones ) )
+  {
+    i_delta = 1;
+    p_mass_numbers =
+      get_mass_numbers_array(
+        Libnucnet__Net__getNuc(
+          Libnucnet__Zone__getNet( zones[0].getNucnetZone() )
+        )
+      );
+  }
+
+#ifndef NO_OPENMP
+  #pragma omp parallel for schedule( dynamic, 1 )
+#endif
+    for( size_t i = 0; i < zones.size(); i++ )
+    {
+
+      boost::shared_ptr<NetworkJacobian> p_jacobian;
+      gsl_vector * p_rhs;
+
+      boost::tie( p_jacobian, p_rhs ) =
+        get_evolution_jacobian_and_vector( zones[i] );
+
+      Libnucnet__Zone__clearRates( zones[i].getNucnetZone() );
+
+      solver.setBlock(
+        i,
+        i_delta,
+        p_jacobian->getRowPointerVector(),
+        p_jacobian->getColumnVector(),
+        p_jacobian->getValueVector()
+      );
+
+      if( p_mass_numbers )
+      {
+        gsl_vector_scale(
+          p_rhs,
+          zones[i].getProperty<double>( nnt::s_ZONE_MASS )
+        );
+        gsl_vector_mul( p_rhs, p_mass_numbers );
+      }
+
+      gsl_vector_view view =
+        gsl_vector_subvector(
+          p_vector,
+          ( i * solver.getBlockSize() ) + i_delta,
+          p_rhs->size
+        );
+
+      gsl_vector_add( &view.vector, p_rhs );
+
+      gsl_vector_free( p_rhs );
+
+    }
+
+  if( p_mass_numbers ) gsl_vector_free( p_mass_numbers );
+
+  solver.setCoupling( p_matrix );
+
+  solver.addValueToDiagonals( 1. / d_dt );
+
+  return solver.factor();
+
+}
+
+//##############################################################################
+// solve_multi_zone_blocks().
+//##############################################################################
+
+/**
+ * \brief Solve the multi-zone matrix equation with the factored blocks as
+ *        the preconditioner.  The Krylov solver is set by the iterative
+ *        solver properties of the first zone.
+ * \param zones The zones.
+ * \param solver The block solver.
+ * \param p_vector The right-hand-side vector.
+ * \return A new gsl_vector containing the solution or NULL if the solver
+ *         did not converge.
+ */
+
+gsl_vector *
+solve_multi_zone_blocks(
+  std::vector<nnt::Zone>& zones,
+  const BlockSolver& solver,
+  const gsl_vector * p_vector
+)
+{
+
+  gsl_vector * p_sol = gsl_vector_alloc( solver.getNumberOfRows() );
+
+  if(
+    !solver.krylovSolve(
+      p_vector,
+      p_sol,
+      get_krylov_solver_parameters( zones[0] )
+    )
+  )
+  {
+    gsl_vector_free( p_sol );
+    return NULL;
+  }
+
+  return p_sol;
+
+}
+
 //##############################################################################
 // get_mass_numbers_array().
 //##############################################################################
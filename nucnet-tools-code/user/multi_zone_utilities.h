@@ -52,6 +52,7 @@
 
 #include "user/evolve.h"
 #include "user/network_limiter.h"
+#include "user/block_solver.h"
 
 namespace user
 {
@@ -199,6 +200,28 @@ get_zone_jacobian_matrices(
   std::vector<nnt::Zone>&
 );
 
+bool
+is_block_multi_zone_solver( std::vector<nnt::Zone>& );
+
+boost::shared_ptr<BlockSolver>
+new_multi_zone_block_solver( std::vector<nnt::Zone>& );
+
+bool
+set_multi_zone_blocks(
+  std::vector<nnt::Zone>&,
+  BlockSolver&,
+  WnMatrix *,
+  gsl_vector *,
+  double
+);
+
+gsl_vector *
+solve_multi_zone_blocks(
+  std::vector<nnt::Zone>&,
+  const BlockSolver&,
+  const gsl_vector *
+);
+
 double
 get_new_timestep_from_zones(
   std::vector<nnt::Zone>&, double, double, double, double
@@ -350,6 +350,7 @@ evolve_multi_zone(
   size_t i, i_species, i_iter, i_offset, i_delta;
   int i_check;
   double d_check;
+  bool b_factored = false;
 
   //============================================================================
   // Get number of species and abundance vectors.
@@ -377,6 +378,16 @@ evolve_multi_zone(
 
   gsl_vector_memcpy( p_current, p_old );
 
+  //============================================================================
+  // Get the block solver if the zone blocks are kept separate.  Its symbolic
+  // factorizations are reused over the iterations.
+  //============================================================================
+
+  boost::shared_ptr<BlockSolver> p_block_solver;
+
+  if( is_block_multi_zone_solver( zones ) )
+    p_block_solver = new_multi_zone_block_solver( zones );
+
   //============================================================================
   // Newton-Raphson loop.
   //============================================================================
@@ -386,37 +397,51 @@ evolve_multi_zone(
 
     boost::tie( p_matrix, p_vector ) = mat_vec_fn( p_current );
 
-    boost::tie( jacobians, rhs_vectors ) =
-      get_zone_jacobians_and_rhs_vectors( zones );
-
-    i = 0;
-    BOOST_FOREACH( WnMatrix * p_sub_matrix, jacobians )
+    if( p_block_solver )
     {
-      
-      WnMatrix__insertMatrix(
-	p_matrix,
-	p_sub_matrix,
-	(i * i_offset) + i_delta + 1,
-	(i * i_offset ) + i_delta + 1
-      );
+      b_factored =
+        set_multi_zone_blocks(
+          zones, *p_block_solver, p_matrix, p_vector, d_dt
+        );
+    }
+    else
+    {
+
+      boost::tie( jacobians, rhs_vectors ) =
+        get_zone_jacobians_and_rhs_vectors( zones );
 
-      WnMatrix__free( p_sub_matrix );
+      i = 0;
+      BOOST_FOREACH( WnMatrix * p_sub_matrix, jacobians )
+      {
 
-      i++;
+        WnMatrix__insertMatrix(
+	  p_matrix,
+	  p_sub_matrix,
+	  (i * i_offset) + i_delta + 1,
+	  (i * i_offset ) + i_delta + 1
+        );
 
-    }
+        WnMatrix__free( p_sub_matrix );
 
-    WnMatrix__addValueToDiagonals( p_matrix, 1. / d_dt );
+        i++;
 
-    i = 0;
-    BOOST_FOREACH( gsl_vector * p_sub_vector, rhs_vectors )
-    {
-      
-      view =
-        gsl_vector_subvector( p_vector, ( i * i_offset ) + i_delta, i_species );
-      gsl_vector_add( &view.vector, p_sub_vector );
-      gsl_vector_free( p_sub_vector );
-      i++;
+      }
+
+      WnMatrix__addValueToDiagonals( p_matrix, 1. / d_dt );
+
+      i = 0;
+      BOOST_FOREACH( gsl_vector * p_sub_vector, rhs_vectors )
+      {
+
+        view =
+          gsl_vector_subvector(
+            p_vector, ( i * i_offset ) + i_delta, i_species
+          );
+        gsl_vector_add( &view.vector, p_sub_vector );
+        gsl_vector_free( p_sub_vector );
+        i++;
+
+      }
 
     }
 
@@ -427,12 +452,18 @@ evolve_multi_zone(
     gsl_vector_sub( p_vector, p_work );
     gsl_vector_free( p_work );
 
-    p_sol =
-      solve_sparse_matrix_with_ilu_preconditioner(
-        p_matrix,
-        p_vector,
-        param_fn
-      ); 
+    if( p_block_solver )
+      p_sol =
+        b_factored ?
+        solve_multi_zone_blocks( zones, *p_block_solver, p_vector ) :
+        NULL;
+    else
+      p_sol =
+        solve_sparse_matrix_with_ilu_preconditioner(
+          p_matrix,
+          p_vector,
+          param_fn
+        );
 
     WnMatrix__free( p_matrix );
     gsl_vector_free( p_vector );
@@ -0,0 +1,488 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the cache of compiled networks.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <libxml/uri.h>
+#include <libxml/xmlreader.h>
+
+#include "user/network_cache.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// hash_network_cache_bytes().
+//##############################################################################
+
+/**
+ * \brief Fold bytes into a 64-bit FNV-1a hash.
+ * \param i_hash The hash so far.
+ * \param p_bytes The bytes.
+ * \param i_bytes The number of bytes.
+ * \return The updated hash.
+ */
+
+uint64_t
+hash_network_cache_bytes(
+  uint64_t i_hash,
+  const void * p_bytes,
+  size_t i_bytes
+)
+{
+
+  const unsigned char * p = (const unsigned char *) p_bytes;
+
+  for( size_t i = 0; i < i_bytes; i++ )
+  {
+    i_hash ^= p[i];
+    i_hash *= 1099511628211ULL;
+  }
+
+  return i_hash;
+
+}
+
+//##############################################################################
+// hash_network_cache_file().
+//##############################################################################
+
+/**
+ * \brief Fold the contents of an xml file and of the files it includes
+ *        into a hash.  Libnucnet expands XInclude elements when it reads a
+ *        file, so the included files are hashed in document order and a
+ *        change to any of them changes the key.
+ * \param i_hash The hash so far.
+ * \param s_file The name of the file.
+ * \param v_stack The files being hashed, used to stop on include cycles.
+ * \return The updated hash.  A missing included file is hashed by name, so
+ *         the key changes once it appears.
+ */
+
+uint64_t
+hash_network_cache_file(
+  uint64_t i_hash,
+  const std::string& s_file,
+  std::vector<std::string>& v_stack
+)
+{
+
+  uint64_t i_length = 0;
+  char s_buffer[65536];
+  size_t i_read;
+
+  FILE * p_file = fopen( s_file.c_str(), "rb" );
+
+  if( !p_file )
+  {
+    if( v_stack.empty() )
+    {
+      std::cerr << "Couldn't open file " << s_file << "!" << std::endl;
+      exit( EXIT_FAILURE );
+    }
+    i_hash = hash_network_cache_bytes( i_hash, s_file.data(), s_file.size() );
+    return hash_network_cache_bytes( i_hash, &i_length, sizeof( i_length ) );
+  }
+
+  while( ( i_read = fread( s_buffer, 1, sizeof( s_buffer ), p_file ) ) > 0 )
+  {
+    i_hash = hash_network_cache_bytes( i_hash, s_buffer, i_read );
+    i_length += i_read;
+  }
+
+  fclose( p_file );
+
+  i_hash = hash_network_cache_bytes( i_hash, &i_length, sizeof( i_length ) );
+
+  //============================================================================
+  // Hash the included files.
+  //============================================================================
+
+  xmlTextReaderPtr p_reader =
+    xmlReaderForFile( s_file.c_str(), NULL, XML_PARSE_NONET );
+
+  if( !p_reader ) return i_hash;
+
+  v_stack.push_back( s_file );
+
+  while( xmlTextReaderRead( p_reader ) == 1 )
+  {
+
+    if( xmlTextReaderNodeType( p_reader ) != XML_READER_TYPE_ELEMENT )
+      continue;
+
+    const xmlChar * s_ns = xmlTextReaderConstNamespaceUri( p_reader );
+    const xmlChar * s_name = xmlTextReaderConstLocalName( p_reader );
+
+    if(
+      !s_ns ||
+      !xmlStrEqual( s_name, BAD_CAST "include" ) ||
+      (
+        !xmlStrEqual( s_ns, BAD_CAST "http://www.w3.org/2001/XInclude" ) &&
+        !xmlStrEqual( s_ns, BAD_CAST "http://www.w3.org/2003/XInclude" )
+      )
+    )
+      continue;
+
+    xmlChar * s_href = xmlTextReaderGetAttribute( p_reader, BAD_CAST "href" );
+
+    if( !s_href ) continue;
+
+    xmlChar * s_uri =
+      xmlBuildURI( s_href, xmlTextReaderConstBaseUri( p_reader ) );
+
+    if( s_uri )
+    {
+
+      std::string s_included( (const char *) s_uri );
+
+      if(
+        std::find( v_stack.begin(), v_stack.end(), s_included ) ==
+        v_stack.end()
+      )
+        i_hash = hash_network_cache_file( i_hash, s_included, v_stack );
+
+      xmlFree( s_uri );
+
+    }
+
+    xmlFree( s_href );
+
+  }
+
+  v_stack.pop_back();
+
+  xmlFreeTextReader( p_reader );
+
+  return i_hash;
+
+}
+
+//##############################################################################
+// compute_network_cache_key().
+//##############################################################################
+
+/**
+ * \brief Compute the key of a compiled network from the contents of its
+ *        input files, including the files they XInclude, and its options.
+ *        Each input is hashed with its length so that differently split
+ *        inputs give different keys.
+ * \param v_files The names of the input files.
+ * \param v_options The options (xpath expressions, flags) used in compiling.
+ * \return The key as sixteen hexadecimal digits.
+ */
+
+std::string
+compute_network_cache_key(
+  const std::vector<std::string>& v_files,
+  const std::vector<std::string>& v_options
+)
+{
+
+  uint64_t i_hash = 14695981039346656037ULL;
+  uint64_t i_length;
+  char s_buffer[65536];
+
+  const uint32_t v_versions[2] =
+    { I_NETWORK_CACHE_VERSION, I_BINARY_DATA_VERSION };
+
+  i_hash = hash_network_cache_bytes( i_hash, v_versions, sizeof( v_versions ) );
+
+  BOOST_FOREACH( const std::string& s_file, v_files )
+  {
+    std::vector<std::string> v_stack;
+    i_hash = hash_network_cache_file( i_hash, s_file, v_stack );
+  }
+
+  BOOST_FOREACH( const std::string& s_option, v_options )
+  {
+
+    i_length = s_option.size();
+
+    i_hash = hash_network_cache_bytes( i_hash, s_option.data(), i_length );
+    i_hash = hash_network_cache_bytes( i_hash, &i_length, sizeof( i_length ) );
+
+  }
+
+  snprintf(
+    s_buffer, sizeof( s_buffer ), "%016llx", (unsigned long long) i_hash
+  );
+
+  return std::string( s_buffer );
+
+}
+
+//##############################################################################
+// get_network_cache_file().
+//##############################################################################
+
+/**
+ * \brief Get the name of the cache file for a key.
+ * \param s_key The key.
+ * \return The file name, or an empty string if no cache directory is set.
+ *         The cache directory is created if it does not exist.
+ */
+
+std::string
+get_network_cache_file( const std::string& s_key )
+{
+
+  const char * s_dir = getenv( S_NETWORK_CACHE_DIR_ENV );
+
+  if( !s_dir || *s_dir == '\0' ) return "";
+
+  if( mkdir( s_dir, 0755 ) != 0 && errno != EEXIST )
+  {
+    std::cerr << "Couldn't create network cache directory " << s_dir <<
+      "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  return std::string( s_dir ) + "/" + s_key + S_NETWORK_CACHE_SUFFIX;
+
+}
+
+//##############################################################################
+// get_net_cache_key().
+//##############################################################################
+
+/**
+ * \brief Compute the key of the network compiled by compile_net_from_xml().
+ * \param s_file The network xml file.
+ * \param s_nuc_xpath The nuclide xpath expression (may be NULL).
+ * \param s_reac_xpath The reaction xpath expression (may be NULL).
+ * \return The key.
+ */
+
+std::string
+get_net_cache_key(
+  const char * s_file,
+  const char * s_nuc_xpath,
+  const char * s_reac_xpath
+)
+{
+
+  std::vector<std::string> v_files, v_options;
+
+  v_files.push_back( s_file );
+
+  v_options.push_back( "net" );
+  v_options.push_back( s_nuc_xpath ? s_nuc_xpath : "" );
+  v_options.push_back( s_reac_xpath ? s_reac_xpath : "" );
+  v_options.push_back(
+    boost::lexical_cast<std::string>(
+      B_REMOVE_SINGLE_NUCLIDE_REACTANT_REACTION
+    )
+  );
+
+  return compute_network_cache_key( v_files, v_options );
+
+}
+
+//##############################################################################
+// compile_net_from_xml().
+//##############################################################################
+
+/**
+ * \brief Read a network from xml and apply the processing done before every
+ *        calculation.  Duplicate reactions are removed; the species keep the
+ *        order in which they are read.
+ * \param p_net The network to update.
+ * \param s_file The network xml file.
+ * \param s_nuc_xpath The nuclide xpath expression (may be NULL).
+ * \param s_reac_xpath The reaction xpath expression (may be NULL).
+ */
+
+void
+compile_net_from_xml(
+  Libnucnet__Net * p_net,
+  const char * s_file,
+  const char * s_nuc_xpath,
+  const char * s_reac_xpath
+)
+{
+
+  Libnucnet__Net__updateFromXml( p_net, s_file, s_nuc_xpath, s_reac_xpath );
+
+  remove_duplicate_reactions( p_net );
+
+}
+
+//##############################################################################
+// write_network_cache().
+//##############################################################################
+
+/**
+ * \brief Write a compiled network to a cache file.  The network is written
+ *        to a temporary file that is then renamed, so concurrent runs
+ *        never read a partly written cache file.
+ * \param p_net The network.
+ * \param s_cache_file The cache file.
+ */
+
+void
+write_network_cache( Libnucnet__Net * p_net, const std::string& s_cache_file )
+{
+
+  BinaryDataWriter writer;
+
+  std::string s_tmp =
+    s_cache_file + "." + boost::lexical_cast<std::string>( getpid() );
+
+  writer.addNet( p_net );
+
+  writer.write( s_tmp.c_str() );
+
+  if( rename( s_tmp.c_str(), s_cache_file.c_str() ) != 0 )
+  {
+    std::cerr << "Couldn't rename " << s_tmp << " to " << s_cache_file <<
+      "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+}
+
+//##############################################################################
+// update_net_from_network_cache().
+//##############################################################################
+
+/**
+ * \brief Update a network with a compiled network.  A binary data file is
+ *        read directly.  For an xml file, the network compiled from the
+ *        file and xpath expressions is read from the cache; if it is not in
+ *        the cache, it is compiled with compile_net_from_xml() and stored.
+ *        Without a cache directory, the network is compiled every time.
+ * \param p_net The network to update.
+ * \param s_file The network xml or binary data file.
+ * \param s_nuc_xpath The nuclide xpath expression (may be NULL).
+ * \param s_reac_xpath The reaction xpath expression (may be NULL).
+ */
+
+void
+update_net_from_network_cache(
+  Libnucnet__Net * p_net,
+  const char * s_file,
+  const char * s_nuc_xpath,
+  const char * s_reac_xpath
+)
+{
+
+  if( is_binary_data_file( s_file ) )
+  {
+    update_net_from_binary_data( p_net, s_file, s_nuc_xpath, s_reac_xpath );
+    return;
+  }
+
+  std::string s_cache_file =
+    get_network_cache_file(
+      get_net_cache_key( s_file, s_nuc_xpath, s_reac_xpath )
+    );
+
+  if( s_cache_file.empty() )
+  {
+    compile_net_from_xml( p_net, s_file, s_nuc_xpath, s_reac_xpath );
+    return;
+  }
+
+  if( !is_binary_data_file( s_cache_file.c_str() ) )
+  {
+    Libnucnet__Net * p_compiled = Libnucnet__Net__new();
+    compile_net_from_xml( p_compiled, s_file, s_nuc_xpath, s_reac_xpath );
+    write_network_cache( p_compiled, s_cache_file );
+    Libnucnet__Net__free( p_compiled );
+  }
+
+  update_net_from_binary_data( p_net, s_cache_file.c_str(), NULL, NULL );
+
+}
+
+//##############################################################################
+// update_net_reactions_from_network_cache().
+//##############################################################################
+
+/**
+ * \brief Update the reactions of a network from a reaction file, such as
+ *        a file of detailed weak rates, through the cache.
+ * \param p_net The network whose reactions are updated.
+ * \param s_file The reaction xml or binary data file.
+ * \param s_reac_xpath The reaction xpath expression (may be NULL).
+ */
+
+void
+update_net_reactions_from_network_cache(
+  Libnucnet__Net * p_net,
+  const char * s_file,
+  const char * s_reac_xpath
+)
+{
+
+  if( is_binary_data_file( s_file ) )
+  {
+    update_net_from_binary_data( p_net, s_file, NULL, s_reac_xpath );
+    return;
+  }
+
+  std::vector<std::string> v_files, v_options;
+
+  v_files.push_back( s_file );
+
+  v_options.push_back( "reactions" );
+  v_options.push_back( s_reac_xpath ? s_reac_xpath : "" );
+
+  std::string s_cache_file =
+    get_network_cache_file( compute_network_cache_key( v_files, v_options ) );
+
+  if( s_cache_file.empty() )
+  {
+    Libnucnet__Reac__updateFromXml(
+      Libnucnet__Net__getReac( p_net ), s_file, s_reac_xpath
+    );
+    return;
+  }
+
+  if( !is_binary_data_file( s_cache_file.c_str() ) )
+  {
+    Libnucnet__Net * p_compiled = Libnucnet__Net__new();
+    Libnucnet__Reac__updateFromXml(
+      Libnucnet__Net__getReac( p_compiled ), s_file, s_reac_xpath
+    );
+    write_network_cache( p_compiled, s_cache_file );
+    Libnucnet__Net__free( p_compiled );
+  }
+
+  update_net_from_binary_data( p_net, s_cache_file.c_str(), NULL, NULL );
+
+}
+
+} // namespace user
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the cache of compiled networks.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_CACHE_H
+#define NETWORK_CACHE_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <string>
+#include <vector>
+
+#include <Libnucnet.h>
+
+#include "user/binary_data.h"
+#include "user/remove_duplicate.h"
+
+//##############################################################################
+// Defines.  The cache is used only when the environment variable
+// S_NETWORK_CACHE_DIR_ENV names a directory, for example,
+// 'export NNT_NETWORK_CACHE_DIR=$HOME/.nnt_cache'.  Change
+// I_NETWORK_CACHE_VERSION when the compilation steps change so that old
+// compiled networks are not reused.
+//##############################################################################
+
+#define S_NETWORK_CACHE_DIR_ENV   "NNT_NETWORK_CACHE_DIR"
+#define S_NETWORK_CACHE_SUFFIX    ".nnb"
+#define I_NETWORK_CACHE_VERSION   1
+
+namespace user
+{
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+std::string
+compute_network_cache_key(
+  const std::vector<std::string>&,
+  const std::vector<std::string>&
+);
+
+std::string
+get_network_cache_file( const std::string& );
+
+std::string
+get_net_cache_key( const char *, const char *, const char * );
+
+void
+compile_net_from_xml(
+  Libnucnet__Net *,
+  const char *,
+  const char *,
+  const char *
+);
+
+void
+write_network_cache( Libnucnet__Net *, const std::string& );
+
+void
+update_net_from_network_cache(
+  Libnucnet__Net *,
+  const char *,
+  const char *,
+  const char *
+);
+
+void
+update_net_reactions_from_network_cache(
+  Libnucnet__Net *,
+  const char *,
+  const char *
+);
+
+} // namespace user
+
+#endif // NETWORK_CACHE_H
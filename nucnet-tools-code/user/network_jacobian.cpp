@@ -0,0 +1,430 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the compressed sparse row network Jacobian.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "network_jacobian.h"
+
+/**
+ * @brief A NucNet Tools namespace for extra (potentially user-supplied)
+ *        codes.
+ */
+namespace user
+{
+
+//##############################################################################
+// NetworkJacobian::NetworkJacobian().
+//##############################################################################
+
+/**
+ * \brief Compile the Jacobian structure for the reactions of zone rates.
+ * \param p_zone The zone whose network defines the matrix rows.
+ * \param rates The zone rates whose reactions contribute.  The reactant
+ *              and product indices are those of the rates' compiled
+ *              reaction topology.
+ */
+
+NetworkJacobian::NetworkJacobian(
+  Libnucnet__Zone * p_zone,
+  const ZoneRates& rates
+) : pView( rates.getNetView() ),
+    pTopology( rates.getTopologyPtr() ),
+    vReactantPtr( pTopology->getReactantPtrVector() ),
+    vReactants( pTopology->getReactantVector() ),
+    vProductPtr( pTopology->getProductPtrVector() ),
+    vProducts( pTopology->getProductVector() ),
+    vDuplicateReactantFactor( pTopology->getDuplicateReactantFactorVector() ),
+    vDuplicateProductFactor( pTopology->getDuplicateProductFactorVector() )
+{
+
+  Libnucnet__Nuc * p_nuc =
+    Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) );
+
+  std::vector<std::pair<size_t, size_t> > elements;
+
+  iRows = Libnucnet__Nuc__getNumberOfSpecies( p_nuc );
+
+  //============================================================================
+  // Matrix elements in assembly order.  Each reactant or product column
+  // couples to all reactant and product rows of the reaction.
+  //============================================================================
+
+  vSlotPtr.push_back( 0 );
+
+  for( size_t r = 0; r < pTopology->getNumberOfReactions(); r++ )
+  {
+
+    for( size_t i = vReactantPtr[r]; i < vReactantPtr[r+1]; i++ )
+    {
+      for( size_t j = vReactantPtr[r]; j < vReactantPtr[r+1]; j++ )
+        elements.push_back( std::make_pair( vReactants[j], vReactants[i] ) );
+      for( size_t j = vProductPtr[r]; j < vProductPtr[r+1]; j++ )
+        elements.push_back( std::make_pair( vProducts[j], vReactants[i] ) );
+    }
+
+    for( size_t i = vProductPtr[r]; i < vProductPtr[r+1]; i++ )
+    {
+      for( size_t j = vReactantPtr[r]; j < vReactantPtr[r+1]; j++ )
+        elements.push_back( std::make_pair( vReactants[j], vProducts[i] ) );
+      for( size_t j = vProductPtr[r]; j < vProductPtr[r+1]; j++ )
+        elements.push_back( std::make_pair( vProducts[j], vProducts[i] ) );
+    }
+
+    vSlotPtr.push_back( elements.size() );
+
+  }
+
+  //============================================================================
+  // Structural pattern, including the diagonal.
+  //============================================================================
+
+  std::vector<std::pair<size_t, size_t> > pattern( elements );
+
+  for( size_t i = 0; i < iRows; i++ )
+    pattern.push_back( std::make_pair( i, i ) );
+
+  std::sort( pattern.begin(), pattern.end() );
+
+  pattern.erase( std::unique( pattern.begin(), pattern.end() ), pattern.end() );
+
+  vRowPtr.assign( iRows + 1, 0 );
+  vCol.resize( pattern.size() );
+
+  for( size_t p = 0; p < pattern.size(); p++ )
+  {
+    vRowPtr[pattern[p].first + 1]++;
+    vCol[p] = pattern[p].second;
+  }
+
+  for( size_t i = 0; i < iRows; i++ )
+    vRowPtr[i+1] += vRowPtr[i];
+
+  vValues.assign( vCol.size(), 0. );
+
+  //============================================================================
+  // Scatter map.
+  //============================================================================
+
+  vSlots.resize( elements.size() );
+
+  for( size_t p = 0; p < elements.size(); p++ )
+  {
+    vSlots[p] =
+      std::lower_bound(
+        vCol.begin() + vRowPtr[elements[p].first],
+        vCol.begin() + vRowPtr[elements[p].first + 1],
+        elements[p].second
+      ) - vCol.begin();
+  }
+
+  vDiagonal.resize( iRows );
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+    vDiagonal[i] =
+      std::lower_bound(
+        vCol.begin() + vRowPtr[i],
+        vCol.begin() + vRowPtr[i+1],
+        i
+      ) - vCol.begin();
+  }
+
+}
+
+//##############################################################################
+// NetworkJacobian::isValidForView().
+//##############################################################################
+
+/**
+ * \brief Determine whether the compiled structure applies to a view.
+ * \param p_zone The zone.
+ * \param p_view The current evolution network view for the zone.
+ * \return true if the structure was compiled for the view and the
+ *         zone's network has not changed, false if not.
+ */
+
+bool
+NetworkJacobian::isValidForView(
+  Libnucnet__Zone * p_zone,
+  Libnucnet__NetView * p_view
+)
+{
+
+  return
+    p_view == pView &&
+    !Libnucnet__NetView__wasNetUpdated( p_view ) &&
+    Libnucnet__Nuc__getNumberOfSpecies(
+      Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) )
+    ) == iRows &&
+    Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac( Libnucnet__NetView__getNet( p_view ) )
+    ) == pTopology->getNumberOfReactions();
+
+}
+
+//##############################################################################
+// NetworkJacobian::computeMatrix().
+//##############################################################################
+
+/**
+ * \brief Compute the Jacobian matrix values from the zone's current rates.
+ * \param rates The zone rates.  The rates must have been computed.
+ * \param p_abunds The abundances.
+ */
+
+void
+NetworkJacobian::computeMatrix(
+  const ZoneRates& rates,
+  const gsl_vector * p_abunds
+)
+{
+
+  double d_forward, d_reverse, d_value;
+
+  const std::vector<double>& v_forward = rates.getForwardRateVector();
+  const std::vector<double>& v_reverse = rates.getReverseRateVector();
+
+  std::fill( vValues.begin(), vValues.end(), 0. );
+
+  for( size_t r = 0; r < pTopology->getNumberOfReactions(); r++ )
+  {
+
+    d_forward = v_forward[r];
+    d_reverse = v_reverse[r];
+
+    size_t i_slot = vSlotPtr[r];
+
+    //--------------------------------------------------------------------------
+    // Reactant columns.
+    //--------------------------------------------------------------------------
+
+    for( size_t i = vReactantPtr[r]; i < vReactantPtr[r+1]; i++ )
+    {
+
+      d_value = d_forward / vDuplicateReactantFactor[r];
+
+      for( size_t j = vReactantPtr[r]; j < vReactantPtr[r+1]; j++ )
+      {
+        if( i != j ) d_value *= gsl_vector_get( p_abunds, vReactants[j] );
+      }
+
+      for( size_t j = vReactantPtr[r]; j < vReactantPtr[r+1]; j++ )
+        vValues[vSlots[i_slot++]] += d_value;
+
+      for( size_t j = vProductPtr[r]; j < vProductPtr[r+1]; j++ )
+        vValues[vSlots[i_slot++]] -= d_value;
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Product columns.
+    //--------------------------------------------------------------------------
+
+    for( size_t i = vProductPtr[r]; i < vProductPtr[r+1]; i++ )
+    {
+
+      d_value = d_reverse / vDuplicateProductFactor[r];
+
+      for( size_t j = vProductPtr[r]; j < vProductPtr[r+1]; j++ )
+      {
+        if( i != j ) d_value *= gsl_vector_get( p_abunds, vProducts[j] );
+      }
+
+      for( size_t j = vReactantPtr[r]; j < vReactantPtr[r+1]; j++ )
+        vValues[vSlots[i_slot++]] -= d_value;
+
+      for( size_t j = vProductPtr[r]; j < vProductPtr[r+1]; j++ )
+        vValues[vSlots[i_slot++]] += d_value;
+
+    }
+
+  }
+
+}
+
+//##############################################################################
+// NetworkJacobian::computeFlowVector().
+//##############################################################################
+
+/**
+ * \brief Compute the flow vector (the abundance time derivatives) from
+ *        the zone's current rates.
+ * \param rates The zone rates.  The rates must have been computed.
+ * \param p_abunds The abundances.
+ * \return A new gsl_vector containing the flows.  The caller must free it
+ *         with gsl_vector_free.
+ */
+
+gsl_vector *
+NetworkJacobian::computeFlowVector(
+  const ZoneRates& rates,
+  const gsl_vector * p_abunds
+)
+{
+
+  gsl_vector * p_flow = gsl_vector_alloc( iRows );
+
+  computeFlowVector( rates, p_abunds, p_flow );
+
+  return p_flow;
+
+}
+
+/**
+ * \brief Compute the flow vector into an existing vector.
+ * \param rates The zone rates.  The rates must have been computed.
+ * \param p_abunds The abundances.
+ * \param p_flow The vector to hold the flows.  It must have one element
+ *        per species.
+ */
+
+void
+NetworkJacobian::computeFlowVector(
+  const ZoneRates& rates,
+  const gsl_vector * p_abunds,
+  gsl_vector * p_flow
+)
+{
+
+  double d_f, d_r;
+
+  const std::vector<double>& v_forward = rates.getForwardRateVector();
+  const std::vector<double>& v_reverse = rates.getReverseRateVector();
+
+  gsl_vector_set_zero( p_flow );
+
+  for( size_t r = 0; r < pTopology->getNumberOfReactions(); r++ )
+  {
+
+    d_f = v_forward[r] / vDuplicateReactantFactor[r];
+
+    for( size_t i = vReactantPtr[r]; i < vReactantPtr[r+1]; i++ )
+      d_f *= gsl_vector_get( p_abunds, vReactants[i] );
+
+    d_r = v_reverse[r] / vDuplicateProductFactor[r];
+
+    for( size_t i = vProductPtr[r]; i < vProductPtr[r+1]; i++ )
+      d_r *= gsl_vector_get( p_abunds, vProducts[i] );
+
+    for( size_t i = vReactantPtr[r]; i < vReactantPtr[r+1]; i++ )
+      *gsl_vector_ptr( p_flow, vReactants[i] ) -= d_f - d_r;
+
+    for( size_t i = vProductPtr[r]; i < vProductPtr[r+1]; i++ )
+      *gsl_vector_ptr( p_flow, vProducts[i] ) += d_f - d_r;
+
+  }
+
+}
+
+//##############################################################################
+// NetworkJacobian::addValueToDiagonals().
+//##############################################################################
+
+/**
+ * \brief Add a value to the diagonal elements of the matrix.
+ * \param d_value The value to add.
+ */
+
+void
+NetworkJacobian::addValueToDiagonals( double d_value )
+{
+
+  for( size_t i = 0; i < iRows; i++ )
+    vValues[vDiagonal[i]] += d_value;
+
+}
+
+//##############################################################################
+// NetworkJacobian::getWnMatrix().
+//##############################################################################
+
+/**
+ * \brief Get the matrix as a WnMatrix for use with the arrow, dense, or
+ *        iterative solvers.
+ * \return A new WnMatrix.  The caller must free it with WnMatrix__free.
+ */
+
+WnMatrix *
+NetworkJacobian::getWnMatrix() const
+{
+
+  WnMatrix * p_matrix = WnMatrix__new( iRows, iRows );
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+    for( size_t p = vRowPtr[i]; p < vRowPtr[i+1]; p++ )
+    {
+      if( vValues[p] != 0. )
+        WnMatrix__assignElement( p_matrix, i + 1, vCol[p] + 1, vValues[p] );
+    }
+  }
+
+  return p_matrix;
+
+}
+
+//##############################################################################
+// get_network_jacobian_for_zone().
+//##############################################################################
+
+/**
+ * \brief Retrieve the Jacobian structure for the zone's current evolution
+ *        network view.  The structure is stored with the zone and only
+ *        compiled anew when the evolution view or the zone's rate vectors
+ *        change.
+ * \param zone The zone.
+ * \return A shared pointer to the Jacobian.
+ */
+
+boost::shared_ptr<NetworkJacobian>
+get_network_jacobian_for_zone( nnt::Zone& zone )
+{
+
+  boost::shared_ptr<ZoneRates> p_rates = get_zone_rates( zone );
+
+  Libnucnet__NetView * p_view = p_rates->getNetView();
+
+  if( zone.hasData( nnt::s_NETWORK_JACOBIAN ) )
+  {
+
+    boost::shared_ptr<NetworkJacobian> p_jacobian =
+      boost::any_cast<boost::shared_ptr<NetworkJacobian> >(
+        zone.getData( nnt::s_NETWORK_JACOBIAN )
+      );
+
+    if(
+      p_jacobian->isValidForView( zone.getNucnetZone(), p_view ) &&
+      p_jacobian->getTopologyPtr() == p_rates->getTopologyPtr()
+    )
+      return p_jacobian;
+
+  }
+
+  boost::shared_ptr<NetworkJacobian> p_jacobian(
+    new NetworkJacobian( zone.getNucnetZone(), *p_rates )
+  );
+
+  zone.updateData( nnt::s_NETWORK_JACOBIAN, p_jacobian );
+
+  return p_jacobian;
+
+}
+
+} // namespace user
@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the compressed sparse row network Jacobian.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_JACOBIAN_H
+#define NETWORK_JACOBIAN_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Libnucnet.h>
+#include <WnMatrix.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+#include "nnt/string_defs.h"
+
+#include "user/zone_rates.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for the network Jacobian.
+//##############################################################################
+
+/**
+ * \brief The network Jacobian matrix in compressed sparse row (CSR) form.
+ *
+ * The constructor takes the reactant and product species indices of a
+ * zone's flat rate vectors from their compiled ReactionTopology (in the
+ * same order as the rates), computes the structural
+ * pattern of the matrix (including all diagonal elements), and builds a
+ * scatter map from each reaction term to its slot in the CSR value
+ * array.  The matrix is then computed by filling the value array
+ * directly.  The matrix is the same as that returned by
+ * Libnucnet__Zone__computeJacobianMatrix, with zero-based indices.
+ */
+
+class NetworkJacobian
+{
+
+  public:
+    NetworkJacobian( Libnucnet__Zone *, const ZoneRates& );
+    Libnucnet__NetView * getNetView() const { return pView; }
+    const boost::shared_ptr<ReactionTopology>& getTopologyPtr() const
+      { return pTopology; }
+    size_t getNumberOfRows() const { return iRows; }
+    size_t getNumberOfElements() const { return vCol.size(); }
+    size_t getNumberOfReactions() const
+      { return pTopology->getNumberOfReactions(); }
+    const std::vector<size_t>& getRowPointerVector() const { return vRowPtr; }
+    const std::vector<size_t>& getColumnVector() const { return vCol; }
+    const std::vector<double>& getValueVector() const { return vValues; }
+    bool isValidForView( Libnucnet__Zone *, Libnucnet__NetView * );
+    void computeMatrix( const ZoneRates&, const gsl_vector * );
+    gsl_vector * computeFlowVector( const ZoneRates&, const gsl_vector * );
+    void computeFlowVector(
+      const ZoneRates&, const gsl_vector *, gsl_vector *
+    );
+    void addValueToDiagonals( double );
+    WnMatrix * getWnMatrix() const;
+
+  private:
+    Libnucnet__NetView * pView;
+    boost::shared_ptr<ReactionTopology> pTopology;
+    const std::vector<size_t>& vReactantPtr;
+    const std::vector<size_t>& vReactants;
+    const std::vector<size_t>& vProductPtr;
+    const std::vector<size_t>& vProducts;
+    const std::vector<double>& vDuplicateReactantFactor;
+    const std::vector<double>& vDuplicateProductFactor;
+    size_t iRows;
+    std::vector<size_t> vSlotPtr;
+    std::vector<size_t> vSlots;
+    std::vector<size_t> vRowPtr;
+    std::vector<size_t> vCol;
+    std::vector<size_t> vDiagonal;
+    std::vector<double> vValues;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+boost::shared_ptr<NetworkJacobian>
+get_network_jacobian_for_zone( nnt::Zone& );
+
+} // namespace user
+
+#endif // NETWORK_JACOBIAN_H
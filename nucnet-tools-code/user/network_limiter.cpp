@@ -30,128 +30,373 @@ namespace user
 {
 
 //##############################################################################
-// check_reactants().
+// NetworkLimiter::NetworkLimiter().
 //##############################################################################
 
-int
-check_reactants(
-  Libnucnet__Zone * p_zone,
-  gsl_vector * p_abunds,
-  Libnucnet__Reaction * p_reaction,
+/**
+ * \brief Index the reactions of the base view and limit the zone's
+ *        evolution network for its current abundances.
+ * \param zone The zone.
+ * \param p_base_view The base view from which the evolution network is
+ *        chosen.
+ * \param d_cutoff The abundance cutoff.
+ */
+
+NetworkLimiter::NetworkLimiter(
+  nnt::Zone& zone,
+  Libnucnet__NetView * p_base_view,
   double d_cutoff
-)
+) : pBaseView( p_base_view ), pView( NULL ), iActive( 0 ), dCutoff( d_cutoff )
 {
 
-  Libnucnet__Species * p_species;
+  Libnucnet__Nuc * p_nuc =
+    Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( zone.getNucnetZone() ) );
+
+  size_t i_species = Libnucnet__Nuc__getNumberOfSpecies( p_nuc );
+
+  iNucUpdate = p_nuc->iUpdate;
+
+  //============================================================================
+  // Reactants and products as species indices.  The base view only holds
+  // reactions whose species are in the network.
+  //============================================================================
 
-  nnt::reaction_element_list_t reactant_list =
-    nnt::make_reaction_nuclide_reactant_list( p_reaction );
+  vReactantPtr.push_back( 0 );
+  vProductPtr.push_back( 0 );
 
-  BOOST_FOREACH( nnt::ReactionElement reactant, reactant_list )
+  BOOST_FOREACH(
+    nnt::Reaction reaction,
+    nnt::make_reaction_list(
+      Libnucnet__Net__getReac( Libnucnet__NetView__getNet( p_base_view ) )
+    )
+  )
   {
 
-    p_species =
-      Libnucnet__Nuc__getSpeciesByName(
-        Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) ),
-        Libnucnet__Reaction__Element__getName(
-          reactant.getNucnetReactionElement()
-        )
-      );
+    vReactions.push_back( reaction.getNucnetReaction() );
 
-    if( !p_species )
+    BOOST_FOREACH(
+      nnt::ReactionElement element,
+      nnt::make_reaction_nuclide_reactant_list( reaction.getNucnetReaction() )
+    )
     {
-      return 0;
+      vReactants.push_back(
+        Libnucnet__Species__getIndex(
+          Libnucnet__Nuc__getSpeciesByName(
+            p_nuc,
+            Libnucnet__Reaction__Element__getName(
+              element.getNucnetReactionElement()
+            )
+          )
+        )
+      );
     }
 
-    if(
-      gsl_vector_get(
-        p_abunds,
-        Libnucnet__Species__getIndex( p_species )
-      ) < d_cutoff
+    BOOST_FOREACH(
+      nnt::ReactionElement element,
+      nnt::make_reaction_nuclide_product_list( reaction.getNucnetReaction() )
     )
     {
-      return 0;
+      vProducts.push_back(
+        Libnucnet__Species__getIndex(
+          Libnucnet__Nuc__getSpeciesByName(
+            p_nuc,
+            Libnucnet__Reaction__Element__getName(
+              element.getNucnetReactionElement()
+            )
+          )
+        )
+      );
     }
 
+    vReactantPtr.push_back( vReactants.size() );
+    vProductPtr.push_back( vProducts.size() );
+
   }
 
-  return 1;
+  //============================================================================
+  // Species to reaction incidence.  Each entry is twice the reaction index
+  // for a reactant and twice the reaction index plus one for a product.
+  //============================================================================
+
+  vIncidencePtr.assign( i_species + 1, 0 );
+
+  for( size_t j = 0; j < vReactants.size(); j++ )
+    vIncidencePtr[vReactants[j] + 1]++;
+  for( size_t j = 0; j < vProducts.size(); j++ )
+    vIncidencePtr[vProducts[j] + 1]++;
+
+  for( size_t s = 0; s < i_species; s++ )
+    vIncidencePtr[s + 1] += vIncidencePtr[s];
+
+  vIncidence.resize( vIncidencePtr.back() );
+
+  std::vector<size_t> v_next( vIncidencePtr.begin(), vIncidencePtr.end() - 1 );
+
+  for( size_t r = 0; r < vReactions.size(); r++ )
+  {
+    for( size_t j = vReactantPtr[r]; j < vReactantPtr[r + 1]; j++ )
+      vIncidence[v_next[vReactants[j]]++] = 2 * r;
+    for( size_t j = vProductPtr[r]; j < vProductPtr[r + 1]; j++ )
+      vIncidence[v_next[vProducts[j]]++] = 2 * r + 1;
+  }
+
+  //============================================================================
+  // State for the current abundances.
+  //============================================================================
+
+  boost::shared_ptr<ZoneAbundances> p_abunds = get_zone_abundances( zone );
+
+  p_abunds->readAbundances( zone.getNucnetZone() );
+
+  const std::vector<double>& v_y = p_abunds->getAbundanceVector();
+
+  vAbove.resize( i_species );
+
+  for( size_t s = 0; s < i_species; s++ ) vAbove[s] = v_y[s] >= dCutoff;
+
+  vReactantsBelow.assign( vReactions.size(), 0 );
+  vProductsBelow.assign( vReactions.size(), 0 );
+
+  for( size_t r = 0; r < vReactions.size(); r++ )
+  {
+    for( size_t j = vReactantPtr[r]; j < vReactantPtr[r + 1]; j++ )
+      if( !vAbove[vReactants[j]] ) vReactantsBelow[r]++;
+    for( size_t j = vProductPtr[r]; j < vProductPtr[r + 1]; j++ )
+      if( !vAbove[vProducts[j]] ) vProductsBelow[r]++;
+  }
+
+  //============================================================================
+  // The evolution view starts as a copy of the base view with all its
+  // reactions, from which the inactive ones are removed.
+  //============================================================================
+
+  pView = Libnucnet__NetView__copy( p_base_view );
+
+  vActive.assign( vReactions.size(), 1 );
+  vUseCount.assign( i_species, 0 );
+  vDirty.assign( vReactions.size(), 0 );
+
+  iActive = vReactions.size();
+
+  for( size_t j = 0; j < vReactants.size(); j++ ) vUseCount[vReactants[j]]++;
+  for( size_t j = 0; j < vProducts.size(); j++ ) vUseCount[vProducts[j]]++;
+
+  for( size_t r = 0; r < vReactions.size(); r++ )
+    if( !isActive( r ) ) setActive( r, false );
+
+  //============================================================================
+  // The zone frees the evolution view this one replaces, so drop the data
+  // recorded for it.
+  //============================================================================
+
+  Libnucnet__NetView * p_old_view =
+    Libnucnet__Zone__getNetView(
+      zone.getNucnetZone(),
+      EVOLUTION_NETWORK,
+      NULL,
+      NULL
+    );
+
+  if( p_old_view ) release_view( zone, p_old_view );
+
+  Libnucnet__Zone__updateNetView(
+    zone.getNucnetZone(),
+    EVOLUTION_NETWORK,
+    NULL,
+    NULL,
+    pView
+  );
 
 }
-  
+
 //##############################################################################
-// check_products().
+// NetworkLimiter::isValidFor().
 //##############################################################################
 
-int
-check_products(
-  Libnucnet__Zone * p_zone,
-  gsl_vector * p_abunds,
-  Libnucnet__Reaction * p_reaction,
+/**
+ * \brief Check whether the limiter applies to a zone.
+ * \param zone The zone.
+ * \param p_base_view The base view.
+ * \param d_cutoff The abundance cutoff.
+ * \return True if the limiter was built for the base view and cutoff, the
+ *         network has not changed since, and the zone's evolution view is
+ *         still the one the limiter maintains, false if not.
+ */
+
+bool
+NetworkLimiter::isValidFor(
+  nnt::Zone& zone,
+  Libnucnet__NetView * p_base_view,
   double d_cutoff
-)
+) const
 {
 
-  Libnucnet__Species * p_species;
+  return
+    p_base_view == pBaseView &&
+    d_cutoff == dCutoff &&
+    !Libnucnet__NetView__wasNetUpdated( p_base_view ) &&
+    Libnucnet__Net__getNuc(
+      Libnucnet__Zone__getNet( zone.getNucnetZone() )
+    )->iUpdate == iNucUpdate &&
+    Libnucnet__Zone__getNetView(
+      zone.getNucnetZone(),
+      EVOLUTION_NETWORK,
+      NULL,
+      NULL
+    ) == pView;
 
-  nnt::reaction_element_list_t element_list =
-    nnt::make_reaction_nuclide_product_list( p_reaction );
+}
+
+//##############################################################################
+// NetworkLimiter::setActive().
+//##############################################################################
+
+void
+NetworkLimiter::setActive( size_t r, bool b_active )
+{
 
-  BOOST_FOREACH( nnt::ReactionElement product, element_list )
+  vActive[r] = b_active;
+
+  if( b_active )
+  {
+    Libnucnet__NetView__addReaction( pView, vReactions[r] );
+    iActive++;
+  }
+  else
   {
+    Libnucnet__NetView__removeReaction( pView, vReactions[r] );
+    iActive--;
+  }
 
-    p_species =
-      Libnucnet__Nuc__getSpeciesByName(
-        Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) ),
-        Libnucnet__Reaction__Element__getName(
-          product.getNucnetReactionElement()
-        )
-      );
+  for( size_t j = vReactantPtr[r]; j < vReactantPtr[r + 1]; j++ )
+    b_active ? vUseCount[vReactants[j]]++ : vUseCount[vReactants[j]]--;
 
-    if( !p_species )
+  for( size_t j = vProductPtr[r]; j < vProductPtr[r + 1]; j++ )
+    b_active ? vUseCount[vProducts[j]]++ : vUseCount[vProducts[j]]--;
+
+}
+
+//##############################################################################
+// NetworkLimiter::update().
+//##############################################################################
+
+/**
+ * \brief Update the zone's evolution network for its current abundances
+ *        and zero out the abundances below the cutoff of the species in
+ *        no reaction of the evolution network.
+ * \param zone The zone.
+ */
+
+void
+NetworkLimiter::update( nnt::Zone& zone )
+{
+
+  boost::shared_ptr<ZoneAbundances> p_abunds = get_zone_abundances( zone );
+
+  p_abunds->readAbundances( zone.getNucnetZone() );
+
+  const std::vector<double>& v_y = p_abunds->getAbundanceVector();
+
+  //============================================================================
+  // Species that crossed the cutoff and the reactions they enter.
+  //============================================================================
+
+  for( size_t s = 0; s < vAbove.size(); s++ )
+  {
+
+    char b_above = v_y[s] >= dCutoff;
+
+    if( b_above == vAbove[s] ) continue;
+
+    vAbove[s] = b_above;
+
+    for( size_t k = vIncidencePtr[s]; k < vIncidencePtr[s + 1]; k++ )
     {
-      return 0;
+
+      size_t r = vIncidence[k] / 2;
+
+      std::vector<size_t>& v_below =
+        vIncidence[k] % 2 == 0 ? vReactantsBelow : vProductsBelow;
+
+      b_above ? v_below[r]-- : v_below[r]++;
+
+      if( !vDirty[r] )
+      {
+        vDirty[r] = 1;
+        vDirtyReactions.push_back( r );
+      }
+
     }
 
-    if(
-      gsl_vector_get(
-        p_abunds,
-        Libnucnet__Species__getIndex( p_species )
-      ) < d_cutoff
-    )
+  }
+
+  //============================================================================
+  // Update the view in place.
+  //============================================================================
+
+  bool b_changed = false;
+
+  BOOST_FOREACH( size_t r, vDirtyReactions )
+  {
+
+    vDirty[r] = 0;
+
+    if( isActive( r ) != ( vActive[r] != 0 ) )
     {
-      return 0;
+      setActive( r, isActive( r ) );
+      b_changed = true;
     }
 
   }
 
-  return 1;
+  vDirtyReactions.clear();
+
+  if( b_changed ) notify_view_change( zone, pView );
+
+  //============================================================================
+  // Zero out small abundances of unused species.
+  //============================================================================
+
+  gsl_vector_view y_view = p_abunds->getAbundanceView();
+
+  for( size_t s = 0; s < vAbove.size(); s++ )
+  {
+
+    if( vUseCount[s] == 0 && !vAbove[s] && v_y[s] != 0. )
+    {
+      Libnucnet__Zone__updateSpeciesAbundance(
+        zone.getNucnetZone(),
+        p_abunds->getSpecies( s ),
+        0.
+      );
+      gsl_vector_set( &y_view.vector, s, 0. );
+    }
+
+  }
 
 }
-  
+
 //##############################################################################
-// limit_evolution_network().
+// get_network_limiter().
 //##############################################################################
 
 /**
- * \brief Routine to limit reactions to those that connect species with
- *        abundance greater than a thresold value.
- *
- * \param zone The zone.
- * \param d_cutoff The cutoff threshold (optional--default = 1.e-25)
- *
-*/
+ * \brief Retrieve the network limiter for a zone.  The limiter is stored
+ *        with the zone and only built anew when the base view, the cutoff,
+ *        or the network change or the zone's evolution view was replaced.
+ * \param zone The zone.  The base view is given by the zone's base
+ *        evolution nuclear and reaction XPath properties, if present.
+ * \param d_cutoff The abundance cutoff.
+ * \return A shared pointer to the limiter.
+ */
 
-void
-limit_evolution_network( nnt::Zone& zone, double d_cutoff )
+boost::shared_ptr<NetworkLimiter>
+get_network_limiter( nnt::Zone& zone, double d_cutoff )
 {
 
-  Libnucnet__NetView * p_base_view, * p_view;
-  gsl_vector * p_abunds;
-
   std::string s_nuc_xpath;
   std::string s_reac_xpath;
-    
+
   if( zone.hasProperty( nnt::s_BASE_EVOLUTION_NUC_XPATH ) )
     s_nuc_xpath =
       zone.getProperty<std::string>( nnt::s_BASE_EVOLUTION_NUC_XPATH );
@@ -164,122 +409,50 @@ limit_evolution_network( nnt::Zone& zone, double d_cutoff )
   else
     s_reac_xpath = "";
 
-  p_base_view = zone.getNetView( s_nuc_xpath.c_str(), s_reac_xpath.c_str() );
-
-  p_abunds = Libnucnet__Zone__getAbundances( zone.getNucnetZone() );
-
-  boost::unordered_set<std::string> species_set;
-
-  nnt::reaction_list_t reaction_list =
-    nnt::make_reaction_list(
-      Libnucnet__Net__getReac( Libnucnet__NetView__getNet( p_base_view ) )
-    );
-
-  p_view = Libnucnet__NetView__copy( p_base_view );
+  Libnucnet__NetView * p_base_view =
+    zone.getNetView( s_nuc_xpath.c_str(), s_reac_xpath.c_str() );
 
-  BOOST_FOREACH( nnt::Reaction reaction, reaction_list )
+  if( zone.hasData( nnt::s_NETWORK_LIMITER ) )
   {
 
-    if(
-      !check_reactants(
-         zone.getNucnetZone(),
-         p_abunds,
-         reaction.getNucnetReaction(),
-         d_cutoff
-      )
-      &&
-      !check_products(
-         zone.getNucnetZone(),
-         p_abunds,
-         reaction.getNucnetReaction(),
-         d_cutoff
-      )
-    )
-    {
-
-      Libnucnet__NetView__removeReaction(
-        p_view,
-        reaction.getNucnetReaction()
+    boost::shared_ptr<NetworkLimiter> p_limiter =
+      boost::any_cast<boost::shared_ptr<NetworkLimiter> >(
+        zone.getData( nnt::s_NETWORK_LIMITER )
       );
 
-    }
-    else
-    {
-
-      nnt::reaction_element_list_t reactant_list =
-        nnt::make_reaction_nuclide_reactant_list(
-          reaction.getNucnetReaction()
-        );
-
-      BOOST_FOREACH( nnt::ReactionElement element, reactant_list )
-      {
-        species_set.insert(
-          Libnucnet__Reaction__Element__getName(
-            element.getNucnetReactionElement()
-          )  
-        );
-      }
-
-      nnt::reaction_element_list_t product_list =
-        nnt::make_reaction_nuclide_product_list(
-          reaction.getNucnetReaction()
-        );
-
-      BOOST_FOREACH( nnt::ReactionElement element, product_list )
-      {
-        species_set.insert(
-          Libnucnet__Reaction__Element__getName(
-            element.getNucnetReactionElement()
-          )  
-        );
-      }
-
-    }
+    if( p_limiter->isValidFor( zone, p_base_view, d_cutoff ) )
+      return p_limiter;
 
   }
 
-  Libnucnet__Zone__updateNetView(
-    zone.getNucnetZone(),
-    EVOLUTION_NETWORK,
-    NULL,
-    NULL,
-    p_view
+  boost::shared_ptr<NetworkLimiter> p_limiter(
+    new NetworkLimiter( zone, p_base_view, d_cutoff )
   );
 
-  nnt::species_list_t species_list =
-    nnt::make_species_list(
-      Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( zone.getNucnetZone() ) )
-    );
+  zone.updateData( nnt::s_NETWORK_LIMITER, p_limiter );
 
-  BOOST_FOREACH( nnt::Species species, species_list )
-  {
+  return p_limiter;
 
-    if(
-      !(
-         species_set.find(
-           Libnucnet__Species__getName( species.getNucnetSpecies() )
-         ) != species_set.end()
-      )
-    )
-    {
+}
 
-      if(
-        gsl_vector_get(
-          p_abunds,
-          Libnucnet__Species__getIndex( species.getNucnetSpecies() )
-        ) < d_cutoff
-      )
-        Libnucnet__Zone__updateSpeciesAbundance(
-          zone.getNucnetZone(),
-          species.getNucnetSpecies(),
-          0.
-        );
- 
-    }
+//##############################################################################
+// limit_evolution_network().
+//##############################################################################
 
-  }
-   
-  gsl_vector_free( p_abunds );
+/**
+ * \brief Routine to limit reactions to those that connect species with
+ *        abundance greater than a thresold value.
+ *
+ * \param zone The zone.
+ * \param d_cutoff The cutoff threshold (optional--default = 1.e-25)
+ *
+*/
+
+void
+limit_evolution_network( nnt::Zone& zone, double d_cutoff )
+{
+
+  get_network_limiter( zone, d_cutoff )->update( zone );
 
 }
 
@@ -365,16 +538,16 @@ zero_out_small_rates( nnt::Zone& zone, double d_threshold )
   BOOST_FOREACH( nnt::Reaction reaction, reaction_list )
   {
 
-    Libnucnet__Zone__getRatesForReaction(
-      zone.getNucnetZone(),
+    get_rates_for_reaction(
+      zone,
       reaction.getNucnetReaction(),
       &d_forward,
       &d_reverse
     );
 
     if( d_forward < d_threshold && d_reverse < d_threshold )
-      Libnucnet__Zone__updateRatesForReaction(
-        zone.getNucnetZone(),
+      update_rates_for_reaction(
+        zone,
         reaction.getNucnetReaction(),
         0.,
         0.
@@ -413,7 +586,7 @@ get_isolated_species(
   nnt::reaction_element_list_t element_list;
 
   p_view =
-    Libnucnet__NetView__new(
+    nnt::new_net_view(
       p_net,
       s_nuc_xpath.c_str(),
       s_reac_xpath.c_str()
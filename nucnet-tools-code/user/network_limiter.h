@@ -27,16 +27,78 @@
 #include <string>
 #include <set>
 
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/unordered_set.hpp>
 
 #include <Libnucnet.h>
 
 #include "nnt/auxiliary.h"
 #include "nnt/iter.h"
+#include "nnt/view_selector.h"
+
+#include "user/zone_rates.h"
+#include "user/zone_abundances.h"
 
 namespace user
 {
 
+//##############################################################################
+// Class for the incremental network limiter.
+//##############################################################################
+
+/**
+ * \brief The state of the network limiter for a zone.
+ *
+ * user::limit_evolution_network() keeps a reaction of the base view in the
+ * evolution network if all its nuclide reactants or all its nuclide
+ * products have abundances at or above the cutoff.  This class stores the
+ * reactants and products of the base view's reactions as species indices,
+ * an index from each species to the reactions it enters, whether each
+ * species is above the cutoff, and, for each reaction, the number of its
+ * reactants and products below the cutoff.  update() then only revisits the
+ * reactions of the species that crossed the cutoff since the last call,
+ * adds or removes them in the zone's evolution view in place, and calls
+ * user::notify_view_change() if the view changed, so the data compiled for
+ * the view are rebuilt only when its reactions change.
+ */
+
+class NetworkLimiter : private boost::noncopyable
+{
+
+  public:
+    NetworkLimiter( nnt::Zone&, Libnucnet__NetView *, double );
+    bool isValidFor( nnt::Zone&, Libnucnet__NetView *, double ) const;
+    size_t getNumberOfActiveReactions() const { return iActive; }
+    void update( nnt::Zone& );
+
+  private:
+    Libnucnet__NetView * pBaseView;
+    Libnucnet__NetView * pView;
+    size_t iNucUpdate;
+    size_t iActive;
+    double dCutoff;
+    std::vector<Libnucnet__Reaction *> vReactions;
+    std::vector<size_t> vReactantPtr;
+    std::vector<size_t> vReactants;
+    std::vector<size_t> vProductPtr;
+    std::vector<size_t> vProducts;
+    std::vector<size_t> vIncidencePtr;
+    std::vector<size_t> vIncidence;
+    std::vector<char> vAbove;
+    std::vector<size_t> vReactantsBelow;
+    std::vector<size_t> vProductsBelow;
+    std::vector<char> vActive;
+    std::vector<size_t> vUseCount;
+    std::vector<char> vDirty;
+    std::vector<size_t> vDirtyReactions;
+
+    bool isActive( size_t r ) const
+      { return vReactantsBelow[r] == 0 || vProductsBelow[r] == 0; }
+    void setActive( size_t, bool );
+
+};
+
 //##############################################################################
 // Prototypes.
 //##############################################################################
@@ -47,6 +109,9 @@ limit_evolution_network( nnt::Zone&, double );
 void
 limit_evolution_network( nnt::Zone& );
 
+boost::shared_ptr<NetworkLimiter>
+get_network_limiter( nnt::Zone&, double );
+
 void
 zero_out_small_abundances( nnt::Zone&, double );
 
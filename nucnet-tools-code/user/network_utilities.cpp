@@ -291,29 +291,24 @@ compute_Ysum(
 // update_t9_rho_in_zone_by_interpolation().
 //##############################################################################
 
+/**
+ * \brief Set a zone's t9 and density from a trajectory at the zone's time.
+ *        If the change in t9 or density from the values last set is too
+ *        large, the time step is halved and the interpolation repeated.
+ * \param zone The zone.
+ * \param p_interpolator The zone's trajectory interpolator.
+ */
+
 void
 update_t9_rho_in_zone_by_interpolation(
   nnt::Zone& zone,
-  std::string s_interpolation_type,
-  const std::vector<double> &time,
-  const std::vector<double> &t9,
-  const std::vector<double> &log10_rho
+  boost::shared_ptr<TrajectoryInterpolator> p_interpolator
 )
 {
 
-  static std::map<nnt::Zone, double> old_t9, old_rho;
-  gsl_vector * p_time, * p_t9, * p_log10_rho;
   double d_t9 = 0, d_rho = 0, d_change_t9, d_change_rho;
   double d_time, d_dt;
 
-  //==========================================================================
-  // Get gsl vectors.
-  //==========================================================================
-
-  p_time = nnt::get_new_gsl_vector_from_std_vector( time );
-  p_t9 = nnt::get_new_gsl_vector_from_std_vector( t9 );
-  p_log10_rho = nnt::get_new_gsl_vector_from_std_vector( log10_rho );
-
   //==========================================================================
   // Get time and dt.
   //==========================================================================
@@ -329,38 +324,23 @@ update_t9_rho_in_zone_by_interpolation(
   while( d_dt > 0. )
   {
 
-     if( s_interpolation_type == "spline" )
-     {
-       d_t9 = nnt::spline_interpolation( p_time, p_t9, d_time );
-       d_rho =
-         pow( 10., nnt::spline_interpolation( p_time, p_log10_rho, d_time ) );
-     }
-     else if( s_interpolation_type == "linear" )
-     {
-       d_t9 = nnt::linear_interpolation( p_time, p_t9, d_time );
-       d_rho =
-         pow( 10., nnt::linear_interpolation( p_time, p_log10_rho, d_time ) );
-     }
-     else
-     {
-       std::cerr << "Invalid interpolation type." << std::endl;
-       exit( EXIT_FAILURE );
-     }
+     d_t9 = p_interpolator->computeT9( d_time );
+     d_rho = p_interpolator->computeRho( d_time );
 
-     if( old_t9.find(zone) == old_t9.end() )
+     if( !p_interpolator->hasLast() )
      {
-       old_t9[zone] = d_t9;
-       old_rho[zone] = d_rho;
+       p_interpolator->setLast( d_t9, d_rho );
        d_change_t9 = 0.;
        d_change_rho = 0.;
      }
      else
      {
        d_change_t9 =
-         fabs( d_t9 - old_t9.find(zone)->second ) / old_t9.find(zone)->second;
+         fabs( d_t9 - p_interpolator->getLastT9() ) /
+           p_interpolator->getLastT9();
        d_change_rho =
-         fabs( d_rho - old_rho.find(zone)->second ) /
-           old_rho.find(zone)->second;
+         fabs( d_rho - p_interpolator->getLastRho() ) /
+           p_interpolator->getLastRho();
      }
 
      if( d_change_t9 < D_EPS && d_change_rho < D_EPS )
@@ -395,13 +375,58 @@ update_t9_rho_in_zone_by_interpolation(
     d_dt
   );
 
-  old_t9[zone] = d_t9;
+  p_interpolator->setLast( d_t9, d_rho );
+
+}
+
+/**
+ * \brief Set a zone's t9 and density from a trajectory shared by the zones.
+ * \param zone The zone.
+ * \param p_trajectory The trajectory.
+ */
+
+void
+update_t9_rho_in_zone_by_interpolation(
+  nnt::Zone& zone,
+  boost::shared_ptr<Trajectory> p_trajectory
+)
+{
+
+  update_t9_rho_in_zone_by_interpolation(
+    zone,
+    get_trajectory_interpolator( zone, p_trajectory )
+  );
+
+}
 
-  old_rho[zone] = d_rho;
+/**
+ * \brief Set a zone's t9 and density from trajectory data.  The trajectory
+ *        is built on the first call and kept with the zone until the data
+ *        change.
+ * \param zone The zone.
+ * \param s_interpolation_type The interpolation type ("spline" or
+ *        "linear").
+ * \param time The times.
+ * \param t9 The t9 values.
+ * \param log10_rho The log10 densities.
+ */
 
-  gsl_vector_free( p_time );
-  gsl_vector_free( p_t9 );
-  gsl_vector_free( p_log10_rho );
+void
+update_t9_rho_in_zone_by_interpolation(
+  nnt::Zone& zone,
+  std::string s_interpolation_type,
+  const std::vector<double> &time,
+  const std::vector<double> &t9,
+  const std::vector<double> &log10_rho
+)
+{
+
+  update_t9_rho_in_zone_by_interpolation(
+    zone,
+    get_trajectory_interpolator(
+      zone, s_interpolation_type, time, t9, log10_rho
+    )
+  );
 
 }
 
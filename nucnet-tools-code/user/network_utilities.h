@@ -38,6 +38,8 @@
 #include "nnt/math.h"
 #include "nnt/string_defs.h"
 
+#include "user/trajectory.h"
+
 namespace user
 {
 
@@ -83,6 +85,18 @@ update_t9_rho_in_zone_by_interpolation(
   const std::vector<double>&
 );
 
+void
+update_t9_rho_in_zone_by_interpolation(
+  nnt::Zone&,
+  boost::shared_ptr<Trajectory>
+);
+
+void
+update_t9_rho_in_zone_by_interpolation(
+  nnt::Zone&,
+  boost::shared_ptr<TrajectoryInterpolator>
+);
+
 void
 copy_zone_abundances_as_properties(
   nnt::Zone&,
@@ -0,0 +1,424 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the compiled non-smoker fit rate kernel.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/non_smoker_rate_kernel.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// collect_non_smoker_fit().
+//##############################################################################
+
+void
+collect_non_smoker_fit(
+  Libnucnet__Reaction__NonSmokerFit * p_fit,
+  std::vector<Libnucnet__Reaction__NonSmokerFit *> * p_fits,
+  xmlChar * sx_note
+)
+{
+
+  if( !sx_note )
+  {
+    std::cerr << "Invalid non-smoker fit." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  p_fits->push_back( p_fit );
+
+}
+
+//##############################################################################
+// compute_non_smoker_exponent().
+//##############################################################################
+
+double
+compute_non_smoker_exponent( const double * a, double d_t9 )
+{
+
+  return
+    ( a[0] ) +
+    ( a[1] / d_t9 ) +
+    ( a[2] / pow( d_t9, ( 1. / 3. ) ) ) +
+    ( a[3] * pow( d_t9, ( 1. / 3. ) ) ) +
+    ( a[4] * d_t9 ) +
+    ( a[5] * pow( d_t9, ( 5. / 3. ) ) ) +
+    ( a[6] * log( d_t9 ) );
+
+}
+
+//##############################################################################
+// NonSmokerRateKernel::NonSmokerRateKernel().
+//##############################################################################
+
+/**
+ * \brief Pack the non-smoker fits of a network view.
+ * \param p_view A pointer to the network view.
+ * \param i_revision The revision of the view (see user::get_view_revision()).
+ */
+
+NonSmokerRateKernel::NonSmokerRateKernel(
+  Libnucnet__NetView * p_view,
+  size_t i_revision
+) : pView( p_view ), iRevision( i_revision ), dT9( -1. )
+{
+
+  Libnucnet__Reac * p_reac =
+    Libnucnet__Net__getReac( Libnucnet__NetView__getNet( p_view ) );
+
+  BOOST_FOREACH( nnt::Reaction reaction, nnt::make_reaction_list( p_reac ) )
+  {
+
+    Libnucnet__Reaction * p_reaction = reaction.getNucnetReaction();
+
+    if(
+      !p_reaction->pRd ||
+      !p_reaction->pRd->pNsfHash ||
+      std::string( Libnucnet__Reaction__getRateFunctionKey( p_reaction ) ) !=
+        NON_SMOKER_STRING
+    )
+      continue;
+
+    std::vector<Libnucnet__Reaction__NonSmokerFit *> v_fits;
+
+    xmlHashScan(
+      p_reaction->pRd->pNsfHash,
+      (xmlHashScanner) collect_non_smoker_fit,
+      &v_fits
+    );
+
+    index_map[p_reaction] = vReactions.size();
+    vReactions.push_back( p_reaction );
+    vTermPtr.push_back( vA0.size() );
+
+    BOOST_FOREACH( Libnucnet__Reaction__NonSmokerFit * p_fit, v_fits )
+    {
+      vA0.push_back( p_fit->a[0] );
+      vA1.push_back( p_fit->a[1] );
+      vA2.push_back( p_fit->a[2] );
+      vA3.push_back( p_fit->a[3] );
+      vA4.push_back( p_fit->a[4] );
+      vA5.push_back( p_fit->a[5] );
+      vA6.push_back( p_fit->a[6] );
+      vTLow.push_back( *p_fit->pTlowfit );
+      vTHigh.push_back( *p_fit->pThighfit );
+      vXLow.push_back(
+        compute_non_smoker_exponent( p_fit->a, *p_fit->pTlowfit )
+      );
+      vXHigh.push_back(
+        compute_non_smoker_exponent( p_fit->a, *p_fit->pThighfit )
+      );
+    }
+
+  }
+
+  vTermPtr.push_back( vA0.size() );
+
+  vTerms.resize( vA0.size() );
+  vRates.resize( vReactions.size() );
+
+  iReacUpdate = p_reac->iUpdate;
+
+}
+
+//##############################################################################
+// NonSmokerRateKernel::isValidForView().
+//##############################################################################
+
+/**
+ * \brief Check whether the kernel is valid for a view.
+ * \param p_view A pointer to the network view.
+ * \return True if the kernel was packed for the view and the reactions have
+ *         not been updated since, false if not.
+ */
+
+bool
+NonSmokerRateKernel::isValidForView( Libnucnet__NetView * p_view ) const
+{
+
+  return
+    p_view == pView &&
+    !Libnucnet__NetView__wasNetUpdated( p_view ) &&
+    Libnucnet__Net__getReac(
+      Libnucnet__NetView__getNet( p_view )
+    )->iUpdate == iReacUpdate;
+
+}
+
+//##############################################################################
+// NonSmokerRateKernel::computeRates().
+//##############################################################################
+
+/**
+ * \brief Compute the rates of all non-smoker reactions at a t9.
+ * \param d_t9 The t9 at which to compute the rates.
+ */
+
+void
+NonSmokerRateKernel::computeRates( double d_t9 )
+{
+
+  size_t i_terms = vTerms.size();
+
+  dT9 = d_t9;
+
+  if( i_terms == 0 ) return;
+
+  //============================================================================
+  // Powers of t9.
+  //============================================================================
+
+  double d_t9_13 = pow( d_t9, ( 1. / 3. ) );
+  double d_t9_53 = pow( d_t9, ( 5. / 3. ) );
+  double d_log_t9 = log( d_t9 );
+
+  //============================================================================
+  // Terms.  Outside a fit range, the exponent at the range limit is used.
+  //============================================================================
+
+  const double * a0 = &vA0[0], * a1 = &vA1[0], * a2 = &vA2[0],
+    * a3 = &vA3[0], * a4 = &vA4[0], * a5 = &vA5[0], * a6 = &vA6[0];
+  const double * t_low = &vTLow[0], * t_high = &vTHigh[0];
+  const double * x_low = &vXLow[0], * x_high = &vXHigh[0];
+  double * terms = &vTerms[0];
+
+#ifndef NO_OPENMP
+  #pragma omp simd
+#endif
+  for( size_t i = 0; i < i_terms; i++ )
+  {
+    double d_x =
+      ( a0[i] ) +
+      ( a1[i] / d_t9 ) +
+      ( a2[i] / d_t9_13 ) +
+      ( a3[i] * d_t9_13 ) +
+      ( a4[i] * d_t9 ) +
+      ( a5[i] * d_t9_53 ) +
+      ( a6[i] * d_log_t9 );
+    d_x = d_t9 < t_low[i] ? x_low[i] : d_x;
+    d_x = d_t9 > t_high[i] ? x_high[i] : d_x;
+    terms[i] = exp( d_x );
+  }
+
+  //============================================================================
+  // Sum terms.
+  //============================================================================
+
+  for( size_t i = 0; i < vReactions.size(); i++ )
+  {
+    double d_rate = 0.;
+    for( size_t j = vTermPtr[i]; j < vTermPtr[i+1]; j++ )
+      d_rate += terms[j];
+    vRates[i] = d_rate;
+  }
+
+}
+
+//##############################################################################
+// NonSmokerRateKernel::computeRate().
+//##############################################################################
+
+/**
+ * \brief Get the rate of a non-smoker reaction at a t9.
+ * \param p_reaction A pointer to the reaction.
+ * \param d_t9 The t9 at which to compute the rate.
+ * \return The rate.  The rates of all reactions are computed if the t9
+ *         differs from that of the last computation.  If the reaction is
+ *         not in the kernel, the rate is computed by Libnucnet.
+ */
+
+double
+NonSmokerRateKernel::computeRate(
+  Libnucnet__Reaction * p_reaction,
+  double d_t9
+)
+{
+
+  boost::unordered_map<const Libnucnet__Reaction *, size_t>::iterator it =
+    index_map.find( p_reaction );
+
+  if( it == index_map.end() || p_reaction->pReac->iUpdate != iReacUpdate )
+    return Libnucnet__Reaction__computeNonSmokerRate( p_reaction, d_t9, NULL );
+
+  if( d_t9 != dT9 ) computeRates( d_t9 );
+
+  return vRates[it->second];
+
+}
+
+//##############################################################################
+// compiled_non_smoker_rate_function().
+//##############################################################################
+
+/**
+ * \brief The non-smoker fit rate function.
+ *
+ * This function replaces the Libnucnet non-smoker fit function.  The data
+ * are the zone's NonSmokerRateKernel.  If no kernel has been set for the
+ * zone, the rate is computed by Libnucnet.
+ */
+
+double
+compiled_non_smoker_rate_function(
+  Libnucnet__Reaction * p_reaction,
+  double d_t9,
+  void * p_data
+)
+{
+
+  if( !p_data )
+    return Libnucnet__Reaction__computeNonSmokerRate( p_reaction, d_t9, NULL );
+
+  return
+    static_cast<NonSmokerRateKernel *>( p_data )->computeRate(
+      p_reaction,
+      d_t9
+    );
+
+}
+
+//##############################################################################
+// free_non_smoker_rate_kernel().
+//##############################################################################
+
+void
+free_non_smoker_rate_kernel( void * p_data )
+{
+
+  delete static_cast<NonSmokerRateKernel *>( p_data );
+
+}
+
+//##############################################################################
+// register_non_smoker_rate_kernel().
+//##############################################################################
+
+/**
+ * \brief Register the compiled non-smoker rate function and its data
+ *        deallocator.
+ * \param p_reac A pointer to the Libnucnet__Reac.
+ */
+
+void
+register_non_smoker_rate_kernel( Libnucnet__Reac * p_reac )
+{
+
+  Libnucnet__Reac__registerUserRateFunction(
+    p_reac,
+    NON_SMOKER_STRING,
+    (Libnucnet__Reaction__userRateFunction) compiled_non_smoker_rate_function
+  );
+
+  Libnucnet__Reac__setUserRateFunctionDataDeallocator(
+    p_reac,
+    NON_SMOKER_STRING,
+    (Libnucnet__Reaction__user_rate_function_data_deallocator)
+      free_non_smoker_rate_kernel
+  );
+
+}
+
+//##############################################################################
+// get_non_smoker_rate_kernel_for_zone().
+//##############################################################################
+
+/**
+ * \brief Get the non-smoker rate kernel for a zone.
+ * \param zone The zone.
+ * \return A pointer to the kernel for the zone's evolution network, or NULL
+ *         if the compiled non-smoker rate function is not registered for
+ *         the zone's network.  The kernel is packed if it is not present or
+ *         if the view or its reactions have changed.  The zone owns the
+ *         kernel.
+ */
+
+NonSmokerRateKernel *
+get_non_smoker_rate_kernel_for_zone( nnt::Zone& zone )
+{
+
+  Libnucnet__Reac__FD * p_fd =
+    (Libnucnet__Reac__FD *)
+    xmlHashLookup(
+      Libnucnet__Net__getReac(
+        Libnucnet__Zone__getNet( zone.getNucnetZone() )
+      )->pFDHash,
+      (const xmlChar *) NON_SMOKER_STRING
+    );
+
+  if(
+    !p_fd ||
+    p_fd->pfFunc !=
+      (Libnucnet__Reaction__rateFunction) compiled_non_smoker_rate_function
+  )
+    return NULL;
+
+  Libnucnet__NetView * p_view =
+    Libnucnet__Zone__getEvolutionNetView( zone.getNucnetZone() );
+
+  NonSmokerRateKernel * p_kernel =
+    static_cast<NonSmokerRateKernel *>(
+      Libnucnet__Zone__getDataForUserRateFunction(
+        zone.getNucnetZone(),
+        NON_SMOKER_STRING
+      )
+    );
+
+  size_t i_revision = get_view_revision( zone, p_view );
+
+  if(
+    p_kernel &&
+    p_kernel->getRevision() == i_revision &&
+    p_kernel->isValidForView( p_view )
+  )
+    return p_kernel;
+
+  p_kernel = new NonSmokerRateKernel( p_view, i_revision );
+
+  Libnucnet__Zone__updateDataForUserRateFunction(
+    zone.getNucnetZone(),
+    NON_SMOKER_STRING,
+    p_kernel
+  );
+
+  return p_kernel;
+
+}
+
+//##############################################################################
+// update_non_smoker_rate_kernel_data().
+//##############################################################################
+
+/**
+ * \brief Ensure a zone's non-smoker rate kernel is current.
+ * \param zone The zone.
+ */
+
+void
+update_non_smoker_rate_kernel_data( nnt::Zone& zone )
+{
+
+  get_non_smoker_rate_kernel_for_zone( zone );
+
+}
+
+} // namespace user
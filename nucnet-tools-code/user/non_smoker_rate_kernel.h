@@ -0,0 +1,120 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the compiled non-smoker fit rate kernel.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NON_SMOKER_RATE_KERNEL_H
+#define NON_SMOKER_RATE_KERNEL_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+
+#include "user/reaction_topology.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for the non-smoker rate kernel.
+//##############################################################################
+
+/**
+ * \brief The non-smoker fits of a network view packed into arrays.
+ *
+ * The constructor copies the seven coefficients of every non-smoker fit
+ * term of the reactions in the view into contiguous arrays (one array per
+ * coefficient), along with the fit temperature limits and the exponents
+ * at those limits.  The rates are then computed for all reactions at once:
+ * the powers of t9 are computed once, the exponents of all terms are
+ * evaluated in a single loop, and the terms are summed into a flat rate
+ * array indexed by reaction.  The rates are the same as those computed by
+ * Libnucnet__Reaction__computeNonSmokerRate.
+ */
+
+class NonSmokerRateKernel : private boost::noncopyable
+{
+
+  public:
+    NonSmokerRateKernel( Libnucnet__NetView *, size_t );
+    Libnucnet__NetView * getNetView() const { return pView; }
+    size_t getRevision() const { return iRevision; }
+    bool isValidForView( Libnucnet__NetView * ) const;
+    size_t getNumberOfReactions() const { return vReactions.size(); }
+    size_t getNumberOfTerms() const { return vA0.size(); }
+    const std::vector<Libnucnet__Reaction *>& getReactionVector() const
+      { return vReactions; }
+    const std::vector<double>& getRateVector() const { return vRates; }
+    void computeRates( double );
+    double computeRate( Libnucnet__Reaction *, double );
+
+  private:
+    Libnucnet__NetView * pView;
+    size_t iRevision;
+    size_t iReacUpdate;
+    double dT9;
+    std::vector<Libnucnet__Reaction *> vReactions;
+    boost::unordered_map<const Libnucnet__Reaction *, size_t> index_map;
+    std::vector<size_t> vTermPtr;
+    std::vector<double> vA0, vA1, vA2, vA3, vA4, vA5, vA6;
+    std::vector<double> vTLow, vTHigh, vXLow, vXHigh;
+    std::vector<double> vTerms;
+    std::vector<double> vRates;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+void
+collect_non_smoker_fit(
+  Libnucnet__Reaction__NonSmokerFit *,
+  std::vector<Libnucnet__Reaction__NonSmokerFit *> *,
+  xmlChar *
+);
+
+double
+compiled_non_smoker_rate_function( Libnucnet__Reaction *, double, void * );
+
+void
+free_non_smoker_rate_kernel( void * );
+
+void
+register_non_smoker_rate_kernel( Libnucnet__Reac * );
+
+NonSmokerRateKernel *
+get_non_smoker_rate_kernel_for_zone( nnt::Zone& );
+
+void
+update_non_smoker_rate_kernel_data( nnt::Zone& );
+
+} // namespace user
+
+#endif // NON_SMOKER_RATE_KERNEL_H
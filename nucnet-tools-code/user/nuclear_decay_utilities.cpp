@@ -60,7 +60,7 @@ get_decay_matrices(
     );
 
   p_net_view =
-    Libnucnet__NetView__new(
+    nnt::new_net_view(
       p_net,
       "",
       s_reac_xpath
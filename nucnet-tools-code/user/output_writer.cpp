@@ -0,0 +1,398 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for writers that append zones to an output file as a
+//!        calculation runs.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/foreach.hpp>
+
+#include "user/output_writer.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// add_property_to_output_node().
+//##############################################################################
+
+/**
+ * \brief Add a zone property to the xml node of a zone.  The optional
+ *        properties node is created with the first property.
+ * \param p_nodes The zone node and the optional properties node.
+ */
+
+void
+add_property_to_output_node(
+  const char * s_name,
+  const char * s_tag1,
+  const char * s_tag2,
+  const char * s_value,
+  xmlNodePtr * p_nodes
+)
+{
+
+  if( !p_nodes[1] )
+    p_nodes[1] =
+      xmlNewChild(
+        p_nodes[0], NULL, (const xmlChar *) OPTIONAL_PROPERTIES, NULL
+      );
+
+  xmlNodePtr p_node =
+    xmlNewChild(
+      p_nodes[1], NULL, (const xmlChar *) PROPERTY, (const xmlChar *) s_value
+    );
+
+  xmlNewProp(
+    p_node, (const xmlChar *) PROPERTY_NAME, (const xmlChar *) s_name
+  );
+
+  if( s_tag1 )
+    xmlNewProp(
+      p_node, (const xmlChar *) PROPERTY_TAG1, (const xmlChar *) s_tag1
+    );
+
+  if( s_tag2 )
+    xmlNewProp(
+      p_node, (const xmlChar *) PROPERTY_TAG2, (const xmlChar *) s_tag2
+    );
+
+}
+
+//##############################################################################
+// XmlOutputWriter::XmlOutputWriter().
+//##############################################################################
+
+/**
+ * \brief Create an xml output file and write the network to it.
+ * \param s_file The output file.
+ * \param p_net The network.
+ * \param s_format The format for the mass fractions.
+ */
+
+XmlOutputWriter::XmlOutputWriter(
+  const char * s_file,
+  Libnucnet__Net * p_net,
+  const char * s_format
+) : sFile( s_file ), sMassFractionFormat( s_format )
+{
+
+  pFile = fopen( s_file, "wb" );
+
+  if( !pFile )
+  {
+    std::cerr << "Couldn't open file " << sFile << "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  pDoc = xmlNewDoc( (const xmlChar *) "1.0" );
+
+  fprintf(
+    pFile,
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<%s>\n",
+    LIBNUCNET_INPUT
+  );
+
+  xmlDocPtr p_net_doc = Libnucnet__Net__makeXmlDocument( p_net );
+
+  writeNode( p_net_doc, xmlDocGetRootElement( p_net_doc ), 1 );
+
+  xmlFreeDoc( p_net_doc );
+
+  fprintf( pFile, "  <%s>\n", ZONE_DATA );
+
+  iTrailer = ftell( pFile );
+
+  writeTrailer();
+
+}
+
+//##############################################################################
+// XmlOutputWriter::~XmlOutputWriter().
+//##############################################################################
+
+XmlOutputWriter::~XmlOutputWriter()
+{
+
+  finalize();
+
+}
+
+//##############################################################################
+// XmlOutputWriter::writeNode().
+//##############################################################################
+
+/**
+ * \brief Write an xml node at the current position in the file.
+ * \param p_doc The document of the node.
+ * \param p_node The node.
+ * \param i_level The indentation level.
+ */
+
+void
+XmlOutputWriter::writeNode( xmlDocPtr p_doc, xmlNodePtr p_node, int i_level )
+{
+
+  xmlBufferPtr p_buffer = xmlBufferCreate();
+
+  if( !p_buffer || xmlNodeDump( p_buffer, p_doc, p_node, i_level, 1 ) < 0 )
+  {
+    std::cerr << "Couldn't write xml node to " << sFile << "." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  for( int i = 0; i < i_level; i++ ) fputs( "  ", pFile );
+
+  fwrite(
+    xmlBufferContent( p_buffer ), 1, xmlBufferLength( p_buffer ), pFile
+  );
+
+  fputc( '\n', pFile );
+
+  xmlBufferFree( p_buffer );
+
+}
+
+//##############################################################################
+// XmlOutputWriter::writeTrailer().
+//##############################################################################
+
+/**
+ * \brief Write the closing tags at the current position and flush the file.
+ *        The next step overwrites the closing tags.
+ */
+
+void
+XmlOutputWriter::writeTrailer()
+{
+
+  fprintf( pFile, "  </%s>\n</%s>\n", ZONE_DATA, LIBNUCNET_INPUT );
+
+  if( ferror( pFile ) || fflush( pFile ) != 0 )
+  {
+    std::cerr << "Couldn't write to " << sFile << "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+}
+
+//##############################################################################
+// XmlOutputWriter::writeZone().
+//##############################################################################
+
+/**
+ * \brief Write a zone at the current position in the file.
+ * \param zone The zone.
+ */
+
+void
+XmlOutputWriter::writeZone( nnt::Zone& zone )
+{
+
+  const char * v_labels[3] = { LABEL_1, LABEL_2, LABEL_3 };
+  char s_buffer[64];
+
+  Libnucnet__Zone * p_zone = zone.getNucnetZone();
+
+  xmlNodePtr p_nodes[2];
+
+  p_nodes[0] = xmlNewDocNode( pDoc, NULL, (const xmlChar *) ZONE, NULL );
+  p_nodes[1] = NULL;
+
+  for( int i = 0; i < 3; i++ )
+  {
+    const char * s_label = Libnucnet__Zone__getLabel( p_zone, i + 1 );
+    if( strcmp( s_label, ZERO ) )
+      xmlNewProp(
+        p_nodes[0], (const xmlChar *) v_labels[i], (const xmlChar *) s_label
+      );
+  }
+
+  Libnucnet__Zone__iterateOptionalProperties(
+    p_zone,
+    NULL,
+    NULL,
+    NULL,
+    (Libnucnet__Zone__optional_property_iterate_function)
+      add_property_to_output_node,
+    p_nodes
+  );
+
+  xmlNodePtr p_mass_fractions =
+    xmlNewChild( p_nodes[0], NULL, (const xmlChar *) MASS_FRACTIONS, NULL );
+
+  nnt::species_list_t species_list =
+    nnt::make_species_list(
+      Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) )
+    );
+
+  BOOST_FOREACH( nnt::Species species, species_list )
+  {
+
+    Libnucnet__Species * p_species = species.getNucnetSpecies();
+
+    double d_x =
+      Libnucnet__Zone__getSpeciesAbundance( p_zone, p_species ) *
+      Libnucnet__Species__getA( p_species );
+
+    if( WnMatrix__value_is_zero( d_x ) ) continue;
+
+    xmlNodePtr p_nuclide =
+      xmlNewChild( p_mass_fractions, NULL, (const xmlChar *) NUCLIDE, NULL );
+
+    xmlNewProp(
+      p_nuclide,
+      (const xmlChar *) SPECIES_NAME,
+      (const xmlChar *) Libnucnet__Species__getName( p_species )
+    );
+
+    snprintf(
+      s_buffer, sizeof( s_buffer ), "%u", Libnucnet__Species__getZ( p_species )
+    );
+    xmlNewChild(
+      p_nuclide, NULL, (const xmlChar *) ATOMIC_NUMBER,
+      (const xmlChar *) s_buffer
+    );
+
+    snprintf(
+      s_buffer, sizeof( s_buffer ), "%u", Libnucnet__Species__getA( p_species )
+    );
+    xmlNewChild(
+      p_nuclide, NULL, (const xmlChar *) MASS_NUMBER,
+      (const xmlChar *) s_buffer
+    );
+
+    snprintf( s_buffer, sizeof( s_buffer ), sMassFractionFormat.c_str(), d_x );
+    xmlNewChild(
+      p_nuclide, NULL, (const xmlChar *) MASS_FRACTION,
+      (const xmlChar *) s_buffer
+    );
+
+  }
+
+  writeNode( pDoc, p_nodes[0], 2 );
+
+  xmlFreeNode( p_nodes[0] );
+
+}
+
+//##############################################################################
+// XmlOutputWriter::seekTrailer().
+//##############################################################################
+
+/**
+ * \brief Move to the closing tags so that they are overwritten.
+ */
+
+void
+XmlOutputWriter::seekTrailer()
+{
+
+  if( !pFile )
+  {
+    std::cerr << "Output file " << sFile << " was finalized." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  fseek( pFile, iTrailer, SEEK_SET );
+
+}
+
+//##############################################################################
+// XmlOutputWriter::appendZone().
+//##############################################################################
+
+/**
+ * \brief Append a zone as a step and flush the file.
+ * \param zone The zone.
+ */
+
+void
+XmlOutputWriter::appendZone( nnt::Zone& zone )
+{
+
+  seekTrailer();
+
+  writeZone( zone );
+
+  iTrailer = ftell( pFile );
+
+  writeTrailer();
+
+}
+
+//##############################################################################
+// XmlOutputWriter::appendZones().
+//##############################################################################
+
+/**
+ * \brief Append the zones of a step and flush the file.
+ * \param p_nucnet The Libnucnet structure containing the zones.
+ */
+
+void
+XmlOutputWriter::appendZones( Libnucnet * p_nucnet )
+{
+
+  seekTrailer();
+
+  nnt::zone_list_t zone_list = nnt::make_zone_list( p_nucnet );
+
+  BOOST_FOREACH( nnt::Zone& zone, zone_list )
+  {
+    writeZone( zone );
+  }
+
+  iTrailer = ftell( pFile );
+
+  writeTrailer();
+
+}
+
+//##############################################################################
+// XmlOutputWriter::finalize().
+//##############################################################################
+
+/**
+ * \brief Close the output file.  The file is already complete, so this only
+ *        releases it; it is called by the destructor if not called before.
+ */
+
+void
+XmlOutputWriter::finalize()
+{
+
+  if( !pFile ) return;
+
+  if( fclose( pFile ) != 0 )
+  {
+    std::cerr << "Couldn't close file " << sFile << "!" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  pFile = NULL;
+
+  xmlFreeDoc( pDoc );
+
+  pDoc = NULL;
+
+}
+
+} // namespace user
@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for writers that append zones to an output file as
+//!        a calculation runs.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include <libxml/tree.h>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define S_OUTPUT_MASS_FRACTION_FORMAT  "%.15e"
+
+namespace user
+{
+
+//##############################################################################
+// Base class for output writers.
+//##############################################################################
+
+/**
+ * \brief A writer that appends the zones of each output step to a file.
+ *        Each step is flushed when it is appended, so the file holds all
+ *        the steps written so far if the calculation stops early.
+ */
+
+class OutputWriter : private boost::noncopyable
+{
+
+  public:
+    virtual ~OutputWriter() {}
+    virtual void appendZones( Libnucnet * ) = 0;
+    virtual void finalize() = 0;
+
+};
+
+//##############################################################################
+// Class for xml output.
+//##############################################################################
+
+/**
+ * \brief An output writer for libnucnet xml.  The network is written when
+ *        the writer is created; each zone is then appended before the
+ *        closing tags, which are rewritten after it.  The file is thus a
+ *        complete libnucnet input document after every step, with the same
+ *        layout as one written by Libnucnet__writeToXmlFile(), and the
+ *        cost of a step does not depend on the number of earlier steps.
+ */
+
+class XmlOutputWriter : public OutputWriter
+{
+
+  public:
+    XmlOutputWriter(
+      const char *,
+      Libnucnet__Net *,
+      const char * = S_OUTPUT_MASS_FRACTION_FORMAT
+    );
+    ~XmlOutputWriter();
+    void appendZone( nnt::Zone& );
+    void appendZones( Libnucnet * );
+    void finalize();
+
+  private:
+    std::string sFile;
+    std::string sMassFractionFormat;
+    FILE * pFile;
+    xmlDocPtr pDoc;
+    long iTrailer;
+    void writeNode( xmlDocPtr, xmlNodePtr, int );
+    void seekTrailer();
+    void writeTrailer();
+    void writeZone( nnt::Zone& );
+
+};
+
+} // namespace user
+
+#endif // OUTPUT_WRITER_H
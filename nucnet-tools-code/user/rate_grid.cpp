@@ -0,0 +1,803 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the log10(t9) rate grid.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/format.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "user/rate_grid.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define D_RATE_GRID_REVERSE_CUTOFF  -300.
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// Global rate grids.  The grids are owned by the zones that use them, so a
+// grid is freed with the last zone that holds it.
+//##############################################################################
+
+boost::unordered_map<Libnucnet__Net *, boost::weak_ptr<RateGrid> > rate_grids;
+
+//##############################################################################
+// is_density_independent_rate_function().
+//##############################################################################
+
+/**
+ * \brief Check whether a rate function depends only on t9.
+ * \param s_key The key of the rate function.
+ * \return True for the single rate, rate table, and non-smoker fit
+ *         functions, false otherwise.  The cached rate-table and compiled
+ *         non-smoker functions registered by register_rate_functions()
+ *         replace the Libnucnet functions under the same keys and need no
+ *         zone data, so they are tabulated as well.
+ */
+
+bool
+is_density_independent_rate_function( const std::string& s_key )
+{
+
+  return
+    s_key == SINGLE_RATE_STRING ||
+    s_key == RATE_TABLE_STRING ||
+    s_key == NON_SMOKER_STRING;
+
+}
+
+//##############################################################################
+// compute_reverse_exponent().
+//##############################################################################
+
+double
+compute_reverse_exponent(
+  Libnucnet__Nuc * p_nuc,
+  const std::vector<Libnucnet__Species *>& v_reactants,
+  const std::vector<Libnucnet__Species *>& v_products,
+  double d_t9
+)
+{
+
+  double d_exp = 0.;
+
+  BOOST_FOREACH( Libnucnet__Species * p_species, v_reactants )
+  {
+    d_exp +=
+      Libnucnet__Nuc__computeSpeciesNseFactor( p_nuc, p_species, d_t9, 1. );
+  }
+
+  BOOST_FOREACH( Libnucnet__Species * p_species, v_products )
+  {
+    d_exp -=
+      Libnucnet__Nuc__computeSpeciesNseFactor( p_nuc, p_species, d_t9, 1. );
+  }
+
+  return d_exp;
+
+}
+
+//##############################################################################
+// compute_rate_grid_error().
+//##############################################################################
+
+double
+compute_rate_grid_error( double d_interpolated, double d_direct )
+{
+
+  if( d_direct == 0. ) return d_interpolated == 0. ? 0. : 1.;
+
+  return fabs( d_interpolated / d_direct - 1. );
+
+}
+
+//##############################################################################
+// RateGrid::RateGrid().
+//##############################################################################
+
+/**
+ * \brief Tabulate and validate the rates of the reactions in a network.
+ * \param p_net A pointer to the base network.  The rate functions are
+ *              called without zone data.
+ * \param d_t9_min The smallest t9 of the grid.
+ * \param d_t9_max The largest t9 of the grid.
+ * \param i_points_per_decade The number of grid points per decade in t9.
+ * \param d_tolerance The largest relative error allowed for a tabulated
+ *                    reaction.
+ */
+
+RateGrid::RateGrid(
+  Libnucnet__Net * p_net,
+  double d_t9_min,
+  double d_t9_max,
+  size_t i_points_per_decade,
+  double d_tolerance
+) :
+  pNet( p_net ),
+  iNetReactions(
+    Libnucnet__Reac__getNumberOfReactions( Libnucnet__Net__getReac( p_net ) )
+  ),
+  dT9Min( d_t9_min ),
+  dT9Max( d_t9_max ),
+  dTolerance( d_tolerance ),
+  iPointsPerDecade( i_points_per_decade )
+{
+
+  Libnucnet__Nuc * p_nuc = Libnucnet__Net__getNuc( p_net );
+
+  if( d_t9_min <= 0. || d_t9_max <= d_t9_min || i_points_per_decade == 0 )
+  {
+    std::cerr << "Invalid rate grid." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  iReacUpdate = Libnucnet__Net__getReac( p_net )->iUpdate;
+  iNucUpdate = p_nuc->iUpdate;
+
+  //============================================================================
+  // Grid.
+  //============================================================================
+
+  dLog10T9Min = log10( d_t9_min );
+
+  iPoints =
+    (size_t)
+    ceil( ( log10( d_t9_max ) - dLog10T9Min ) * (double) i_points_per_decade )
+    + 1;
+
+  if( iPoints < 4 ) iPoints = 4;
+
+  dStep = ( log10( d_t9_max ) - dLog10T9Min ) / (double) ( iPoints - 1 );
+
+  std::vector<double> v_t9( iPoints ), v_t9_mid( iPoints - 1 );
+
+  for( size_t k = 0; k < iPoints; k++ )
+    v_t9[k] = pow( 10., dLog10T9Min + (double) k * dStep );
+
+  v_t9[0] = d_t9_min;
+  v_t9[iPoints - 1] = d_t9_max;
+
+  for( size_t k = 0; k < iPoints - 1; k++ )
+    v_t9_mid[k] = pow( 10., dLog10T9Min + ( (double) k + 0.5 ) * dStep );
+
+  //============================================================================
+  // Tabulate candidate reactions.  The values are stored by reaction here
+  // and transposed to grid point order at the end.
+  //============================================================================
+
+  std::vector<double> v_forward, v_ratio;
+  std::vector<double> v_g_forward( iPoints ), v_g_ratio( iPoints );
+  size_t i_k;
+  double w[4];
+
+  nnt::reaction_list_t reaction_list =
+    nnt::make_reaction_list( Libnucnet__Net__getReac( p_net ) );
+
+  BOOST_FOREACH( nnt::Reaction reaction, reaction_list )
+  {
+
+    Libnucnet__Reaction * p_reaction = reaction.getNucnetReaction();
+
+    std::string s_key = Libnucnet__Reaction__getRateFunctionKey( p_reaction );
+
+    if( !is_density_independent_rate_function( s_key ) ) continue;
+
+    void * p_data = NULL;
+
+    std::vector<Libnucnet__Species *> v_reactants, v_products;
+
+    BOOST_FOREACH(
+      nnt::ReactionElement reactant,
+      nnt::make_reaction_nuclide_reactant_list( p_reaction )
+    )
+    {
+      v_reactants.push_back(
+        Libnucnet__Nuc__getSpeciesByName(
+          p_nuc,
+          Libnucnet__Reaction__Element__getName(
+            reactant.getNucnetReactionElement()
+          )
+        )
+      );
+    }
+
+    BOOST_FOREACH(
+      nnt::ReactionElement product,
+      nnt::make_reaction_nuclide_product_list( p_reaction )
+    )
+    {
+      v_products.push_back(
+        Libnucnet__Nuc__getSpeciesByName(
+          p_nuc,
+          Libnucnet__Reaction__Element__getName(
+            product.getNucnetReactionElement()
+          )
+        )
+      );
+    }
+
+    bool b_ratio =
+      !Libnucnet__Reaction__isWeak( p_reaction ) &&
+      v_reactants.size() +
+        (size_t) xmlListSize( p_reaction->pOtherReactantList ) != 1;
+
+    double d_log_duplicate_factor =
+      log(
+        Libnucnet__Reaction__getDuplicateProductFactor( p_reaction ) /
+        Libnucnet__Reaction__getDuplicateReactantFactor( p_reaction )
+      );
+
+    ValidationEntry entry;
+    entry.sReaction = Libnucnet__Reaction__getString( p_reaction );
+    entry.dForwardError = 0.;
+    entry.dReverseError = 0.;
+    entry.bTabulated = false;
+
+    //--------------------------------------------------------------------------
+    // Grid values.  A reaction with a rate that is not positive at a grid
+    // point is not tabulated.
+    //--------------------------------------------------------------------------
+
+    bool b_valid = true;
+
+    for( size_t k = 0; k < iPoints; k++ )
+    {
+
+      double d_forward =
+        Libnucnet__Reaction__computeRate( p_reaction, v_t9[k], p_data );
+
+      if( !( d_forward > 0. ) )
+      {
+        b_valid = false;
+        break;
+      }
+
+      v_g_forward[k] = v_t9[k] * log( d_forward );
+
+      v_g_ratio[k] =
+        b_ratio ?
+          v_t9[k] *
+          (
+            compute_reverse_exponent( p_nuc, v_reactants, v_products, v_t9[k] )
+            + d_log_duplicate_factor
+          ) :
+          0.;
+
+    }
+
+    if( !b_valid )
+    {
+      entry.dForwardError = 1.;
+      vReport.push_back( entry );
+      continue;
+    }
+
+    //--------------------------------------------------------------------------
+    // Validate against direct evaluation at the interval midpoints.
+    //--------------------------------------------------------------------------
+
+    for( size_t k = 0; k < iPoints - 1; k++ )
+    {
+
+      double d_t9 = v_t9_mid[k], d_forward, d_reverse;
+
+      Libnucnet__Net__computeRatesForReaction(
+        p_net,
+        p_reaction,
+        d_t9,
+        1.,
+        p_data,
+        &d_forward,
+        &d_reverse
+      );
+
+      getWeights( d_t9, &i_k, w );
+
+      double d_f =
+        exp(
+          (
+            w[0] * v_g_forward[i_k] + w[1] * v_g_forward[i_k + 1] +
+            w[2] * v_g_forward[i_k + 2] + w[3] * v_g_forward[i_k + 3]
+          ) / d_t9
+        );
+
+      double d_r = 0.;
+
+      if( b_ratio )
+      {
+
+        double d_x =
+          (
+            w[0] * v_g_ratio[i_k] + w[1] * v_g_ratio[i_k + 1] +
+            w[2] * v_g_ratio[i_k + 2] + w[3] * v_g_ratio[i_k + 3]
+          ) / d_t9;
+
+        double d_exp = d_x - d_log_duplicate_factor;
+
+        if( d_exp > D_LARGE )
+          d_f = 0.;
+        else if( d_exp >= D_RATE_GRID_REVERSE_CUTOFF )
+          d_r = d_f * exp( d_x );
+
+      }
+
+      entry.dForwardError =
+        GSL_MAX(
+          entry.dForwardError,
+          compute_rate_grid_error( d_f, d_forward )
+        );
+
+      if( d_reverse > 0. || d_r == 0. )
+        entry.dReverseError =
+          GSL_MAX(
+            entry.dReverseError,
+            compute_rate_grid_error( d_r, d_reverse )
+          );
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Keep the reaction if it is within tolerance.
+    //--------------------------------------------------------------------------
+
+    if(
+      entry.dForwardError <= dTolerance &&
+      entry.dReverseError <= dTolerance
+    )
+    {
+
+      entry.bTabulated = true;
+
+      column_map[p_reaction] = vHasRatio.size();
+      vHasRatio.push_back( b_ratio ? 1 : 0 );
+      vLogDuplicateFactor.push_back( d_log_duplicate_factor );
+
+      v_forward.insert(
+        v_forward.end(), v_g_forward.begin(), v_g_forward.end()
+      );
+      v_ratio.insert( v_ratio.end(), v_g_ratio.begin(), v_g_ratio.end() );
+
+    }
+
+    vReport.push_back( entry );
+
+  }
+
+  //============================================================================
+  // Store by grid point so that all reactions are interpolated in one sweep.
+  //============================================================================
+
+  size_t i_tab = vHasRatio.size();
+
+  vForwardGrid.resize( iPoints * i_tab );
+  vRatioGrid.resize( iPoints * i_tab );
+
+  for( size_t i = 0; i < i_tab; i++ )
+  {
+    for( size_t k = 0; k < iPoints; k++ )
+    {
+      vForwardGrid[k * i_tab + i] = v_forward[i * iPoints + k];
+      vRatioGrid[k * i_tab + i] = v_ratio[i * iPoints + k];
+    }
+  }
+
+}
+
+//##############################################################################
+// RateGrid::isValidFor().
+//##############################################################################
+
+/**
+ * \brief Check whether the grid applies to a network and settings.
+ * \param p_net A pointer to the network.
+ * \param d_t9_min The smallest t9 of the grid.
+ * \param d_t9_max The largest t9 of the grid.
+ * \param i_points_per_decade The number of grid points per decade in t9.
+ * \param d_tolerance The tolerance.
+ * \return True if the grid was built for the network and settings and the
+ *         network's reactions and nuclei have not changed since, false if
+ *         not.  Views of the network do not affect the grid.
+ */
+
+bool
+RateGrid::isValidFor(
+  Libnucnet__Net * p_net,
+  double d_t9_min,
+  double d_t9_max,
+  size_t i_points_per_decade,
+  double d_tolerance
+) const
+{
+
+  return
+    p_net == pNet &&
+    Libnucnet__Net__getReac( p_net )->iUpdate == iReacUpdate &&
+    Libnucnet__Net__getNuc( p_net )->iUpdate == iNucUpdate &&
+    Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac( p_net )
+    ) == iNetReactions &&
+    d_t9_min == dT9Min &&
+    d_t9_max == dT9Max &&
+    i_points_per_decade == iPointsPerDecade &&
+    d_tolerance == dTolerance;
+
+}
+
+//##############################################################################
+// RateGrid::isInRange().
+//##############################################################################
+
+/**
+ * \brief Check whether a t9 lies on the grid.
+ * \param d_t9 The t9.
+ * \return True if the t9 is within the grid limits, false if not.
+ */
+
+bool
+RateGrid::isInRange( double d_t9 ) const
+{
+
+  return d_t9 >= dT9Min && d_t9 <= dT9Max;
+
+}
+
+//##############################################################################
+// RateGrid::getColumn().
+//##############################################################################
+
+/**
+ * \brief Get the grid column of a reaction.
+ * \param p_reaction A pointer to the reaction.
+ * \return The column, or the number of tabulated reactions if the reaction
+ *         is not tabulated.
+ */
+
+size_t
+RateGrid::getColumn( const Libnucnet__Reaction * p_reaction ) const
+{
+
+  boost::unordered_map<const Libnucnet__Reaction *, size_t>::const_iterator
+    it = column_map.find( p_reaction );
+
+  if( it == column_map.end() ) return vHasRatio.size();
+
+  return it->second;
+
+}
+
+//##############################################################################
+// RateGrid::getWeights().
+//##############################################################################
+
+void
+RateGrid::getWeights( double d_t9, size_t * p_k, double * w ) const
+{
+
+  double d_x = ( log10( d_t9 ) - dLog10T9Min ) / dStep;
+
+  long i_k = (long) floor( d_x ) - 1;
+
+  if( i_k < 0 ) i_k = 0;
+  if( i_k > (long) iPoints - 4 ) i_k = (long) iPoints - 4;
+
+  double t = d_x - (double) i_k;
+
+  w[0] = -( t - 1. ) * ( t - 2. ) * ( t - 3. ) / 6.;
+  w[1] = t * ( t - 2. ) * ( t - 3. ) / 2.;
+  w[2] = -t * ( t - 1. ) * ( t - 3. ) / 2.;
+  w[3] = t * ( t - 1. ) * ( t - 2. ) / 6.;
+
+  *p_k = (size_t) i_k;
+
+}
+
+//##############################################################################
+// RateGrid::interpolateRates().
+//##############################################################################
+
+/**
+ * \brief Interpolate the rates of tabulated reactions into rate arrays.
+ * \param d_t9 The t9, which must be in range.
+ * \param b_detailed_balance Whether to compute the reverse rates.
+ * \param v_columns The grid columns of the reactions to interpolate.
+ * \param v_indices The indices of the same reactions in the rate arrays.
+ * \param v_forward The forward rate array.  Only the elements given by
+ *                  v_indices are set.
+ * \param v_reverse The reverse rate array.  Only the elements given by
+ *                  v_indices are set.
+ *
+ * The rates do not include the density factors or screening.
+ */
+
+void
+RateGrid::interpolateRates(
+  double d_t9,
+  bool b_detailed_balance,
+  const std::vector<size_t>& v_columns,
+  const std::vector<size_t>& v_indices,
+  std::vector<double>& v_forward,
+  std::vector<double>& v_reverse
+) const
+{
+
+  size_t i_tab = vHasRatio.size(), i_k;
+  double w[4];
+
+  if( v_columns.empty() ) return;
+
+  getWeights( d_t9, &i_k, w );
+
+  double d_inv_t9 = 1. / d_t9;
+
+  const double * f0 = &vForwardGrid[i_k * i_tab];
+  const double * f1 = f0 + i_tab, * f2 = f1 + i_tab, * f3 = f2 + i_tab;
+  const double * r0 = &vRatioGrid[i_k * i_tab];
+  const double * r1 = r0 + i_tab, * r2 = r1 + i_tab, * r3 = r2 + i_tab;
+
+  for( size_t j = 0; j < v_columns.size(); j++ )
+  {
+
+    size_t i = v_columns[j];
+
+    double d_f =
+      exp(
+        ( w[0] * f0[i] + w[1] * f1[i] + w[2] * f2[i] + w[3] * f3[i] ) *
+        d_inv_t9
+      );
+
+    double d_r = 0.;
+
+    if( b_detailed_balance && vHasRatio[i] )
+    {
+
+      double d_x =
+        ( w[0] * r0[i] + w[1] * r1[i] + w[2] * r2[i] + w[3] * r3[i] ) *
+        d_inv_t9;
+
+      double d_exp = d_x - vLogDuplicateFactor[i];
+
+      if( d_exp > D_LARGE )
+        d_f = 0.;
+      else if( d_exp >= D_RATE_GRID_REVERSE_CUTOFF )
+        d_r = d_f * exp( d_x );
+
+    }
+
+    v_forward[v_indices[j]] = d_f;
+    v_reverse[v_indices[j]] = d_r;
+
+  }
+
+}
+
+//##############################################################################
+// RateGrid::printValidationReport().
+//##############################################################################
+
+/**
+ * \brief Print the comparison of the grid with direct evaluation.
+ * \param os The output stream.
+ *
+ * The report gives, for each candidate reaction, the largest relative
+ * errors of the interpolated forward and reverse rates at the interval
+ * midpoints and whether the reaction is tabulated.
+ */
+
+void
+RateGrid::printValidationReport( std::ostream& os ) const
+{
+
+  size_t i_max = vReport.size();
+  double d_max = -1.;
+
+  os <<
+    boost::format(
+      "\nRate grid: t9 from %e to %e, %lu points, tolerance %e\n"
+    ) % dT9Min % dT9Max % (unsigned long) iPoints % dTolerance;
+
+  os <<
+    boost::format(
+      "Candidate reactions: %lu  Tabulated: %lu  Evaluated directly: %lu\n\n"
+    ) %
+    (unsigned long) vReport.size() %
+    (unsigned long) vHasRatio.size() %
+    (unsigned long) ( vReport.size() - vHasRatio.size() );
+
+  os <<
+    boost::format( "%14s %14s %10s  %s\n" ) %
+    "forward error" % "reverse error" % "status" % "reaction";
+
+  for( size_t i = 0; i < vReport.size(); i++ )
+  {
+
+    os <<
+      boost::format( "%14.4e %14.4e %10s  %s\n" ) %
+      vReport[i].dForwardError %
+      vReport[i].dReverseError %
+      ( vReport[i].bTabulated ? "tabulated" : "direct" ) %
+      vReport[i].sReaction;
+
+    double d_error =
+      GSL_MAX( vReport[i].dForwardError, vReport[i].dReverseError );
+
+    if( vReport[i].bTabulated && d_error > d_max )
+    {
+      d_max = d_error;
+      i_max = i;
+    }
+
+  }
+
+  if( i_max < vReport.size() )
+    os <<
+      boost::format( "\nLargest error of a tabulated reaction: %e (%s)\n" ) %
+      d_max % vReport[i_max].sReaction;
+
+}
+
+//##############################################################################
+// is_using_rate_grid().
+//##############################################################################
+
+/**
+ * \brief Check whether a zone interpolates rates from a rate grid.
+ * \param zone The zone.
+ * \return True if the zone's use rate grid property is "yes", false if not.
+ */
+
+bool
+is_using_rate_grid( nnt::Zone& zone )
+{
+
+  return
+    zone.hasProperty( nnt::s_USE_RATE_GRID ) &&
+    zone.getProperty<std::string>( nnt::s_USE_RATE_GRID ) == "yes";
+
+}
+
+//##############################################################################
+// get_rate_grid_for_net().
+//##############################################################################
+
+/**
+ * \brief Retrieve the rate grid for a network.
+ * \param p_net A pointer to the base network.
+ * \param d_t9_min The smallest t9 of the grid.
+ * \param d_t9_max The largest t9 of the grid.
+ * \param i_points_per_decade The number of grid points per decade in t9.
+ * \param d_tolerance The largest relative error allowed for a tabulated
+ *                    reaction.
+ * \return A shared pointer to the grid.  The grid is built once for the
+ *         network and shared by all callers while any of them holds it.  It
+ *         is only built anew when the network's reactions or nuclei or the
+ *         grid settings change.
+ */
+
+boost::shared_ptr<RateGrid>
+get_rate_grid_for_net(
+  Libnucnet__Net * p_net,
+  double d_t9_min,
+  double d_t9_max,
+  size_t i_points_per_decade,
+  double d_tolerance
+)
+{
+
+  boost::shared_ptr<RateGrid> p_grid;
+
+#ifndef NO_OPENMP
+  #pragma omp critical( rate_grids )
+#endif
+  {
+
+    p_grid = rate_grids[p_net].lock();
+
+    if(
+      !p_grid ||
+      !p_grid->isValidFor(
+        p_net, d_t9_min, d_t9_max, i_points_per_decade, d_tolerance
+      )
+    )
+    {
+      p_grid.reset(
+        new RateGrid(
+          p_net, d_t9_min, d_t9_max, i_points_per_decade, d_tolerance
+        )
+      );
+      rate_grids[p_net] = p_grid;
+    }
+
+  }
+
+  return p_grid;
+
+}
+
+//##############################################################################
+// get_rate_grid_for_zone().
+//##############################################################################
+
+/**
+ * \brief Retrieve the rate grid for the zone's network.
+ * \param zone The zone.
+ * \return A shared pointer to the grid.  The grid is stored with the zone,
+ *         which checks it without locking.  A grid that no longer applies
+ *         is replaced by the network's grid from get_rate_grid_for_net(), so
+ *         the zones of a network share one grid.  The grid limits, points
+ *         per decade, and tolerance are taken from the zone's properties if
+ *         present.
+ */
+
+boost::shared_ptr<RateGrid>
+get_rate_grid_for_zone( nnt::Zone& zone )
+{
+
+  double d_t9_min = D_RATE_GRID_T9_MIN, d_t9_max = D_RATE_GRID_T9_MAX;
+  double d_tolerance = D_RATE_GRID_TOLERANCE;
+  size_t i_points_per_decade = I_RATE_GRID_POINTS_PER_DECADE;
+
+  if( zone.hasProperty( nnt::s_RATE_GRID_T9_MIN ) )
+    d_t9_min = zone.getProperty<double>( nnt::s_RATE_GRID_T9_MIN );
+
+  if( zone.hasProperty( nnt::s_RATE_GRID_T9_MAX ) )
+    d_t9_max = zone.getProperty<double>( nnt::s_RATE_GRID_T9_MAX );
+
+  if( zone.hasProperty( nnt::s_RATE_GRID_POINTS_PER_DECADE ) )
+    i_points_per_decade =
+      zone.getProperty<size_t>( nnt::s_RATE_GRID_POINTS_PER_DECADE );
+
+  if( zone.hasProperty( nnt::s_RATE_GRID_TOLERANCE ) )
+    d_tolerance = zone.getProperty<double>( nnt::s_RATE_GRID_TOLERANCE );
+
+  Libnucnet__Net * p_net = Libnucnet__Zone__getNet( zone.getNucnetZone() );
+
+  if( zone.hasData( nnt::s_RATE_GRID ) )
+  {
+
+    boost::shared_ptr<RateGrid> p_grid =
+      boost::any_cast<boost::shared_ptr<RateGrid> >(
+        zone.getData( nnt::s_RATE_GRID )
+      );
+
+    if(
+      p_grid->isValidFor(
+        p_net, d_t9_min, d_t9_max, i_points_per_decade, d_tolerance
+      )
+    )
+      return p_grid;
+
+  }
+
+  boost::shared_ptr<RateGrid> p_grid =
+    get_rate_grid_for_net(
+      p_net, d_t9_min, d_t9_max, i_points_per_decade, d_tolerance
+    );
+
+  zone.updateData( nnt::s_RATE_GRID, p_grid );
+
+  return p_grid;
+
+}
+
+} // namespace user
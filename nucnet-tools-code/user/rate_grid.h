@@ -0,0 +1,146 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the log10(t9) rate grid.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RATE_GRID_H
+#define RATE_GRID_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+#include "nnt/string_defs.h"
+
+#include "user/zone_rates.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define D_RATE_GRID_T9_MIN             1.e-2
+#define D_RATE_GRID_T9_MAX             1.e1
+#define I_RATE_GRID_POINTS_PER_DECADE  100
+#define D_RATE_GRID_TOLERANCE          1.e-4
+
+namespace user
+{
+
+//##############################################################################
+// Class for the rate grid.
+//##############################################################################
+
+/**
+ * \brief The forward rates and reverse ratios of the reactions in a network
+ *        tabulated on a uniform log10(t9) grid.
+ *
+ * The grid is built once for the base network, not for a view, and each
+ * ZoneRates maps the reactions of its view onto the grid's columns.  Only
+ * reactions whose rate function depends on t9 alone are tabulated: single
+ * rates, rate tables, and non-smoker fits.  The grid stores t9 times the
+ * natural logarithm of the forward rate and of the reverse ratio (the
+ * reverse rate divided by the forward rate), so the 1/t9 terms of the fits
+ * and the Q-value term of the ratio are interpolated exactly.  Values are
+ * interpolated with four-point Lagrange polynomials.
+ *
+ * At construction, each candidate reaction is checked against direct
+ * evaluation at the midpoints of the grid intervals.  A reaction whose
+ * largest relative error exceeds the tolerance is not tabulated and is
+ * evaluated directly.
+ */
+
+class RateGrid : private boost::noncopyable
+{
+
+  public:
+    RateGrid( Libnucnet__Net *, double, double, size_t, double );
+    bool isValidFor(
+      Libnucnet__Net *, double, double, size_t, double
+    ) const;
+    bool isInRange( double ) const;
+    size_t getColumn( const Libnucnet__Reaction * ) const;
+    size_t getNumberOfPoints() const { return iPoints; }
+    size_t getNumberOfTabulatedReactions() const
+      { return vHasRatio.size(); }
+    size_t getNumberOfCandidateReactions() const { return vReport.size(); }
+    double getTolerance() const { return dTolerance; }
+    void interpolateRates(
+      double,
+      bool,
+      const std::vector<size_t>&,
+      const std::vector<size_t>&,
+      std::vector<double>&,
+      std::vector<double>&
+    ) const;
+    void printValidationReport( std::ostream& ) const;
+
+  private:
+    struct ValidationEntry
+    {
+      std::string sReaction;
+      double dForwardError;
+      double dReverseError;
+      bool bTabulated;
+    };
+    Libnucnet__Net * pNet;
+    size_t iNetReactions;
+    size_t iReacUpdate;
+    size_t iNucUpdate;
+    double dT9Min, dT9Max, dLog10T9Min, dStep, dTolerance;
+    size_t iPointsPerDecade, iPoints;
+    boost::unordered_map<const Libnucnet__Reaction *, size_t> column_map;
+    std::vector<char> vHasRatio;
+    std::vector<double> vLogDuplicateFactor;
+    std::vector<double> vForwardGrid;
+    std::vector<double> vRatioGrid;
+    std::vector<ValidationEntry> vReport;
+    void getWeights( double, size_t *, double * ) const;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+bool
+is_density_independent_rate_function( const std::string& );
+
+boost::shared_ptr<RateGrid>
+get_rate_grid_for_net( Libnucnet__Net *, double, double, size_t, double );
+
+boost::shared_ptr<RateGrid>
+get_rate_grid_for_zone( nnt::Zone& );
+
+bool
+is_using_rate_grid( nnt::Zone& );
+
+} // namespace user
+
+#endif // RATE_GRID_H
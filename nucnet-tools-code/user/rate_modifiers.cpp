@@ -76,15 +76,15 @@ modify_rates_in_view(
     if( p_reaction )
     {
 
-      Libnucnet__Zone__getRatesForReaction(
-        zone.getNucnetZone(),
+      get_rates_for_reaction(
+        zone,
         reaction.getNucnetReaction(),
         &d_forward,
         &d_reverse
       );
 
-      Libnucnet__Zone__updateRatesForReaction(
-        zone.getNucnetZone(),
+      update_rates_for_reaction(
+        zone,
         reaction.getNucnetReaction(),
         d_forward * d_factor,
         d_reverse * d_factor
@@ -36,6 +36,8 @@
 #include "nnt/iter.h"
 #include "nnt/string_defs.h"
 
+#include "user/zone_rates.h"
+
 namespace user
 {
 
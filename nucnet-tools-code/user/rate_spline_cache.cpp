@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for cached rate-table and partition-function splines.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/rate_spline_cache.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// T9Table::T9Table().
+//##############################################################################
+
+/**
+ * \brief Build the interpolant for a table.
+ * \param p_t9 The table t9 values.
+ * \param v_log10 The log10 values to interpolate.
+ * \param d_low The value to return at or below the first t9.
+ * \param d_high The value to return at or above the last t9.
+ * \param d_factor The factor multiplying the interpolated value.
+ */
+
+T9Table::T9Table(
+  const gsl_vector * p_t9,
+  const std::vector<double>& v_log10,
+  double d_low,
+  double d_high,
+  double d_factor
+) : vLog10( v_log10 ), dLow( d_low ), dHigh( d_high ), dFactor( d_factor )
+{
+
+  pSpline = NULL;
+  pAcc = NULL;
+
+  for( size_t i = 0; i < p_t9->size; i++ )
+    vT9.push_back( gsl_vector_get( p_t9, i ) );
+
+  if( vT9.size() > 2 )
+  {
+    pSpline = gsl_spline_alloc( gsl_interp_cspline, vT9.size() );
+    gsl_spline_init( pSpline, &vT9[0], &vLog10[0], vT9.size() );
+    pAcc = gsl_interp_accel_alloc();
+  }
+
+}
+
+//##############################################################################
+// T9Table::~T9Table().
+//##############################################################################
+
+T9Table::~T9Table()
+{
+
+  if( pSpline ) gsl_spline_free( pSpline );
+  if( pAcc ) gsl_interp_accel_free( pAcc );
+
+}
+
+//##############################################################################
+// T9Table::computeValue().
+//##############################################################################
+
+/**
+ * \brief Compute the table value at a t9.
+ * \param d_t9 The t9 at which to compute the value.
+ * \return The value.
+ */
+
+double
+T9Table::computeValue( double d_t9 )
+{
+
+  if( d_t9 <= vT9.front() ) return dLow;
+
+  if( d_t9 >= vT9.back() ) return dHigh;
+
+  if( !pSpline )
+    return
+      dFactor *
+      pow(
+        10.,
+        vLog10[0] +
+        ( d_t9 - vT9[0] ) * ( vLog10[1] - vLog10[0] ) / ( vT9[1] - vT9[0] )
+      );
+
+  return dFactor * pow( 10., gsl_spline_eval( pSpline, d_t9, pAcc ) );
+
+}
+
+//##############################################################################
+// RateSplineCache::RateSplineCache().
+//##############################################################################
+
+/**
+ * \brief Build the rate-table interpolants for a network.
+ * \param p_net A pointer to the Libnucnet__Net.
+ */
+
+RateSplineCache::RateSplineCache( Libnucnet__Net * p_net ) : pNet( p_net )
+{
+
+  iReacUpdate = Libnucnet__Net__getReac( p_net )->iUpdate;
+  iNucUpdate = Libnucnet__Net__getNuc( p_net )->iUpdate;
+
+  BOOST_FOREACH(
+    nnt::Reaction reaction,
+    nnt::make_reaction_list( Libnucnet__Net__getReac( p_net ) )
+  )
+  {
+
+    Libnucnet__Reaction * p_reaction = reaction.getNucnetReaction();
+
+    if(
+      !p_reaction->pRd ||
+      !p_reaction->pRd->pRt ||
+      std::string( Libnucnet__Reaction__getRateFunctionKey( p_reaction ) ) !=
+        RATE_TABLE_STRING
+    )
+      continue;
+
+    const Libnucnet__Reaction__RateTable * p_table = p_reaction->pRd->pRt;
+
+    std::vector<double> v_log10;
+
+    for( size_t i = 0; i < p_table->pT9->size; i++ )
+      v_log10.push_back(
+        log10( gsl_vector_get( p_table->pRate, i ) + TINY ) +
+        log10( gsl_vector_get( p_table->pSef, i ) + TINY )
+      );
+
+    rate_map[p_reaction] =
+      std::make_pair(
+        p_table,
+        boost::shared_ptr<T9Table>(
+          new T9Table(
+            p_table->pT9,
+            v_log10,
+            gsl_vector_get( p_table->pRate, 0 ),
+            gsl_vector_get( p_table->pRate, p_table->pRate->size - 1 ),
+            1.
+          )
+        )
+      );
+
+  }
+
+}
+
+//##############################################################################
+// RateSplineCache::isValidForNet().
+//##############################################################################
+
+/**
+ * \brief Check whether the cache is valid for a network.
+ * \param p_net A pointer to the Libnucnet__Net.
+ * \return True if the cache was built for the network and neither its
+ *         reactions nor its nuclei have been updated since, false if not.
+ */
+
+bool
+RateSplineCache::isValidForNet( Libnucnet__Net * p_net ) const
+{
+
+  return
+    p_net == pNet &&
+    Libnucnet__Net__getReac( p_net )->iUpdate == iReacUpdate &&
+    Libnucnet__Net__getNuc( p_net )->iUpdate == iNucUpdate;
+
+}
+
+//##############################################################################
+// RateSplineCache::computeRateFromTable().
+//##############################################################################
+
+/**
+ * \brief Compute a rate-table rate from the cached interpolant.
+ * \param p_reaction A pointer to the reaction.
+ * \param d_t9 The t9 at which to compute the rate.
+ * \return The rate.  If the reaction has no cached table, the rate is
+ *         computed by Libnucnet.
+ */
+
+double
+RateSplineCache::computeRateFromTable(
+  Libnucnet__Reaction * p_reaction,
+  double d_t9
+)
+{
+
+  boost::unordered_map<const Libnucnet__Reaction *, rate_entry_t>::iterator
+    it = rate_map.find( p_reaction );
+
+  if(
+    it == rate_map.end() ||
+    !p_reaction->pRd ||
+    it->second.first != p_reaction->pRd->pRt
+  )
+    return Libnucnet__Reaction__computeRateFromTable( p_reaction, d_t9, NULL );
+
+  return it->second.second->computeValue( d_t9 );
+
+}
+
+//##############################################################################
+// RateSplineCache::computePartitionFunction().
+//##############################################################################
+
+/**
+ * \brief Compute a species partition function from the cached interpolant.
+ * \param p_species A pointer to the species.
+ * \param d_t9 The t9 at which to compute the partition function.
+ * \return The partition function.  The interpolant is built on the first
+ *         call for the species.
+ */
+
+double
+RateSplineCache::computePartitionFunction(
+  Libnucnet__Species * p_species,
+  double d_t9
+)
+{
+
+  if( !p_species->pT9 || d_t9 < 0 )
+    return Libnucnet__Species__computePartitionFunction( p_species, d_t9 );
+
+  boost::unordered_map<const Libnucnet__Species *, partf_entry_t>::iterator
+    it = partf_map.find( p_species );
+
+  if( it == partf_map.end() || it->second.first != p_species->pT9 )
+  {
+
+    double d_g = 2. * p_species->dSpin + 1.;
+
+    std::vector<double> v_log10(
+      p_species->pLog10Partf->data,
+      p_species->pLog10Partf->data + p_species->pLog10Partf->size
+    );
+
+    partf_map[p_species] =
+      std::make_pair(
+        p_species->pT9,
+        boost::shared_ptr<T9Table>(
+          new T9Table(
+            p_species->pT9,
+            v_log10,
+            d_g * pow( 10., v_log10.front() ),
+            d_g * pow( 10., v_log10.back() ),
+            d_g
+          )
+        )
+      );
+
+    it = partf_map.find( p_species );
+
+  }
+
+  return it->second.second->computeValue( d_t9 );
+
+}
+
+//##############################################################################
+// cached_rate_table_function().
+//##############################################################################
+
+/**
+ * \brief The rate-table rate function.
+ *
+ * This function replaces the Libnucnet rate-table function.  The data are
+ * the zone's RateSplineCache.  If no cache has been set for the zone, the
+ * rate is computed by Libnucnet.
+ */
+
+double
+cached_rate_table_function(
+  Libnucnet__Reaction * p_reaction,
+  double d_t9,
+  void * p_data
+)
+{
+
+  if( !p_data )
+    return Libnucnet__Reaction__computeRateFromTable( p_reaction, d_t9, NULL );
+
+  return
+    static_cast<RateSplineCache *>( p_data )->computeRateFromTable(
+      p_reaction,
+      d_t9
+    );
+
+}
+
+//##############################################################################
+// free_rate_spline_cache().
+//##############################################################################
+
+void
+free_rate_spline_cache( void * p_data )
+{
+
+  delete static_cast<RateSplineCache *>( p_data );
+
+}
+
+//##############################################################################
+// register_rate_spline_cache().
+//##############################################################################
+
+/**
+ * \brief Register the cached rate-table function and its data deallocator.
+ * \param p_reac A pointer to the Libnucnet__Reac.
+ */
+
+void
+register_rate_spline_cache( Libnucnet__Reac * p_reac )
+{
+
+  Libnucnet__Reac__registerUserRateFunction(
+    p_reac,
+    RATE_TABLE_STRING,
+    (Libnucnet__Reaction__userRateFunction) cached_rate_table_function
+  );
+
+  Libnucnet__Reac__setUserRateFunctionDataDeallocator(
+    p_reac,
+    RATE_TABLE_STRING,
+    (Libnucnet__Reaction__user_rate_function_data_deallocator)
+      free_rate_spline_cache
+  );
+
+}
+
+//##############################################################################
+// get_rate_spline_cache_for_zone().
+//##############################################################################
+
+/**
+ * \brief Get the rate spline cache for a zone.
+ * \param zone The zone.
+ * \return A pointer to the cache, or NULL if the cached rate-table function
+ *         is not registered for the zone's network.  The cache is built if
+ *         it is not present or if the network has been updated.  The zone
+ *         owns the cache.
+ */
+
+RateSplineCache *
+get_rate_spline_cache_for_zone( nnt::Zone& zone )
+{
+
+  Libnucnet__Net * p_net = Libnucnet__Zone__getNet( zone.getNucnetZone() );
+
+  Libnucnet__Reac__FD * p_fd =
+    (Libnucnet__Reac__FD *)
+    xmlHashLookup(
+      Libnucnet__Net__getReac( p_net )->pFDHash,
+      (const xmlChar *) RATE_TABLE_STRING
+    );
+
+  if(
+    !p_fd ||
+    p_fd->pfFunc !=
+      (Libnucnet__Reaction__rateFunction) cached_rate_table_function
+  )
+    return NULL;
+
+  RateSplineCache * p_cache =
+    static_cast<RateSplineCache *>(
+      Libnucnet__Zone__getDataForUserRateFunction(
+        zone.getNucnetZone(),
+        RATE_TABLE_STRING
+      )
+    );
+
+  if( p_cache && p_cache->isValidForNet( p_net ) ) return p_cache;
+
+  p_cache = new RateSplineCache( p_net );
+
+  Libnucnet__Zone__updateDataForUserRateFunction(
+    zone.getNucnetZone(),
+    RATE_TABLE_STRING,
+    p_cache
+  );
+
+  return p_cache;
+
+}
+
+//##############################################################################
+// update_rate_spline_cache_data().
+//##############################################################################
+
+/**
+ * \brief Ensure a zone's rate spline cache is current.
+ * \param zone The zone.
+ */
+
+void
+update_rate_spline_cache_data( nnt::Zone& zone )
+{
+
+  get_rate_spline_cache_for_zone( zone );
+
+}
+
+} // namespace user
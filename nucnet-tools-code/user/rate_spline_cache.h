@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for cached rate-table and partition-function splines.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RATE_SPLINE_CACHE_H
+#define RATE_SPLINE_CACHE_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <gsl/gsl_spline.h>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for an interpolation table in t9.
+//##############################################################################
+
+/**
+ * \brief A table of log10 values in t9 with its interpolant built once.
+ *
+ * The table reproduces the Libnucnet interpolation of rate tables and
+ * partition functions: the end values are returned outside the table,
+ * linear interpolation is used for a two-point table, and a cubic spline
+ * in the log10 values is used otherwise.  The spline and its accelerator
+ * are allocated when the table is built.
+ */
+
+class T9Table : private boost::noncopyable
+{
+
+  public:
+    T9Table(
+      const gsl_vector *,
+      const std::vector<double>&,
+      double,
+      double,
+      double
+    );
+    ~T9Table();
+    double computeValue( double );
+
+  private:
+    std::vector<double> vT9;
+    std::vector<double> vLog10;
+    double dLow, dHigh, dFactor;
+    gsl_spline * pSpline;
+    gsl_interp_accel * pAcc;
+
+};
+
+//##############################################################################
+// Class for the rate spline cache.
+//##############################################################################
+
+/**
+ * \brief Cached rate-table and partition-function interpolants for a network.
+ *
+ * The rate-table interpolants are built when the cache is created.  The
+ * partition-function interpolants are built on the first request for a
+ * species.  The cache is valid as long as the reactions and nuclei in the
+ * network are not updated.  Each zone owns its own cache, so the spline
+ * accelerators are never shared between threads.
+ */
+
+class RateSplineCache : private boost::noncopyable
+{
+
+  public:
+    RateSplineCache( Libnucnet__Net * );
+    bool isValidForNet( Libnucnet__Net * ) const;
+    size_t getNumberOfRateTables() const { return rate_map.size(); }
+    double computeRateFromTable( Libnucnet__Reaction *, double );
+    double computePartitionFunction( Libnucnet__Species *, double );
+
+  private:
+    Libnucnet__Net * pNet;
+    size_t iReacUpdate, iNucUpdate;
+    typedef std::pair<
+      const Libnucnet__Reaction__RateTable *,
+      boost::shared_ptr<T9Table>
+    > rate_entry_t;
+    typedef std::pair<
+      const gsl_vector *,
+      boost::shared_ptr<T9Table>
+    > partf_entry_t;
+    boost::unordered_map<const Libnucnet__Reaction *, rate_entry_t> rate_map;
+    boost::unordered_map<const Libnucnet__Species *, partf_entry_t> partf_map;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+double
+cached_rate_table_function( Libnucnet__Reaction *, double, void * );
+
+void
+free_rate_spline_cache( void * );
+
+void
+register_rate_spline_cache( Libnucnet__Reac * );
+
+RateSplineCache *
+get_rate_spline_cache_for_zone( nnt::Zone& );
+
+void
+update_rate_spline_cache_data( nnt::Zone& );
+
+} // namespace user
+
+#endif // RATE_SPLINE_CACHE_H
@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the compiled reaction topology of a view.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/reaction_topology.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// ReactionTopology::ReactionTopology().
+//##############################################################################
+
+/**
+ * \brief Compile the reactions of a view.
+ * \param p_view A pointer to the network view.
+ * \param i_revision The revision of the view (see user::get_view_revision()).
+ */
+
+ReactionTopology::ReactionTopology(
+  Libnucnet__NetView * p_view,
+  size_t i_revision
+) : pView( p_view ), iRevision( i_revision )
+{
+
+  Libnucnet__Net * p_net = Libnucnet__NetView__getNet( p_view );
+  Libnucnet__Nuc * p_nuc = Libnucnet__Net__getNuc( p_net );
+
+  iNucUpdate = p_nuc->iUpdate;
+
+  vReactantPtr.push_back( 0 );
+  vProductPtr.push_back( 0 );
+
+  BOOST_FOREACH(
+    nnt::Reaction reaction,
+    nnt::make_reaction_list( Libnucnet__Net__getReac( p_net ) )
+  )
+  {
+
+    Libnucnet__Reaction * p_reaction = reaction.getNucnetReaction();
+
+    int i_charge = 0, i_number = 0;
+
+    vReactions.push_back( p_reaction );
+
+    BOOST_FOREACH(
+      nnt::ReactionElement reactant,
+      nnt::make_reaction_nuclide_reactant_list( p_reaction )
+    )
+    {
+      Libnucnet__Species * p_species =
+        Libnucnet__Nuc__getSpeciesByName(
+          p_nuc,
+          Libnucnet__Reaction__Element__getName(
+            reactant.getNucnetReactionElement()
+          )
+        );
+      vReactants.push_back( Libnucnet__Species__getIndex( p_species ) );
+      vReactantZ.push_back( Libnucnet__Species__getZ( p_species ) );
+      vReactantA.push_back( Libnucnet__Species__getA( p_species ) );
+      i_charge -= (int) vReactantZ.back();
+      i_number++;
+    }
+
+    BOOST_FOREACH(
+      nnt::ReactionElement product,
+      nnt::make_reaction_nuclide_product_list( p_reaction )
+    )
+    {
+      Libnucnet__Species * p_species =
+        Libnucnet__Nuc__getSpeciesByName(
+          p_nuc,
+          Libnucnet__Reaction__Element__getName(
+            product.getNucnetReactionElement()
+          )
+        );
+      vProducts.push_back( Libnucnet__Species__getIndex( p_species ) );
+      vProductZ.push_back( Libnucnet__Species__getZ( p_species ) );
+      vProductA.push_back( Libnucnet__Species__getA( p_species ) );
+      i_charge += (int) vProductZ.back();
+      i_number--;
+    }
+
+    vReactantPtr.push_back( vReactants.size() );
+    vProductPtr.push_back( vProducts.size() );
+
+    vDuplicateReactantFactor.push_back(
+      Libnucnet__Reaction__getDuplicateReactantFactor( p_reaction )
+    );
+    vDuplicateProductFactor.push_back(
+      Libnucnet__Reaction__getDuplicateProductFactor( p_reaction )
+    );
+
+    vChargeChange.push_back( i_charge );
+    vNuclideNumberChange.push_back( i_number );
+
+    vQValue.push_back(
+      nnt::compute_reaction_nuclear_Qvalue(
+        p_net,
+        p_reaction,
+        nnt::d_ELECTRON_MASS_IN_MEV
+      )
+    );
+
+  }
+
+}
+
+//##############################################################################
+// ReactionTopology::isValidForView().
+//##############################################################################
+
+/**
+ * \brief Check whether the topology applies to a view.
+ * \param p_view A pointer to the network view.
+ * \return True if the topology was compiled for the view and neither the
+ *         network nor the nuclear data have changed since, false if not.
+ */
+
+bool
+ReactionTopology::isValidForView( Libnucnet__NetView * p_view ) const
+{
+
+  return
+    p_view == pView &&
+    !Libnucnet__NetView__wasNetUpdated( p_view ) &&
+    Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac( Libnucnet__NetView__getNet( p_view ) )
+    ) == vReactions.size() &&
+    Libnucnet__Net__getNuc(
+      Libnucnet__NetView__getNet( p_view )
+    )->iUpdate == iNucUpdate;
+
+}
+
+//##############################################################################
+// get_reaction_topology().
+//##############################################################################
+
+/**
+ * \brief Retrieve the compiled reaction topology of a view for a zone.
+ *        The topologies are stored with the zone, keyed by view, and only
+ *        compiled anew when a view or its revision changes.
+ * \param zone The zone.
+ * \param p_view A pointer to the network view.
+ * \return A shared pointer to the topology.
+ */
+
+boost::shared_ptr<ReactionTopology>
+get_reaction_topology( nnt::Zone& zone, Libnucnet__NetView * p_view )
+{
+
+  if( !zone.hasData( nnt::s_REACTION_TOPOLOGY ) )
+    zone.updateData(
+      nnt::s_REACTION_TOPOLOGY,
+      boost::shared_ptr<reaction_topology_map_t>(
+        new reaction_topology_map_t()
+      )
+    );
+
+  boost::shared_ptr<reaction_topology_map_t> p_map =
+    boost::any_cast<boost::shared_ptr<reaction_topology_map_t> >(
+      zone.getData( nnt::s_REACTION_TOPOLOGY )
+    );
+
+  size_t i_revision = get_view_revision( zone, p_view );
+
+  reaction_topology_map_t::iterator it = p_map->find( p_view );
+
+  if(
+    it != p_map->end() &&
+    it->second->getRevision() == i_revision &&
+    it->second->isValidForView( p_view )
+  )
+    return it->second;
+
+  boost::shared_ptr<ReactionTopology> p_topology(
+    new ReactionTopology( p_view, i_revision )
+  );
+
+  (*p_map)[p_view] = p_topology;
+
+  return p_topology;
+
+}
+
+//##############################################################################
+// erase_reaction_topology().
+//##############################################################################
+
+/**
+ * \brief Remove the topology stored for a view of a zone.
+ * \param zone The zone.
+ * \param p_view A pointer to the network view.
+ */
+
+void
+erase_reaction_topology( nnt::Zone& zone, Libnucnet__NetView * p_view )
+{
+
+  if( !zone.hasData( nnt::s_REACTION_TOPOLOGY ) ) return;
+
+  boost::any_cast<boost::shared_ptr<reaction_topology_map_t> >(
+    zone.getData( nnt::s_REACTION_TOPOLOGY )
+  )->erase( p_view );
+
+}
+
+//##############################################################################
+// get_view_revision().
+//##############################################################################
+
+/**
+ * \brief Get the revision of a view of a zone.
+ *
+ * Libnucnet marks a change to a network but not a change made in place to
+ * a view with Libnucnet__NetView__addReaction() or
+ * Libnucnet__NetView__removeReaction().  Code that changes a view in place
+ * calls user::notify_view_change(), and the data compiled for the view
+ * record the revision and are compiled anew when it changes.
+ *
+ * \param zone The zone.
+ * \param p_view A pointer to the network view.
+ * \return The number of in-place changes to the view.
+ */
+
+size_t
+get_view_revision( nnt::Zone& zone, Libnucnet__NetView * p_view )
+{
+
+  if( !zone.hasData( nnt::s_VIEW_REVISIONS ) ) return 0;
+
+  boost::shared_ptr<view_revision_map_t> p_map =
+    boost::any_cast<boost::shared_ptr<view_revision_map_t> >(
+      zone.getData( nnt::s_VIEW_REVISIONS )
+    );
+
+  view_revision_map_t::const_iterator it = p_map->find( p_view );
+
+  if( it == p_map->end() ) return 0;
+
+  return it->second;
+
+}
+
+//##############################################################################
+// notify_view_change().
+//##############################################################################
+
+/**
+ * \brief Record that a view of a zone was changed in place.  The topology
+ *        compiled for the old contents of the view is dropped.
+ * \param zone The zone.
+ * \param p_view A pointer to the network view.
+ */
+
+void
+notify_view_change( nnt::Zone& zone, Libnucnet__NetView * p_view )
+{
+
+  if( !zone.hasData( nnt::s_VIEW_REVISIONS ) )
+    zone.updateData(
+      nnt::s_VIEW_REVISIONS,
+      boost::shared_ptr<view_revision_map_t>( new view_revision_map_t() )
+    );
+
+  boost::shared_ptr<view_revision_map_t> p_map =
+    boost::any_cast<boost::shared_ptr<view_revision_map_t> >(
+      zone.getData( nnt::s_VIEW_REVISIONS )
+    );
+
+  (*p_map)[p_view]++;
+
+  erase_reaction_topology( zone, p_view );
+
+}
+
+//##############################################################################
+// release_view().
+//##############################################################################
+
+/**
+ * \brief Drop the data recorded for a view of a zone.  Code that replaces
+ *        a view of a zone calls this routine for the old view before it is
+ *        freed, so that the zone does not keep entries for views that no
+ *        longer exist.
+ * \param zone The zone.
+ * \param p_view A pointer to the network view.
+ */
+
+void
+release_view( nnt::Zone& zone, Libnucnet__NetView * p_view )
+{
+
+  if( zone.hasData( nnt::s_VIEW_REVISIONS ) )
+    boost::any_cast<boost::shared_ptr<view_revision_map_t> >(
+      zone.getData( nnt::s_VIEW_REVISIONS )
+    )->erase( p_view );
+
+  erase_reaction_topology( zone, p_view );
+
+}
+
+} // namespace user
@@ -0,0 +1,162 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the compiled reaction topology of a view.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef REACTION_TOPOLOGY_H
+#define REACTION_TOPOLOGY_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+#include "nnt/auxiliary.h"
+#include "nnt/string_defs.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for the reaction topology.
+//##############################################################################
+
+/**
+ * \brief The reactant and product nuclides of the reactions in a network
+ *        view compiled into flat arrays.
+ *
+ * The reactions are in the order of nnt::make_reaction_list for the view,
+ * which is also the order of the ZoneRates arrays.  The nuclide reactants
+ * of reaction r are elements vReactantPtr[r] to vReactantPtr[r+1] - 1 of
+ * the reactant arrays, which give the species index, Z, and A of each
+ * element, and similarly for the products.  The duplicate factors, the
+ * changes in charge and in the number of nuclides, and the nuclear Q value
+ * (with the electron mass for weak reactions, as
+ * nnt::compute_reaction_nuclear_Qvalue) are also stored per reaction.
+ * The topology is built once per view and is valid until the view's
+ * network or nuclear data change or the view is changed in place (see
+ * user::notify_view_change()).
+ */
+
+class ReactionTopology : private boost::noncopyable
+{
+
+  public:
+    ReactionTopology( Libnucnet__NetView *, size_t );
+    Libnucnet__NetView * getNetView() const { return pView; }
+    size_t getRevision() const { return iRevision; }
+    bool isValidForView( Libnucnet__NetView * ) const;
+    size_t getNumberOfReactions() const { return vReactions.size(); }
+    const std::vector<Libnucnet__Reaction *>& getReactionVector() const
+      { return vReactions; }
+    const std::vector<size_t>& getReactantPtrVector() const
+      { return vReactantPtr; }
+    const std::vector<size_t>& getReactantVector() const
+      { return vReactants; }
+    const std::vector<unsigned int>& getReactantZVector() const
+      { return vReactantZ; }
+    const std::vector<unsigned int>& getReactantAVector() const
+      { return vReactantA; }
+    const std::vector<size_t>& getProductPtrVector() const
+      { return vProductPtr; }
+    const std::vector<size_t>& getProductVector() const
+      { return vProducts; }
+    const std::vector<unsigned int>& getProductZVector() const
+      { return vProductZ; }
+    const std::vector<unsigned int>& getProductAVector() const
+      { return vProductA; }
+    const std::vector<double>& getDuplicateReactantFactorVector() const
+      { return vDuplicateReactantFactor; }
+    const std::vector<double>& getDuplicateProductFactorVector() const
+      { return vDuplicateProductFactor; }
+    const std::vector<int>& getChargeChangeVector() const
+      { return vChargeChange; }
+    const std::vector<int>& getNuclideNumberChangeVector() const
+      { return vNuclideNumberChange; }
+    const std::vector<double>& getQValueVector() const { return vQValue; }
+
+  private:
+    Libnucnet__NetView * pView;
+    size_t iRevision;
+    size_t iNucUpdate;
+    std::vector<Libnucnet__Reaction *> vReactions;
+    std::vector<size_t> vReactantPtr;
+    std::vector<size_t> vReactants;
+    std::vector<unsigned int> vReactantZ;
+    std::vector<unsigned int> vReactantA;
+    std::vector<size_t> vProductPtr;
+    std::vector<size_t> vProducts;
+    std::vector<unsigned int> vProductZ;
+    std::vector<unsigned int> vProductA;
+    std::vector<double> vDuplicateReactantFactor;
+    std::vector<double> vDuplicateProductFactor;
+    std::vector<int> vChargeChange;
+    std::vector<int> vNuclideNumberChange;
+    std::vector<double> vQValue;
+
+};
+
+//##############################################################################
+// Typedef for the topologies stored with a zone, keyed by view.
+//##############################################################################
+
+typedef
+boost::unordered_map<
+  Libnucnet__NetView *,
+  boost::shared_ptr<ReactionTopology>
+> reaction_topology_map_t;
+
+//##############################################################################
+// Typedef for the revisions of the views of a zone.
+//##############################################################################
+
+typedef
+boost::unordered_map<Libnucnet__NetView *, size_t> view_revision_map_t;
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+boost::shared_ptr<ReactionTopology>
+get_reaction_topology( nnt::Zone&, Libnucnet__NetView * );
+
+size_t
+get_view_revision( nnt::Zone&, Libnucnet__NetView * );
+
+void
+erase_reaction_topology( nnt::Zone&, Libnucnet__NetView * );
+
+void
+notify_view_change( nnt::Zone&, Libnucnet__NetView * );
+
+void
+release_view( nnt::Zone&, Libnucnet__NetView * );
+
+} // namespace user
+
+#endif // REACTION_TOPOLOGY_H
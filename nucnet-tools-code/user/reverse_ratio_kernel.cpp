@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the precomputed reverse ratio kernel.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/reverse_ratio_kernel.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define D_REVERSE_RATIO_CUTOFF  -300.
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// compute_log_quantum_abundance_factor().
+//##############################################################################
+
+/**
+ * \brief Compute the log of a species' quantum abundance at t9 = 1 and unit
+ *        density without the partition function.
+ * \param p_species A pointer to the species.
+ * \return The log of the factor.  The factor is the same as that of
+ *         Libnucnet__Species__computeQuantumAbundance with a unit partition
+ *         function.
+ */
+
+double
+compute_log_quantum_abundance_factor( Libnucnet__Species * p_species )
+{
+
+  double d_xmnu =
+    WN_AMU_TO_MEV *
+    Libnucnet__Species__getA( p_species ) +
+    Libnucnet__Species__getMassExcess( p_species );
+
+  return
+    1.5 *
+    log(
+      (
+        d_xmnu *
+        WN_MEV_TO_ERGS *
+        GSL_CONST_CGSM_BOLTZMANN *
+        GSL_CONST_NUM_GIGA
+      )
+      /
+      (
+        2 * M_PI *
+        gsl_pow_2(
+          GSL_CONST_CGSM_PLANCKS_CONSTANT_HBAR *
+          GSL_CONST_CGSM_SPEED_OF_LIGHT
+        )
+      )
+    )
+    -
+    log( GSL_CONST_NUM_AVOGADRO );
+
+}
+
+//##############################################################################
+// ReverseRatioKernel::ReverseRatioKernel().
+//##############################################################################
+
+/**
+ * \brief Precompute the constant parts of the reverse ratios.
+ * \param p_nuc A pointer to the nuclear species collection.
+ * \param v_reactions The reactions.  The ratios are indexed as the vector.
+ */
+
+ReverseRatioKernel::ReverseRatioKernel(
+  Libnucnet__Nuc * p_nuc,
+  const std::vector<Libnucnet__Reaction *>& v_reactions
+)
+{
+
+  boost::unordered_map<Libnucnet__Species *, size_t> species_map;
+  std::vector<double> v_species_constant, v_binding;
+
+  double d_kT_1 = nnt::compute_kT_in_MeV( 1. );
+
+  vReactantPtr.push_back( 0 );
+  vProductPtr.push_back( 0 );
+
+  BOOST_FOREACH( Libnucnet__Reaction * p_reaction, v_reactions )
+  {
+
+    std::vector<Libnucnet__Species *> v_reactants, v_products;
+
+    BOOST_FOREACH(
+      nnt::ReactionElement reactant,
+      nnt::make_reaction_nuclide_reactant_list( p_reaction )
+    )
+    {
+      v_reactants.push_back(
+        Libnucnet__Nuc__getSpeciesByName(
+          p_nuc,
+          Libnucnet__Reaction__Element__getName(
+            reactant.getNucnetReactionElement()
+          )
+        )
+      );
+    }
+
+    BOOST_FOREACH(
+      nnt::ReactionElement product,
+      nnt::make_reaction_nuclide_product_list( p_reaction )
+    )
+    {
+      v_products.push_back(
+        Libnucnet__Nuc__getSpeciesByName(
+          p_nuc,
+          Libnucnet__Reaction__Element__getName(
+            product.getNucnetReactionElement()
+          )
+        )
+      );
+    }
+
+    //--------------------------------------------------------------------------
+    // Weak reactions and decays have no reverse rate.
+    //--------------------------------------------------------------------------
+
+    bool b_ratio =
+      !Libnucnet__Reaction__isWeak( p_reaction ) &&
+      v_reactants.size() +
+        (size_t) xmlListSize( p_reaction->pOtherReactantList ) != 1;
+
+    vHasRatio.push_back( b_ratio ? 1 : 0 );
+
+    if( !b_ratio )
+    {
+      v_reactants.clear();
+      v_products.clear();
+    }
+
+    //--------------------------------------------------------------------------
+    // Species.  The constant is the log of the quantum abundance at t9 = 1
+    // and unit density without the partition function.  It is computed
+    // directly so that no partition-function interpolant is built here.
+    //--------------------------------------------------------------------------
+
+    double d_constant = 0., d_binding = 0.;
+
+    for( size_t j = 0; j < v_reactants.size() + v_products.size(); j++ )
+    {
+
+      bool b_reactant = j < v_reactants.size();
+
+      Libnucnet__Species * p_species =
+        b_reactant ? v_reactants[j] : v_products[j - v_reactants.size()];
+
+      if( species_map.find( p_species ) == species_map.end() )
+      {
+        species_map[p_species] = vSpecies.size();
+        vSpecies.push_back( p_species );
+        v_species_constant.push_back(
+          compute_log_quantum_abundance_factor( p_species )
+        );
+        v_binding.push_back(
+          Libnucnet__Nuc__computeSpeciesBindingEnergy( p_nuc, p_species )
+        );
+      }
+
+      size_t i_species = species_map[p_species];
+
+      if( b_reactant )
+      {
+        vReactants.push_back( i_species );
+        d_constant += v_species_constant[i_species];
+        d_binding += v_binding[i_species];
+      }
+      else
+      {
+        vProducts.push_back( i_species );
+        d_constant -= v_species_constant[i_species];
+        d_binding -= v_binding[i_species];
+      }
+
+    }
+
+    vReactantPtr.push_back( vReactants.size() );
+    vProductPtr.push_back( vProducts.size() );
+
+    vConstant.push_back( d_constant );
+    vQOverK.push_back( d_binding / d_kT_1 );
+    vT9Power.push_back(
+      1.5 * ( (double) v_reactants.size() - (double) v_products.size() )
+    );
+    vLogDuplicateFactor.push_back(
+      log(
+        Libnucnet__Reaction__getDuplicateProductFactor( p_reaction ) /
+        Libnucnet__Reaction__getDuplicateReactantFactor( p_reaction )
+      )
+    );
+
+  }
+
+  vLogPartf.resize( vSpecies.size() );
+  vExponent.resize( v_reactions.size() );
+  vRatio.resize( v_reactions.size() );
+  vSuppressForward.resize( v_reactions.size() );
+
+}
+
+//##############################################################################
+// ReverseRatioKernel::computeRatios().
+//##############################################################################
+
+/**
+ * \brief Compute the reverse ratios at a t9.
+ * \param d_t9 The t9.
+ * \param p_cache A pointer to a rate spline cache for the network, or NULL.
+ *                If supplied, the partition functions are interpolated from
+ *                the cached splines rather than from splines built by
+ *                Libnucnet on each call.
+ */
+
+void
+ReverseRatioKernel::computeRatios( double d_t9, RateSplineCache * p_cache )
+{
+
+  size_t i_reactions = vExponent.size();
+
+  if( i_reactions == 0 ) return;
+
+  double d_log_t9 = log( d_t9 ), d_inv_t9 = 1. / d_t9;
+
+  //============================================================================
+  // Partition functions, once per species.
+  //============================================================================
+
+  if( p_cache )
+  {
+    for( size_t s = 0; s < vSpecies.size(); s++ )
+      vLogPartf[s] =
+        log( p_cache->computePartitionFunction( vSpecies[s], d_t9 ) );
+  }
+  else
+  {
+    for( size_t s = 0; s < vSpecies.size(); s++ )
+      vLogPartf[s] =
+        log(
+          Libnucnet__Species__computePartitionFunction( vSpecies[s], d_t9 )
+        );
+  }
+
+  //============================================================================
+  // Exponents.
+  //============================================================================
+
+  for( size_t r = 0; r < i_reactions; r++ )
+  {
+
+    double d_exp =
+      vConstant[r] + vT9Power[r] * d_log_t9 + vQOverK[r] * d_inv_t9;
+
+    for( size_t j = vReactantPtr[r]; j < vReactantPtr[r+1]; j++ )
+      d_exp += vLogPartf[vReactants[j]];
+
+    for( size_t j = vProductPtr[r]; j < vProductPtr[r+1]; j++ )
+      d_exp -= vLogPartf[vProducts[j]];
+
+    vExponent[r] = d_exp;
+
+  }
+
+  //============================================================================
+  // Ratios.  As in Libnucnet, a forward rate is set to zero if its
+  // exponent is too large, and a reverse rate is zero if its exponent is
+  // too small.
+  //============================================================================
+
+  const double * p_exp = &vExponent[0], * p_dup = &vLogDuplicateFactor[0];
+  const char * p_has = &vHasRatio[0];
+  double * p_ratio = &vRatio[0];
+  char * p_suppress = &vSuppressForward[0];
+
+#ifndef NO_OPENMP
+  #pragma omp simd
+#endif
+  for( size_t r = 0; r < i_reactions; r++ )
+  {
+    double d_exp = p_exp[r];
+    bool b_large = p_has[r] && d_exp > D_LARGE;
+    bool b_keep = p_has[r] && !b_large && d_exp >= D_REVERSE_RATIO_CUTOFF;
+    double d_ratio = exp( GSL_MIN( d_exp, D_LARGE ) + p_dup[r] );
+    p_suppress[r] = b_large ? 1 : 0;
+    p_ratio[r] = b_keep ? d_ratio : 0.;
+  }
+
+}
+
+} // namespace user
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the precomputed reverse ratio kernel.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef REVERSE_RATIO_KERNEL_H
+#define REVERSE_RATIO_KERNEL_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/auxiliary.h"
+#include "nnt/iter.h"
+
+#include "user/rate_spline_cache.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for the reverse ratio kernel.
+//##############################################################################
+
+/**
+ * \brief The detailed-balance reverse ratios of a list of reactions.
+ *
+ * The constructor precomputes, for each reaction, the parts of the reverse
+ * ratio that do not change during a run: the mass and duplicate factors,
+ * the power of t9, and the binding-energy difference over k.  It also
+ * lists the species that appear in the reactions.  computeRatios() then
+ * computes the partition function of each species once, from a rate spline
+ * cache if one is supplied, and forms all the ratios with one exponential
+ * per reaction.  The reverse rates are the
+ * same as those computed by Libnucnet__Net__computeReverseRate.
+ */
+
+class ReverseRatioKernel
+{
+
+  public:
+    ReverseRatioKernel(
+      Libnucnet__Nuc *,
+      const std::vector<Libnucnet__Reaction *>&
+    );
+    size_t getNumberOfSpecies() const { return vSpecies.size(); }
+    void computeRatios( double, RateSplineCache * = NULL );
+    double computeReverseRate( size_t i, double * p_forward ) const
+    {
+      if( vSuppressForward[i] ) *p_forward = 0.;
+      return *p_forward * vRatio[i];
+    }
+
+  private:
+    std::vector<Libnucnet__Species *> vSpecies;
+    std::vector<char> vHasRatio;
+    std::vector<double> vConstant;
+    std::vector<double> vLogDuplicateFactor;
+    std::vector<double> vT9Power;
+    std::vector<double> vQOverK;
+    std::vector<size_t> vReactantPtr;
+    std::vector<size_t> vReactants;
+    std::vector<size_t> vProductPtr;
+    std::vector<size_t> vProducts;
+    std::vector<double> vLogPartf;
+    std::vector<double> vExponent;
+    std::vector<double> vRatio;
+    std::vector<char> vSuppressForward;
+
+};
+
+double
+compute_log_quantum_abundance_factor( Libnucnet__Species * );
+
+} // namespace user
+
+#endif // REVERSE_RATIO_KERNEL_H
@@ -144,6 +144,7 @@ reaction_screening_function(
 )
 {
 
+  Libnucnet__Nuc * p_nuc = Libnucnet__Net__getNuc( p_net );
   unsigned int i_z1, i_a1;
 
   //============================================================================
@@ -160,26 +161,17 @@ reaction_screening_function(
   BOOST_FOREACH( nnt::ReactionElement reactant, reactant_list )
   {
 
-    unsigned int i_z2 =
-      Libnucnet__Species__getZ(
-        Libnucnet__Nuc__getSpeciesByName(
-          Libnucnet__Net__getNuc( p_net ),
-          Libnucnet__Reaction__Element__getName(
-            reactant.getNucnetReactionElement()
-          )
+    Libnucnet__Species * p_species =
+      Libnucnet__Nuc__getSpeciesByName(
+        p_nuc,
+        Libnucnet__Reaction__Element__getName(
+          reactant.getNucnetReactionElement()
         )
-      ); 
-    
-    unsigned int i_a2 =
-      Libnucnet__Species__getA(
-        Libnucnet__Nuc__getSpeciesByName(
-          Libnucnet__Net__getNuc( p_net ),
-          Libnucnet__Reaction__Element__getName(
-            reactant.getNucnetReactionElement()
-          )
-        )
-      ); 
-    
+      );
+
+    unsigned int i_z2 = Libnucnet__Species__getZ( p_species );
+    unsigned int i_a2 = Libnucnet__Species__getA( p_species );
+
     if( i_z1 != 0 && i_a1 != 0 )
     {
       *p_screen_f *=
@@ -214,26 +206,17 @@ reaction_screening_function(
   BOOST_FOREACH( nnt::ReactionElement product, product_list )
   {
 
-    unsigned int i_z2 =
-      Libnucnet__Species__getZ(
-        Libnucnet__Nuc__getSpeciesByName(
-          Libnucnet__Net__getNuc( p_net ),
-          Libnucnet__Reaction__Element__getName(
-            product.getNucnetReactionElement()
-          )
+    Libnucnet__Species * p_species =
+      Libnucnet__Nuc__getSpeciesByName(
+        p_nuc,
+        Libnucnet__Reaction__Element__getName(
+          product.getNucnetReactionElement()
         )
-      ); 
-    
-    unsigned int i_a2 =
-      Libnucnet__Species__getA(
-        Libnucnet__Nuc__getSpeciesByName(
-          Libnucnet__Net__getNuc( p_net ),
-          Libnucnet__Reaction__Element__getName(
-            product.getNucnetReactionElement()
-          )
-        )
-      ); 
-    
+      );
+
+    unsigned int i_z2 = Libnucnet__Species__getZ( p_species );
+    unsigned int i_a2 = Libnucnet__Species__getA( p_species );
+
     if( i_z1 != 0 && i_a1 != 0 )
     {
       *p_screen_r *=
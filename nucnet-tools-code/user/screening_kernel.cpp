@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the batch screening kernel.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "user/screening_kernel.h"
+#include "user/screen.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define D_GAMMA_WEAK          0.3
+#define D_GAMMA_STRONG        0.8
+#define D_GAMMA_MAX           168.
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// ScreeningKernel::ScreeningKernel().
+//##############################################################################
+
+/**
+ * \brief List the distinct screening pairs and the species of a topology.
+ * \param topology The compiled reaction topology.  The reactions are
+ *        screened in its order.
+ */
+
+ScreeningKernel::ScreeningKernel( const ReactionTopology& topology ) :
+  dMaxGammaConstant( 0. )
+{
+
+  boost::unordered_map<boost::uint64_t, size_t> pair_map;
+  boost::unordered_map<size_t, size_t> species_map;
+
+  Libnucnet__Nuc * p_nuc =
+    Libnucnet__Net__getNuc(
+      Libnucnet__NetView__getNet( topology.getNetView() )
+    );
+
+  std::vector<Libnucnet__Species *> v_species_by_index(
+    Libnucnet__Nuc__getNumberOfSpecies( p_nuc )
+  );
+
+  BOOST_FOREACH( nnt::Species species, nnt::make_species_list( p_nuc ) )
+  {
+    v_species_by_index[
+      Libnucnet__Species__getIndex( species.getNucnetSpecies() )
+    ] = species.getNucnetSpecies();
+  }
+
+  vForwardPairPtr.push_back( 0 );
+  vReversePairPtr.push_back( 0 );
+  vReactantPtr.push_back( 0 );
+  vProductPtr.push_back( 0 );
+
+  for( size_t r = 0; r < topology.getNumberOfReactions(); r++ )
+  {
+
+    for( int i_dir = 0; i_dir < 2; i_dir++ )
+    {
+
+      const std::vector<size_t>& v_ptr =
+        i_dir == 0 ?
+          topology.getReactantPtrVector() : topology.getProductPtrVector();
+      const std::vector<size_t>& v_index =
+        i_dir == 0 ?
+          topology.getReactantVector() : topology.getProductVector();
+      const std::vector<unsigned int>& v_z =
+        i_dir == 0 ?
+          topology.getReactantZVector() : topology.getProductZVector();
+      const std::vector<unsigned int>& v_a =
+        i_dir == 0 ?
+          topology.getReactantAVector() : topology.getProductAVector();
+
+      std::vector<size_t>& v_pairs =
+        i_dir == 0 ? vForwardPairs : vReversePairs;
+      std::vector<size_t>& v_species = i_dir == 0 ? vReactants : vProducts;
+
+      unsigned int i_z1 = 0, i_a1 = 0;
+
+      for( size_t j = v_ptr[r]; j < v_ptr[r+1]; j++ )
+      {
+
+        //----------------------------------------------------------------------
+        // Pairs, as in reaction_screening_function().  A pair with a
+        // neutral member has a factor of one and is left out.
+        //----------------------------------------------------------------------
+
+        if( i_z1 != 0 && i_a1 != 0 && v_z[j] != 0 )
+        {
+
+          boost::uint64_t i_key =
+            ( (boost::uint64_t) i_z1 << 48 ) |
+            ( (boost::uint64_t) i_a1 << 32 ) |
+            ( (boost::uint64_t) v_z[j] << 16 ) |
+            (boost::uint64_t) v_a[j];
+
+          if( pair_map.find( i_key ) == pair_map.end() )
+          {
+
+            double d_z1 = i_z1, d_a1 = i_a1, d_z2 = v_z[j], d_a2 = v_a[j];
+            double d_a_bar = d_a1 * d_a2 / ( d_a1 + d_a2 );
+
+            pair_map[i_key] = vWeakConstant.size();
+
+            vWeakConstant.push_back(
+              d_z1 * d_z2 * 1.88e8 * pow( d_a_bar, -1. / 2. )
+            );
+            vGammaConstant.push_back(
+              pow( 2. / ( d_z1 + d_z2 ), 1. / 3. ) * d_z1 * d_z2
+            );
+            vTauConstant.push_back(
+              4.24872 * pow( gsl_pow_2( d_z1 * d_z1 ) * d_a_bar, 1. / 3. )
+            );
+            vZ53.push_back(
+              pow( d_z1 + d_z2, 5. / 3. ) -
+              pow( d_z1, 5. / 3. ) - pow( d_z2, 5. / 3. )
+            );
+            vZ512.push_back(
+              pow( d_z1 + d_z2, 5. / 12. ) -
+              pow( d_z1, 5. / 12. ) - pow( d_z2, 5. / 12. )
+            );
+            vLogConstant.push_back(
+              0.5551 * ( 5. / 3. ) * log( d_z1 * d_z2 ) / ( d_z1 + d_z2 )
+              + 2.996
+            );
+
+            dMaxGammaConstant =
+              GSL_MAX( dMaxGammaConstant, vGammaConstant.back() );
+
+          }
+
+          v_pairs.push_back( pair_map[i_key] );
+
+        }
+
+        i_z1 += v_z[j];
+        i_a1 += v_a[j];
+
+        //----------------------------------------------------------------------
+        // Species for the NSE correction.
+        //----------------------------------------------------------------------
+
+        if( species_map.find( v_index[j] ) == species_map.end() )
+        {
+          species_map[v_index[j]] = vSpecies.size();
+          vSpecies.push_back( v_species_by_index[v_index[j]] );
+        }
+
+        v_species.push_back( species_map[v_index[j]] );
+
+      }
+
+    }
+
+    vForwardPairPtr.push_back( vForwardPairs.size() );
+    vReversePairPtr.push_back( vReversePairs.size() );
+    vReactantPtr.push_back( vReactants.size() );
+    vProductPtr.push_back( vProducts.size() );
+
+  }
+
+  vPairFactor.resize( vWeakConstant.size() );
+  vSpeciesCorrection.resize( vSpecies.size() );
+
+}
+
+//##############################################################################
+// ScreeningKernel::screenRates().
+//##############################################################################
+
+/**
+ * \brief Screen the rates of the topology's reactions for a zone.
+ * \param p_zone A pointer to the zone.  Its screening data are those of
+ *        user::set_screening_function(), and its NSE correction function,
+ *        if any, is applied.
+ * \param d_t9 The t9.
+ * \param d_rho The mass density (g/cc).
+ * \param d_Ye The electron-to-nucleon ratio.
+ * \param v_forward The forward rates, screened on return.
+ * \param v_reverse The reverse rates, screened on return.
+ */
+
+void
+ScreeningKernel::screenRates(
+  Libnucnet__Zone * p_zone,
+  double d_t9,
+  double d_rho,
+  double d_Ye,
+  std::vector<double>& v_forward,
+  std::vector<double>& v_reverse
+)
+{
+
+  size_t i_pairs = vPairFactor.size();
+  size_t i_reactions = vForwardPairPtr.size() - 1;
+
+  //============================================================================
+  // Pair factors.  The weak, intermediate, and strong forms are all
+  // evaluated and the applicable one selected, so the loop has no branches.
+  //============================================================================
+
+  if( i_pairs > 0 )
+  {
+
+    double d_Ye2 =
+      boost::any_cast<screening_data_t>(
+        *(boost::any *) Libnucnet__Zone__getScreeningData( p_zone )
+      ).dYe2;
+
+    double d_Gamma_e = calculate_gamma_e( d_t9, d_rho, d_Ye );
+
+    if( d_Gamma_e * dMaxGammaConstant > D_GAMMA_MAX )
+    {
+      LIBNUCNET__ERROR(
+        "This is beyond the strong screening regime and not covered by "
+        "this approximation."
+      );
+    }
+
+    double d_weak_scale =
+      pow( D_THETA_E * d_Ye + d_Ye2, 1. / 2. ) *
+      pow( d_rho, 1. / 2. ) *
+      pow( d_t9 * 1.e9, -3. / 2. );
+    double d_tau_scale = pow( d_t9, -1. / 3. );
+    double d_c_z53 = 0.896434 * d_Gamma_e;
+    double d_c_z512 = 3.44740 * pow( d_Gamma_e, 1. / 4. );
+    double d_c_log = 0.5551 * log( d_Gamma_e );
+
+    const double * p_weak = &vWeakConstant[0];
+    const double * p_gamma = &vGammaConstant[0];
+    const double * p_tau = &vTauConstant[0];
+    const double * p_z53 = &vZ53[0];
+    const double * p_z512 = &vZ512[0];
+    const double * p_log = &vLogConstant[0];
+    double * p_factor = &vPairFactor[0];
+
+#ifndef NO_OPENMP
+    #pragma omp simd
+#endif
+    for( size_t k = 0; k < i_pairs; k++ )
+    {
+
+      double d_h_weak = p_weak[k] * d_weak_scale;
+      double d_gamma = p_gamma[k] * d_Gamma_e;
+      double d_tau = p_tau[k] * d_tau_scale;
+
+      double d_b = 3. * d_gamma / d_tau;
+      double d_b3 = d_b * d_b * d_b;
+      double d_b4 = d_b3 * d_b;
+      double d_b5 = d_b4 * d_b;
+      double d_b6 = d_b5 * d_b;
+
+      double d_h_strong =
+        d_c_z53 * p_z53[k] - d_c_z512 * p_z512[k] - d_c_log - p_log[k]
+        -
+        ( d_tau / 3. ) * ( ( 5. / 32. ) * d_b3 - 0.014 * d_b4 - 0.128 * d_b5 )
+        -
+        d_gamma * ( 0.0055 * d_b4 - 0.0098 * d_b5 + 0.0048 * d_b6 );
+
+      double d_h_intermediate =
+        d_h_weak * d_h_strong /
+        sqrt( d_h_weak * d_h_weak + d_h_strong * d_h_strong );
+
+      double d_h =
+        d_gamma < D_GAMMA_WEAK ?
+          d_h_weak :
+          ( d_gamma < D_GAMMA_STRONG ? d_h_intermediate : d_h_strong );
+
+      p_factor[k] = exp( d_h );
+
+    }
+
+  }
+
+  //============================================================================
+  // NSE corrections, once per species.
+  //============================================================================
+
+  Libnucnet__Species__nseCorrectionFactorFunction pf_nse =
+    Libnucnet__Zone__getNseCorrectionFactorFunction( p_zone );
+
+  if( pf_nse )
+  {
+    void * p_nse_data = Libnucnet__Zone__getNseCorrectionFactorData( p_zone );
+    for( size_t s = 0; s < vSpecies.size(); s++ )
+      vSpeciesCorrection[s] =
+        pf_nse( vSpecies[s], d_t9, d_rho, d_Ye, p_nse_data );
+  }
+
+  //============================================================================
+  // Apply the factors as user::screening_function().
+  //============================================================================
+
+  for( size_t r = 0; r < i_reactions; r++ )
+  {
+
+    double d_screen_f = 1., d_screen_r = 1., d_nse_corr = 1.;
+
+    for( size_t j = vForwardPairPtr[r]; j < vForwardPairPtr[r+1]; j++ )
+      d_screen_f *= vPairFactor[vForwardPairs[j]];
+
+    for( size_t j = vReversePairPtr[r]; j < vReversePairPtr[r+1]; j++ )
+      d_screen_r *= vPairFactor[vReversePairs[j]];
+
+    if( pf_nse )
+    {
+      double d_exp = 0.;
+      for( size_t j = vReactantPtr[r]; j < vReactantPtr[r+1]; j++ )
+        d_exp += vSpeciesCorrection[vReactants[j]];
+      for( size_t j = vProductPtr[r]; j < vProductPtr[r+1]; j++ )
+        d_exp -= vSpeciesCorrection[vProducts[j]];
+      d_nse_corr = exp( d_exp );
+    }
+
+    if( d_screen_f >= d_screen_r )
+    {
+      v_forward[r] *= d_screen_f;
+      v_reverse[r] *= d_screen_f * d_nse_corr;
+    }
+    else
+    {
+      v_forward[r] *= d_screen_r / d_nse_corr;
+      v_reverse[r] *= d_screen_r;
+    }
+
+  }
+
+}
+
+} // namespace user
@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the batch screening kernel.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SCREENING_KERNEL_H
+#define SCREENING_KERNEL_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <Libnucnet.h>
+
+#include "user/reaction_topology.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for the screening kernel.
+//##############################################################################
+
+/**
+ * \brief The screening of all the reactions of a compiled topology in one
+ *        pass.
+ *
+ * The screening factor of a reaction is a product of pair factors that
+ * depend only on the charges and mass numbers of the pair and on t9,
+ * density, and Ye.  A network has far fewer distinct (Z1,A1,Z2,A2) pairs
+ * than reaction pairs, so the constructor lists the distinct pairs, stores
+ * the parts of the pair screening that do not depend on the conditions,
+ * and lists for each reaction the pairs in its forward and reverse
+ * directions.  It also lists the species of the reactions for the NSE
+ * correction.  screenRates() then evaluates each pair once in a loop over
+ * flat arrays, calls the zone's NSE correction function once per species,
+ * and applies the factors to all the rates.  The result is the same as that
+ * of calling user::screening_function() for each reaction.
+ */
+
+class ScreeningKernel : private boost::noncopyable
+{
+
+  public:
+    ScreeningKernel( const ReactionTopology& );
+    size_t getNumberOfPairs() const { return vPairFactor.size(); }
+    size_t getNumberOfSpecies() const { return vSpecies.size(); }
+    void screenRates(
+      Libnucnet__Zone *,
+      double,
+      double,
+      double,
+      std::vector<double>&,
+      std::vector<double>&
+    );
+
+  private:
+    double dMaxGammaConstant;
+    std::vector<double> vWeakConstant;
+    std::vector<double> vGammaConstant;
+    std::vector<double> vTauConstant;
+    std::vector<double> vZ53;
+    std::vector<double> vZ512;
+    std::vector<double> vLogConstant;
+    std::vector<double> vPairFactor;
+    std::vector<size_t> vForwardPairPtr;
+    std::vector<size_t> vForwardPairs;
+    std::vector<size_t> vReversePairPtr;
+    std::vector<size_t> vReversePairs;
+    std::vector<Libnucnet__Species *> vSpecies;
+    std::vector<size_t> vReactantPtr;
+    std::vector<size_t> vReactants;
+    std::vector<size_t> vProductPtr;
+    std::vector<size_t> vProducts;
+    std::vector<double> vSpeciesCorrection;
+
+};
+
+} // namespace user
+
+#endif // SCREENING_KERNEL_H
@@ -0,0 +1,675 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the sparse direct LU solver.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "sparse_lu_solver.h"
+
+#define D_SPARSE_LU_PIVOT_TOL  1.e-14
+
+/**
+ * @brief A NucNet Tools namespace for extra (potentially user-supplied)
+ *        codes.
+ */
+namespace user
+{
+
+//##############################################################################
+// SparseLUSolver::SparseLUSolver().
+//##############################################################################
+
+/**
+ * \brief Construct the solver and compute the ordering and symbolic
+ *        factorization for a matrix pattern.
+ * \param i_rows The number of rows (and columns) in the matrix.
+ * \param row_ptr The zero-based CSR row pointer vector (size i_rows + 1).
+ * \param col The zero-based CSR column index vector.  Within each row,
+ *            the columns must be in increasing order.
+ */
+
+SparseLUSolver::SparseLUSolver(
+  size_t i_rows,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col
+) : iRows( i_rows ), vRowPtr( row_ptr ), vCol( col ), bFactored( false )
+{
+
+  if( vRowPtr.size() != iRows + 1 || vRowPtr[iRows] != vCol.size() )
+  {
+    std::cerr << "Invalid CSR pattern for sparse LU solver." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  computeOrdering();
+
+  computeSymbolicFactorization();
+
+  vLU.resize( vLUCol.size() );
+  vWork.resize( iRows );
+  vPosition.resize( iRows );
+
+}
+
+//##############################################################################
+// SparseLUSolver::computeOrdering().
+//##############################################################################
+
+void
+SparseLUSolver::computeOrdering()
+{
+
+  std::vector<std::set<size_t> > graph( iRows );
+  std::set<std::pair<size_t, size_t> > queue;
+
+  //============================================================================
+  // Symmetrized graph of the matrix.
+  //============================================================================
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+    for( size_t p = vRowPtr[i]; p < vRowPtr[i+1]; p++ )
+    {
+      if( vCol[p] != i )
+      {
+        graph[i].insert( vCol[p] );
+        graph[vCol[p]].insert( i );
+      }
+    }
+  }
+
+  for( size_t i = 0; i < iRows; i++ )
+    queue.insert( std::make_pair( graph[i].size(), i ) );
+
+  //============================================================================
+  // Minimum-degree elimination.  Ties are broken by index so the ordering
+  // is deterministic.
+  //============================================================================
+
+  vPerm.resize( iRows );
+  vInversePerm.resize( iRows );
+
+  for( size_t k = 0; k < iRows; k++ )
+  {
+
+    size_t i_node = queue.begin()->second;
+    queue.erase( queue.begin() );
+
+    vPerm[k] = i_node;
+    vInversePerm[i_node] = k;
+
+    std::vector<size_t> neighbors( graph[i_node].begin(), graph[i_node].end() );
+
+    for( size_t a = 0; a < neighbors.size(); a++ )
+    {
+      queue.erase(
+        std::make_pair( graph[neighbors[a]].size(), neighbors[a] )
+      );
+      graph[neighbors[a]].erase( i_node );
+    }
+
+    for( size_t a = 0; a < neighbors.size(); a++ )
+    {
+      for( size_t b = 0; b < neighbors.size(); b++ )
+      {
+        if( a != b ) graph[neighbors[a]].insert( neighbors[b] );
+      }
+    }
+
+    for( size_t a = 0; a < neighbors.size(); a++ )
+    {
+      queue.insert(
+        std::make_pair( graph[neighbors[a]].size(), neighbors[a] )
+      );
+    }
+
+    graph[i_node].clear();
+
+  }
+
+}
+
+//##############################################################################
+// SparseLUSolver::computeSymbolicFactorization().
+//##############################################################################
+
+void
+SparseLUSolver::computeSymbolicFactorization()
+{
+
+  vLURowPtr.assign( 1, 0 );
+  vLUCol.clear();
+  vLUDiag.resize( iRows );
+
+  //============================================================================
+  // Row i of the factors of the permuted matrix is the union of row i of the
+  // permuted matrix and the upper parts of the rows k < i it references.
+  //============================================================================
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+
+    std::set<size_t> row;
+    size_t i_orig = vPerm[i];
+
+    row.insert( i );
+
+    for( size_t p = vRowPtr[i_orig]; p < vRowPtr[i_orig+1]; p++ )
+      row.insert( vInversePerm[vCol[p]] );
+
+    for(
+      std::set<size_t>::iterator it = row.begin();
+      it != row.end() && *it < i;
+      it++
+    )
+    {
+      for( size_t q = vLUDiag[*it] + 1; q < vLURowPtr[*it+1]; q++ )
+        row.insert( vLUCol[q] );
+    }
+
+    for(
+      std::set<size_t>::iterator it = row.begin();
+      it != row.end();
+      it++
+    )
+    {
+      if( *it == i ) vLUDiag[i] = vLUCol.size();
+      vLUCol.push_back( *it );
+    }
+
+    vLURowPtr.push_back( vLUCol.size() );
+
+  }
+
+  //============================================================================
+  // Scatter map from matrix elements to factor elements.
+  //============================================================================
+
+  vScatter.resize( vCol.size() );
+
+  for( size_t i_orig = 0; i_orig < iRows; i_orig++ )
+  {
+    size_t i = vInversePerm[i_orig];
+    for( size_t p = vRowPtr[i_orig]; p < vRowPtr[i_orig+1]; p++ )
+    {
+      vScatter[p] =
+        std::lower_bound(
+          vLUCol.begin() + vLURowPtr[i],
+          vLUCol.begin() + vLURowPtr[i+1],
+          vInversePerm[vCol[p]]
+        ) - vLUCol.begin();
+    }
+  }
+
+}
+
+//##############################################################################
+// SparseLUSolver::hasPattern().
+//##############################################################################
+
+/**
+ * \brief Determine whether the solver was analyzed for the input pattern.
+ * \param i_rows The number of rows.
+ * \param row_ptr The zero-based CSR row pointer vector.
+ * \param col The zero-based CSR column index vector.
+ * \return true if the pattern is the one analyzed, false if not.
+ */
+
+bool
+SparseLUSolver::hasPattern(
+  size_t i_rows,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col
+) const
+{
+
+  return i_rows == iRows && row_ptr == vRowPtr && col == vCol;
+
+}
+
+//##############################################################################
+// SparseLUSolver::factor().
+//##############################################################################
+
+/**
+ * \brief Compute the numerical LU factorization.
+ * \param values The matrix values in the CSR order of the analyzed pattern.
+ * \return true if the factorization succeeded, false if a zero or
+ *         negligibly small pivot was encountered.
+ */
+
+bool
+SparseLUSolver::factor( const std::vector<double>& values )
+{
+
+  bFactored = false;
+
+  if( values.size() != vCol.size() ) return false;
+
+  std::fill( vLU.begin(), vLU.end(), 0. );
+
+  for( size_t p = 0; p < values.size(); p++ )
+    vLU[vScatter[p]] += values[p];
+
+  return computeNumericalFactorization();
+
+}
+
+/**
+ * \brief Compute the numerical LU factorization of a matrix whose pattern
+ *        may differ from the analyzed one.  Since the network matrix drops
+ *        elements that are zero (for example, because of zero abundances),
+ *        the pattern often shrinks without the network changing.  Any
+ *        pattern contained in the analyzed pattern (including its fill)
+ *        may be factored without a new symbolic analysis.
+ * \param row_ptr The zero-based CSR row pointer vector.
+ * \param col The zero-based CSR column index vector.
+ * \param values The matrix values in the CSR order of the input pattern.
+ * \return true if the factorization succeeded, false if the pattern is
+ *         not contained in the analyzed pattern or if a zero or
+ *         negligibly small pivot was encountered.
+ */
+
+bool
+SparseLUSolver::factor(
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col,
+  const std::vector<double>& values
+)
+{
+
+  if( row_ptr == vRowPtr && col == vCol ) return factor( values );
+
+  bFactored = false;
+
+  if( row_ptr.size() != iRows + 1 || values.size() != col.size() )
+    return false;
+
+  std::fill( vLU.begin(), vLU.end(), 0. );
+
+  for( size_t i_orig = 0; i_orig < iRows; i_orig++ )
+  {
+    size_t i = vInversePerm[i_orig];
+    for( size_t p = row_ptr[i_orig]; p < row_ptr[i_orig+1]; p++ )
+    {
+      std::vector<size_t>::iterator it =
+        std::lower_bound(
+          vLUCol.begin() + vLURowPtr[i],
+          vLUCol.begin() + vLURowPtr[i+1],
+          vInversePerm[col[p]]
+        );
+      if(
+        it == vLUCol.begin() + vLURowPtr[i+1] ||
+        *it != vInversePerm[col[p]]
+      )
+        return false;
+      vLU[it - vLUCol.begin()] += values[p];
+    }
+  }
+
+  return computeNumericalFactorization();
+
+}
+
+//##############################################################################
+// SparseLUSolver::computeNumericalFactorization().
+//##############################################################################
+
+bool
+SparseLUSolver::computeNumericalFactorization()
+{
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+
+    double d_row_max = 0.;
+
+    for( size_t q = vLURowPtr[i]; q < vLURowPtr[i+1]; q++ )
+    {
+      vPosition[vLUCol[q]] = q;
+      if( fabs( vLU[q] ) > d_row_max ) d_row_max = fabs( vLU[q] );
+    }
+
+    for( size_t q = vLURowPtr[i]; q < vLUDiag[i]; q++ )
+    {
+
+      size_t k = vLUCol[q];
+
+      double d_l = vLU[q] / vLU[vLUDiag[k]];
+
+      vLU[q] = d_l;
+
+      if( d_l == 0. ) continue;
+
+      for( size_t s = vLUDiag[k] + 1; s < vLURowPtr[k+1]; s++ )
+        vLU[vPosition[vLUCol[s]]] -= d_l * vLU[s];
+
+    }
+
+    if(
+      !( fabs( vLU[vLUDiag[i]] ) > D_SPARSE_LU_PIVOT_TOL * d_row_max )
+    )
+      return false;
+
+  }
+
+  bFactored = true;
+
+  return true;
+
+}
+
+//##############################################################################
+// SparseLUSolver::solve().
+//##############################################################################
+
+/**
+ * \brief Solve the factored system for a right-hand-side vector.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution.  The caller must
+ *         free it with gsl_vector_free.  Returns NULL if the matrix
+ *         has not been successfully factored.
+ */
+
+gsl_vector *
+SparseLUSolver::solve( const gsl_vector * p_rhs )
+{
+
+  if( !bFactored || p_rhs->size != iRows ) return NULL;
+
+  gsl_vector * p_sol = gsl_vector_alloc( iRows );
+
+  solve( p_rhs, p_sol );
+
+  return p_sol;
+
+}
+
+/**
+ * \brief Solve the factored system into an existing vector.
+ * \param p_rhs The right-hand-side vector.
+ * \param p_sol The vector to hold the solution.  It may not be p_rhs.
+ * \return True if the solution was computed, false if the matrix has not
+ *         been successfully factored or the vectors are of the wrong size.
+ */
+
+bool
+SparseLUSolver::solve( const gsl_vector * p_rhs, gsl_vector * p_sol )
+{
+
+  if( !bFactored || p_rhs->size != iRows || p_sol->size != iRows )
+    return false;
+
+  for( size_t i = 0; i < iRows; i++ )
+    vWork[i] = gsl_vector_get( p_rhs, vPerm[i] );
+
+  for( size_t i = 0; i < iRows; i++ )
+  {
+    double d_sum = vWork[i];
+    for( size_t q = vLURowPtr[i]; q < vLUDiag[i]; q++ )
+      d_sum -= vLU[q] * vWork[vLUCol[q]];
+    vWork[i] = d_sum;
+  }
+
+  for( size_t i = iRows; i-- > 0; )
+  {
+    double d_sum = vWork[i];
+    for( size_t q = vLUDiag[i] + 1; q < vLURowPtr[i+1]; q++ )
+      d_sum -= vLU[q] * vWork[vLUCol[q]];
+    vWork[i] = d_sum / vLU[vLUDiag[i]];
+    gsl_vector_set( p_sol, vPerm[i], vWork[i] );
+  }
+
+  return true;
+
+}
+
+//##############################################################################
+// get_csr_from_wn_matrix().
+//##############################################################################
+
+/**
+ * \brief Retrieve the zero-based CSR form of a WnMatrix.
+ * \param p_matrix A pointer to the WnMatrix.
+ * \param row_ptr The row pointer vector on return.
+ * \param col The column index vector on return.
+ * \param values The value vector on return.
+ */
+
+void
+get_csr_from_wn_matrix(
+  WnMatrix * p_matrix,
+  std::vector<size_t>& row_ptr,
+  std::vector<size_t>& col,
+  std::vector<double>& values
+)
+{
+
+  size_t i_rows = WnMatrix__getNumberOfRows( p_matrix );
+  size_t i_count = WnMatrix__getNumberOfElements( p_matrix );
+
+  row_ptr.assign( i_rows + 1, 0 );
+  col.resize( i_count );
+  values.resize( i_count );
+
+  if( i_count == 0 ) return;
+
+  WnMatrix__Coo * p_coo = WnMatrix__getCoo( p_matrix );
+
+  size_t * a_row = WnMatrix__Coo__getRowVector( p_coo );
+  size_t * a_col = WnMatrix__Coo__getColumnVector( p_coo );
+  double * a_val = WnMatrix__Coo__getValueVector( p_coo );
+
+  for( size_t p = 0; p < i_count; p++ )
+  {
+    row_ptr[a_row[p]]++;
+    col[p] = a_col[p] - 1;
+    values[p] = a_val[p];
+  }
+
+  for( size_t i = 0; i < i_rows; i++ )
+    row_ptr[i+1] += row_ptr[i];
+
+  WnMatrix__Coo__free( p_coo );
+
+}
+
+//##############################################################################
+// sparse_lu_solve().
+//##############################################################################
+
+/**
+ * \brief Solve a matrix equation with the sparse direct LU solver.
+ * \param p_matrix A pointer to the WnMatrix.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution or NULL if the
+ *         factorization failed.
+ */
+
+gsl_vector *
+sparse_lu_solve( WnMatrix * p_matrix, const gsl_vector * p_rhs )
+{
+
+  std::vector<size_t> row_ptr, col;
+  std::vector<double> values;
+
+  get_csr_from_wn_matrix( p_matrix, row_ptr, col, values );
+
+  SparseLUSolver solver(
+    WnMatrix__getNumberOfRows( p_matrix ), row_ptr, col
+  );
+
+  if( !solver.factor( values ) ) return NULL;
+
+  return solver.solve( p_rhs );
+
+}
+
+//##############################################################################
+// sparse_lu_solve_for_zone().
+//##############################################################################
+
+/**
+ * \brief Solve a zone's matrix equation with the sparse direct LU solver,
+ *        reusing the ordering and symbolic factorization stored with the
+ *        zone.  The analysis is redone only if the evolution network view
+ *        has changed or the matrix has elements outside the analyzed
+ *        pattern.
+ * \param zone The zone.
+ * \param i_rows The number of rows in the matrix.
+ * \param row_ptr The zero-based CSR row pointer vector.
+ * \param col The zero-based CSR column index vector.
+ * \param values The matrix values.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution or NULL if the
+ *         factorization failed.
+ */
+
+gsl_vector *
+sparse_lu_solve_for_zone(
+  nnt::Zone& zone,
+  size_t i_rows,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col,
+  const std::vector<double>& values,
+  const gsl_vector * p_rhs
+)
+{
+
+  gsl_vector * p_sol = gsl_vector_alloc( i_rows );
+
+  if(
+    !sparse_lu_solve_for_zone(
+      zone, i_rows, row_ptr, col, values, p_rhs, p_sol
+    )
+  )
+  {
+    gsl_vector_free( p_sol );
+    return NULL;
+  }
+
+  return p_sol;
+
+}
+
+/**
+ * \brief Solve a zone's matrix equation with the sparse direct LU solver
+ *        into an existing vector.
+ * \param zone The zone.
+ * \param i_rows The number of rows in the matrix.
+ * \param row_ptr The zero-based CSR row pointer vector.
+ * \param col The zero-based CSR column index vector.
+ * \param values The matrix values.
+ * \param p_rhs The right-hand-side vector.
+ * \param p_sol The vector to hold the solution.
+ * \return True if the solution was computed, false if the factorization
+ *         failed.
+ */
+
+bool
+sparse_lu_solve_for_zone(
+  nnt::Zone& zone,
+  size_t i_rows,
+  const std::vector<size_t>& row_ptr,
+  const std::vector<size_t>& col,
+  const std::vector<double>& values,
+  const gsl_vector * p_rhs,
+  gsl_vector * p_sol
+)
+{
+
+  Libnucnet__NetView * p_view =
+    Libnucnet__Zone__getEvolutionNetView( zone.getNucnetZone() );
+
+  //============================================================================
+  // Try the cached analysis.
+  //============================================================================
+
+  if( zone.hasData( nnt::s_SPARSE_LU_SOLVER_CACHE ) )
+  {
+
+    sparse_lu_cache_t cache =
+      boost::any_cast<sparse_lu_cache_t>(
+        zone.getData( nnt::s_SPARSE_LU_SOLVER_CACHE )
+      );
+
+    if(
+      cache.first == p_view &&
+      cache.second->getNumberOfRows() == i_rows &&
+      cache.second->factor( row_ptr, col, values )
+    )
+      return cache.second->solve( p_rhs, p_sol );
+
+  }
+
+  //============================================================================
+  // New analysis.
+  //============================================================================
+
+  boost::shared_ptr<SparseLUSolver> p_solver(
+    new SparseLUSolver( i_rows, row_ptr, col )
+  );
+
+  zone.updateData(
+    nnt::s_SPARSE_LU_SOLVER_CACHE,
+    sparse_lu_cache_t( p_view, p_solver )
+  );
+
+  if( !p_solver->factor( values ) ) return false;
+
+  return p_solver->solve( p_rhs, p_sol );
+
+}
+
+/**
+ * \brief Solve a zone's WnMatrix equation with the sparse direct LU solver.
+ * \param zone The zone.
+ * \param p_matrix A pointer to the WnMatrix.
+ * \param p_rhs The right-hand-side vector.
+ * \return A new gsl_vector containing the solution or NULL if the
+ *         factorization failed.
+ */
+
+gsl_vector *
+sparse_lu_solve_for_zone(
+  nnt::Zone& zone,
+  WnMatrix * p_matrix,
+  const gsl_vector * p_rhs
+)
+{
+
+  std::vector<size_t> row_ptr, col;
+  std::vector<double> values;
+
+  get_csr_from_wn_matrix( p_matrix, row_ptr, col, values );
+
+  return
+    sparse_lu_solve_for_zone(
+      zone,
+      WnMatrix__getNumberOfRows( p_matrix ),
+      row_ptr,
+      col,
+      values,
+      p_rhs
+    );
+
+}
+
+} // namespace user
@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the sparse direct LU solver.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPARSE_LU_SOLVER_H
+#define SPARSE_LU_SOLVER_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+#include <set>
+
+#include <boost/shared_ptr.hpp>
+
+#include <WnMatrix.h>
+#include <gsl/gsl_vector.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/string_defs.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for a sparse direct LU solver.
+//##############################################################################
+
+/**
+ * \brief A sparse direct LU solver.
+ *
+ * The solver works on a matrix given in compressed sparse row (CSR) form
+ * with zero-based row pointers and column indices.  The constructor
+ * computes a fill-reducing minimum-degree ordering of the symmetrized
+ * pattern and the symbolic factorization.  The numerical factorization
+ * may then be computed any number of times for matrices with the same
+ * pattern.  Pivots are taken from the (permuted) diagonal, which is
+ * appropriate for the diagonally-dominant network Newton matrices.
+ */
+
+class SparseLUSolver
+{
+
+  public:
+    SparseLUSolver(
+      size_t,
+      const std::vector<size_t>&,
+      const std::vector<size_t>&
+    );
+    bool hasPattern(
+      size_t,
+      const std::vector<size_t>&,
+      const std::vector<size_t>&
+    ) const;
+    bool factor( const std::vector<double>& );
+    bool factor(
+      const std::vector<size_t>&,
+      const std::vector<size_t>&,
+      const std::vector<double>&
+    );
+    gsl_vector * solve( const gsl_vector * );
+    bool solve( const gsl_vector *, gsl_vector * );
+    size_t getNumberOfRows() const { return iRows; }
+    size_t getNumberOfMatrixElements() const { return vCol.size(); }
+    size_t getNumberOfFactorElements() const { return vLUCol.size(); }
+
+  private:
+    size_t iRows;
+    std::vector<size_t> vRowPtr;
+    std::vector<size_t> vCol;
+    std::vector<size_t> vPerm;
+    std::vector<size_t> vInversePerm;
+    std::vector<size_t> vLURowPtr;
+    std::vector<size_t> vLUCol;
+    std::vector<size_t> vLUDiag;
+    std::vector<size_t> vScatter;
+    std::vector<double> vLU;
+    std::vector<double> vWork;
+    std::vector<size_t> vPosition;
+    bool bFactored;
+
+    void computeOrdering();
+    void computeSymbolicFactorization();
+    bool computeNumericalFactorization();
+
+};
+
+//##############################################################################
+// Typedef for the cached solver.  The evolution view is a key to whether
+// the cached analysis is likely to apply.
+//##############################################################################
+
+typedef
+std::pair<Libnucnet__NetView *, boost::shared_ptr<SparseLUSolver> >
+sparse_lu_cache_t;
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+void
+get_csr_from_wn_matrix(
+  WnMatrix *,
+  std::vector<size_t>&,
+  std::vector<size_t>&,
+  std::vector<double>&
+);
+
+gsl_vector *
+sparse_lu_solve( WnMatrix *, const gsl_vector * );
+
+gsl_vector *
+sparse_lu_solve_for_zone(
+  nnt::Zone&,
+  size_t,
+  const std::vector<size_t>&,
+  const std::vector<size_t>&,
+  const std::vector<double>&,
+  const gsl_vector *
+);
+
+bool
+sparse_lu_solve_for_zone(
+  nnt::Zone&,
+  size_t,
+  const std::vector<size_t>&,
+  const std::vector<size_t>&,
+  const std::vector<double>&,
+  const gsl_vector *,
+  gsl_vector *
+);
+
+gsl_vector *
+sparse_lu_solve_for_zone( nnt::Zone&, WnMatrix *, const gsl_vector * );
+
+} // namespace user
+
+#endif // SPARSE_LU_SOLVER_H
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "user/thermo.h"
+#include "user/electron_eos_table.h"
 
 /**
  * @brief A NucNet Tools namespace for extra (potentially user-supplied)
@@ -358,9 +359,15 @@ compute_internal_energy_density( nnt::Zone& zone )
 {
 
   return
-    compute_baryon_internal_energy_density( zone ) +
-    compute_electron_internal_energy_density( zone ) +
-    compute_photon_internal_energy_density( zone );
+    compute_thermo_quantity(
+      zone, nnt::s_INTERNAL_ENERGY_DENSITY, nnt::s_BARYON
+    ) +
+    compute_thermo_quantity(
+      zone, nnt::s_INTERNAL_ENERGY_DENSITY, nnt::s_ELECTRON
+    ) +
+    compute_thermo_quantity(
+      zone, nnt::s_INTERNAL_ENERGY_DENSITY, nnt::s_PHOTON
+    );
 
 }
   
@@ -699,9 +706,9 @@ compute_dPdT( nnt::Zone& zone )
 {
 
   return
-    compute_baryon_dPdT( zone ) +
-    compute_electron_dPdT( zone ) +
-    compute_photon_dPdT( zone );
+    compute_thermo_quantity( zone, nnt::s_DPDT, nnt::s_BARYON ) +
+    compute_thermo_quantity( zone, nnt::s_DPDT, nnt::s_ELECTRON ) +
+    compute_thermo_quantity( zone, nnt::s_DPDT, nnt::s_PHOTON );
 
 }
   
@@ -914,6 +921,8 @@ compute_baryon_specific_heat_per_nucleon( nnt::Zone& zone )
 
   nnt::species_list_t species_list = get_thermo_species_list( zone );
 
+  RateSplineCache * p_cache = get_rate_spline_cache_for_zone( zone );
+
   BOOST_FOREACH( nnt::Species species, species_list )
   {
 
@@ -930,8 +939,9 @@ compute_baryon_specific_heat_per_nucleon( nnt::Zone& zone )
           zone.getProperty<double>( nnt::s_T9 ) *
           GSL_CONST_NUM_GIGA *
           compute_dlnG_dT(
-            species.getNucnetSpecies(), 
-            zone.getProperty<double>( nnt::s_T9 ) * GSL_CONST_NUM_GIGA
+            species.getNucnetSpecies(),
+            zone.getProperty<double>( nnt::s_T9 ) * GSL_CONST_NUM_GIGA,
+            p_cache
           )
         )
       );
@@ -1052,9 +1062,15 @@ compute_specific_heat_per_nucleon( nnt::Zone& zone )
 {
 
   return
-    compute_baryon_specific_heat_per_nucleon( zone ) +
-    compute_electron_specific_heat_per_nucleon( zone ) +
-    compute_photon_specific_heat_per_nucleon( zone );
+    compute_thermo_quantity(
+      zone, nnt::s_SPECIFIC_HEAT_PER_NUCLEON, nnt::s_BARYON
+    ) +
+    compute_thermo_quantity(
+      zone, nnt::s_SPECIFIC_HEAT_PER_NUCLEON, nnt::s_ELECTRON
+    ) +
+    compute_thermo_quantity(
+      zone, nnt::s_SPECIFIC_HEAT_PER_NUCLEON, nnt::s_PHOTON
+    );
 
 }
   
@@ -1066,6 +1082,13 @@ void
 assign_default_thermo_functions( nnt::Zone& zone )
 {
 
+  //============================================================================
+  // The electron quantities are interpolated from the electron EOS table if
+  // the zone requests it.
+  //============================================================================
+
+  bool b_table = is_using_electron_eos_table( zone );
+
   //============================================================================
   // Pressure.
   //============================================================================
@@ -1087,7 +1110,9 @@ assign_default_thermo_functions( nnt::Zone& zone )
     zone.updateFunction(
       nnt::char_cat( nnt::s_ELECTRON, nnt::s_PRESSURE ),
       static_cast<boost::function<double( nnt::Zone& )> >(
-        compute_electron_pressure
+        b_table ?
+          compute_tabulated_electron_pressure :
+          compute_electron_pressure
       ),
       "The electron pressure in dynes / cm^2.",
       nnt::s_THERMO
@@ -1147,7 +1172,9 @@ assign_default_thermo_functions( nnt::Zone& zone )
     zone.updateFunction(
       nnt::char_cat( nnt::s_ELECTRON, nnt::s_ENTROPY_PER_NUCLEON ),
       static_cast<boost::function<double( nnt::Zone& )> >(
-        compute_electron_entropy_per_nucleon
+        b_table ?
+          compute_tabulated_electron_entropy_per_nucleon :
+          compute_electron_entropy_per_nucleon
       ),
       "The electron entropy per nucleon in units of Boltzmann's constant.",
       nnt::s_THERMO
@@ -1207,7 +1234,9 @@ assign_default_thermo_functions( nnt::Zone& zone )
     zone.updateFunction(
       nnt::char_cat( nnt::s_ELECTRON, nnt::s_DPDT ),
       static_cast<boost::function<double( nnt::Zone& )> >(
-        compute_electron_dPdT
+        b_table ?
+          compute_tabulated_electron_dPdT :
+          compute_electron_dPdT
       ),
       "The derivative of electron pressure with respect to temperature (in dynes per cm^2 per Kelvin",
       nnt::s_THERMO
@@ -1267,7 +1296,9 @@ assign_default_thermo_functions( nnt::Zone& zone )
     zone.updateFunction(
       nnt::char_cat( nnt::s_ELECTRON, nnt::s_SPECIFIC_HEAT_PER_NUCLEON ),
       static_cast<boost::function<double( nnt::Zone& )> >(
-        compute_electron_specific_heat_per_nucleon
+        b_table ?
+          compute_tabulated_electron_specific_heat_per_nucleon :
+          compute_electron_specific_heat_per_nucleon
       ),
       "The electron specific heat per nucleon in units of Boltzmann's constant.",
       nnt::s_THERMO
@@ -1335,7 +1366,9 @@ assign_default_thermo_functions( nnt::Zone& zone )
     zone.updateFunction(
       nnt::char_cat( nnt::s_ELECTRON, nnt::s_INTERNAL_ENERGY_DENSITY ),
       static_cast<boost::function<double( nnt::Zone& )> >(
-        compute_electron_internal_energy_density
+        b_table ?
+          compute_tabulated_electron_internal_energy_density :
+          compute_electron_internal_energy_density
       ),
       "The electron internal energy density in ergs per cm^3.",
       nnt::s_THERMO
@@ -1387,7 +1420,9 @@ assign_default_thermo_functions( nnt::Zone& zone )
     zone.updateFunction(
       nnt::char_cat( nnt::s_ELECTRON, nnt::s_CHEMICAL_POTENTIAL_KT ),
       static_cast<boost::function<double( nnt::Zone& )> >(
-        compute_electron_chemical_potential_kT
+        b_table ?
+          compute_tabulated_electron_chemical_potential_kT :
+          compute_electron_chemical_potential_kT
       ),
       "The electron chemical potential (less rest mass) divided by kT.",
       nnt::s_THERMO
@@ -1409,7 +1444,9 @@ assign_default_thermo_functions( nnt::Zone& zone )
         nnt::s_T_DERIVATIVE_CHEMICAL_POTENTIAL_KT
       ),
       static_cast<boost::function<double( nnt::Zone& )> >(
-        compute_electron_chemical_potential_kT_temperature_derivative
+        b_table ?
+          compute_tabulated_electron_chemical_potential_kT_temperature_derivative :
+          compute_electron_chemical_potential_kT_temperature_derivative
       ),
       "The temperature derivative of the electron chemical potential (less rest mass) divided by kT (in units of K^-1).",
       nnt::s_THERMO
@@ -1698,8 +1735,8 @@ double dS_dT_at_constant_pressure(
   return
     compute_thermo_quantity(
       zone,
-      nnt::s_TOTAL,
-      nnt::s_ENTROPY_PER_NUCLEON
+      nnt::s_ENTROPY_PER_NUCLEON,
+      nnt::s_TOTAL
     );
 
 }
@@ -1721,7 +1758,7 @@ compute_log10_rho_pressure_root(
   );
 
   double d_result =
-    compute_pressure( zone )
+    compute_thermo_quantity( zone, nnt::s_PRESSURE, nnt::s_TOTAL )
     -
     zone.getProperty<double>( nnt::s_PRESSURE );
 
@@ -1800,7 +1837,8 @@ double dP_drho(
     d_t9 
   );
 
-  double d_result = compute_pressure( zone );
+  double d_result =
+    compute_thermo_quantity( zone, nnt::s_PRESSURE, nnt::s_TOTAL );
 
   zone.updateProperty( nnt::s_T9, s_t9 );
 
@@ -1815,7 +1853,8 @@ double dP_drho(
 double
 compute_dlnG_dT(
   Libnucnet__Species * p_species,
-  double d_T
+  double d_T,
+  RateSplineCache * p_cache
 )
 {
 
@@ -1824,7 +1863,8 @@ compute_dlnG_dT(
       boost::bind(
         compute_lnG,
         _1,
-        p_species
+        p_species,
+        p_cache
       ),
       d_T
     );
@@ -1836,9 +1876,19 @@ compute_dlnG_dT(
 //##############################################################################
 
 double
-compute_lnG( double d_T, Libnucnet__Species * p_species )
+compute_lnG(
+  double d_T,
+  Libnucnet__Species * p_species,
+  RateSplineCache * p_cache
+)
 {
 
+  if( p_cache )
+    return
+      log(
+        p_cache->computePartitionFunction( p_species, d_T / GSL_CONST_NUM_GIGA )
+      );
+
   return
     log(
       Libnucnet__Species__computePartitionFunction(
@@ -42,6 +42,8 @@
 #include "nnt/auxiliary.h"
 #include "nnt/math.h"
 
+#include "user/rate_spline_cache.h"
+
 namespace user
 {
 
@@ -155,10 +157,10 @@ compute_log10_density_entropy_root_with_equilibrium(
 );
 
 double
-compute_dlnG_dT( Libnucnet__Species *, double );
+compute_dlnG_dT( Libnucnet__Species *, double, RateSplineCache * = NULL );
 
 double
-compute_lnG( double, Libnucnet__Species * );
+compute_lnG( double, Libnucnet__Species *, RateSplineCache * = NULL );
 
 double
 dP_drho( double, nnt::Zone& );
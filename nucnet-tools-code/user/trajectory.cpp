@@ -0,0 +1,323 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for interpolating thermodynamic trajectories.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/trajectory.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// Trajectory::Trajectory().
+//##############################################################################
+
+/**
+ * \brief Copy a trajectory and build its interpolants.
+ * \param s_type The interpolation type ("spline" or "linear").
+ * \param time The times, in increasing order.
+ * \param t9 The t9 values at the times.
+ * \param log10_rho The log10 of the mass densities (g/cc) at the times.
+ */
+
+Trajectory::Trajectory(
+  const std::string& s_type,
+  const std::vector<double>& time,
+  const std::vector<double>& t9,
+  const std::vector<double>& log10_rho
+) : sType( s_type ), vTime( time ), vT9( t9 ), vLog10Rho( log10_rho )
+{
+
+  const gsl_interp_type * p_type;
+
+  if( s_type != "spline" && s_type != "linear" )
+  {
+    std::cerr << "Invalid interpolation type." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  if(
+    vTime.empty() ||
+    vT9.size() != vTime.size() ||
+    vLog10Rho.size() != vTime.size()
+  )
+  {
+    std::cerr << "Invalid trajectory." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  pT9Spline = NULL;
+  pLog10RhoSpline = NULL;
+
+  if( vTime.size() < 2 ) return;
+
+  if( s_type == "spline" && vTime.size() > 2 )
+    p_type = gsl_interp_cspline;
+  else
+    p_type = gsl_interp_linear;
+
+  pT9Spline = gsl_spline_alloc( p_type, vTime.size() );
+  gsl_spline_init( pT9Spline, &vTime[0], &vT9[0], vTime.size() );
+
+  pLog10RhoSpline = gsl_spline_alloc( p_type, vTime.size() );
+  gsl_spline_init( pLog10RhoSpline, &vTime[0], &vLog10Rho[0], vTime.size() );
+
+}
+
+//##############################################################################
+// Trajectory::~Trajectory().
+//##############################################################################
+
+Trajectory::~Trajectory()
+{
+
+  if( pT9Spline ) gsl_spline_free( pT9Spline );
+  if( pLog10RhoSpline ) gsl_spline_free( pLog10RhoSpline );
+
+}
+
+//##############################################################################
+// Trajectory::isValidFor().
+//##############################################################################
+
+/**
+ * \brief Check whether the trajectory was built from the input data.
+ * \param s_type The interpolation type.
+ * \param time The times.
+ * \param t9 The t9 values.
+ * \param log10_rho The log10 densities.
+ * \return True if the data are the same as those the trajectory was built
+ *         from, false if not.  The contents are always compared, since
+ *         the caller's vectors may have been modified in place.
+ */
+
+bool
+Trajectory::isValidFor(
+  const std::string& s_type,
+  const std::vector<double>& time,
+  const std::vector<double>& t9,
+  const std::vector<double>& log10_rho
+) const
+{
+
+  if(
+    s_type != sType ||
+    time.size() != vTime.size() ||
+    t9.size() != vT9.size() ||
+    log10_rho.size() != vLog10Rho.size()
+  )
+    return false;
+
+  return time == vTime && t9 == vT9 && log10_rho == vLog10Rho;
+
+}
+
+//##############################################################################
+// Trajectory::computeT9().
+//##############################################################################
+
+/**
+ * \brief Interpolate t9 at a time.
+ * \param d_time The time.
+ * \param p_acc The caller's accelerator.
+ * \return The t9.
+ */
+
+double
+Trajectory::computeT9( double d_time, gsl_interp_accel * p_acc ) const
+{
+
+  if( d_time < vTime.front() ) return vT9.front();
+
+  if( d_time >= vTime.back() ) return vT9.back();
+
+  return gsl_spline_eval( pT9Spline, d_time, p_acc );
+
+}
+
+//##############################################################################
+// Trajectory::computeRho().
+//##############################################################################
+
+/**
+ * \brief Interpolate the mass density at a time.
+ * \param d_time The time.
+ * \param p_acc The caller's accelerator.
+ * \return The mass density (g/cc).
+ */
+
+double
+Trajectory::computeRho( double d_time, gsl_interp_accel * p_acc ) const
+{
+
+  if( d_time < vTime.front() ) return pow( 10., vLog10Rho.front() );
+
+  if( d_time >= vTime.back() ) return pow( 10., vLog10Rho.back() );
+
+  return pow( 10., gsl_spline_eval( pLog10RhoSpline, d_time, p_acc ) );
+
+}
+
+//##############################################################################
+// TrajectoryInterpolator::TrajectoryInterpolator().
+//##############################################################################
+
+/**
+ * \brief Create the interpolation state for a trajectory.
+ * \param p_trajectory The trajectory.
+ */
+
+TrajectoryInterpolator::TrajectoryInterpolator(
+  boost::shared_ptr<Trajectory> p_trajectory
+) : pTrajectory( p_trajectory ), bHasLast( false ), dLastT9( 0. ),
+    dLastRho( 0. )
+{
+
+  pAcc = gsl_interp_accel_alloc();
+
+}
+
+//##############################################################################
+// TrajectoryInterpolator::~TrajectoryInterpolator().
+//##############################################################################
+
+TrajectoryInterpolator::~TrajectoryInterpolator()
+{
+
+  gsl_interp_accel_free( pAcc );
+
+}
+
+//##############################################################################
+// TrajectoryInterpolator::setLast().
+//##############################################################################
+
+/**
+ * \brief Record the t9 and density last set in the zone.
+ * \param d_t9 The t9.
+ * \param d_rho The mass density (g/cc).
+ */
+
+void
+TrajectoryInterpolator::setLast( double d_t9, double d_rho )
+{
+
+  dLastT9 = d_t9;
+  dLastRho = d_rho;
+  bHasLast = true;
+
+}
+
+//##############################################################################
+// get_trajectory_interpolator().
+//##############################################################################
+
+/**
+ * \brief Retrieve a zone's interpolator for a trajectory.
+ * \param zone The zone.
+ * \param p_trajectory The trajectory.
+ * \return A shared pointer to the interpolator stored with the zone.  A new
+ *         interpolator is stored if the zone has none for the trajectory;
+ *         it keeps the t9 and density last set in the zone.
+ */
+
+boost::shared_ptr<TrajectoryInterpolator>
+get_trajectory_interpolator(
+  nnt::Zone& zone,
+  boost::shared_ptr<Trajectory> p_trajectory
+)
+{
+
+  boost::shared_ptr<TrajectoryInterpolator> p_old;
+
+  if( zone.hasData( nnt::s_TRAJECTORY_INTERPOLATOR ) )
+  {
+
+    p_old =
+      boost::any_cast<boost::shared_ptr<TrajectoryInterpolator> >(
+        zone.getData( nnt::s_TRAJECTORY_INTERPOLATOR )
+      );
+
+    if( p_old->getTrajectory() == p_trajectory ) return p_old;
+
+  }
+
+  boost::shared_ptr<TrajectoryInterpolator> p_interpolator(
+    new TrajectoryInterpolator( p_trajectory )
+  );
+
+  if( p_old && p_old->hasLast() )
+    p_interpolator->setLast( p_old->getLastT9(), p_old->getLastRho() );
+
+  zone.updateData( nnt::s_TRAJECTORY_INTERPOLATOR, p_interpolator );
+
+  return p_interpolator;
+
+}
+
+/**
+ * \brief Retrieve a zone's interpolator for trajectory data.  The
+ *        trajectory is only built when the zone has no interpolator or the
+ *        data differ from those of the zone's trajectory.
+ * \param zone The zone.
+ * \param s_type The interpolation type ("spline" or "linear").
+ * \param time The times.
+ * \param t9 The t9 values.
+ * \param log10_rho The log10 densities.
+ * \return A shared pointer to the interpolator stored with the zone.
+ */
+
+boost::shared_ptr<TrajectoryInterpolator>
+get_trajectory_interpolator(
+  nnt::Zone& zone,
+  const std::string& s_type,
+  const std::vector<double>& time,
+  const std::vector<double>& t9,
+  const std::vector<double>& log10_rho
+)
+{
+
+  if( zone.hasData( nnt::s_TRAJECTORY_INTERPOLATOR ) )
+  {
+
+    boost::shared_ptr<TrajectoryInterpolator> p_interpolator =
+      boost::any_cast<boost::shared_ptr<TrajectoryInterpolator> >(
+        zone.getData( nnt::s_TRAJECTORY_INTERPOLATOR )
+      );
+
+    if(
+      p_interpolator->getTrajectory()->isValidFor(
+        s_type, time, t9, log10_rho
+      )
+    )
+      return p_interpolator;
+
+  }
+
+  boost::shared_ptr<Trajectory> p_trajectory(
+    new Trajectory( s_type, time, t9, log10_rho )
+  );
+
+  return get_trajectory_interpolator( zone, p_trajectory );
+
+}
+
+} // namespace user
@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for interpolating thermodynamic trajectories.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <gsl/gsl_spline.h>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/string_defs.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for a trajectory.
+//##############################################################################
+
+/**
+ * \brief A time, t9, and log10 rho trajectory with its interpolants built
+ *        once.
+ *
+ * The interpolation is "spline" (a natural cubic spline, as in
+ * nnt::spline_interpolation()) or "linear".  A linear interpolant is used
+ * for a spline trajectory with fewer than three points.  The end values are
+ * returned outside the trajectory.  The trajectory is not modified once
+ * built, so it may be shared between zones and threads; each caller
+ * supplies its own accelerator, which keeps the current interval so that
+ * evaluations at increasing times are found without a search.
+ */
+
+class Trajectory : private boost::noncopyable
+{
+
+  public:
+    Trajectory(
+      const std::string&,
+      const std::vector<double>&,
+      const std::vector<double>&,
+      const std::vector<double>&
+    );
+    ~Trajectory();
+    bool isValidFor(
+      const std::string&,
+      const std::vector<double>&,
+      const std::vector<double>&,
+      const std::vector<double>&
+    ) const;
+    size_t getNumberOfPoints() const { return vTime.size(); }
+    double computeT9( double, gsl_interp_accel * ) const;
+    double computeRho( double, gsl_interp_accel * ) const;
+
+  private:
+    std::string sType;
+    std::vector<double> vTime, vT9, vLog10Rho;
+    gsl_spline * pT9Spline, * pLog10RhoSpline;
+
+};
+
+//##############################################################################
+// Class for a zone's trajectory interpolator.
+//##############################################################################
+
+/**
+ * \brief The per-zone state for interpolating a trajectory: the
+ *        accelerator and the t9 and density last set in the zone.  The
+ *        interpolator is stored with the zone, so zones evolved on
+ *        different threads do not share state.
+ */
+
+class TrajectoryInterpolator : private boost::noncopyable
+{
+
+  public:
+    TrajectoryInterpolator( boost::shared_ptr<Trajectory> );
+    ~TrajectoryInterpolator();
+    boost::shared_ptr<Trajectory> getTrajectory() const { return pTrajectory; }
+    double computeT9( double d_time ) const
+      { return pTrajectory->computeT9( d_time, pAcc ); }
+    double computeRho( double d_time ) const
+      { return pTrajectory->computeRho( d_time, pAcc ); }
+    bool hasLast() const { return bHasLast; }
+    double getLastT9() const { return dLastT9; }
+    double getLastRho() const { return dLastRho; }
+    void setLast( double, double );
+
+  private:
+    boost::shared_ptr<Trajectory> pTrajectory;
+    gsl_interp_accel * pAcc;
+    bool bHasLast;
+    double dLastT9, dLastRho;
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+boost::shared_ptr<TrajectoryInterpolator>
+get_trajectory_interpolator( nnt::Zone&, boost::shared_ptr<Trajectory> );
+
+boost::shared_ptr<TrajectoryInterpolator>
+get_trajectory_interpolator(
+  nnt::Zone&,
+  const std::string&,
+  const std::vector<double>&,
+  const std::vector<double>&,
+  const std::vector<double>&
+);
+
+} // namespace user
+
+#endif // TRAJECTORY_H
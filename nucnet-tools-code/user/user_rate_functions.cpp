@@ -54,6 +54,18 @@ void
 register_rate_functions( Libnucnet__Reac *p_reac )
 {
 
+  //============================================================================
+  // Register the cached rate-table function.
+  //============================================================================
+
+  register_rate_spline_cache( p_reac );
+
+  //============================================================================
+  // Register the compiled non-smoker fit rate function.
+  //============================================================================
+
+  register_non_smoker_rate_kernel( p_reac );
+
   //============================================================================
   // Register two-d weak rates and set deallocator.
   //============================================================================
@@ -192,8 +204,8 @@ update_approximate_weak_rate_functions_data(
   Libnucnet__Zone *p_zone,
   double d_electron_mass,
   double d_eta_F,
-  double d_mu_nue_kT
-
+  double d_mu_nue_kT,
+  Aa522a25PhaseSpaceTables * p_tables
 )
 {
 
@@ -202,6 +214,7 @@ update_approximate_weak_rate_functions_data(
     double dElectronMassMeV;
     double dEtaF;
     double dMuNuekT;
+    Aa522a25PhaseSpaceTables * pTables;
   } work;
 
   work * p_work;
@@ -222,6 +235,7 @@ update_approximate_weak_rate_functions_data(
   p_work->dElectronMassMeV = d_electron_mass;
   p_work->dEtaF = d_eta_F;
   p_work->dMuNuekT = d_mu_nue_kT;
+  p_work->pTables = p_tables;
 
   //============================================================================
   // Set data for approximate electron capture reaction.
@@ -235,6 +249,76 @@ update_approximate_weak_rate_functions_data(
 
 }
 
+//##############################################################################
+// is_using_approximate_weak_rate_table().
+//##############################################################################
+
+/**
+ * \brief Check whether a zone interpolates the approximate weak rates and
+ *        their neutrino energy-loss rates from phase-space tables.
+ * \param zone The zone.
+ * \return True if the zone's use approximate weak rate table property is
+ *         "yes", false if not.
+ */
+
+bool
+is_using_approximate_weak_rate_table( nnt::Zone& zone )
+{
+
+  return
+    zone.hasProperty( nnt::s_USE_APPROXIMATE_WEAK_RATE_TABLE ) &&
+    zone.getProperty<std::string>( nnt::s_USE_APPROXIMATE_WEAK_RATE_TABLE )
+      == "yes";
+
+}
+
+//##############################################################################
+// get_approximate_weak_rate_tables_for_zone().
+//##############################################################################
+
+/**
+ * \brief Retrieve the approximate weak rate phase-space tables of a zone.
+ * \param zone The zone.
+ * \param d_electron_mass The electron rest mass (MeV).
+ * \return A pointer to the tables, or NULL if the zone does not use them.
+ *         The zone owns the tables, which are created anew only when the
+ *         zone's network is updated.
+ */
+
+Aa522a25PhaseSpaceTables *
+get_approximate_weak_rate_tables_for_zone(
+  nnt::Zone& zone,
+  double d_electron_mass
+)
+{
+
+  if( !is_using_approximate_weak_rate_table( zone ) ) return NULL;
+
+  Libnucnet__Net * p_net = Libnucnet__Zone__getNet( zone.getNucnetZone() );
+
+  if( zone.hasData( nnt::s_APPROXIMATE_WEAK_RATE_TABLES ) )
+  {
+
+    boost::shared_ptr<Aa522a25PhaseSpaceTables> p_tables =
+      boost::any_cast<boost::shared_ptr<Aa522a25PhaseSpaceTables> >(
+        zone.getData( nnt::s_APPROXIMATE_WEAK_RATE_TABLES )
+      );
+
+    if( p_tables->isValidFor( p_net, d_electron_mass ) )
+      return p_tables.get();
+
+  }
+
+  boost::shared_ptr<Aa522a25PhaseSpaceTables> p_tables(
+    new Aa522a25PhaseSpaceTables( p_net, d_electron_mass )
+  );
+
+  zone.updateData( nnt::s_APPROXIMATE_WEAK_RATE_TABLES, p_tables );
+
+  return p_tables.get();
+
+}
+
 //##############################################################################
 // update_rate_functions_data().
 //##############################################################################
@@ -309,7 +393,11 @@ update_rate_functions_data(
       zone.getNucnetZone(),
       Libstatmech__Fermion__getRestMass( p_electron ),
       d_eta_F,
-      d_mu_nue_kT
+      d_mu_nue_kT,
+      get_approximate_weak_rate_tables_for_zone(
+        zone,
+        Libstatmech__Fermion__getRestMass( p_electron )
+      )
     );
 
     zone.updateProperty(
@@ -328,6 +416,10 @@ update_rate_functions_data(
 
   update_neutrino_rate_functions_data( zone );
 
+  update_rate_spline_cache_data( zone );
+
+  update_non_smoker_rate_kernel_data( zone );
+
 }
 
 //##############################################################################
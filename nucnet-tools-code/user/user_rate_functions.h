@@ -34,6 +34,8 @@
 #include "nnt/string_defs.h"
 
 #include "user/neutrino_rate_functions.h"
+#include "user/rate_spline_cache.h"
+#include "user/non_smoker_rate_kernel.h"
 #include "user/thermo.h"
 #include "user/weak_utilities.h"
 
@@ -64,9 +66,16 @@ update_approximate_weak_rate_functions_data(
   Libnucnet__Zone *,
   double,
   double,
-  double
+  double,
+  Aa522a25PhaseSpaceTables * = NULL
 );
 
+bool
+is_using_approximate_weak_rate_table( nnt::Zone& );
+
+Aa522a25PhaseSpaceTables *
+get_approximate_weak_rate_tables_for_zone( nnt::Zone&, double );
+
 void
 update_rate_functions_data(
   nnt::Zone &
@@ -181,28 +181,28 @@ set_weak_views_in_zones(
   Libnucnet__NetView * p_view_bm, * p_view_bp, * p_view_ec, * p_view_pc;
 
   p_view_bm =
-    Libnucnet__NetView__new(
+    nnt::new_net_view(
       Libnucnet__getNet( p_nucnet ),
       "",
       nnt::s_BETA_MINUS_XPATH
     );
 
   p_view_bp =
-    Libnucnet__NetView__new(
+    nnt::new_net_view(
       Libnucnet__getNet( p_nucnet ),
       "",
       nnt::s_BETA_PLUS_XPATH
     );
 
   p_view_ec =
-    Libnucnet__NetView__new(
+    nnt::new_net_view(
       Libnucnet__getNet( p_nucnet ),
       "",
       nnt::s_ELECTRON_CAPTURE_XPATH
     );
 
   p_view_pc =
-    Libnucnet__NetView__new(
+    nnt::new_net_view(
       Libnucnet__getNet( p_nucnet ),
       "",
       nnt::s_POSITRON_CAPTURE_XPATH
@@ -359,6 +359,7 @@ compute_approximate_neutrino_entropy_loss_rate(
 
   Libnucnet__NetView * p_view;
   Libstatmech__Fermion * p_electron;
+  Aa522a25PhaseSpaceTables * p_tables;
   double d_eta_F, d_result = 0, d_entropy_flow;
 
   p_view =
@@ -380,6 +381,12 @@ compute_approximate_neutrino_entropy_loss_rate(
       -1.
     );
 
+  p_tables =
+    get_approximate_weak_rate_tables_for_zone(
+      zone,
+      Libstatmech__Fermion__getRestMass( p_electron )
+    );
+
   d_eta_F =
     compute_thermo_quantity(
       zone,
@@ -414,16 +421,17 @@ compute_approximate_neutrino_entropy_loss_rate(
 
       d_entropy_flow =
         aa522a25__compute_reaction_neutrino_energy_loss_rate(
-	  r.getNucnetReaction(),
-	  Libnucnet__Zone__getNet( zone.getNucnetZone() ),
-	  Libstatmech__Fermion__getRestMass( p_electron ),
-	  zone.getProperty<double>( nnt::s_T9 ),
-	  d_eta_F,
+          r.getNucnetReaction(),
+          Libnucnet__Zone__getNet( zone.getNucnetZone() ),
+          Libstatmech__Fermion__getRestMass( p_electron ),
+          zone.getProperty<double>( nnt::s_T9 ),
+          d_eta_F,
           compute_thermo_quantity(
             zone,
             nnt::s_CHEMICAL_POTENTIAL_KT,
             nnt::s_NEUTRINO_E
-          )
+          ),
+          p_tables
         );
 
       BOOST_FOREACH( nnt::ReactionElement reactant, reactant_list )
@@ -491,6 +499,7 @@ compute_neutrino_energy_loss_rate(
 
   Libnucnet__NetView * p_view;
   Libstatmech__Fermion * p_electron;
+  Aa522a25PhaseSpaceTables * p_tables;
   double d_eta_F, d_energy_flow, d_result = 0.;
 
   //============================================================================
@@ -524,6 +533,12 @@ compute_neutrino_energy_loss_rate(
       -1.
     );
 
+  p_tables =
+    get_approximate_weak_rate_tables_for_zone(
+      zone,
+      Libstatmech__Fermion__getRestMass( p_electron )
+    );
+
   zone.updateProperty(
     nnt::s_YE,
     Libnucnet__Zone__computeZMoment( zone.getNucnetZone(), 1 )
@@ -578,7 +593,8 @@ compute_neutrino_energy_loss_rate(
             nnt::s_CHEMICAL_POTENTIAL_KT,
             nnt::s_NEUTRINO_E
           ),
-          d_eta_F
+          d_eta_F,
+          p_tables
         );
 
       BOOST_FOREACH( nnt::ReactionElement reactant, reactant_list )
@@ -623,7 +639,8 @@ compute_reaction_neutrino_energy_loss_rate(
   double d_t9,
   double d_rhoe,
   double d_mu_nue_kT,
-  double d_eta_F
+  double d_eta_F,
+  Aa522a25PhaseSpaceTables * p_tables
 )
 {
 
@@ -715,10 +732,11 @@ compute_reaction_neutrino_energy_loss_rate(
       aa522a25__compute_reaction_neutrino_energy_loss_rate(
         p_reaction,
         p_net,
-        d_electron_mass, 
+        d_electron_mass,
         d_t9,
         d_eta_F,
-        d_mu_nue_kT
+        d_mu_nue_kT,
+        p_tables
       );
 
     return d_energy_loss_rate;
@@ -747,8 +765,9 @@ compute_approximate_neutrino_entropy_loss_rate(
   Libnucnet__NetView * p_view;
   double d_result = 0.;
   std::pair< double, double > flows;
-  double d_kT, d_eta_F;
+  double d_kT, d_eta_F, d_average_energy;
   Libstatmech__Fermion * p_electron;
+  Aa522a25PhaseSpaceTables * p_tables;
 
   //============================================================================
   // Check that neutrinos lost.
@@ -784,6 +803,12 @@ compute_approximate_neutrino_entropy_loss_rate(
       -1.
     );
 
+  p_tables =
+    get_approximate_weak_rate_tables_for_zone(
+      zone,
+      Libstatmech__Fermion__getRestMass( p_electron )
+    );
+
   d_eta_F =
     compute_thermo_quantity(
       zone,
@@ -825,8 +850,7 @@ compute_approximate_neutrino_entropy_loss_rate(
     )
     {
 
-      d_result +=
-        flows.first *
+      d_average_energy =
         aa522a25__compute_reaction_average_neutrino_energy(
           reaction.getNucnetReaction(),
           Libnucnet__Zone__getNet( zone.getNucnetZone() ),
@@ -837,8 +861,11 @@ compute_approximate_neutrino_entropy_loss_rate(
             zone,
             nnt::s_CHEMICAL_POTENTIAL_KT,
             nnt::s_NEUTRINO_E
-          )
-        ) / d_kT;
+          ),
+          p_tables
+        );
+
+      d_result += flows.first * d_average_energy / d_kT;
 
     }
 
@@ -1231,6 +1258,7 @@ approximate_weak_rate_function(
     double dElectronMassMeV;
     double dEtaF;
     double dMuNuekT;
+    Aa522a25PhaseSpaceTables * pTables;
   } work;
 
   double d_result;
@@ -1252,7 +1280,8 @@ approximate_weak_rate_function(
       p_work->dElectronMassMeV,
       d_t9,
       p_work->dEtaF,
-      p_work->dMuNuekT
+      p_work->dMuNuekT,
+      p_work->pTables
     );
 
   correct_for_weak_lab_rate( p_reaction, d_t9, d_result );
@@ -1554,8 +1583,8 @@ set_weak_detailed_balance( nnt::Zone& zone )
     )
     {       
 
-      Libnucnet__Zone__getRatesForReaction(
-	zone.getNucnetZone(),
+      get_rates_for_reaction(
+	zone,
 	reaction.getNucnetReaction(),
 	&d_forward,
 	&d_reverse
@@ -1584,8 +1613,8 @@ set_weak_detailed_balance( nnt::Zone& zone )
 	d_reverse = 0.;
       }
 
-      Libnucnet__Zone__updateRatesForReaction(
-	zone.getNucnetZone(),
+      update_rates_for_reaction(
+	zone,
 	reaction.getNucnetReaction(),
 	d_forward,
 	d_reverse
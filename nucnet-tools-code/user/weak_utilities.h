@@ -39,10 +39,12 @@
 #include "nnt/iter.h"
 #include "nnt/math.h"
 #include "nnt/two_d_weak_rates.h"
+#include "nnt/view_selector.h"
 
 #include "user/user_rate_functions.h"
 #include "user/flow_utilities.h"
 #include "user/thermo.h"
+#include "user/zone_rates.h"
 
 namespace user
 {
@@ -103,7 +105,8 @@ compute_reaction_neutrino_energy_loss_rate(
   double,
   double,
   double,
-  double
+  double,
+  Aa522a25PhaseSpaceTables * = NULL
 );
 
 double 
@@ -0,0 +1,443 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the dense zone abundance arrays.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "user/zone_abundances.h"
+
+//##############################################################################
+// Defines.
+//##############################################################################
+
+#define D_TIME_STEP_TINY  1.e-300
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// ZoneAbundances::ZoneAbundances().
+//##############################################################################
+
+/**
+ * \brief Index the species of a zone's nuclide collection and allocate the
+ *        arrays.  The arrays are zero until read.
+ * \param p_zone The zone.
+ */
+
+ZoneAbundances::ZoneAbundances( Libnucnet__Zone * p_zone )
+{
+
+  pNuc = Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) );
+  iNucUpdate = pNuc->iUpdate;
+
+  size_t i_species = Libnucnet__Nuc__getNumberOfSpecies( pNuc );
+
+  vSpecies.resize( i_species );
+  vA.resize( i_species );
+  vZ.resize( i_species );
+
+  BOOST_FOREACH( nnt::Species species, nnt::make_species_list( pNuc ) )
+  {
+    size_t i = Libnucnet__Species__getIndex( species.getNucnetSpecies() );
+    vSpecies[i] = species.getNucnetSpecies();
+    vA[i] = Libnucnet__Species__getA( species.getNucnetSpecies() );
+    vZ[i] = Libnucnet__Species__getZ( species.getNucnetSpecies() );
+  }
+
+  vAbundances.assign( i_species, 0. );
+  vAbundanceChanges.assign( i_species, 0. );
+
+  bAbundancesChanged = false;
+
+}
+
+//##############################################################################
+// ZoneAbundances::isValidFor().
+//##############################################################################
+
+/**
+ * \brief Check whether the species indexing applies to a zone.
+ * \param p_zone The zone.
+ * \return True if the zone's nuclide collection is the one the arrays were
+ *         indexed for and has not changed since, false if not.
+ */
+
+bool
+ZoneAbundances::isValidFor( Libnucnet__Zone * p_zone ) const
+{
+
+  Libnucnet__Nuc * p_nuc =
+    Libnucnet__Net__getNuc( Libnucnet__Zone__getNet( p_zone ) );
+
+  return
+    p_nuc == pNuc &&
+    p_nuc->iUpdate == iNucUpdate &&
+    Libnucnet__Nuc__getNumberOfSpecies( p_nuc ) == vSpecies.size();
+
+}
+
+//##############################################################################
+// ZoneAbundances::read().
+//##############################################################################
+
+void
+ZoneAbundances::read(
+  Libnucnet__Zone * p_zone,
+  xmlHashTablePtr p_hash,
+  std::vector<double>& v
+)
+{
+
+  if( !isValidFor( p_zone ) )
+  {
+    std::cerr << "Zone abundance arrays do not apply to zone." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  for( size_t i = 0; i < vSpecies.size(); i++ )
+  {
+    double * p_value =
+      (double *)
+      xmlHashLookup(
+        p_hash,
+        (const xmlChar *) Libnucnet__Species__getName( vSpecies[i] )
+      );
+    v[i] = p_value ? *p_value : 0.;
+  }
+
+}
+
+//##############################################################################
+// ZoneAbundances::readAbundances().
+//##############################################################################
+
+/**
+ * \brief Copy the zone's abundances into the abundance array.
+ * \param p_zone The zone.
+ */
+
+void
+ZoneAbundances::readAbundances( Libnucnet__Zone * p_zone )
+{
+
+  read( p_zone, p_zone->pAbundanceHash, vAbundances );
+
+  bAbundancesChanged = false;
+
+}
+
+//##############################################################################
+// ZoneAbundances::readAbundanceChanges().
+//##############################################################################
+
+/**
+ * \brief Copy the zone's abundance changes into the abundance change array.
+ * \param p_zone The zone.
+ */
+
+void
+ZoneAbundances::readAbundanceChanges( Libnucnet__Zone * p_zone )
+{
+
+  read( p_zone, p_zone->pAbundanceChangeHash, vAbundanceChanges );
+
+}
+
+//##############################################################################
+// ZoneAbundances::writeAbundances().
+//##############################################################################
+
+/**
+ * \brief Copy the abundance array into the zone.  The result is the same
+ *        as that of Libnucnet__Zone__updateAbundances.
+ * \param p_zone The zone.
+ */
+
+void
+ZoneAbundances::writeAbundances( Libnucnet__Zone * p_zone )
+{
+
+  for( size_t i = 0; i < vSpecies.size(); i++ )
+  {
+
+    double * p_y =
+      (double *)
+      xmlHashLookup(
+        p_zone->pAbundanceHash,
+        (const xmlChar *) Libnucnet__Species__getName( vSpecies[i] )
+      );
+
+    if( p_y && !WnMatrix__value_is_zero( vAbundances[i] ) )
+      *p_y = vAbundances[i];
+    else
+      Libnucnet__Zone__updateSpeciesAbundance(
+        p_zone, vSpecies[i], vAbundances[i]
+      );
+
+  }
+
+  bAbundancesChanged = false;
+
+}
+
+//##############################################################################
+// ZoneAbundances::writeAbundanceChanges().
+//##############################################################################
+
+/**
+ * \brief Copy the abundance change array into the zone.  The result is the
+ *        same as that of Libnucnet__Zone__updateAbundanceChanges.
+ * \param p_zone The zone.
+ */
+
+void
+ZoneAbundances::writeAbundanceChanges( Libnucnet__Zone * p_zone ) const
+{
+
+  for( size_t i = 0; i < vSpecies.size(); i++ )
+  {
+
+    double * p_dy =
+      (double *)
+      xmlHashLookup(
+        p_zone->pAbundanceChangeHash,
+        (const xmlChar *) Libnucnet__Species__getName( vSpecies[i] )
+      );
+
+    if( p_dy && !WnMatrix__value_is_zero( vAbundanceChanges[i] ) )
+      *p_dy = vAbundanceChanges[i];
+    else
+      Libnucnet__Zone__updateSpeciesAbundanceChange(
+        p_zone, vSpecies[i], vAbundanceChanges[i]
+      );
+
+  }
+
+}
+
+//##############################################################################
+// ZoneAbundances::updateAbundance().
+//##############################################################################
+
+/**
+ * \brief Set the abundance of a species in the abundance array.  The zone
+ *        is updated at the next write or sync.
+ * \param p_species The species.
+ * \param d_y The abundance.
+ */
+
+void
+ZoneAbundances::updateAbundance( Libnucnet__Species * p_species, double d_y )
+{
+
+  vAbundances[Libnucnet__Species__getIndex( p_species )] = d_y;
+
+  bAbundancesChanged = true;
+
+}
+
+//##############################################################################
+// ZoneAbundances::syncAbundances().
+//##############################################################################
+
+/**
+ * \brief Bring the zone's abundances up to date with the abundance array.
+ *        The array is only written if it was changed since the last read
+ *        or write.
+ * \param p_zone The zone.
+ */
+
+void
+ZoneAbundances::syncAbundances( Libnucnet__Zone * p_zone )
+{
+
+  if( bAbundancesChanged ) writeAbundances( p_zone );
+
+}
+
+//##############################################################################
+// ZoneAbundances::zeroSmallNegativeAbundances().
+//##############################################################################
+
+/**
+ * \brief Check the abundance array for negative abundances, as
+ *        user::is_nonneg_abunds().  Negative abundances smaller in
+ *        magnitude than the threshold are set to zero.
+ * \param d_abund_min The threshold.
+ * \return False if an abundance is more negative than the threshold, true
+ *         if not.
+ */
+
+bool
+ZoneAbundances::zeroSmallNegativeAbundances( double d_abund_min )
+{
+
+  for( size_t i = 0; i < vAbundances.size(); i++ )
+  {
+
+    if( vAbundances[i] < 0 )
+    {
+      if( fabs( vAbundances[i] ) >= d_abund_min ) return false;
+      vAbundances[i] = 0.;
+      bAbundancesChanged = true;
+    }
+
+  }
+
+  return true;
+
+}
+
+//##############################################################################
+// ZoneAbundances::computeAMoment().
+//##############################################################################
+
+/**
+ * \brief Compute a mass-number moment of the abundances, as
+ *        Libnucnet__Zone__computeAMoment.
+ * \param n The moment.
+ * \return The sum over species of A^n Y.
+ */
+
+double
+ZoneAbundances::computeAMoment( int n ) const
+{
+
+  double d_result = 0.;
+
+  for( size_t i = 0; i < vAbundances.size(); i++ )
+    d_result += pow( vA[i], (double) n ) * vAbundances[i];
+
+  return d_result;
+
+}
+
+//##############################################################################
+// ZoneAbundances::computeZMoment().
+//##############################################################################
+
+/**
+ * \brief Compute a charge moment of the abundances, as
+ *        Libnucnet__Zone__computeZMoment.
+ * \param n The moment.
+ * \return The sum over species of Z^n Y.
+ */
+
+double
+ZoneAbundances::computeZMoment( int n ) const
+{
+
+  double d_result = 0.;
+
+  for( size_t i = 0; i < vAbundances.size(); i++ )
+    d_result += pow( vZ[i], (double) n ) * vAbundances[i];
+
+  return d_result;
+
+}
+
+//##############################################################################
+// ZoneAbundances::computeTimeStep().
+//##############################################################################
+
+/**
+ * \brief Compute the next time step from the abundances and abundance
+ *        changes, as Libnucnet__Zone__updateTimeStep.
+ * \param d_dt The current time step.
+ * \param d_regt The largest fractional increase in the time step.
+ * \param d_regy The largest fractional change in an abundance above
+ *        d_ymin.
+ * \param d_ymin The smallest abundance considered.
+ * \return The new time step.
+ */
+
+double
+ZoneAbundances::computeTimeStep(
+  double d_dt,
+  double d_regt,
+  double d_regy,
+  double d_ymin
+) const
+{
+
+  double d_dt_new = ( 1. + d_regt ) * d_dt;
+
+  for( size_t i = 0; i < vAbundances.size(); i++ )
+  {
+
+    double d_y = vAbundances[i], d_dy = vAbundanceChanges[i];
+
+    if( d_y > d_ymin && !WnMatrix__value_is_zero( d_dy ) )
+    {
+      double d_check =
+        d_dt * d_regy * fabs( d_y / ( d_dy + D_TIME_STEP_TINY ) );
+      if( d_check < d_dt_new ) d_dt_new = d_check;
+    }
+
+  }
+
+  return d_dt_new;
+
+}
+
+//##############################################################################
+// get_zone_abundances().
+//##############################################################################
+
+/**
+ * \brief Retrieve the dense abundance arrays for a zone.  The arrays are
+ *        stored with the zone and only indexed anew when the zone's
+ *        nuclide collection changes.  A new or re-indexed set of arrays
+ *        is read from the zone.
+ * \param zone The zone.
+ * \return A shared pointer to the arrays.
+ */
+
+boost::shared_ptr<ZoneAbundances>
+get_zone_abundances( nnt::Zone& zone )
+{
+
+  if( zone.hasData( nnt::s_ZONE_ABUNDANCES ) )
+  {
+
+    boost::shared_ptr<ZoneAbundances> p_abunds =
+      boost::any_cast<boost::shared_ptr<ZoneAbundances> >(
+        zone.getData( nnt::s_ZONE_ABUNDANCES )
+      );
+
+    if( p_abunds->isValidFor( zone.getNucnetZone() ) ) return p_abunds;
+
+  }
+
+  boost::shared_ptr<ZoneAbundances> p_abunds(
+    new ZoneAbundances( zone.getNucnetZone() )
+  );
+
+  p_abunds->readAbundances( zone.getNucnetZone() );
+  p_abunds->readAbundanceChanges( zone.getNucnetZone() );
+
+  zone.updateData( nnt::s_ZONE_ABUNDANCES, p_abunds );
+
+  return p_abunds;
+
+}
+
+} // namespace user
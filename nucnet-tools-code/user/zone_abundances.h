@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the dense zone abundance arrays.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ZONE_ABUNDANCES_H
+#define ZONE_ABUNDANCES_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Libnucnet.h>
+#include <gsl/gsl_vector.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+#include "nnt/string_defs.h"
+
+namespace user
+{
+
+//##############################################################################
+// Class for the zone abundances.
+//##############################################################################
+
+/**
+ * \brief The abundances and abundance changes of a zone in contiguous
+ *        arrays indexed by Libnucnet__Species__getIndex.
+ *
+ * Libnucnet keeps a zone's abundances in hashes keyed by species name.
+ * During an evolution, the abundance array is the primary storage: the
+ * Newton-Raphson iterations, the moments, the time step, and the
+ * negative abundance check work on it, and getAbundance() and
+ * updateAbundance() give per-species access to it by species index
+ * rather than by name.  The read routines copy the zone's values into the
+ * arrays at entry, and the zone's hashes are only brought up to date when
+ * code outside the arrays may read them: syncAbundances() writes the
+ * abundance array back if it was changed (see markAbundancesChanged())
+ * since the last read or write.  The write routines overwrite the zone's
+ * existing hash entries in place and only call Libnucnet (which
+ * allocates) to add or remove an entry.  user::evolve() and
+ * user::safe_evolve() leave the arrays and the zone matching.
+ */
+
+class ZoneAbundances : private boost::noncopyable
+{
+
+  public:
+    ZoneAbundances( Libnucnet__Zone * );
+    bool isValidFor( Libnucnet__Zone * ) const;
+    size_t getNumberOfSpecies() const { return vSpecies.size(); }
+    Libnucnet__Species * getSpecies( size_t i ) const { return vSpecies[i]; }
+    const std::vector<double>& getMassNumberVector() const { return vA; }
+    const std::vector<double>& getChargeVector() const { return vZ; }
+    const std::vector<double>& getAbundanceVector() const
+      { return vAbundances; }
+    const std::vector<double>& getAbundanceChangeVector() const
+      { return vAbundanceChanges; }
+    gsl_vector_view getAbundanceView()
+      { return gsl_vector_view_array( &vAbundances[0], vAbundances.size() ); }
+    gsl_vector_view getAbundanceChangeView()
+    {
+      return
+        gsl_vector_view_array(
+          &vAbundanceChanges[0], vAbundanceChanges.size()
+        );
+    }
+    double getAbundance( Libnucnet__Species * p_species ) const
+      { return vAbundances[Libnucnet__Species__getIndex( p_species )]; }
+    void updateAbundance( Libnucnet__Species *, double );
+    void markAbundancesChanged() { bAbundancesChanged = true; }
+    void readAbundances( Libnucnet__Zone * );
+    void readAbundanceChanges( Libnucnet__Zone * );
+    void writeAbundances( Libnucnet__Zone * );
+    void writeAbundanceChanges( Libnucnet__Zone * ) const;
+    void syncAbundances( Libnucnet__Zone * );
+    bool zeroSmallNegativeAbundances( double );
+    double computeAMoment( int ) const;
+    double computeZMoment( int ) const;
+    double computeTimeStep( double, double, double, double ) const;
+
+  private:
+    Libnucnet__Nuc * pNuc;
+    size_t iNucUpdate;
+    std::vector<Libnucnet__Species *> vSpecies;
+    std::vector<double> vA;
+    std::vector<double> vZ;
+    std::vector<double> vAbundances;
+    std::vector<double> vAbundanceChanges;
+    bool bAbundancesChanged;
+
+    void read( Libnucnet__Zone *, xmlHashTablePtr, std::vector<double>& );
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+boost::shared_ptr<ZoneAbundances>
+get_zone_abundances( nnt::Zone& );
+
+} // namespace user
+
+#endif // ZONE_ABUNDANCES_H
@@ -0,0 +1,593 @@
+////////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief Code for the flat zone rate vectors.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "user/zone_rates.h"
+#include "user/rate_grid.h"
+#include "user/screen.h"
+
+/**
+ * @brief A namespace for user-defined functions.
+ */
+namespace user
+{
+
+//##############################################################################
+// ZoneRates::ZoneRates().
+//##############################################################################
+
+/**
+ * \brief Index the reactions in a view.
+ * \param p_topology A shared pointer to the compiled topology of the view.
+ *        The rates are indexed in the order of its reactions.
+ */
+
+ZoneRates::ZoneRates(
+  const boost::shared_ptr<ReactionTopology>& p_topology
+) : pView( p_topology->getNetView() ), pTopology( p_topology ),
+    bComputed( false )
+{
+
+  size_t i_max = 0;
+
+  const std::vector<size_t>& v_reactant_ptr =
+    p_topology->getReactantPtrVector();
+  const std::vector<size_t>& v_product_ptr =
+    p_topology->getProductPtrVector();
+
+  BOOST_FOREACH(
+    Libnucnet__Reaction * p_reaction,
+    p_topology->getReactionVector()
+  )
+  {
+
+    size_t r = vReactions.size();
+
+    index_map[p_reaction] = r;
+    vReactions.push_back( p_reaction );
+
+    std::string s_key = Libnucnet__Reaction__getRateFunctionKey( p_reaction );
+
+    size_t i_key =
+      std::find( vFunctionKeys.begin(), vFunctionKeys.end(), s_key ) -
+      vFunctionKeys.begin();
+
+    if( i_key == vFunctionKeys.size() ) vFunctionKeys.push_back( s_key );
+
+    vFunctionKeyIndex.push_back( i_key );
+
+    vReactantNumber.push_back( v_reactant_ptr[r+1] - v_reactant_ptr[r] );
+
+    vProductNumber.push_back( v_product_ptr[r+1] - v_product_ptr[r] );
+
+    i_max =
+      std::max(
+        i_max,
+        std::max( vReactantNumber.back(), vProductNumber.back() )
+      );
+
+  }
+
+  pRatios.reset(
+    new ReverseRatioKernel(
+      Libnucnet__Net__getNuc( Libnucnet__NetView__getNet( pView ) ),
+      vReactions
+    )
+  );
+
+  iNucUpdate =
+    Libnucnet__Net__getNuc( Libnucnet__NetView__getNet( pView ) )->iUpdate;
+
+  vUserData.resize( vFunctionKeys.size() );
+  vRhoPower.resize( i_max + 1 );
+  vForward.assign( vReactions.size(), 0. );
+  vReverse.assign( vReactions.size(), 0. );
+
+}
+
+//##############################################################################
+// ZoneRates::isValidForView().
+//##############################################################################
+
+/**
+ * \brief Check whether the rate arrays apply to a view.
+ * \param p_view A pointer to the network view.
+ * \return True if the arrays were indexed for the view and the network has
+ *         not changed since, false if not.  A change to the nuclear data
+ *         invalidates the precomputed reverse ratios.
+ */
+
+bool
+ZoneRates::isValidForView( Libnucnet__NetView * p_view ) const
+{
+
+  return
+    p_view == pView &&
+    !Libnucnet__NetView__wasNetUpdated( p_view ) &&
+    Libnucnet__Reac__getNumberOfReactions(
+      Libnucnet__Net__getReac( Libnucnet__NetView__getNet( p_view ) )
+    ) == vReactions.size() &&
+    Libnucnet__Net__getNuc(
+      Libnucnet__NetView__getNet( p_view )
+    )->iUpdate == iNucUpdate;
+
+}
+
+//##############################################################################
+// ZoneRates::mapRateGrid().
+//##############################################################################
+
+/**
+ * \brief Map the reactions of the view onto the columns of a rate grid.
+ * \param p_grid A shared pointer to the rate grid of the base network.  The
+ *               arrays keep the grid so that the map stays valid.
+ */
+
+void
+ZoneRates::mapRateGrid( const boost::shared_ptr<RateGrid>& p_grid )
+{
+
+  pGrid = p_grid;
+
+  vGridColumns.clear();
+  vGridIndices.clear();
+  vGridTabulated.assign( vReactions.size(), 0 );
+
+  for( size_t i = 0; i < vReactions.size(); i++ )
+  {
+
+    size_t i_column = p_grid->getColumn( vReactions[i] );
+
+    if( i_column < p_grid->getNumberOfTabulatedReactions() )
+    {
+      vGridColumns.push_back( i_column );
+      vGridIndices.push_back( i );
+      vGridTabulated[i] = 1;
+    }
+
+  }
+
+}
+
+//##############################################################################
+// ZoneRates::getReactionIndex().
+//##############################################################################
+
+/**
+ * \brief Get the index of a reaction in the rate arrays.
+ * \param p_reaction A pointer to the reaction.
+ * \return The index, or the number of reactions if the reaction is not in
+ *         the view.
+ */
+
+size_t
+ZoneRates::getReactionIndex( const Libnucnet__Reaction * p_reaction ) const
+{
+
+  boost::unordered_map<const Libnucnet__Reaction *, size_t>::const_iterator
+    it = index_map.find( p_reaction );
+
+  if( it == index_map.end() ) return vReactions.size();
+
+  return it->second;
+
+}
+
+//##############################################################################
+// ZoneRates::computeRates().
+//##############################################################################
+
+/**
+ * \brief Compute the rates for a zone.
+ * \param p_zone A pointer to the zone.
+ * \param d_t9 The t9 at which to compute the rates.
+ * \param d_rho The mass density (g/cc) at which to compute the rates.
+ * \param p_grid A shared pointer to the rate grid of the base network, or
+ *               an empty pointer.  The grid is only used if the t9 is
+ *               within its range.
+ * \param p_cache A pointer to the zone's rate spline cache, or NULL.  The
+ *                cache supplies the partition functions for the reverse
+ *                ratios.
+ */
+
+void
+ZoneRates::computeRates(
+  Libnucnet__Zone * p_zone,
+  double d_t9,
+  double d_rho,
+  const boost::shared_ptr<RateGrid>& p_grid,
+  RateSplineCache * p_cache
+)
+{
+
+  int i_detailed_balance =
+    Libnucnet__Zone__isComputingReverseRatesFromDetailedBalance( p_zone );
+
+  //============================================================================
+  // Rate function data and density factors.
+  //============================================================================
+
+  for( size_t i = 0; i < vFunctionKeys.size(); i++ )
+    vUserData[i] =
+      Libnucnet__Zone__getDataForUserRateFunction(
+        p_zone,
+        vFunctionKeys[i].c_str()
+      );
+
+  for( size_t i = 0; i < vRhoPower.size(); i++ )
+    vRhoPower[i] = pow( d_rho, (double) i - 1. );
+
+  //============================================================================
+  // Rates.  Tabulated rates are interpolated from the grid.
+  //============================================================================
+
+  bool b_grid = p_grid && p_grid->isInRange( d_t9 );
+
+  if( b_grid )
+  {
+    if( p_grid != pGrid ) mapRateGrid( p_grid );
+    pGrid->interpolateRates(
+      d_t9, i_detailed_balance, vGridColumns, vGridIndices, vForward, vReverse
+    );
+  }
+
+  if(
+    i_detailed_balance &&
+    ( !b_grid || vGridIndices.size() < vReactions.size() )
+  )
+    pRatios->computeRatios( d_t9, p_cache );
+
+  for( size_t i = 0; i < vReactions.size(); i++ )
+  {
+
+    if( !b_grid || !vGridTabulated[i] )
+    {
+      vForward[i] =
+        Libnucnet__Reaction__computeRate(
+          vReactions[i],
+          d_t9,
+          vUserData[vFunctionKeyIndex[i]]
+        );
+
+      vReverse[i] =
+        i_detailed_balance ?
+          pRatios->computeReverseRate( i, &vForward[i] ) :
+          0.;
+    }
+
+    vForward[i] *= vRhoPower[vReactantNumber[i]];
+    vReverse[i] *= vRhoPower[vProductNumber[i]];
+
+  }
+
+  //============================================================================
+  // Screening.  The default screening function is applied to all the
+  // reactions by the kernel; other functions are called per reaction.
+  //============================================================================
+
+  Libnucnet__Zone__screeningFunction pf_screening =
+    Libnucnet__Zone__getScreeningFunction( p_zone );
+
+  if( pf_screening )
+  {
+
+    double d_ye = Libnucnet__Zone__computeZMoment( p_zone, 1 );
+
+    if(
+      pf_screening ==
+        (Libnucnet__Zone__screeningFunction) user::screening_function
+    )
+    {
+      if( !pScreening ) pScreening.reset( new ScreeningKernel( *pTopology ) );
+      pScreening->screenRates( p_zone, d_t9, d_rho, d_ye, vForward, vReverse );
+    }
+    else
+    {
+      for( size_t i = 0; i < vReactions.size(); i++ )
+        pf_screening(
+          p_zone,
+          vReactions[i],
+          d_t9,
+          d_rho,
+          d_ye,
+          &vForward[i],
+          &vReverse[i]
+        );
+    }
+
+  }
+
+  bComputed = true;
+
+}
+
+//##############################################################################
+// ZoneRates::getRatesForReaction().
+//##############################################################################
+
+/**
+ * \brief Get the rates for a reaction.
+ * \param p_reaction A pointer to the reaction.
+ * \param p_forward A pointer to a double to hold the forward rate.
+ * \param p_reverse A pointer to a double to hold the reverse rate.
+ * \return True if the rates were found, false if the rates have not been
+ *         computed or the reaction is not in the view.
+ */
+
+bool
+ZoneRates::getRatesForReaction(
+  const Libnucnet__Reaction * p_reaction,
+  double * p_forward,
+  double * p_reverse
+) const
+{
+
+  size_t i = getReactionIndex( p_reaction );
+
+  if( !bComputed || i == vReactions.size() ) return false;
+
+  *p_forward = vForward[i];
+  *p_reverse = vReverse[i];
+
+  return true;
+
+}
+
+//##############################################################################
+// ZoneRates::updateRatesForReaction().
+//##############################################################################
+
+/**
+ * \brief Update the rates for a reaction.
+ * \param p_reaction A pointer to the reaction.
+ * \param d_forward The new forward rate.
+ * \param d_reverse The new reverse rate.
+ * \return True if the rates were updated, false if the rates have not been
+ *         computed or the reaction is not in the view.
+ */
+
+bool
+ZoneRates::updateRatesForReaction(
+  const Libnucnet__Reaction * p_reaction,
+  double d_forward,
+  double d_reverse
+)
+{
+
+  size_t i = getReactionIndex( p_reaction );
+
+  if( !bComputed || i == vReactions.size() ) return false;
+
+  vForward[i] = d_forward;
+  vReverse[i] = d_reverse;
+
+  return true;
+
+}
+
+//##############################################################################
+// ZoneRates::updateLibnucnetRates().
+//##############################################################################
+
+/**
+ * \brief Copy the rates into the zone's Libnucnet rate hash for routines
+ *        that retrieve the rates through Libnucnet.
+ * \param p_zone A pointer to the zone.
+ */
+
+void
+ZoneRates::updateLibnucnetRates( Libnucnet__Zone * p_zone ) const
+{
+
+  if( !bComputed ) return;
+
+  for( size_t i = 0; i < vReactions.size(); i++ )
+    Libnucnet__Zone__updateRatesForReaction(
+      p_zone,
+      vReactions[i],
+      vForward[i],
+      vReverse[i]
+    );
+
+}
+
+//##############################################################################
+// get_zone_rates().
+//##############################################################################
+
+/**
+ * \brief Retrieve the rate arrays for the zone's current evolution network
+ *        view.  The arrays are stored with the zone and only indexed anew
+ *        when the evolution view changes.
+ * \param zone The zone.
+ * \return A shared pointer to the rate arrays.
+ */
+
+boost::shared_ptr<ZoneRates>
+get_zone_rates( nnt::Zone& zone )
+{
+
+  Libnucnet__NetView * p_view =
+    Libnucnet__Zone__getEvolutionNetView( zone.getNucnetZone() );
+
+  if( zone.hasData( nnt::s_ZONE_RATES ) )
+  {
+
+    boost::shared_ptr<ZoneRates> p_rates =
+      boost::any_cast<boost::shared_ptr<ZoneRates> >(
+        zone.getData( nnt::s_ZONE_RATES )
+      );
+
+    if(
+      p_rates->isValidForView( p_view ) &&
+      p_rates->getTopology().getRevision() == get_view_revision( zone, p_view )
+    )
+      return p_rates;
+
+  }
+
+  boost::shared_ptr<ZoneRates> p_rates(
+    new ZoneRates( get_reaction_topology( zone, p_view ) )
+  );
+
+  zone.updateData( nnt::s_ZONE_RATES, p_rates );
+
+  return p_rates;
+
+}
+
+//##############################################################################
+// compute_rates_for_zone().
+//##############################################################################
+
+/**
+ * \brief Compute the rates for the zone's evolution network at the zone's
+ *        t9 and density into the zone's rate arrays.
+ * \param zone The zone.
+ *
+ * If the zone's use rate grid property is "yes", the rates of reactions
+ * that depend only on t9 are interpolated from the network's rate grid.
+ */
+
+void
+compute_rates_for_zone( nnt::Zone& zone )
+{
+
+  boost::shared_ptr<RateGrid> p_grid;
+
+  if( is_using_rate_grid( zone ) ) p_grid = get_rate_grid_for_zone( zone );
+
+  get_zone_rates( zone )->computeRates(
+    zone.getNucnetZone(),
+    zone.getProperty<double>( nnt::s_T9 ),
+    zone.getProperty<double>( nnt::s_RHO ),
+    p_grid,
+    get_rate_spline_cache_for_zone( zone )
+  );
+
+}
+
+//##############################################################################
+// get_rates_for_reaction().
+//##############################################################################
+
+/**
+ * \brief Get the rates for a reaction in a zone.
+ * \param zone The zone.
+ * \param p_reaction A pointer to the reaction.
+ * \param p_forward A pointer to a double to hold the forward rate.
+ * \param p_reverse A pointer to a double to hold the reverse rate.
+ *
+ * The rates are taken from the zone's rate arrays if they hold the
+ * reaction, and from the zone's Libnucnet rate hash otherwise.
+ */
+
+void
+get_rates_for_reaction(
+  nnt::Zone& zone,
+  const Libnucnet__Reaction * p_reaction,
+  double * p_forward,
+  double * p_reverse
+)
+{
+
+  if(
+    zone.hasData( nnt::s_ZONE_RATES ) &&
+    boost::any_cast<boost::shared_ptr<ZoneRates> >(
+      zone.getData( nnt::s_ZONE_RATES )
+    )->getRatesForReaction( p_reaction, p_forward, p_reverse )
+  )
+    return;
+
+  Libnucnet__Zone__getRatesForReaction(
+    zone.getNucnetZone(),
+    p_reaction,
+    p_forward,
+    p_reverse
+  );
+
+}
+
+//##############################################################################
+// update_rates_for_reaction().
+//##############################################################################
+
+/**
+ * \brief Update the rates for a reaction in a zone.
+ * \param zone The zone.
+ * \param p_reaction A pointer to the reaction.
+ * \param d_forward The new forward rate.
+ * \param d_reverse The new reverse rate.
+ *
+ * The rates are stored in the zone's rate arrays if they hold the
+ * reaction, and in the zone's Libnucnet rate hash otherwise.
+ */
+
+void
+update_rates_for_reaction(
+  nnt::Zone& zone,
+  Libnucnet__Reaction * p_reaction,
+  double d_forward,
+  double d_reverse
+)
+{
+
+  if(
+    zone.hasData( nnt::s_ZONE_RATES ) &&
+    boost::any_cast<boost::shared_ptr<ZoneRates> >(
+      zone.getData( nnt::s_ZONE_RATES )
+    )->updateRatesForReaction( p_reaction, d_forward, d_reverse )
+  )
+    return;
+
+  Libnucnet__Zone__updateRatesForReaction(
+    zone.getNucnetZone(),
+    p_reaction,
+    d_forward,
+    d_reverse
+  );
+
+}
+
+//##############################################################################
+// update_libnucnet_rates_for_zone().
+//##############################################################################
+
+/**
+ * \brief Copy the zone's rate arrays into its Libnucnet rate hash.
+ * \param zone The zone.
+ *
+ * This is only needed before calling Libnucnet routines that retrieve the
+ * rates from the zone, such as Libnucnet__Zone__computeJacobianMatrix.
+ */
+
+void
+update_libnucnet_rates_for_zone( nnt::Zone& zone )
+{
+
+  if( zone.hasData( nnt::s_ZONE_RATES ) )
+    boost::any_cast<boost::shared_ptr<ZoneRates> >(
+      zone.getData( nnt::s_ZONE_RATES )
+    )->updateLibnucnetRates( zone.getNucnetZone() );
+
+}
+
+} // namespace user
@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file was originally written by Bradley S. Meyer.
+//
+// This is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \brief A header file for the flat zone rate vectors.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ZONE_RATES_H
+#define ZONE_RATES_H
+
+//##############################################################################
+// Includes.
+//##############################################################################
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <Libnucnet.h>
+
+#include "nnt/wrappers.hpp"
+#include "nnt/iter.h"
+#include "nnt/string_defs.h"
+
+#include "user/reverse_ratio_kernel.h"
+#include "user/reaction_topology.h"
+#include "user/screening_kernel.h"
+
+namespace user
+{
+
+class RateGrid;
+
+//##############################################################################
+// Class for the zone rates.
+//##############################################################################
+
+/**
+ * \brief The forward and reverse rates of the reactions in a network view
+ *        stored in flat arrays.
+ *
+ * Each reaction in the view has a stable index into the forward and reverse
+ * rate arrays.  computeRates() fills the arrays in the same way as
+ * Libnucnet__Zone__computeRates fills the zone's rate hash (including the
+ * density factors and the zone's screening function), but without
+ * allocating a rate structure for each reaction.  Reverse rates from
+ * detailed balance use the precomputed ratios of a ReverseRatioKernel
+ * rather than Libnucnet__Net__computeReverseRate.  With the default
+ * screening function, all the reactions are screened in one pass by a
+ * ScreeningKernel; another screening function set on the zone is called
+ * for each reaction.  If a RateGrid for the base network is
+ * supplied, the reactions of the view are mapped onto its columns once, and
+ * the rates of the tabulated reactions are interpolated from the grid
+ * rather than evaluated.  The reaction-keyed
+ * accessors allow the arrays to be used in place of
+ * Libnucnet__Zone__getRatesForReaction and
+ * Libnucnet__Zone__updateRatesForReaction.
+ */
+
+class ZoneRates : private boost::noncopyable
+{
+
+  public:
+    ZoneRates( const boost::shared_ptr<ReactionTopology>& );
+    Libnucnet__NetView * getNetView() const { return pView; }
+    const ReactionTopology& getTopology() const { return *pTopology; }
+    boost::shared_ptr<ReactionTopology> getTopologyPtr() const
+      { return pTopology; }
+    bool isValidForView( Libnucnet__NetView * ) const;
+    size_t getNumberOfReactions() const { return vReactions.size(); }
+    const std::vector<Libnucnet__Reaction *>& getReactionVector() const
+      { return vReactions; }
+    size_t getReactionIndex( const Libnucnet__Reaction * ) const;
+    std::vector<double>& getForwardRateVector() { return vForward; }
+    std::vector<double>& getReverseRateVector() { return vReverse; }
+    const std::vector<double>& getForwardRateVector() const
+      { return vForward; }
+    const std::vector<double>& getReverseRateVector() const
+      { return vReverse; }
+    bool hasRates() const { return bComputed; }
+    void computeRates(
+      Libnucnet__Zone *,
+      double,
+      double,
+      const boost::shared_ptr<RateGrid>& = boost::shared_ptr<RateGrid>(),
+      RateSplineCache * = NULL
+    );
+    bool getRatesForReaction(
+      const Libnucnet__Reaction *, double *, double *
+    ) const;
+    bool updateRatesForReaction( const Libnucnet__Reaction *, double, double );
+    void updateLibnucnetRates( Libnucnet__Zone * ) const;
+
+  private:
+    Libnucnet__NetView * pView;
+    boost::shared_ptr<ReactionTopology> pTopology;
+    size_t iNucUpdate;
+    bool bComputed;
+    std::vector<Libnucnet__Reaction *> vReactions;
+    boost::unordered_map<const Libnucnet__Reaction *, size_t> index_map;
+    std::vector<std::string> vFunctionKeys;
+    std::vector<size_t> vFunctionKeyIndex;
+    std::vector<size_t> vReactantNumber;
+    std::vector<size_t> vProductNumber;
+    std::vector<void *> vUserData;
+    std::vector<double> vRhoPower;
+    std::vector<double> vForward;
+    std::vector<double> vReverse;
+    boost::shared_ptr<ReverseRatioKernel> pRatios;
+    boost::shared_ptr<ScreeningKernel> pScreening;
+    boost::shared_ptr<RateGrid> pGrid;
+    std::vector<size_t> vGridColumns;
+    std::vector<size_t> vGridIndices;
+    std::vector<char> vGridTabulated;
+    void mapRateGrid( const boost::shared_ptr<RateGrid>& );
+
+};
+
+//##############################################################################
+// Prototypes.
+//##############################################################################
+
+boost::shared_ptr<ZoneRates>
+get_zone_rates( nnt::Zone& );
+
+void
+compute_rates_for_zone( nnt::Zone& );
+
+void
+get_rates_for_reaction(
+  nnt::Zone&,
+  const Libnucnet__Reaction *,
+  double *,
+  double *
+);
+
+void
+update_rates_for_reaction(
+  nnt::Zone&,
+  Libnucnet__Reaction *,
+  double,
+  double
+);
+
+void
+update_libnucnet_rates_for_zone( nnt::Zone& );
+
+} // namespace user
+
+#endif // ZONE_RATES_H